@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <kettle/kettle.hpp>
+
+/*
+    Times the engines that the `KETTLE_PRNG_ENGINE` CMake option can choose from, on the two ways the
+    library draws from them: raw outputs, and uniform doubles on [0, 1), which is what the sampling
+    methods use. The time of each engine is the best of a few runs.
+*/
+
+namespace
+{
+
+constexpr auto N_REPEATS = std::size_t {3};
+constexpr auto N_DRAWS = std::size_t {50'000'000};
+
+template <typename Engine, typename Draw>
+auto time_draws_(Draw draw) -> double
+{
+    auto best_seconds = -1.0;
+
+    for (std::size_t i_repeat {0}; i_repeat < N_REPEATS; ++i_repeat) {
+        auto engine = Engine {42};
+
+        const auto start = std::chrono::steady_clock::now();
+        auto checksum = draw(engine);
+        const auto stop = std::chrono::steady_clock::now();
+
+        // use the output, so the loop cannot be optimized away
+        if (checksum == 0) {
+            std::cerr << "unexpected checksum\n";
+        }
+
+        const auto seconds = std::chrono::duration<double> {stop - start}.count();
+        if (best_seconds < 0.0 || seconds < best_seconds) {
+            best_seconds = seconds;
+        }
+    }
+
+    return best_seconds;
+}
+
+template <typename Engine>
+void print_engine_(const std::string& name)
+{
+    const auto raw_seconds = time_draws_<Engine>([](Engine& engine) {
+        auto checksum = std::uint64_t {0};
+        for (std::size_t i {0}; i < N_DRAWS; ++i) {
+            checksum ^= static_cast<std::uint64_t>(engine());
+        }
+        return checksum;
+    });
+
+    const auto uniform_seconds = time_draws_<Engine>([](Engine& engine) {
+        auto uniform = std::uniform_real_distribution<double> {0.0, 1.0};
+        auto sum = 0.0;
+        for (std::size_t i {0}; i < N_DRAWS; ++i) {
+            sum += uniform(engine);
+        }
+        return static_cast<std::uint64_t>(sum);
+    });
+
+    const auto bytes_per_output = sizeof(typename Engine::result_type);
+    const auto n_draws = static_cast<double>(N_DRAWS);
+
+    std::cout << std::setw(20) << name
+              << std::setw(16) << 1.0e-6 * n_draws / raw_seconds
+              << std::setw(12) << 1.0e-9 * n_draws * static_cast<double>(bytes_per_output) / raw_seconds
+              << std::setw(18) << 1.0e-6 * n_draws / uniform_seconds << '\n';
+}
+
+}  // namespace
+
+
+auto main() -> int
+{
+    std::cout << std::setw(20) << "engine"
+              << std::setw(16) << "outputs (M/s)"
+              << std::setw(12) << "GB/s"
+              << std::setw(18) << "doubles (M/s)" << '\n';
+
+    std::cout << std::fixed << std::setprecision(1);
+
+    print_engine_<std::mt19937>("MT19937");
+    print_engine_<ket::Xoshiro256PlusPlus>("XOSHIRO256PP");
+    print_engine_<ket::Philox4x32>("PHILOX4X32");
+
+    return 0;
+}
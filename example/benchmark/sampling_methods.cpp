@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <kettle/kettle.hpp>
+
+/*
+    Times the CUMULATIVE and ALIAS sampling methods over a range of state sizes and numbers of shots,
+    to show where one overtakes the other; the time of each configuration is the best of a few runs,
+    and includes the setup (the cumulative distribution, or the alias table) done for every call.
+*/
+
+namespace
+{
+
+constexpr auto N_REPEATS = std::size_t {3};
+
+auto time_sampling_(const std::vector<double>& probabilities, std::size_t n_shots, ket::SamplingMethod method) -> double
+{
+    auto best_seconds = -1.0;
+
+    for (std::size_t i_repeat {0}; i_repeat < N_REPEATS; ++i_repeat) {
+        const auto start = std::chrono::steady_clock::now();
+        const auto memory = ket::perform_measurements_as_memory(probabilities, n_shots, 42, method);
+        const auto stop = std::chrono::steady_clock::now();
+
+        // use the output, so the call cannot be optimized away
+        if (memory.size() != n_shots) {
+            std::cerr << "unexpected number of measurements\n";
+        }
+
+        const auto seconds = std::chrono::duration<double> {stop - start}.count();
+        if (best_seconds < 0.0 || seconds < best_seconds) {
+            best_seconds = seconds;
+        }
+    }
+
+    return best_seconds;
+}
+
+}  // namespace
+
+
+auto main() -> int
+{
+    const auto all_n_qubits = std::vector<std::size_t> {4, 10, 16, 20, 22};
+    const auto all_n_shots = std::vector<std::size_t> {1'000, 100'000, 1'000'000};
+
+    std::cout << std::setw(8) << "n_qubits"
+              << std::setw(12) << "n_shots"
+              << std::setw(18) << "CUMULATIVE (ms)"
+              << std::setw(14) << "ALIAS (ms)"
+              << std::setw(10) << "ratio" << '\n';
+
+    std::cout << std::fixed << std::setprecision(3);
+
+    for (const auto n_qubits : all_n_qubits) {
+        const auto state = ket::generate_random_state(n_qubits);
+        const auto probabilities = ket::calculate_probabilities_raw(state);
+
+        for (const auto n_shots : all_n_shots) {
+            const auto cumulative = time_sampling_(probabilities, n_shots, ket::SamplingMethod::CUMULATIVE);
+            const auto alias = time_sampling_(probabilities, n_shots, ket::SamplingMethod::ALIAS);
+
+            std::cout << std::setw(8) << n_qubits
+                      << std::setw(12) << n_shots
+                      << std::setw(18) << 1000.0 * cumulative
+                      << std::setw(14) << 1000.0 * alias
+                      << std::setw(10) << cumulative / alias << '\n';
+        }
+    }
+
+    return 0;
+}
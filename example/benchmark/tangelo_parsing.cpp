@@ -0,0 +1,198 @@
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <kettle/kettle.hpp>
+
+/*
+    Times the tangelo reader against the `std::istringstream` parsing it used before it read the
+    lines with a tokenizer, on a large generated circuit. Both parse the same text from a
+    `std::istringstream`, so only the parsing differs; the time of each is the best of a few runs.
+
+    The old parsing is copied here for the gates in the generated circuit only: each line gets its
+    own `std::stringstream`, and every token is extracted with `operator>>`. The gate names are
+    compared directly instead of being looked up in the table of all the primitive gates, so the
+    old parsing is, if anything, a little faster here than it was in the library.
+*/
+
+namespace
+{
+
+constexpr auto N_REPEATS = std::size_t {3};
+constexpr auto N_QUBITS = std::size_t {20};
+constexpr auto N_LINES = std::size_t {500'000};
+
+auto generate_tangelo_text_() -> std::string
+{
+    auto prng = std::mt19937 {42};
+    auto qubit = std::uniform_int_distribution<std::size_t> {0, N_QUBITS - 1};
+    auto angle = std::uniform_real_distribution<double> {0.0, 6.283185307179586};
+
+    auto stream = std::ostringstream {};
+    stream << std::setprecision(17);
+
+    for (std::size_t i {0}; i < N_LINES; ++i) {
+        const auto target = qubit(prng);
+        const auto control = (target + 1 + qubit(prng) % (N_QUBITS - 1)) % N_QUBITS;
+
+        switch (i % 5) {
+            case 0 :
+                stream << "H         target : [" << target << "]   \n";
+                break;
+            case 1 :
+                stream << "RX        target : [" << target << "]   parameter : " << angle(prng) << '\n';
+                break;
+            case 2 :
+                stream << "CNOT      target : [" << target << "]   control : [" << control << "]   \n";
+                break;
+            case 3 :
+                stream << "RZ        target : [" << target << "]   parameter : " << angle(prng) << '\n';
+                break;
+            default :
+                stream << "CRZ       target : [" << target << "]   control : [" << control << "]   parameter : " << angle(prng) << '\n';
+                break;
+        }
+    }
+
+    return stream.str();
+}
+
+auto old_tangelo_to_local_name_(const std::string& name) -> std::string
+{
+    if (name == "CNOT") {
+        return "CX";
+    }
+    else {
+        return name;
+    }
+}
+
+void old_parse_tangelo_line_(ket::QuantumCircuit& circuit, std::stringstream& gatestream)
+{
+    std::string name;
+    gatestream >> name;
+
+    if (name == "") {
+        return;
+    }
+
+    const auto local_name = old_tangelo_to_local_name_(name);
+
+    std::string dummy_str;
+    char dummy_ch;  // NOLINT(cppcoreguidelines-init-variables)
+    std::size_t target_qubit;  // NOLINT(cppcoreguidelines-init-variables)
+    std::size_t control_qubit;  // NOLINT(cppcoreguidelines-init-variables)
+    double angle;  // NOLINT(cppcoreguidelines-init-variables)
+
+    gatestream >> dummy_str >> dummy_str >> dummy_ch >> target_qubit >> dummy_ch;  // 'target : [i]'
+
+    if (local_name == "H") {
+        circuit.add_h_gate(target_qubit);
+    }
+    else if (local_name == "RX" || local_name == "RZ") {
+        gatestream >> dummy_str >> dummy_str >> angle;  // 'parameter : angle'
+        if (local_name == "RX") {
+            circuit.add_rx_gate(target_qubit, angle);
+        }
+        else {
+            circuit.add_rz_gate(target_qubit, angle);
+        }
+    }
+    else if (local_name == "CX" || local_name == "CRZ") {
+        gatestream >> dummy_str >> dummy_str >> dummy_ch >> control_qubit >> dummy_ch;  // 'control : [i]'
+        if (local_name == "CX") {
+            circuit.add_cx_gate(control_qubit, target_qubit);
+        }
+        else {
+            gatestream >> dummy_str >> dummy_str >> angle;  // 'parameter : angle'
+            circuit.add_crz_gate(control_qubit, target_qubit, angle);
+        }
+    }
+    else {
+        throw std::runtime_error {"ERROR: unexpected gate in the generated circuit: " + local_name + '\n'};
+    }
+}
+
+auto old_read_tangelo_circuit_(std::size_t n_qubits, std::istream& stream) -> ket::QuantumCircuit
+{
+    auto circuit = ket::QuantumCircuit {n_qubits};
+
+    std::string line;
+    while (std::getline(stream, line)) {
+        auto gatestream = std::stringstream {line};
+        old_parse_tangelo_line_(circuit, gatestream);
+    }
+
+    return circuit;
+}
+
+template <typename Read>
+auto time_reading_(const std::string& text, Read read) -> std::pair<double, std::size_t>
+{
+    auto best_seconds = -1.0;
+    auto n_elements = std::size_t {0};
+
+    for (std::size_t i_repeat {0}; i_repeat < N_REPEATS; ++i_repeat) {
+        auto stream = std::istringstream {text};
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto circuit = read(stream);
+        const auto stop = std::chrono::steady_clock::now();
+
+        n_elements = circuit.n_circuit_elements();
+
+        const auto seconds = std::chrono::duration<double> {stop - start}.count();
+        if (best_seconds < 0.0 || seconds < best_seconds) {
+            best_seconds = seconds;
+        }
+    }
+
+    return {best_seconds, n_elements};
+}
+
+}  // namespace
+
+
+auto main() -> int
+{
+    const auto text = generate_tangelo_text_();
+
+    const auto [old_seconds, old_n_elements] = time_reading_(text, [](std::istream& stream) {
+        return old_read_tangelo_circuit_(N_QUBITS, stream);
+    });
+
+    const auto [new_seconds, new_n_elements] = time_reading_(text, [](std::istream& stream) {
+        return ket::read_tangelo_circuit(N_QUBITS, stream, 0);
+    });
+
+    if (old_n_elements != N_LINES || new_n_elements != N_LINES) {
+        std::cerr << "ERROR: the circuits do not hold one element per line\n";
+        return 1;
+    }
+
+    const auto megabytes = static_cast<double>(text.size()) / 1.0e6;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "lines: " << N_LINES << ", size: " << megabytes << " MB\n";
+    std::cout << std::setw(16) << "parser"
+              << std::setw(12) << "time (ms)"
+              << std::setw(10) << "MB/s" << '\n';
+
+    std::cout << std::setw(16) << "istringstream"
+              << std::setw(12) << 1000.0 * old_seconds
+              << std::setw(10) << megabytes / old_seconds << '\n';
+
+    std::cout << std::setw(16) << "text cursor"
+              << std::setw(12) << 1000.0 * new_seconds
+              << std::setw(10) << megabytes / new_seconds << '\n';
+
+    std::cout << std::setprecision(2) << "speedup: " << old_seconds / new_seconds << '\n';
+
+    return 0;
+}
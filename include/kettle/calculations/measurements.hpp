@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <optional>
 #include <string>
@@ -17,6 +18,38 @@
 namespace ket
 {
 
+/*
+    The method used to draw each shot from the probability distribution over the computational states
+    (n = number of qubits, k = number of shots):
+      - CUMULATIVE: binary search over the cumulative distribution; O(2^n) setup, O(n) per shot
+      - ALIAS: Walker's alias method; O(2^n) setup (about 5 times the cost of CUMULATIVE), O(1) per shot
+      - MULTINOMIAL: the counts are drawn directly, by splitting the shots with binomial draws down a
+        binary tree over the state indices; O(2^n) in total, independent of k
+      - STREAMING: k sorted uniform random numbers are drawn, and matched to the states in a single
+        sweep over the probabilities; O(2^n + k) in total, with only O(k) extra memory
+
+    The binary search of CUMULATIVE makes about n random memory accesses per shot, while ALIAS makes
+    one, so ALIAS wins once the number of shots is a few times 2^n. The example in
+    `example/benchmark/sampling_methods.cpp` times both; on a single thread, ALIAS took 1.6 to 4.7
+    times less time for 10^6 shots from 4 to 22 qubits, while CUMULATIVE took 4 to 8 times less time
+    for 10^3 shots from 16 qubits up, where building the alias table dominates.
+
+    MULTINOMIAL is the fastest way to get counts for a large number of shots; when the memory is
+    requested, the counts are expanded into a randomly shuffled vector, which still takes O(k) time.
+
+    STREAMING is meant for large states; when measuring a `Statevector` without noise, the amplitudes
+    are read directly, so no vector of 2^n probabilities is created at all.
+
+    The methods give different (but equally distributed) measurements for the same seed.
+*/
+enum class SamplingMethod : std::uint8_t
+{
+    CUMULATIVE,
+    ALIAS,
+    MULTINOMIAL,
+    STREAMING
+};
+
 auto memory_to_counts(const std::vector<std::size_t>& measurements) -> std::map<std::size_t, std::size_t>;
 
 auto memory_to_fractions(const std::vector<std::size_t>& measurements) -> std::map<std::size_t, double>;
@@ -38,38 +71,97 @@ auto memory_to_fractions(const std::vector<std::size_t>& measurements) -> std::m
     Reference MicroQiskit
       - memory complexity: O(max(2^n, k))
       - time complexity: O(k * 2^n)
+
+    The shots of this function and the other `perform_measurements_*()` functions can be split across
+    `n_threads` threads. Each thread draws from its own stream of random numbers derived from the seed,
+    so the measurements are reproducible for a given seed and number of threads, but change with the
+    number of threads.
 */
 auto perform_measurements_as_memory(
     const std::vector<double>& probabilities_raw,
     std::size_t n_shots,
-    std::optional<int> seed = std::nullopt
+    std::optional<int> seed = std::nullopt,
+    SamplingMethod method = SamplingMethod::CUMULATIVE,
+    std::size_t n_threads = 1
 ) -> std::vector<std::size_t>;
 
 auto perform_measurements_as_memory(
     const Statevector& state,
     std::size_t n_shots,
     const QuantumNoise* noise = nullptr,
-    std::optional<int> seed = std::nullopt
+    std::optional<int> seed = std::nullopt,
+    SamplingMethod method = SamplingMethod::CUMULATIVE,
+    std::size_t n_threads = 1
 ) -> std::vector<std::size_t>;
 
 auto perform_measurements_as_counts_raw(
     const std::vector<double>& probabilities_raw,
     std::size_t n_shots,
-    std::optional<int> seed = std::nullopt
+    std::optional<int> seed = std::nullopt,
+    SamplingMethod method = SamplingMethod::CUMULATIVE,
+    std::size_t n_threads = 1
 ) -> std::map<std::size_t, std::size_t>;
 
 auto perform_measurements_as_counts_raw(
     const Statevector& state,
     std::size_t n_shots,
     const QuantumNoise* noise = nullptr,
-    std::optional<int> seed = std::nullopt
+    std::optional<int> seed = std::nullopt,
+    SamplingMethod method = SamplingMethod::CUMULATIVE,
+    std::size_t n_threads = 1
 ) -> std::map<std::size_t, std::size_t>;
 
+/*
+    Performs measurements of the state, and counts them in a dense vector, without creating a string
+    for each outcome; the vector has 2^m entries, where m is the number of qubits that are not in
+    `marginal_qubits`.
+
+    The entry at index `i` holds the counts of the outcome where the k-th measured qubit (in increasing
+    order of qubit index) has the value of bit k of `i`. For example, with 4 qubits and marginal qubits
+    {1}, bit 0 of `i` is the outcome of qubit 0, bit 1 is qubit 2, and bit 2 is qubit 3.
+
+    The shots are drawn from the marginal distribution of the measured qubits (see
+    `calculate_marginal_probabilities_raw()`), rather than from the full distribution.
+
+    For the same seed, sampling method, and number of threads, the counts match those of
+    `perform_measurements_as_counts_marginal()`.
+*/
+auto perform_measurements_as_counts_dense(
+    const std::vector<double>& probabilities_raw,
+    std::size_t n_shots,
+    const std::vector<std::size_t>& marginal_qubits = {},
+    std::optional<int> seed = std::nullopt,
+    SamplingMethod method = SamplingMethod::CUMULATIVE,
+    std::size_t n_threads = 1
+) -> std::vector<std::uint64_t>;
+
+auto perform_measurements_as_counts_dense(
+    const Statevector& state,
+    std::size_t n_shots,
+    const std::vector<std::size_t>& marginal_qubits = {},
+    const QuantumNoise* noise = nullptr,
+    std::optional<int> seed = std::nullopt,
+    SamplingMethod method = SamplingMethod::CUMULATIVE,
+    std::size_t n_threads = 1
+) -> std::vector<std::uint64_t>;
+
+/*
+    Converts the counts made by `perform_measurements_as_counts_dense()` into the bitstring counts
+    made by `perform_measurements_as_counts_marginal()`; outcomes with zero counts are left out.
+*/
+auto dense_counts_to_marginal_counts(
+    const std::vector<std::uint64_t>& dense_counts,
+    std::size_t n_qubits,
+    const std::vector<std::size_t>& marginal_qubits = {}
+) -> std::map<std::string, std::size_t>;
+
 auto perform_measurements_as_counts_marginal(
     const std::vector<double>& probabilities_raw,
     std::size_t n_shots,
     const std::vector<std::size_t>& marginal_qubits = {},
-    std::optional<int> seed = std::nullopt
+    std::optional<int> seed = std::nullopt,
+    SamplingMethod method = SamplingMethod::CUMULATIVE,
+    std::size_t n_threads = 1
 ) -> std::map<std::string, std::size_t>;
 
 auto perform_measurements_as_counts_marginal(
@@ -77,9 +169,18 @@ auto perform_measurements_as_counts_marginal(
     std::size_t n_shots,
     const std::vector<std::size_t>& marginal_qubits = {},
     const QuantumNoise* noise = nullptr,
-    std::optional<int> seed = std::nullopt
+    std::optional<int> seed = std::nullopt,
+    SamplingMethod method = SamplingMethod::CUMULATIVE,
+    std::size_t n_threads = 1
 ) -> std::map<std::string, std::size_t>;
 
+/*
+    Runs `circuit` on `original_state` for `n_shots` shots, and measures the final state of each shot.
+
+    The shots are simulated together with `simulate_branches()`, so the circuit is only simulated once
+    for each distinct sequence of mid-circuit measurement outcomes; the final measurements of each branch
+    are then drawn from a multinomial distribution.
+*/
 auto perform_measurements_as_counts_marginal(
     const QuantumCircuit& circuit,
     const Statevector& original_state,
@@ -93,7 +194,9 @@ auto perform_measurements_as_counts(
     const Statevector& state,
     std::size_t n_shots,
     const QuantumNoise* noise = nullptr,
-    std::optional<int> seed = std::nullopt
+    std::optional<int> seed = std::nullopt,
+    SamplingMethod method = SamplingMethod::CUMULATIVE,
+    std::size_t n_threads = 1
 ) -> std::map<std::string, std::size_t>;
 
 }  // namespace ket
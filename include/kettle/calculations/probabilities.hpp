@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -16,6 +18,24 @@
 namespace ket
 {
 
+/*
+    How the noise of a QuantumNoise object is applied when measurements are performed
+    (n = number of qubits, k = number of shots):
+      - PROBABILITIES: the probabilities of all 2^n states are transformed before sampling, with one
+        full pass over them for each qubit; O(n * 2^n)
+      - SHOTS: the shots are sampled from the noiseless probabilities, and then the bit of each qubit
+        in each shot is flipped with the noise probability of that qubit; only the flipped bits are
+        visited, so the cost is O(n + k * (sum of the noise probabilities))
+
+    Both give measurements with the same distribution, but different measurements for the same seed.
+    The probabilities calculated by `calculate_probabilities_raw()` always use PROBABILITIES.
+*/
+enum class NoiseApplication : std::uint8_t
+{
+    PROBABILITIES,
+    SHOTS
+};
+
 /*
     The QuantumNoise class holds the noise applied to the probabilities calculated
     from the Statevector object.
@@ -26,16 +46,23 @@ namespace ket
 class QuantumNoise
 {
 public:
-    explicit QuantumNoise(std::size_t n_qubits);
+    explicit QuantumNoise(std::size_t n_qubits, NoiseApplication application = NoiseApplication::PROBABILITIES);
 
     void set(std::size_t index, double noise);
 
     [[nodiscard]]
     auto get(std::size_t index) const -> const double&;
 
+    [[nodiscard]]
+    constexpr auto application() const noexcept -> NoiseApplication
+    {
+        return application_;
+    }
+
 private:
     std::size_t n_qubits_;
     std::vector<double> noise_;
+    NoiseApplication application_;
 
     void check_index_(std::size_t index) const;
 };
@@ -50,4 +77,25 @@ auto calculate_probabilities(
     const QuantumNoise* noise = nullptr
 ) -> std::map<std::string, double>;
 
+/*
+    Calculates the probabilities of the outcomes of the qubits that are not in `marginal_qubits`, by
+    summing the probabilities of all the states that share the same outcome. The result has 2^m entries,
+    where m is the number of measured qubits, and is indexed in the same way as the counts made by
+    `perform_measurements_as_counts_dense()`.
+
+    The states are split into `n_threads` contiguous sections, which are reduced in parallel.
+*/
+auto calculate_marginal_probabilities_raw(
+    const std::vector<double>& probabilities_raw,
+    const std::vector<std::size_t>& marginal_qubits,
+    std::size_t n_threads = 1
+) -> std::vector<double>;
+
+auto calculate_marginal_probabilities_raw(
+    const Statevector& state,
+    const std::vector<std::size_t>& marginal_qubits,
+    const QuantumNoise* noise = nullptr,
+    std::size_t n_threads = 1
+) -> std::vector<double>;
+
 }  // namespace ket
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "kettle/common/tolerance.hpp"
+
+/*
+    This file contains code components to model the errors made when the qubits are read out, and to
+    undo these errors on the measured counts (readout-error mitigation).
+
+    Unlike `QuantumNoise`, the errors can be asymmetric (a qubit in |1> can decay to a 0 more often
+    than a qubit in |0> is excited to a 1), and groups of qubits can have correlated errors.
+*/
+
+namespace ket
+{
+
+/*
+    A group of qubits whose readout errors are described together by a single confusion matrix.
+
+    The entry `confusion_matrix(i_measured, i_prepared)` is the probability of reading out the outcome
+    `i_measured` when the qubits of the block are in the computational state `i_prepared`; bit `k` of
+    each index is the value of the qubit `qubits[k]`. Each column of the matrix sums to 1.
+*/
+struct ReadoutConfusionBlock
+{
+    std::vector<std::size_t> qubits;
+    Eigen::MatrixXd confusion_matrix;
+    Eigen::MatrixXd inverse;  // empty if the confusion matrix is singular
+};
+
+/*
+    The ReadoutNoiseModel class holds the confusion matrices of the readout errors of a register of
+    qubits, as a tensor product of independent blocks; each qubit belongs to at most one block, and
+    qubits that do not belong to any block are read out without errors.
+*/
+class ReadoutNoiseModel
+{
+public:
+    explicit ReadoutNoiseModel(std::size_t n_qubits);
+
+    /*
+        Sets the readout error of a single qubit, where `prob_0_to_1` is the probability of reading
+        out a 1 when the qubit is in |0>, and `prob_1_to_0` is the probability of reading out a 0
+        when the qubit is in |1>. Replaces the earlier error of the qubit, if it was set by this
+        member function; throws if the qubit belongs to a correlated block.
+    */
+    void set_qubit_error(std::size_t qubit, double prob_0_to_1, double prob_1_to_0);
+
+    /*
+        Adds a block of correlated readout errors over `qubits`, with the 2^k x 2^k `confusion_matrix`
+        laid out as described in `ReadoutConfusionBlock`. Throws if the matrix does not have the right
+        shape, if it is not column-stochastic, or if any of the qubits already belongs to a block.
+    */
+    void add_correlated_block(
+        const std::vector<std::size_t>& qubits,
+        const Eigen::MatrixXd& confusion_matrix,
+        double tolerance = CONFUSION_MATRIX_COLUMN_SUM_TOLERANCE
+    );
+
+    [[nodiscard]]
+    constexpr auto n_qubits() const noexcept -> std::size_t
+    {
+        return n_qubits_;
+    }
+
+    [[nodiscard]]
+    constexpr auto blocks() const noexcept -> const std::vector<ReadoutConfusionBlock>&
+    {
+        return blocks_;
+    }
+
+private:
+    std::size_t n_qubits_;
+    std::vector<ReadoutConfusionBlock> blocks_;
+    std::vector<std::size_t> block_of_qubit_;
+
+    void add_block_(ReadoutConfusionBlock block);
+};
+
+/*
+    Applies the readout errors of `model` to the probabilities of all 2^n computational states, in place.
+
+    The confusion matrix of the whole register is the tensor product of the matrices of the blocks, so
+    it is never built; instead, each block is applied in a single pass over the probabilities, which
+    costs O(2^n * 2^k) for a block of k qubits.
+*/
+void apply_readout_noise(std::vector<double>& probabilities_raw, const ReadoutNoiseModel& model);
+
+/*
+    Undoes the readout errors of `model` on the dense counts made by `perform_measurements_as_counts_dense()`
+    with the same `marginal_qubits`, by applying the inverse of the confusion matrix of each block.
+
+    The inverse of a tensor product is the tensor product of the inverses, so only the (small) matrix of
+    each block is inverted, and each is applied in a single pass over the counts. The result is the
+    estimate of the counts without readout errors; it has the same total as the input, but some entries
+    can be negative due to the statistical noise in the counts.
+
+    Throws if a block has a singular confusion matrix, or if a block contains both measured and
+    marginal qubits, since the errors of the measured qubits then depend on the unmeasured ones.
+*/
+auto mitigate_readout_counts(
+    const std::vector<std::uint64_t>& dense_counts,
+    const ReadoutNoiseModel& model,
+    const std::vector<std::size_t>& marginal_qubits = {}
+) -> std::vector<double>;
+
+}  // namespace ket
@@ -14,9 +14,18 @@
 #include "kettle/parameter/parameter.hpp"
 
 
+namespace ket::internal
+{
+
+class BinaryCircuitCodec;
+
+}  // namespace ket::internal
+
 namespace ket
 {
 
+struct CircuitOptimizationStatistics;
+
 class QuantumCircuit
 {
 public:
@@ -363,7 +372,27 @@ public:
 
     friend auto append_circuits(QuantumCircuit left, const QuantumCircuit& right) -> QuantumCircuit;
     friend void extend_circuit(QuantumCircuit& left, const QuantumCircuit& right);
+    friend void extend_circuit(QuantumCircuit& left, QuantumCircuit&& right);
     friend auto transpile_to_primitive(const QuantumCircuit& circuit, double tolerance_sq) -> QuantumCircuit;
+    friend auto relabel_qubits(
+        const QuantumCircuit& circuit,
+        const std::vector<std::size_t>& new_qubit_indices,
+        std::size_t new_n_qubits
+    ) -> QuantumCircuit;
+    friend auto prune_to_lightcone(
+        const QuantumCircuit& circuit,
+        const std::vector<std::size_t>& observed_qubits,
+        const std::vector<std::size_t>& observed_bits
+    ) -> QuantumCircuit;
+    friend auto optimize_circuit(
+        const QuantumCircuit& circuit,
+        CircuitOptimizationStatistics& statistics,
+        std::size_t window_size,
+        double angle_tolerance
+    ) -> QuantumCircuit;
+    friend auto reorder_commuting_gates(const QuantumCircuit& circuit) -> QuantumCircuit;
+    friend class CircuitDAG;
+    friend class ket::internal::BinaryCircuitCodec;
 
 private:
     std::size_t n_qubits_;
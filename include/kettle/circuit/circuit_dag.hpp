@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit/circuit_element.hpp"
+#include "kettle/parameter/parameter.hpp"
+
+/*
+    This header file contains the `CircuitDAG` class, which represents a `QuantumCircuit` as a
+    directed acyclic graph of dependencies between its elements.
+*/
+
+namespace ket
+{
+
+/*
+    A directed acyclic graph where each node is one of the top-level elements of a `QuantumCircuit`,
+    and there is an edge from node `a` to node `b` if `b` must be applied after `a`.
+
+    Node `b` depends on node `a` if `a` comes earlier in the circuit, and:
+      - they act on the same qubit, with no node in between acting on that qubit
+      - `b` reads a classical bit last written by `a`
+      - `b` writes a classical bit that `a` wrote to or read from, with no write in between
+
+    A control flow statement acts on every qubit and bit used anywhere inside of its subcircuits, and
+    reads the bits of its predicate. A circuit logger acts on every qubit and bit, so no node moves past it.
+
+    The nodes are numbered by their position in the original circuit, which is always a valid
+    topological order of the graph. The graph holds copies of the elements and the parameters of the
+    circuit, so `to_circuit()` recreates the original circuit exactly.
+*/
+class CircuitDAG
+{
+public:
+    explicit CircuitDAG(const QuantumCircuit& circuit);
+
+    [[nodiscard]]
+    constexpr auto n_qubits() const noexcept -> std::size_t
+    {
+        return n_qubits_;
+    }
+
+    [[nodiscard]]
+    constexpr auto n_bits() const noexcept -> std::size_t
+    {
+        return n_bits_;
+    }
+
+    [[nodiscard]]
+    constexpr auto n_nodes() const noexcept -> std::size_t
+    {
+        return nodes_.size();
+    }
+
+    [[nodiscard]]
+    auto node(std::size_t index) const -> const CircuitElement&;
+
+    /*
+        The nodes that must be applied immediately before the node at `index`, in increasing order.
+    */
+    [[nodiscard]]
+    auto predecessors(std::size_t index) const -> const std::vector<std::size_t>&;
+
+    /*
+        The nodes that must be applied after the node at `index`, with no node in between, in increasing order.
+    */
+    [[nodiscard]]
+    auto successors(std::size_t index) const -> const std::vector<std::size_t>&;
+
+    /*
+        The earliest layer the node at `index` can be placed in; nodes without predecessors are in layer 0,
+        and every other node is in the layer after the latest of its predecessors.
+    */
+    [[nodiscard]]
+    auto layer_index(std::size_t index) const -> std::size_t;
+
+    /*
+        The nodes of each layer, in increasing order. The nodes in the same layer do not depend on each
+        other, so gates in the same layer act on disjoint qubits and can be applied in any order.
+    */
+    [[nodiscard]]
+    auto layers() const -> std::vector<std::vector<std::size_t>>;
+
+    /*
+        The number of layers; this is the length of the longest chain of dependent nodes.
+    */
+    [[nodiscard]]
+    auto depth() const noexcept -> std::size_t;
+
+    /*
+        The nodes along one of the longest chains of dependent nodes, in the order they are applied.
+    */
+    [[nodiscard]]
+    auto critical_path() const -> std::vector<std::size_t>;
+
+    /*
+        Create the `QuantumCircuit` with the nodes in their original order.
+    */
+    [[nodiscard]]
+    auto to_circuit() const -> QuantumCircuit;
+
+    /*
+        Create an equivalent `QuantumCircuit` with the nodes ordered layer by layer.
+    */
+    [[nodiscard]]
+    auto to_layered_circuit() const -> QuantumCircuit;
+
+private:
+    std::size_t n_qubits_;
+    std::size_t n_bits_;
+    std::vector<CircuitElement> nodes_;
+    std::vector<std::vector<std::size_t>> predecessors_;
+    std::vector<std::vector<std::size_t>> successors_;
+    std::vector<std::size_t> layer_indices_;
+    std::size_t depth_ {0};
+    ket::param::ParameterDataMap parameter_data_;
+    std::size_t parameter_count_ {0};
+
+    void check_index_(std::size_t index) const;
+
+    [[nodiscard]]
+    auto create_circuit_(const std::vector<std::size_t>& order) const -> QuantumCircuit;
+};
+
+}  // namespace ket
@@ -18,6 +18,12 @@ public:
         : measured_bits_ (n_bits, std::nullopt)
     {}
 
+    [[nodiscard]]
+    constexpr auto n_bits() const noexcept -> std::size_t
+    {
+        return measured_bits_.size();
+    }
+
     [[nodiscard]]
     constexpr auto is_measured(std::size_t qubit_index) const -> bool
     {
@@ -7,6 +7,14 @@ class QuantumCircuit;
     
 void extend_circuit(QuantumCircuit& left, const QuantumCircuit& right);
 
+/*
+    Moves the elements and parameters of `right` onto the end of `left`, instead of copying them;
+    `right` is left empty.
+*/
+void extend_circuit(QuantumCircuit& left, QuantumCircuit&& right);
+
 auto append_circuits(QuantumCircuit left, const QuantumCircuit& right) -> QuantumCircuit;
 
+auto append_circuits(QuantumCircuit left, QuantumCircuit&& right) -> QuantumCircuit;
+
 }  // namespace ket
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "kettle/circuit/circuit.hpp"
+
+/*
+    This header file contains functions that compute the backward lightcone (the causal cone) of
+    a subset of the qubits of a `QuantumCircuit`, and use it to remove the elements of the circuit
+    that cannot affect those qubits.
+*/
+
+namespace ket
+{
+
+/*
+    Returns the sorted indices of every qubit in the backward lightcone of `observed_qubits` and
+    `observed_bits`; these are the qubits whose initial state, or whose gates, can affect the reduced
+    state of the observed qubits or the values of the observed classical bits at the end of the circuit.
+*/
+auto lightcone_qubits(
+    const QuantumCircuit& circuit,
+    const std::vector<std::size_t>& observed_qubits,
+    const std::vector<std::size_t>& observed_bits = {}
+) -> std::vector<std::size_t>;
+
+/*
+    Create a copy of `circuit` without the elements outside of the backward lightcone of `observed_qubits`
+    and `observed_bits`.
+
+    The pruned circuit has the same number of qubits and bits as the original. For any initial state,
+    simulating the pruned circuit produces the same reduced state on the observed qubits, and the same
+    distribution of values for the observed classical bits, as simulating the original circuit.
+
+    Classical control flow statements are either kept whole or removed entirely. Circuit loggers are
+    always kept, and they log the state of the pruned circuit.
+*/
+auto prune_to_lightcone(
+    const QuantumCircuit& circuit,
+    const std::vector<std::size_t>& observed_qubits,
+    const std::vector<std::size_t>& observed_bits = {}
+) -> QuantumCircuit;
+
+/*
+    A circuit that only acts on the qubits in a lightcone, where the qubit at index `i` of `circuit`
+    corresponds to the qubit at index `kept_qubits[i]` of the original circuit.
+*/
+struct LightconeCircuit
+{
+    QuantumCircuit circuit;
+    std::vector<std::size_t> kept_qubits;
+};
+
+/*
+    Prune `circuit` to the backward lightcone of `observed_qubits` and `observed_bits`, and remove
+    all qubits outside of the lightcone from the register.
+
+    This is only a valid substitute for the original circuit if the initial state is a product state
+    between the qubits inside and outside of the lightcone (for example, a computational basis state).
+*/
+auto reduce_to_lightcone(
+    const QuantumCircuit& circuit,
+    const std::vector<std::size_t>& observed_qubits,
+    const std::vector<std::size_t>& observed_bits = {}
+) -> LightconeCircuit;
+
+}  // namespace ket
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+
+#include "kettle/common/tolerance.hpp"
+
+/*
+    This header file contains the `optimize_circuit()` function, which performs a peephole
+    optimization pass over a `QuantumCircuit`, removing gates that cancel each other out and
+    merging consecutive rotations about the same axis.
+*/
+
+namespace ket
+{
+
+class QuantumCircuit;
+
+/*
+    The number of earlier gates sharing a qubit with the current gate that the optimizer looks
+    through while searching for a gate to cancel or merge with.
+*/
+constexpr inline auto DEFAULT_OPTIMIZATION_WINDOW_SIZE = std::size_t {32};
+
+/*
+    The changes made by `optimize_circuit()`; the gates inside of control flow statements are included.
+
+    The number of removed gates, `n_gates_before - n_gates_after`, is the sum of `n_cancelled_gates`,
+    `n_merged_gates`, and `n_identity_gates`.
+*/
+struct CircuitOptimizationStatistics
+{
+    std::size_t n_gates_before {0};
+    std::size_t n_gates_after {0};
+
+    // gates removed because they formed a pair that multiplies to the identity (H.H, S.SDAG, CX.CX, etc.)
+    std::size_t n_cancelled_gates {0};
+
+    // rotation gates removed by adding their angle to an earlier rotation of the same kind
+    std::size_t n_merged_gates {0};
+
+    // rotation gates with a fixed angle that are equal to the identity (RZ(0), P(2pi), etc.)
+    std::size_t n_identity_gates {0};
+};
+
+/*
+    Create a copy of `circuit` with redundant gates removed.
+
+    For each gate, the optimizer looks backwards through up to `window_size` earlier gates that share
+    a qubit with it, for a gate that it can be combined with. The search passes over gates that commute
+    with the current gate (for example, a CX gate commutes with an RZ gate on its control qubit and with
+    an RX gate on its target qubit), and stops at the first gate that does not.
+
+      - pairs of gates that multiply to the identity are both removed (H.H, X.X, S.SDAG, CX.CX, CZ.CZ, etc.)
+      - two rotations of the same kind on the same qubits are merged into a single rotation
+      - rotations whose fixed angle makes them equal to the identity are removed
+
+    If either of the merged rotations is parameterized, the merged rotation is parameterized by the sum
+    of both angles, so the optimized circuit remains valid when the parameter values are changed later.
+    Parameterized rotations are never removed as identities.
+
+    Measurements block the search on the qubit they measure, and circuit loggers and classical control
+    flow statements block the search on all qubits. The subcircuits of control flow statements are
+    optimized independently.
+*/
+auto optimize_circuit(
+    const QuantumCircuit& circuit,
+    CircuitOptimizationStatistics& statistics,
+    std::size_t window_size = DEFAULT_OPTIMIZATION_WINDOW_SIZE,
+    double angle_tolerance = ket::MATCHING_PARAMETER_VALUE_TOLERANCE
+) -> QuantumCircuit;
+
+auto optimize_circuit(
+    const QuantumCircuit& circuit,
+    std::size_t window_size = DEFAULT_OPTIMIZATION_WINDOW_SIZE,
+    double angle_tolerance = ket::MATCHING_PARAMETER_VALUE_TOLERANCE
+) -> QuantumCircuit;
+
+}  // namespace ket
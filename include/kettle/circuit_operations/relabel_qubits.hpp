@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "kettle/circuit/circuit.hpp"
+
+/*
+    This header file contains the `relabel_qubits()` function, which creates a copy of a
+    `QuantumCircuit` where every qubit index has been mapped to a new qubit index, and functions
+    that choose such a mapping based on how often each qubit is used.
+*/
+
+namespace ket
+{
+
+/*
+    Create a new `QuantumCircuit` with `new_n_qubits` qubits, where every element that acts on the
+    qubit at index `i` of `circuit` instead acts on the qubit at index `new_qubit_indices[i]`.
+
+    The classical bits, parameters, control flow predicates, and circuit loggers are unchanged, and
+    the subcircuits of control flow statements are relabelled as well.
+
+    The size of `new_qubit_indices` must be equal to the number of qubits in `circuit`. The entries of
+    `new_qubit_indices` for qubits that no element of the circuit acts on are ignored; this allows
+    unused qubits to be removed from the circuit entirely.
+*/
+auto relabel_qubits(
+    const QuantumCircuit& circuit,
+    const std::vector<std::size_t>& new_qubit_indices,
+    std::size_t new_n_qubits
+) -> QuantumCircuit;
+
+/*
+    Returns the number of gates (including measurements) that act on each qubit of `circuit`; a
+    controlled gate counts towards both its control and its target qubit.
+
+    The gates in every branch of the control flow statements are included.
+*/
+auto qubit_gate_counts(const QuantumCircuit& circuit) -> std::vector<std::size_t>;
+
+/*
+    Returns the new qubit indices that move the most frequently used qubits of `circuit` to the lowest
+    qubit indices. Qubits used equally often keep their relative order.
+
+    The qubit at index `i` of the `Statevector` controls the bit `2^i` of the state index, so gates on
+    the low qubits update amplitudes that are close together in memory, while gates on the high qubits
+    update amplitudes spread across the entire state.
+*/
+auto hot_qubit_permutation(const QuantumCircuit& circuit) -> std::vector<std::size_t>;
+
+/*
+    A circuit whose qubits were relabelled, where the qubit at index `i` of the original circuit
+    corresponds to the qubit at index `new_qubit_indices[i]` of `circuit`.
+*/
+struct RelabelledCircuit
+{
+    QuantumCircuit circuit;
+    std::vector<std::size_t> new_qubit_indices;
+};
+
+/*
+    Relabel the qubits of `circuit` using `hot_qubit_permutation()`.
+
+    Use `permute_qubits()` with `new_qubit_indices` to bring an initial state into the new qubit order,
+    and with `inverse_qubit_permutation(new_qubit_indices)` to bring the final state back.
+*/
+auto relabel_hot_qubits(const QuantumCircuit& circuit) -> RelabelledCircuit;
+
+}  // namespace ket
@@ -0,0 +1,37 @@
+#pragma once
+
+/*
+    This header file contains the `reorder_commuting_gates()` function, which reorders the gates of
+    a `QuantumCircuit` so that gates acting on the same qubits are placed next to each other.
+*/
+
+namespace ket
+{
+
+class QuantumCircuit;
+
+/*
+    Create a copy of `circuit` where the gates are reordered, without changing the action of the circuit,
+    so that gates acting on the same qubits are next to each other.
+
+    The gates between two barriers are placed into a dependency graph, where a gate depends on every
+    earlier gate that it might not commute with. Two gates are treated as commuting if, on every qubit they
+    share, they both act diagonally, or both act along the X-axis, or both act along the Y-axis. For
+    example, an RZ gate commutes with a CZ gate, and with a CX gate when it acts on the control qubit.
+
+    The gates are then emitted in an order consistent with the dependency graph, preferring (in order):
+      - gates that only act on qubits that the previously emitted gate acted on
+      - diagonal gates, if the previously emitted gate was diagonal
+      - gates that share a qubit with the previously emitted gate
+      - the gate that came earliest in the original circuit
+
+    Grouping the gates this way gives `optimize_circuit()` more opportunities to cancel and merge gates,
+    and keeps consecutive gates within the same part of the statevector.
+
+    Measurements never move past a gate acting on the measured qubit, or past another measurement writing
+    to the same classical bit. Circuit loggers and classical control flow statements are barriers that no
+    gate moves across. The subcircuits of control flow statements are reordered independently.
+*/
+auto reorder_commuting_gates(const QuantumCircuit& circuit) -> QuantumCircuit;
+
+}  // namespace ket
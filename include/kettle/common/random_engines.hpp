@@ -0,0 +1,146 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/*
+    This header file contains pseudorandom number engines that can be used in place of `std::mt19937`.
+    Both satisfy the `std::uniform_random_bit_generator` concept, so they work with the distributions
+    in the `<random>` header.
+
+      - `Xoshiro256PlusPlus`: a 256-bit state, and 64 bits per call; much faster than `std::mt19937`,
+        and `jump()` gives streams that do not overlap for 2^128 calls each
+      - `Philox4x32`: a counter-based engine, where each block of 4 outputs is a keyed bijection of a
+        128-bit counter; separate streams are made by choosing a different stream index, and skipping
+        ahead with `discard()` takes constant time
+
+    SOURCES:
+      - xoshiro256++: https://prng.di.unimi.it/xoshiro256plusplus.c
+      - Philox-4x32-10: Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC11 (2011)
+*/
+
+namespace ket
+{
+
+class Xoshiro256PlusPlus
+{
+public:
+    using result_type = std::uint64_t;
+    using state_type = std::array<std::uint64_t, 4>;
+
+    /*
+        The four words of the state are filled with the outputs of a SplitMix64 generator seeded
+        with `seed`, as recommended by the authors.
+    */
+    explicit Xoshiro256PlusPlus(std::uint64_t seed = 0);
+
+    /*
+        Uses `state` as the initial state directly; it cannot be all zeros.
+    */
+    explicit Xoshiro256PlusPlus(const state_type& state);
+
+    static constexpr auto min() noexcept -> result_type
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr auto max() noexcept -> result_type
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    auto operator()() noexcept -> result_type
+    {
+        auto& [s0, s1, s2, s3] = state_;
+
+        const auto result = rotl_(s0 + s3, 23) + s0;
+        const auto temp = s1 << 17U;
+
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= temp;
+        s3 = rotl_(s3, 45);
+
+        return result;
+    }
+
+    void discard(std::uint64_t n_outputs) noexcept;
+
+    /*
+        Advances the state as if 2^128 outputs had been drawn.
+    */
+    void jump() noexcept;
+
+    [[nodiscard]]
+    constexpr auto state() const noexcept -> const state_type&
+    {
+        return state_;
+    }
+
+    friend auto operator==(const Xoshiro256PlusPlus& left, const Xoshiro256PlusPlus& right) noexcept -> bool = default;
+
+private:
+    state_type state_;
+
+    static constexpr auto rotl_(std::uint64_t value, unsigned int shift) noexcept -> std::uint64_t
+    {
+        return (value << shift) | (value >> (64U - shift));
+    }
+};
+
+class Philox4x32
+{
+public:
+    using result_type = std::uint32_t;
+    using counter_type = std::array<std::uint32_t, 4>;
+    using key_type = std::array<std::uint32_t, 2>;
+
+    /*
+        The key is made from `seed`, and the upper 64 bits of the counter hold `stream`; engines with
+        the same seed and different streams produce unrelated outputs.
+    */
+    explicit Philox4x32(std::uint64_t seed = 0, std::uint64_t stream = 0) noexcept;
+
+    static constexpr auto min() noexcept -> result_type
+    {
+        return std::numeric_limits<result_type>::min();
+    }
+
+    static constexpr auto max() noexcept -> result_type
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    auto operator()() noexcept -> result_type
+    {
+        if (i_output_ == outputs_.size()) {
+            refill_();
+        }
+
+        return outputs_[i_output_++];
+    }
+
+    void discard(std::uint64_t n_outputs) noexcept;
+
+    /*
+        The Philox-4x32-10 bijection; maps `counter` to a block of 4 random outputs under `key`.
+    */
+    static auto block(const counter_type& counter, const key_type& key) noexcept -> counter_type;
+
+    friend auto operator==(const Philox4x32& left, const Philox4x32& right) noexcept -> bool = default;
+
+private:
+    key_type key_;
+    std::uint64_t stream_;
+    std::uint64_t i_block_ {0};
+    counter_type outputs_ {};
+    std::size_t i_output_ {4};
+
+    void refill_() noexcept;
+};
+
+}  // namespace ket
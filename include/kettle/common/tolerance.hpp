@@ -10,5 +10,7 @@ constexpr inline auto MATRIX_2X2_SQRT_TOLERANCE = double {1.0e-6};
 constexpr inline auto MATCHING_PARAMETER_VALUE_TOLERANCE = double {1.0e-6};
 constexpr inline auto DENSITY_MATRIX_TRACE_TOLERANCE = double {1.0e-8};
 constexpr inline auto MATRIX_HERMITIAN_TOLERANCE = double {1.0e-8};
+constexpr inline auto SPARSE_STATEVECTOR_PRUNING_TOLERANCE_SQ = double {1.0e-24};
+constexpr inline auto CONFUSION_MATRIX_COLUMN_SUM_TOLERANCE = double {1.0e-8};
 
 }  // namespace ket
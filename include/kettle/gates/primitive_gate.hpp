@@ -5,9 +5,15 @@
 #include <cstdint>
 
 #include "kettle/common/matrix2x2.hpp"
-#include "kettle/common/clone_ptr.hpp"
 #include "kettle/parameter/parameter_expression.hpp"
 
+namespace ket::internal
+{
+
+class GatePayload;
+
+}  // namespace ket::internal
+
 namespace ket
 {
 
@@ -53,29 +59,69 @@ enum class Gate : std::uint8_t
 
 /*
     The `GateInfo` type holds all the information needed to describe any of the primitive gates in
-    the project's specification. This implementation forces the gate to carry the information needed
-    for every possible type of gate, even if some parameters are not used. For example, the `GateInfo`
-    instance for an X-gate only needs the target index (one `std::size_t`), but it still holds all the
-    other parameters.
+    the project's specification, in a compact 24-byte record.
 
-    Each of the primitive gates can have up to two index arguments:
+    Each of the primitive gates can have up to two index arguments, stored in `arg0` and `arg1`:
       - a target qubit index
       - possibly a control qubit index
       - in the case of measurement gates, a qubit index and a classical bit index
 
-    Some of the primitive gates can have one real parameter, an angle.
-
-    The U and CU primitive gates can hold a pointer to a unitary 2x2 matrix.
+    Some of the primitive gates can have one real parameter, an angle. Instead of an angle, a
+    parameterized gate holds a parameter expression, and the U and CU primitive gates hold a unitary
+    2x2 matrix. The expression or matrix is stored in an immutable payload that is shared between
+    copies of the `GateInfo` instance, so copying a gate never copies the payload itself.
 
+    The `GateInfo` instances should be created and unpacked through the functions in
+    `kettle_internal/gates/primitive_gate/gate_create.hpp`.
 */
 struct GateInfo
 {
+public:
+    GateInfo(Gate gate_, std::uint32_t arg0_, std::uint32_t arg1_, double arg2_) noexcept;
+    GateInfo(Gate gate_, std::uint32_t arg0_, std::uint32_t arg1_, Matrix2X2 unitary);
+    GateInfo(Gate gate_, std::uint32_t arg0_, std::uint32_t arg1_, ket::param::ParameterExpression param_expression);
+
+    ~GateInfo();
+    GateInfo(const GateInfo& other) noexcept;
+    GateInfo(GateInfo&& other) noexcept;
+    auto operator=(const GateInfo& other) noexcept -> GateInfo&;
+    auto operator=(GateInfo&& other) noexcept -> GateInfo&;
+
+    /*
+        Returns the angle of the gate; this is `0.0` for gates that hold a payload.
+    */
+    [[nodiscard]]
+    constexpr auto arg2() const noexcept -> double
+    {
+        return has_payload_ ? 0.0 : angle_;
+    }
+
+    /*
+        Returns a pointer to the unitary matrix of a U-gate or CU-gate, or `nullptr` for all other gates.
+    */
+    [[nodiscard]]
+    auto unitary_ptr() const noexcept -> const Matrix2X2*;
+
+    /*
+        Returns a pointer to the parameter expression of a parameterized gate, or `nullptr` otherwise.
+    */
+    [[nodiscard]]
+    auto param_expression_ptr() const noexcept -> const ket::param::ParameterExpression*;
+
     Gate gate;
-    std::size_t arg0;
-    std::size_t arg1;
-    double arg2;
-    ket::ClonePtr<Matrix2X2> unitary_ptr;
-    ket::ClonePtr<ket::param::ParameterExpression> param_expression_ptr;
+    std::uint32_t arg0;
+    std::uint32_t arg1;
+
+private:
+    bool has_payload_ {false};
+
+    union
+    {
+        double angle_;
+        const ket::internal::GatePayload* payload_;
+    };
+
+    void release_() noexcept;
 };
 
 }  // namespace ket
@@ -4,6 +4,7 @@
 #include <random>
 
 #include "kettle/common/matrix2x2.hpp"
+#include "kettle/common/random_engines.hpp"
 
 
 namespace ket
@@ -17,6 +18,10 @@ namespace ket
 */
 auto generate_random_unitary2x2(std::mt19937& prng) -> ket::Matrix2X2;
 
+auto generate_random_unitary2x2(Xoshiro256PlusPlus& prng) -> ket::Matrix2X2;
+
+auto generate_random_unitary2x2(Philox4x32& prng) -> ket::Matrix2X2;
+
 /*
     Generate a random 2x2 unitary matrix, generating a fresh PRNG using the provided seed.
 
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <span>
+
+#include "kettle/circuit/circuit.hpp"
+
+/*
+    This header file contains functions to save and load a `QuantumCircuit` in a compact binary
+    format, which is much faster to read than the text-based tangelo format.
+
+    All integers and floating-point numbers are stored in little-endian order. The file starts with
+    the 8-byte magic string "KETCIRC" (padded with a null byte) and a 32-bit format version, followed
+    by the circuit itself:
+      - the number of qubits, the number of bits, and the parameter counter of the circuit
+      - the parameters of the circuit, each with their ID, name, value, and number of uses
+      - the elements of the circuit; gates hold their indices and their angle, unitary matrix, or
+        parameter expression, control flow statements hold their predicate and subcircuits (stored
+        in the same way as the circuit), and circuit loggers hold only their kind
+*/
+
+namespace ket
+{
+
+constexpr inline auto BINARY_CIRCUIT_FORMAT_VERSION = std::uint32_t {1};
+
+void save_binary_circuit(std::ostream& outstream, const QuantumCircuit& circuit);
+
+void save_binary_circuit(const std::filesystem::path& filepath, const QuantumCircuit& circuit);
+
+/*
+    Reconstructs the `QuantumCircuit` held in the binary circuit format in `bytes`.
+*/
+auto read_binary_circuit(std::span<const std::byte> bytes) -> QuantumCircuit;
+
+auto load_binary_circuit(std::istream& instream) -> QuantumCircuit;
+
+/*
+    Loads the `QuantumCircuit` saved in the binary circuit format in `filepath`; where possible, the
+    file is memory-mapped and decoded in place, without any intermediate copies.
+*/
+auto load_binary_circuit(const std::filesystem::path& filepath) -> QuantumCircuit;
+
+/*
+    Reads the circuit of `n_qubits` qubits in the tangelo format at `tangelo_filepath`, skipping the
+    first `n_skip_lines` lines, and saves it in the binary circuit format at `binary_filepath`.
+*/
+void convert_tangelo_to_binary_circuit(
+    std::size_t n_qubits,
+    const std::filesystem::path& tangelo_filepath,
+    std::size_t n_skip_lines,
+    const std::filesystem::path& binary_filepath
+);
+
+}  // namespace ket
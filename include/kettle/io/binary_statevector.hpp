@@ -0,0 +1,103 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <span>
+#include <vector>
+
+#include "kettle/state/endian.hpp"
+#include "kettle/state/statevector.hpp"
+
+/*
+    This header file contains functions to save and load a `Statevector` in a binary checkpoint
+    format, which is much smaller and faster to read and write than the text-based format.
+
+    All integers and floating-point numbers are stored in little-endian order. The file starts with
+    a 40-byte header:
+      - the 8-byte magic string "KETSTAT" (padded with a null byte)
+      - a 32-bit format version
+      - a 32-bit flag for the order of the amplitudes (0 for little endian, 1 for big endian)
+      - the 64-bit number of qubits
+      - the 64-bit number of amplitudes
+      - a 64-bit checksum of the amplitudes
+    followed by the amplitudes themselves, each stored as the real and imaginary parts as 64-bit doubles.
+*/
+
+namespace ket
+{
+
+constexpr inline auto BINARY_STATEVECTOR_FORMAT_VERSION = std::uint32_t {1};
+
+constexpr inline auto BINARY_STATEVECTOR_HEADER_SIZE = std::size_t {40};
+
+/*
+    Controls whether saving a binary statevector to a file waits until the data is physically
+    written to the storage device, so that the checkpoint survives a crash of the whole machine.
+*/
+enum class FileSyncPolicy : std::uint8_t
+{
+    NO_SYNC,
+    SYNC_ON_CLOSE
+};
+
+struct BinaryStatevectorHeader
+{
+    std::uint32_t version;
+    Endian endian;
+    std::size_t n_qubits;
+    std::size_t n_states;
+    std::uint64_t checksum;
+};
+
+void save_binary_statevector(
+    std::ostream& outstream,
+    const Statevector& state,
+    Endian endian = Endian::LITTLE
+);
+
+/*
+    Saves `state` in the binary statevector format at `filepath`.
+
+    Where possible, the amplitudes are encoded and written by `n_threads` threads, each writing a
+    separate contiguous section of the file.
+*/
+void save_binary_statevector(
+    const std::filesystem::path& filepath,
+    const Statevector& state,
+    Endian endian = Endian::LITTLE,
+    FileSyncPolicy sync_policy = FileSyncPolicy::NO_SYNC,
+    std::size_t n_threads = 1
+);
+
+/*
+    Reconstructs the `Statevector` held in the binary statevector format in `bytes`, after checking
+    that the checksum matches the amplitudes.
+*/
+auto read_binary_statevector(std::span<const std::byte> bytes) -> Statevector;
+
+auto load_binary_statevector(std::istream& instream) -> Statevector;
+
+/*
+    Loads the `Statevector` saved in the binary statevector format in `filepath`; where possible, the
+    file is memory-mapped and decoded in place, without any intermediate copies.
+*/
+auto load_binary_statevector(const std::filesystem::path& filepath) -> Statevector;
+
+auto load_binary_statevector_header(const std::filesystem::path& filepath) -> BinaryStatevectorHeader;
+
+/*
+    Loads the amplitudes at the indices `[i_begin, i_end)` of the binary statevector saved in `filepath`,
+    in the order they are stored in the file (given by the endianness in the header).
+
+    Only the pages of the file that hold the requested amplitudes are read, so the checksum is not verified.
+*/
+auto load_binary_statevector_slice(
+    const std::filesystem::path& filepath,
+    std::size_t i_begin,
+    std::size_t i_end
+) -> std::vector<std::complex<double>>;
+
+}  // namespace ket
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <span>
+#include <vector>
+
+#include "kettle/state/endian.hpp"
+#include "kettle/state/statevector.hpp"
+
+/*
+    This header file contains functions to read and write one-dimensional arrays in the NumPy `.npy`
+    binary format, so that statevectors, probabilities, and counts can be passed to and from Python
+    with `numpy.load()` and `numpy.save()` without a round trip through text.
+
+    Files of versions 1.0, 2.0 and 3.0 of the format can be read; the elements can be stored in
+    either byte order, as complex128 ('c16'), complex64 ('c8'), float64 ('f8'), or float32 ('f4').
+    Files are always written in version 1.0 (or 2.0 if the header is too long) in little-endian order.
+*/
+
+namespace ket
+{
+
+/*
+    Reconstructs the `Statevector` held in the `.npy` file contents in `bytes`; the array must be
+    one-dimensional, and its length must be a power of 2. Real-valued arrays are read as amplitudes
+    with an imaginary part of zero.
+*/
+auto read_npy_statevector(
+    std::span<const std::byte> bytes,
+    Endian input_endian = Endian::LITTLE
+) -> Statevector;
+
+auto load_npy_statevector(
+    std::istream& instream,
+    Endian input_endian = Endian::LITTLE
+) -> Statevector;
+
+/*
+    Loads the `Statevector` saved in the `.npy` file at `filepath`; where possible, the file is
+    memory-mapped and the amplitudes are decoded directly into the `Statevector`.
+*/
+auto load_npy_statevector(
+    const std::filesystem::path& filepath,
+    Endian input_endian = Endian::LITTLE
+) -> Statevector;
+
+/*
+    Reads the real-valued, one-dimensional array (of 'f8' or 'f4' elements) held in the `.npy`
+    file contents in `bytes`, such as an array of probabilities.
+*/
+auto read_npy_real_array(std::span<const std::byte> bytes) -> std::vector<double>;
+
+auto load_npy_real_array(const std::filesystem::path& filepath) -> std::vector<double>;
+
+/*
+    Saves the amplitudes of `state` as a complex128 array.
+*/
+void save_npy_statevector(
+    std::ostream& outstream,
+    const Statevector& state,
+    Endian output_endian = Endian::LITTLE
+);
+
+void save_npy_statevector(
+    const std::filesystem::path& filepath,
+    const Statevector& state,
+    Endian output_endian = Endian::LITTLE
+);
+
+/*
+    Saves `probabilities` (for example, from `calculate_probabilities_raw()`) as a float64 array.
+*/
+void save_npy_probabilities(std::ostream& outstream, const std::vector<double>& probabilities);
+
+void save_npy_probabilities(const std::filesystem::path& filepath, const std::vector<double>& probabilities);
+
+/*
+    Saves the histogram in `counts` (for example, from `perform_measurements_as_counts_raw()`) as a
+    dense uint64 array of length `n_states`, where element `i` holds the counts of state `i`.
+*/
+void save_npy_counts(
+    std::ostream& outstream,
+    const std::map<std::size_t, std::size_t>& counts,
+    std::size_t n_states
+);
+
+void save_npy_counts(
+    const std::filesystem::path& filepath,
+    const std::map<std::size_t, std::size_t>& counts,
+    std::size_t n_states
+);
+
+}  // namespace ket
@@ -9,6 +9,10 @@
 namespace ket
 {
 
+/*
+    Reads a `Statevector` written as the number of qubits, followed by one amplitude per line in the
+    numpy format `(real+imagj)`; only the lines of the statevector are consumed from the stream.
+*/
 auto read_numpy_statevector(
     std::istream& instream,
     Endian input_endian = Endian::LITTLE
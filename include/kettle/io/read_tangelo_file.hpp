@@ -48,4 +48,41 @@ auto read_tangelo_circuit(
     std::size_t n_skip_lines
 ) -> QuantumCircuit;
 
+/*
+    Reads a quantum circuit in the tangelo format from a stream one block at a time, so that the
+    full circuit never needs to be held in memory at once.
+
+    The blocks, applied one after the other, describe the same circuit that `read_tangelo_circuit()`
+    would return for the same stream.
+*/
+class TangeloCircuitReader
+{
+public:
+    /*
+        The reader holds a reference to `stream`, which must outlive it.
+    */
+    TangeloCircuitReader(std::size_t n_qubits, std::istream& stream, std::size_t n_skip_lines);
+
+    /*
+        Reads lines until the next block holds at least `n_elements` circuit elements, or until the
+        end of the stream is reached. A block never ends on an if statement, because the line after
+        it may be the 'ELSE' that it is combined with.
+    */
+    auto read_block(std::size_t n_elements) -> QuantumCircuit;
+
+    /*
+        Returns `true` once the end of the stream has been reached.
+    */
+    [[nodiscard]]
+    constexpr auto is_done() const noexcept -> bool
+    {
+        return is_done_;
+    }
+
+private:
+    std::size_t n_qubits_;
+    std::istream* stream_;
+    bool is_done_ {false};
+};
+
 }  // namespace ket
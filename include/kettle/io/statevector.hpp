@@ -21,6 +21,12 @@ void save_statevector(
     Endian endian = Endian::LITTLE
 );
 
+/*
+    Loads a `Statevector` saved by `save_statevector()`; a statevector saved in the binary format
+    by `save_binary_statevector()` is recognized by its header and loaded as well.
+
+    The stream overload only consumes the statevector itself, so the stream can hold more data after it.
+*/
 auto load_statevector(std::istream& instream) -> Statevector;
 
 auto load_statevector(const std::filesystem::path& filepath) -> Statevector;
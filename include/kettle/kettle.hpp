@@ -2,9 +2,11 @@
 
 #include <kettle/calculations/measurements.hpp>
 #include <kettle/calculations/probabilities.hpp>
+#include <kettle/calculations/readout_noise.hpp>
 
 #include <kettle/circuit/circuit_element.hpp>
 #include <kettle/circuit/circuit.hpp>
+#include <kettle/circuit/circuit_dag.hpp>
 #include <kettle/circuit/classical_register.hpp>
 #include <kettle/circuit/control_flow_predicate.hpp>
 #include <kettle/circuit/control_flow.hpp>
@@ -13,13 +15,18 @@
 
 #include <kettle/circuit_operations/append_circuits.hpp>
 #include <kettle/circuit_operations/compare_circuits.hpp>
+#include <kettle/circuit_operations/lightcone.hpp>
 #include <kettle/circuit_operations/make_binary_controlled_circuit.hpp>
 #include <kettle/circuit_operations/make_controlled_circuit.hpp>
+#include <kettle/circuit_operations/optimize_circuit.hpp>
+#include <kettle/circuit_operations/relabel_qubits.hpp>
+#include <kettle/circuit_operations/reorder_gates.hpp>
 #include <kettle/circuit_operations/transpile_to_primitive.hpp>
 
 #include <kettle/common/arange.hpp>
 #include <kettle/common/mathtools.hpp>
 #include <kettle/common/matrix2x2.hpp>
+#include <kettle/common/random_engines.hpp>
 
 #include <kettle/gates/common_u_gates.hpp>
 #include <kettle/gates/compound_gate.hpp>
@@ -27,6 +34,9 @@
 #include <kettle/gates/primitive_gate.hpp>
 #include <kettle/gates/random_u_gates.hpp>
 
+#include <kettle/io/binary_circuit.hpp>
+#include <kettle/io/binary_statevector.hpp>
+#include <kettle/io/npy.hpp>
 #include <kettle/io/read_pauli_operator.hpp>
 #include <kettle/io/read_tangelo_file.hpp>
 #include <kettle/io/numpy_statevector.hpp>
@@ -38,14 +48,20 @@
 
 #include <kettle/optimize/n_local.hpp>
 
+#include <kettle/simulation/simulate_auto.hpp>
 #include <kettle/simulation/simulate_density_matrix.hpp>
 #include <kettle/simulation/simulate_pauli.hpp>
+#include <kettle/simulation/simulate_relabelled.hpp>
 #include <kettle/simulation/simulate.hpp>
+#include <kettle/simulation/simulate_sparse.hpp>
+#include <kettle/simulation/simulate_tangelo_stream.hpp>
 
 #include <kettle/state/density_matrix.hpp>
 #include <kettle/state/endian.hpp>
 #include <kettle/state/marginal.hpp>
+#include <kettle/state/permute_qubits.hpp>
 #include <kettle/state/project_state.hpp>
 #include <kettle/state/qubit_state_conversion.hpp>
 #include <kettle/state/random.hpp>
+#include <kettle/state/sparse_statevector.hpp>
 #include <kettle/state/statevector.hpp>
@@ -79,6 +79,10 @@ auto almost_eq(
     double coeff_tolerance = COMPLEX_ALMOST_EQ_TOLERANCE_SQ
 ) -> bool;
 
+/*
+    Calculates <state|P|state> for each Pauli string P directly from the amplitudes of `state`, in a single
+    read-only pass per Pauli string; the state is never copied, and the Pauli gates are never applied.
+*/
 auto expectation_value(const PauliOperator& pauli_op, const Statevector& state) -> std::complex<double>;
 
 auto expectation_value(const SparsePauliString& sparse_pauli_string, const Statevector& state) -> std::complex<double>;
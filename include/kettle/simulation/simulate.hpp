@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <vector>
 
@@ -18,6 +19,13 @@ class StatevectorSimulator
 public:
     void run(const QuantumCircuit& circuit, Statevector& state, std::optional<int> prng_seed = std::nullopt);
 
+    /*
+        Same as `run()`, except that the classical register and the circuit loggers from the previous
+        run are kept and added to, instead of being replaced. This allows a long circuit to be
+        simulated in consecutive pieces.
+    */
+    void resume(const QuantumCircuit& circuit, Statevector& state, std::optional<int> prng_seed = std::nullopt);
+
     [[nodiscard]]
     auto has_been_run() const -> bool;
 
@@ -40,6 +48,35 @@ private:
 
 void simulate(const QuantumCircuit& circuit, Statevector& state, std::optional<int> prng_seed = std::nullopt);
 
+/*
+    One of the distinct outcomes of running a circuit with mid-circuit measurements many times; the
+    `n_shots` shots that followed this branch all end in `state`, with the bits in `cregister`.
+*/
+struct SimulationBranch
+{
+    Statevector state;
+    ClassicalRegister cregister;
+    std::size_t n_shots;
+};
+
+/*
+    Simulates `n_shots` independent runs of `circuit` on copies of `state`, without simulating each
+    run separately.
+
+    The runs share a single simulation until a measurement gate is reached; the shots are then split
+    between the two outcomes by drawing from a binomial distribution, and each outcome that receives
+    shots continues with its own collapsed copy of the state. The cost grows with the number of distinct
+    branches rather than the number of shots; for a circuit without measurements, it is a single simulation.
+
+    The circuit loggers in `circuit` are ignored.
+*/
+auto simulate_branches(
+    const QuantumCircuit& circuit,
+    const Statevector& state,
+    std::size_t n_shots,
+    std::optional<int> prng_seed = std::nullopt
+) -> std::vector<SimulationBranch>;
+
 }  // namespace ket
 
 
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <variant>
+
+#include "kettle/circuit/classical_register.hpp"
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/state/density_matrix.hpp"
+#include "kettle/state/endian.hpp"
+#include "kettle/state/sparse_statevector.hpp"
+#include "kettle/state/statevector.hpp"
+
+/*
+    This header file contains a dispatcher that inspects a circuit before simulating it, and
+    chooses which of the available simulators to run it on.
+*/
+
+namespace ket
+{
+
+enum class SimulationBackend
+{
+    STATEVECTOR,
+    SPARSE_STATEVECTOR,
+    DENSITY_MATRIX
+};
+
+auto simulation_backend_name(SimulationBackend backend) -> std::string;
+
+/*
+    The default amount of memory the dispatcher allows a state to occupy, in bytes (4 GiB).
+*/
+constexpr inline auto DEFAULT_SIMULATION_MEMORY_BUDGET = std::size_t {4ULL * 1024ULL * 1024ULL * 1024ULL};
+
+/*
+    An estimate of the number of bytes needed to store a single amplitude in a `SparseStatevector`,
+    including the overhead of the node and bucket of the hash map.
+*/
+constexpr inline auto SPARSE_STATEVECTOR_BYTES_PER_AMPLITUDE = std::size_t {48};
+
+/*
+    The properties of a circuit that the dispatcher bases its decision on.
+
+    The gates inside of all branches of the classical control flow statements are included, so the
+    counts are upper bounds on what is executed during any single simulation.
+*/
+struct CircuitAnalysis
+{
+    std::size_t n_qubits;
+    std::size_t n_gates;
+    std::size_t n_measurements;
+
+    // gates that can map a single basis state onto a superposition of two basis states, and thus
+    // can at most double the number of nonzero amplitudes of the state
+    std::size_t n_branching_gates;
+
+    bool is_clifford;
+    bool has_control_flow;
+    bool has_circuit_loggers;
+
+    // an upper bound on the number of nonzero amplitudes at any point during the simulation
+    std::size_t max_support_size;
+};
+
+/*
+    Analyze `circuit`, assuming the initial state has `initial_support_size` nonzero amplitudes.
+*/
+auto analyze_circuit(const QuantumCircuit& circuit, std::size_t initial_support_size = 1) -> CircuitAnalysis;
+
+/*
+    Options that control how the dispatcher chooses a simulator.
+*/
+struct BackendSelectionOptions
+{
+    // skip the heuristics and use this simulator
+    std::optional<SimulationBackend> forced_backend {std::nullopt};
+
+    // the largest amount of memory the state is allowed to use, in bytes
+    std::size_t memory_budget {DEFAULT_SIMULATION_MEMORY_BUDGET};
+
+    // the sparse simulator is preferred if its estimated memory use is at most this fraction of
+    // the memory use of the dense statevector
+    double sparse_memory_fraction {0.25};
+};
+
+/*
+    The simulator chosen by the dispatcher, alongside the analysis it was based on and a
+    human-readable explanation of the choice.
+*/
+struct BackendDecision
+{
+    SimulationBackend backend;
+    CircuitAnalysis analysis;
+    std::size_t estimated_memory;
+    std::string reason;
+};
+
+/*
+    Choose a simulator for a circuit with the given analysis.
+
+    Throws a `std::runtime_error` if no available simulator can run the circuit within the memory budget,
+    or if the forced simulator cannot run the circuit.
+*/
+auto select_backend(const CircuitAnalysis& analysis, const BackendSelectionOptions& options = {}) -> BackendDecision;
+
+/*
+    The final state, the classical register, and the decision made by `simulate_auto()`.
+
+    The alternative held by `state` matches `decision.backend`.
+*/
+struct AutoSimulationResult
+{
+    BackendDecision decision;
+    std::variant<Statevector, SparseStatevector, DensityMatrix> state;
+    ClassicalRegister classical_register;
+};
+
+/*
+    Analyze `circuit`, choose a simulator, and simulate the circuit starting from the computational
+    basis state given by `initial_bitstring`.
+*/
+auto simulate_auto(
+    const QuantumCircuit& circuit,
+    const std::string& initial_bitstring,
+    const BackendSelectionOptions& options = {},
+    Endian input_endian = Endian::LITTLE,
+    std::optional<int> prng_seed = std::nullopt
+) -> AutoSimulationResult;
+
+/*
+    Analyze `circuit`, choose a simulator, and simulate the circuit starting from `initial_state`.
+*/
+auto simulate_auto(
+    const QuantumCircuit& circuit,
+    const Statevector& initial_state,
+    const BackendSelectionOptions& options = {},
+    std::optional<int> prng_seed = std::nullopt
+) -> AutoSimulationResult;
+
+}  // namespace ket
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <optional>
+
+#include "kettle/circuit/classical_register.hpp"
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/state/statevector.hpp"
+
+/*
+    This header file contains a simulation function that relabels the qubits of a circuit so that the
+    most frequently used qubits have the most cache-friendly memory access pattern.
+*/
+
+namespace ket
+{
+
+/*
+    Simulate `circuit` on `state`, after moving the most frequently used qubits to the lowest indices
+    with `relabel_hot_qubits()`.
+
+    The state is permuted into the new qubit order before the simulation and back into the original
+    order afterwards, so the final `state` and the returned classical register are the same as those
+    produced by `ket::simulate()`. Each permutation costs one pass over the state, so this is only
+    worthwhile for circuits with many gates on high-index qubits.
+
+    Any statevector circuit loggers in `circuit` log the state in the relabelled qubit order.
+*/
+auto simulate_with_hot_qubits_first(
+    const QuantumCircuit& circuit,
+    Statevector& state,
+    std::optional<int> prng_seed = std::nullopt
+) -> ClassicalRegister;
+
+}  // namespace ket
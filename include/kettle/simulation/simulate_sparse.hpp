@@ -0,0 +1,50 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "kettle/circuit/classical_register.hpp"
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit_loggers/circuit_logger.hpp"
+#include "kettle/common/clone_ptr.hpp"
+#include "kettle/state/sparse_statevector.hpp"
+
+
+namespace ket
+{
+
+/*
+    Simulates a circuit on a `SparseStatevector`; supports the same primitive gates, measurements,
+    classical control flow and circuit loggers as the `StatevectorSimulator`.
+
+    Any `StatevectorCircuitLogger` in the circuit receives a dense copy of the state, so these should
+    be avoided for circuits with a large number of qubits.
+*/
+class SparseStatevectorSimulator
+{
+public:
+    void run(const QuantumCircuit& circuit, SparseStatevector& state, std::optional<int> prng_seed = std::nullopt);
+
+    [[nodiscard]]
+    auto has_been_run() const -> bool;
+
+    [[nodiscard]]
+    auto classical_register() const -> const ClassicalRegister&;
+
+    auto classical_register() -> ClassicalRegister&;
+
+    [[nodiscard]]
+    auto circuit_loggers() const -> const std::vector<CircuitLogger>&;
+
+private:
+    // there is no default constructor for the ClassicalRegsiter (it wouldn't make sense), and we
+    // only find out how many bits are needed after the first simulation; hence why we use a pointer
+    ket::ClonePtr<ClassicalRegister> cregister_ {nullptr};
+    bool has_been_run_ {false};
+    std::vector<CircuitLogger> circuit_loggers_;
+};
+
+
+void simulate(const QuantumCircuit& circuit, SparseStatevector& state, std::optional<int> prng_seed = std::nullopt);
+
+}  // namespace ket
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/state/statevector.hpp"
+
+/*
+    This header file contains functions that simulate a circuit in the tangelo format while it is
+    being read, without ever holding the full circuit in memory.
+*/
+
+namespace ket
+{
+
+constexpr inline auto DEFAULT_TANGELO_STREAM_BLOCK_SIZE = std::size_t {4096};
+
+/*
+    Simulate the circuit in the tangelo format held in `stream` on `state`, skipping the first
+    `n_skip_lines` lines; the circuit acts on all the qubits of `state`.
+
+    The circuit is read in blocks of about `block_size` elements by a `TangeloCircuitReader`. A
+    background thread parses the next block while the current block is simulated, and at most two
+    parsed blocks are held in memory at any time.
+
+    The classical register and circuit loggers of the simulation are stored in `simulator`, as if
+    the full circuit had been passed to `simulator.run()`.
+*/
+void simulate_tangelo_stream(
+    StatevectorSimulator& simulator,
+    std::istream& stream,
+    std::size_t n_skip_lines,
+    Statevector& state,
+    std::optional<int> prng_seed = std::nullopt,
+    std::size_t block_size = DEFAULT_TANGELO_STREAM_BLOCK_SIZE
+);
+
+void simulate_tangelo_stream(
+    StatevectorSimulator& simulator,
+    const std::filesystem::path& filepath,
+    std::size_t n_skip_lines,
+    Statevector& state,
+    std::optional<int> prng_seed = std::nullopt,
+    std::size_t block_size = DEFAULT_TANGELO_STREAM_BLOCK_SIZE
+);
+
+}  // namespace ket
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "kettle/state/statevector.hpp"
+
+/*
+    This header file contains functions for reordering the qubits of a `Statevector`.
+*/
+
+namespace ket
+{
+
+/*
+    Create a new `Statevector` where the qubit at index `i` of `state` is moved to the index
+    `new_qubit_indices[i]`.
+
+    The entries of `new_qubit_indices` must be a permutation of `0, 1, ..., n_qubits - 1`.
+*/
+auto permute_qubits(
+    const Statevector& state,
+    const std::vector<std::size_t>& new_qubit_indices
+) -> Statevector;
+
+/*
+    Returns the permutation that undoes `new_qubit_indices`; if the qubit at index `i` is moved to
+    index `new_qubit_indices[i]`, then the inverse permutation moves it back to index `i`.
+*/
+auto inverse_qubit_permutation(const std::vector<std::size_t>& new_qubit_indices) -> std::vector<std::size_t>;
+
+}  // namespace ket
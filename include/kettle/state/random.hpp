@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <random>
 
+#include "kettle/common/random_engines.hpp"
 #include "kettle/state/statevector.hpp"
 
 
@@ -14,6 +15,10 @@ namespace ket
 */
 auto generate_random_state(std::size_t n_qubits, std::mt19937& prng) -> Statevector;
 
+auto generate_random_state(std::size_t n_qubits, Xoshiro256PlusPlus& prng) -> Statevector;
+
+auto generate_random_state(std::size_t n_qubits, Philox4x32& prng) -> Statevector;
+
 /*
     Generate a random `Statevector` instance, generating a fresh PRNG using the provided seed.
 */
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+#include "kettle/common/tolerance.hpp"
+#include "kettle/state/endian.hpp"
+#include "kettle/state/statevector.hpp"
+
+namespace ket
+{
+
+/*
+    A quantum state that only stores the computational basis states with a nonzero amplitude.
+
+    Circuits made mostly of reversible classical logic (X, CX, Toffoli-like decompositions, modular
+    arithmetic oracles, etc.) that start from a basis state only ever populate a handful of the
+    2^n basis states. Storing the amplitudes in a hash map keyed by the state index means that the
+    memory use and the cost of applying a gate scale with the size of the support instead of 2^n.
+
+    Any amplitude whose squared norm falls below `pruning_tolerance_sq()` after an operation is
+    removed from the support.
+
+    Like the `Statevector`, the indices are stored in little endian format.
+*/
+class SparseStatevector
+{
+public:
+    using AmplitudeMap = std::unordered_map<std::size_t, std::complex<double>>;
+
+    /*
+        Creates the |0000...0> state.
+    */
+    explicit SparseStatevector(
+        std::size_t n_qubits,
+        double pruning_tolerance_sq = ket::SPARSE_STATEVECTOR_PRUNING_TOLERANCE_SQ
+    );
+
+    explicit SparseStatevector(
+        std::size_t n_qubits,
+        AmplitudeMap amplitudes,
+        double normalization_tolerance = ket::CONSTRUCTION_NORMALIZATION_TOLERANCE,
+        double pruning_tolerance_sq = ket::SPARSE_STATEVECTOR_PRUNING_TOLERANCE_SQ
+    );
+
+    explicit SparseStatevector(
+        const std::string& computational_state,
+        Endian input_endian = Endian::LITTLE,
+        double pruning_tolerance_sq = ket::SPARSE_STATEVECTOR_PRUNING_TOLERANCE_SQ
+    );
+
+    /*
+        Creates a sparse copy of a dense `Statevector`, dropping all amplitudes below the pruning tolerance.
+    */
+    explicit SparseStatevector(
+        const Statevector& state,
+        double pruning_tolerance_sq = ket::SPARSE_STATEVECTOR_PRUNING_TOLERANCE_SQ
+    );
+
+    /*
+        Returns the amplitude of the basis state at `index`; states outside of the support
+        have an amplitude of zero.
+    */
+    [[nodiscard]]
+    auto at(std::size_t index) const -> std::complex<double>;
+
+    [[nodiscard]]
+    auto at(const std::string& bitstring, Endian endian = Endian::LITTLE) const -> std::complex<double>;
+
+    /*
+        Direct access to the underlying map of amplitudes; used by the simulator to update the
+        state in place. The caller is responsible for keeping the state normalized.
+    */
+    [[nodiscard]]
+    auto amplitudes() const noexcept -> const AmplitudeMap&
+    {
+        return amplitudes_;
+    }
+
+    auto amplitudes() noexcept -> AmplitudeMap&
+    {
+        return amplitudes_;
+    }
+
+    /*
+        Removes every amplitude whose squared norm is below the pruning tolerance.
+    */
+    void prune();
+
+    [[nodiscard]]
+    auto n_nonzero() const noexcept -> std::size_t
+    {
+        return amplitudes_.size();
+    }
+
+    [[nodiscard]]
+    constexpr auto n_states() const noexcept -> std::size_t
+    {
+        return n_states_;
+    }
+
+    [[nodiscard]]
+    constexpr auto n_qubits() const noexcept -> std::size_t
+    {
+        return n_qubits_;
+    }
+
+    [[nodiscard]]
+    constexpr auto pruning_tolerance_sq() const noexcept -> double
+    {
+        return pruning_tolerance_sq_;
+    }
+
+private:
+    std::size_t n_qubits_;
+    std::size_t n_states_;
+    double pruning_tolerance_sq_;
+    AmplitudeMap amplitudes_;
+
+    void check_valid_number_of_qubits_() const;
+
+    void check_index_(std::size_t index) const;
+
+    void check_normalization_of_amplitudes_(double normalization_tolerance) const;
+};
+
+/*
+    Creates the dense `Statevector` with the same amplitudes as the `SparseStatevector`.
+*/
+auto to_statevector(const SparseStatevector& state) -> Statevector;
+
+auto almost_eq(
+    const SparseStatevector& left,
+    const SparseStatevector& right,
+    double tolerance_sq = ket::COMPLEX_ALMOST_EQ_TOLERANCE_SQ
+) noexcept -> bool;
+
+}  // namespace ket
@@ -1,14 +1,20 @@
 #include <algorithm>
+#include <bit>
+#include <complex>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <random>
 #include <stdexcept>
 #include <string>
 #include <map>
+#include <numeric>
+#include <utility>
 #include <vector>
 
 #include "kettle/calculations/probabilities.hpp"
 #include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit_operations/lightcone.hpp"
 #include "kettle_internal/common/prng.hpp"
 #include "kettle/simulation/simulate.hpp"
 #include "kettle/state/statevector.hpp"
@@ -17,12 +23,360 @@
 #include "kettle/calculations/measurements.hpp"
 
 #include "kettle_internal/calculations/measurements_internal.hpp"
+#include "kettle_internal/calculations/probabilities_internal.hpp"
 #include "kettle_internal/common/mathtools_internal.hpp"
+#include "kettle_internal/common/threads.hpp"
+#include "kettle_internal/simulation/simulate_branches.hpp"
 
 /*
     This file contains code components to perform measurements of the state.
 */
 
+namespace
+{
+
+/*
+    Creates the sampler for `method` over `probabilities`, and passes it to `function`; the
+    MULTINOMIAL method does not draw separate shots, and is handled before a sampler is needed.
+*/
+template <typename Function>
+auto with_sampler_(
+    const std::vector<double>& probabilities,
+    std::optional<int> seed,
+    ket::SamplingMethod method,
+    Function&& function
+)
+{
+    if (method == ket::SamplingMethod::ALIAS) {
+        auto sampler = ket::internal::AliasSampler_ {probabilities, seed};
+        return std::forward<Function>(function)(sampler);
+    }
+    else {
+        auto sampler = ket::internal::ProbabilitySampler_ {probabilities, seed};
+        return std::forward<Function>(function)(sampler);
+    }
+}
+
+/*
+    The number of chunks that `for_each_shot_chunk_()` splits `n_shots` shots into.
+*/
+auto n_shot_chunks_(std::size_t n_shots, std::size_t n_threads) -> std::size_t
+{
+    return std::clamp(n_threads, std::size_t {1}, std::max(n_shots, std::size_t {1}));
+}
+
+/*
+    Splits the `n_shots` shots into `n_threads` contiguous chunks, and calls
+    `function(i_thread, i_shot_begin, i_shot_end, prng)` for each chunk on a separate thread.
+
+    Each chunk draws from its own stream of random numbers, so the results only depend on the seed and
+    the number of threads; each thread should only write to the outputs of its own chunk, so that the
+    outputs can be merged after all threads finish without any locking.
+*/
+template <typename Function>
+void for_each_shot_chunk_(
+    std::size_t n_shots,
+    std::size_t n_threads,
+    std::optional<int> seed,
+    Function&& function
+)
+{
+    n_threads = n_shot_chunks_(n_shots, n_threads);
+
+    auto prngs = ket::internal::get_prng_streams_(seed, n_threads);
+    const auto chunk_size = (n_shots + n_threads - 1) / n_threads;
+
+    const auto run_chunk = [&](std::size_t i_thread) {
+        const auto i_begin = std::min(i_thread * chunk_size, n_shots);
+        const auto i_end = std::min(i_begin + chunk_size, n_shots);
+        function(i_thread, i_begin, i_end, prngs[i_thread]);
+    };
+
+    ket::internal::run_in_parallel_(n_threads, run_chunk);
+}
+
+/*
+    Expands the `counts` of each state index into the range `[first, last)`, which must hold exactly
+    as many elements as the total number of counts, and shuffles them; separate samples are independent,
+    so their order is a uniformly random permutation.
+*/
+template <typename Iterator>
+void expand_counts_shuffled_(
+    const std::vector<std::pair<std::size_t, std::size_t>>& counts,
+    Iterator first,
+    Iterator last,
+    ket::internal::Prng& prng
+)
+{
+    auto it = first;
+    for (const auto& [i_state, count] : counts) {
+        it = std::fill_n(it, count, i_state);
+    }
+
+    std::shuffle(first, last, prng);
+}
+
+/*
+    Generates `n_values` uniform random numbers on `[0, upper)`, already in increasing order, in O(n_values)
+    time; the partial sums of `n_values + 1` exponential random numbers, divided by their total, are
+    distributed as the order statistics of `n_values` uniform random numbers on [0, 1).
+*/
+auto sorted_uniforms_(std::size_t n_values, double upper, ket::internal::Prng& prng) -> std::vector<double>
+{
+    auto exponential = std::exponential_distribution<double> {1.0};
+
+    auto values = std::vector<double> {};
+    values.reserve(n_values);
+
+    auto partial_sum = 0.0;
+    for (std::size_t i {0}; i < n_values; ++i) {
+        partial_sum += exponential(prng);
+        values.push_back(partial_sum);
+    }
+
+    const auto total = partial_sum + exponential(prng);
+    for (auto& value : values) {
+        value = upper * (value / total);
+    }
+
+    return values;
+}
+
+/*
+    The implementation of `ket::internal::sample_streaming_counts_()`, for any source of probabilities,
+    where `probability_of(i)` gives the (possibly unnormalized) probability of state `i`.
+*/
+template <typename ProbabilityOf>
+auto sample_streaming_counts_impl_(
+    std::size_t n_states,
+    const ProbabilityOf& probability_of,
+    std::size_t n_shots,
+    ket::internal::Prng& prng,
+    std::size_t n_threads
+) -> std::vector<std::pair<std::size_t, std::size_t>>
+{
+    if (n_shots == 0) {
+        return {};
+    }
+
+    // the states are split into one contiguous block per thread
+    n_threads = std::clamp(n_threads, std::size_t {1}, n_states);
+    const auto block_size = (n_states + n_threads - 1) / n_threads;
+    const auto block_bounds = [&](std::size_t i_block) {
+        const auto i_begin = std::min(i_block * block_size, n_states);
+        const auto i_end = std::min(i_begin + block_size, n_states);
+        return std::pair {i_begin, i_end};
+    };
+
+    // first pass: the total probability of each block, so each block knows where it starts in the
+    // cumulative distribution without the cumulative distribution being stored; the last state in each
+    // block with a nonzero probability is found as well (or `n_states`, if there is none)
+    auto block_sums = std::vector<double>(n_threads, 0.0);
+    auto block_last_nonzero = std::vector<std::size_t>(n_threads, n_states);
+    ket::internal::run_in_parallel_(n_threads, [&](std::size_t i_block) {
+        const auto [i_begin, i_end] = block_bounds(i_block);
+
+        auto block_sum = 0.0;
+        for (std::size_t i_state {i_begin}; i_state < i_end; ++i_state) {
+            const auto prob = probability_of(i_state);
+            block_sum += prob;
+
+            if (prob != 0.0) {
+                block_last_nonzero[i_block] = i_state;
+            }
+        }
+
+        block_sums[i_block] = block_sum;
+    });
+
+    // the last state with a nonzero probability before the start of each block, across all the blocks
+    auto last_nonzero_before = std::vector<std::size_t>(n_threads, n_states);
+    for (std::size_t i_block {1}; i_block < n_threads; ++i_block) {
+        const auto i_last = block_last_nonzero[i_block - 1];
+        last_nonzero_before[i_block] = (i_last != n_states) ? i_last : last_nonzero_before[i_block - 1];
+    }
+
+    auto block_offsets = std::vector<double>(n_threads + 1, 0.0);
+    std::partial_sum(block_sums.begin(), block_sums.end(), block_offsets.begin() + 1);
+
+    const auto total = block_offsets.back();
+    if (!(total > 0.0)) {
+        throw std::runtime_error {"ERROR: cannot sample from probabilities that sum to zero.\n"};
+    }
+
+    const auto thresholds = sorted_uniforms_(n_shots, total, prng);
+
+    // second pass: each block walks through its states and the thresholds that fall inside it at the
+    // same time; a state is sampled once for each threshold it crosses
+    auto block_counts = std::vector<std::vector<std::pair<std::size_t, std::size_t>>>(n_threads);
+    ket::internal::run_in_parallel_(n_threads, [&](std::size_t i_block) {
+        const auto [i_begin, i_end] = block_bounds(i_block);
+        const auto offset = block_offsets[i_block];
+
+        auto it = std::ranges::lower_bound(thresholds, offset);
+        const auto it_end = (i_block + 1 == n_threads) ? thresholds.end() : std::ranges::lower_bound(thresholds, block_offsets[i_block + 1]);
+
+        auto& counts = block_counts[i_block];
+        auto running_sum = 0.0;
+        auto i_last_nonzero = last_nonzero_before[i_block];
+
+        for (std::size_t i_state {i_begin}; i_state < i_end && it != it_end; ++i_state) {
+            const auto prob = probability_of(i_state);
+            if (prob == 0.0) {
+                continue;
+            }
+
+            running_sum += prob;
+            i_last_nonzero = i_state;
+
+            auto count = std::size_t {0};
+            while (it != it_end && (*it - offset) < running_sum) {
+                ++count;
+                ++it;
+            }
+
+            if (count != 0) {
+                counts.emplace_back(i_state, count);
+            }
+        }
+
+        // due to rounding, a few thresholds at the very end of the block can be left over; they belong
+        // to the last state that can be sampled, which is in an earlier block if every state in this
+        // block has a zero probability
+        const auto n_leftover = static_cast<std::size_t>(std::distance(it, it_end));
+        if (n_leftover != 0 && i_last_nonzero != n_states) {
+            if (!counts.empty() && counts.back().first == i_last_nonzero) {
+                counts.back().second += n_leftover;
+            }
+            else {
+                counts.emplace_back(i_last_nonzero, n_leftover);
+            }
+        }
+    });
+
+    // a block can give its leftover thresholds to the same state as the blocks before it
+    auto output = std::move(block_counts[0]);
+    for (std::size_t i_block {1}; i_block < n_threads; ++i_block) {
+        for (const auto& [i_state, count] : block_counts[i_block]) {
+            if (!output.empty() && output.back().first == i_state) {
+                output.back().second += count;
+            }
+            else {
+                output.emplace_back(i_state, count);
+            }
+        }
+    }
+
+    return output;
+}
+
+/*
+    Whether the noise is applied to the sampled shots, rather than to the probabilities.
+*/
+auto is_applied_to_shots_(const ket::QuantumNoise* noise) -> bool
+{
+    return noise != nullptr && noise->application() == ket::NoiseApplication::SHOTS;
+}
+
+/*
+    The noise probabilities of the qubits that are not marginalized, in increasing order of qubit index;
+    the bit at index `k` of the compacted outcome belongs to the k-th of these qubits.
+*/
+auto readout_flip_probabilities_(const ket::QuantumNoise& noise, const std::vector<std::uint8_t>& marginal_bitmask) -> std::vector<double>
+{
+    auto flip_probabilities = std::vector<double> {};
+    for (std::size_t i_qubit {0}; i_qubit < marginal_bitmask.size(); ++i_qubit) {
+        if (marginal_bitmask[i_qubit] == 0) {
+            flip_probabilities.push_back(noise.get(i_qubit));
+        }
+    }
+
+    return flip_probabilities;
+}
+
+/*
+    The generator for the bit flips must not share its stream with any of the generators used to sample
+    the noiseless shots, so it uses the stream after the last of them; zero threads are treated as one,
+    as the samplers do, so the stream is never stream 0, the one made by `get_prng_()`.
+*/
+auto readout_prng_(std::optional<int> seed, std::size_t n_threads) -> ket::internal::Prng
+{
+    const auto n_sampling_streams = std::max(n_threads, std::size_t {1});
+    return ket::internal::get_prng_streams_(seed, n_sampling_streams + 1).back();
+}
+
+/*
+    Applies the bit flips to the shots of `ideal_counts`, a range of pairs of outcome and count. The shots are
+    expanded into a buffer of a fixed size, a chunk at a time, so the memory does not grow with the number of shots.
+*/
+template <typename Counts>
+auto flip_counts_(
+    const Counts& ideal_counts,
+    const std::vector<double>& flip_probabilities,
+    ket::internal::Prng& prng
+) -> std::map<std::size_t, std::size_t>
+{
+    constexpr auto chunk_size = std::size_t {1} << 16;
+
+    auto counts = std::map<std::size_t, std::size_t> {};
+    auto outcomes = std::vector<std::size_t> {};
+    outcomes.reserve(chunk_size);
+
+    const auto flush = [&]() {
+        ket::internal::flip_outcome_bits_(outcomes, flip_probabilities, prng);
+        for (auto i_outcome : outcomes) {
+            ++counts[i_outcome];
+        }
+        outcomes.clear();
+    };
+
+    for (const auto& [i_outcome, count] : ideal_counts) {
+        for (std::size_t i_shot {0}; i_shot < count; ++i_shot) {
+            outcomes.push_back(static_cast<std::size_t>(i_outcome));
+            if (outcomes.size() == chunk_size) {
+                flush();
+            }
+        }
+    }
+
+    flush();
+
+    return counts;
+}
+
+/*
+    Samples the shots of `state` with the streaming sampler, and counts the outcomes of the measured qubits
+    by their compacted index. Only the distinct outcomes are stored, so nothing the size of the state is
+    allocated, and the shots are the same as those of the dense STREAMING counts with the same seed.
+*/
+auto sample_streaming_measured_counts_(
+    const ket::Statevector& state,
+    std::size_t n_shots,
+    const std::vector<std::uint8_t>& marginal_bitmask,
+    const ket::QuantumNoise* noise,
+    std::optional<int> seed,
+    std::size_t n_threads
+) -> std::map<std::size_t, std::size_t>
+{
+    const auto measured_mask = ket::internal::measured_qubits_mask_(marginal_bitmask);
+    auto prng = ket::internal::get_prng_(seed);
+
+    auto counts = std::map<std::size_t, std::size_t> {};
+    for (const auto& [i_state, count] : ket::internal::sample_streaming_counts_(state, n_shots, prng, n_threads)) {
+        counts[static_cast<std::size_t>(ket::internal::compact_bits_(i_state, measured_mask))] += count;
+    }
+
+    if (is_applied_to_shots_(noise)) {
+        auto readout_prng = readout_prng_(seed, n_threads);
+        return flip_counts_(counts, readout_flip_probabilities_(*noise, marginal_bitmask), readout_prng);
+    }
+
+    return counts;
+}
+
+}  // namespace
+
+
 namespace ket
 {
 
@@ -77,19 +431,41 @@ auto memory_to_fractions(const std::vector<std::size_t>& measurements) -> std::m
 auto perform_measurements_as_memory(
     const std::vector<double>& probabilities_raw,
     std::size_t n_shots,
-    std::optional<int> seed
+    std::optional<int> seed,
+    SamplingMethod method,
+    std::size_t n_threads
 ) -> std::vector<std::size_t>
 {
-    auto sampler = ket::internal::ProbabilitySampler_ {probabilities_raw, seed};
+    auto measurements = std::vector<std::size_t>(n_shots);
+
+    if (method == SamplingMethod::MULTINOMIAL) {
+        for_each_shot_chunk_(n_shots, n_threads, seed, [&](std::size_t, std::size_t i_begin, std::size_t i_end, ket::internal::Prng& prng) {
+            const auto chunk_begin = measurements.begin() + static_cast<std::ptrdiff_t>(i_begin);
+            const auto chunk_end = measurements.begin() + static_cast<std::ptrdiff_t>(i_end);
+
+            const auto counts = ket::internal::sample_multinomial_counts_(probabilities_raw, i_end - i_begin, prng);
+            expand_counts_shuffled_(counts, chunk_begin, chunk_end, prng);
+        });
+
+        return measurements;
+    }
 
-    auto measurements = std::vector<std::size_t> {};
-    measurements.reserve(n_shots);
+    if (method == SamplingMethod::STREAMING) {
+        auto prng = ket::internal::get_prng_(seed);
+        const auto counts = ket::internal::sample_streaming_counts_(probabilities_raw, n_shots, prng, n_threads);
+        expand_counts_shuffled_(counts, measurements.begin(), measurements.end(), prng);
 
-    for (std::size_t i_shot {0}; i_shot < n_shots; ++i_shot) {
-        const auto i_state = sampler();
-        measurements.push_back(i_state);
+        return measurements;
     }
 
+    with_sampler_(probabilities_raw, seed, method, [&](const auto& sampler) {
+        for_each_shot_chunk_(n_shots, n_threads, seed, [&](std::size_t, std::size_t i_begin, std::size_t i_end, ket::internal::Prng& prng) {
+            for (std::size_t i_shot {i_begin}; i_shot < i_end; ++i_shot) {
+                measurements[i_shot] = sampler(prng);
+            }
+        });
+    });
+
     return measurements;
 }
 
@@ -97,26 +473,77 @@ auto perform_measurements_as_memory(
     const Statevector& state,
     std::size_t n_shots,
     const QuantumNoise* noise,
-    std::optional<int> seed
+    std::optional<int> seed,
+    SamplingMethod method,
+    std::size_t n_threads
 ) -> std::vector<std::size_t>
 {
+    if (is_applied_to_shots_(noise)) {
+        const auto all_qubits = ket::internal::build_marginal_bitmask_({}, state.n_qubits());
+        auto prng = readout_prng_(seed, n_threads);
+
+        auto measurements = perform_measurements_as_memory(state, n_shots, nullptr, seed, method, n_threads);
+        ket::internal::flip_outcome_bits_(measurements, readout_flip_probabilities_(*noise, all_qubits), prng);
+
+        return measurements;
+    }
+
+    if (method == SamplingMethod::STREAMING && noise == nullptr) {
+        auto prng = ket::internal::get_prng_(seed);
+        const auto counts = ket::internal::sample_streaming_counts_(state, n_shots, prng, n_threads);
+
+        auto measurements = std::vector<std::size_t>(n_shots);
+        expand_counts_shuffled_(counts, measurements.begin(), measurements.end(), prng);
+
+        return measurements;
+    }
+
     const auto probabilities_raw = calculate_probabilities_raw(state, noise);
-    return perform_measurements_as_memory(probabilities_raw, n_shots, seed);
+    return perform_measurements_as_memory(probabilities_raw, n_shots, seed, method, n_threads);
 }
 
 auto perform_measurements_as_counts_raw(
     const std::vector<double>& probabilities_raw,
     std::size_t n_shots,
-    std::optional<int> seed
+    std::optional<int> seed,
+    SamplingMethod method,
+    std::size_t n_threads
 ) -> std::map<std::size_t, std::size_t>
 {
-    auto sampler = ket::internal::ProbabilitySampler_ {probabilities_raw, seed};
-    auto measurements = std::map<std::size_t, std::size_t> {};
+    if (method == SamplingMethod::STREAMING) {
+        auto prng = ket::internal::get_prng_(seed);
+        const auto counts = ket::internal::sample_streaming_counts_(probabilities_raw, n_shots, prng, n_threads);
 
-    // REMINDER: if the entry does not exist, `std::map` will first initialize it to 0
-    for (std::size_t i_shot {0}; i_shot < n_shots; ++i_shot) {
-        const auto i_state = sampler();
-        ++measurements[i_state];
+        return {counts.begin(), counts.end()};
+    }
+
+    // each thread counts its own shots, and the counts are merged once all threads are done
+    auto thread_counts = std::vector<std::map<std::size_t, std::size_t>>(n_shot_chunks_(n_shots, n_threads));
+
+    if (method == SamplingMethod::MULTINOMIAL) {
+        for_each_shot_chunk_(n_shots, n_threads, seed, [&](std::size_t i_thread, std::size_t i_begin, std::size_t i_end, ket::internal::Prng& prng) {
+            const auto counts = ket::internal::sample_multinomial_counts_(probabilities_raw, i_end - i_begin, prng);
+            thread_counts[i_thread] = {counts.begin(), counts.end()};
+        });
+    }
+    else {
+        with_sampler_(probabilities_raw, seed, method, [&](const auto& sampler) {
+            for_each_shot_chunk_(n_shots, n_threads, seed, [&](std::size_t i_thread, std::size_t i_begin, std::size_t i_end, ket::internal::Prng& prng) {
+                auto& measurements = thread_counts[i_thread];
+
+                // REMINDER: if the entry does not exist, `std::map` will first initialize it to 0
+                for (std::size_t i_shot {i_begin}; i_shot < i_end; ++i_shot) {
+                    ++measurements[sampler(prng)];
+                }
+            });
+        });
+    }
+
+    auto measurements = std::move(thread_counts[0]);
+    for (std::size_t i_thread {1}; i_thread < thread_counts.size(); ++i_thread) {
+        for (const auto& [i_state, count] : thread_counts[i_thread]) {
+            measurements[i_state] += count;
+        }
     }
 
     return measurements;
@@ -126,19 +553,38 @@ auto perform_measurements_as_counts_raw(
     const Statevector& state,
     std::size_t n_shots,
     const QuantumNoise* noise,
-    std::optional<int> seed
+    std::optional<int> seed,
+    SamplingMethod method,
+    std::size_t n_threads
 ) -> std::map<std::size_t, std::size_t>
 {
+    if (is_applied_to_shots_(noise)) {
+        const auto all_qubits = ket::internal::build_marginal_bitmask_({}, state.n_qubits());
+        auto prng = readout_prng_(seed, n_threads);
+
+        const auto ideal_counts = perform_measurements_as_counts_raw(state, n_shots, nullptr, seed, method, n_threads);
+        return flip_counts_(ideal_counts, readout_flip_probabilities_(*noise, all_qubits), prng);
+    }
+
+    if (method == SamplingMethod::STREAMING && noise == nullptr) {
+        auto prng = ket::internal::get_prng_(seed);
+        const auto counts = ket::internal::sample_streaming_counts_(state, n_shots, prng, n_threads);
+
+        return {counts.begin(), counts.end()};
+    }
+
     const auto probabilities_raw = calculate_probabilities_raw(state, noise);
-    return perform_measurements_as_counts_raw(probabilities_raw, n_shots, seed);
+    return perform_measurements_as_counts_raw(probabilities_raw, n_shots, seed, method, n_threads);
 }
 
-auto perform_measurements_as_counts_marginal(
+auto perform_measurements_as_counts_dense(
     const std::vector<double>& probabilities_raw,
     std::size_t n_shots,
     const std::vector<std::size_t>& marginal_qubits,
-    std::optional<int> seed
-) -> std::map<std::string, std::size_t>
+    std::optional<int> seed,
+    SamplingMethod method,
+    std::size_t n_threads
+) -> std::vector<std::uint64_t>
 {
     if (!ket::internal::is_power_of_2(probabilities_raw.size())) {
         throw std::runtime_error {"The number of probabilities must be a power of 2.\n"};
@@ -146,33 +592,184 @@ auto perform_measurements_as_counts_marginal(
 
     const auto n_qubits = ket::internal::log_2_int(probabilities_raw.size());
     const auto marginal_bitmask = ket::internal::build_marginal_bitmask_(marginal_qubits, n_qubits);
+    const auto measured_mask = ket::internal::measured_qubits_mask_(marginal_bitmask);
 
-    auto sampler = ket::internal::ProbabilitySampler_ {probabilities_raw, seed};
-    auto measurements = std::map<std::string, std::size_t> {};
+    // the shots only need to be drawn from the distribution over the measured qubits, which is much
+    // smaller than the full distribution if many qubits are marginalized
+    const auto marginal_probabilities = ket::internal::marginalize_probabilities_(probabilities_raw, measured_mask, n_threads);
+    const auto n_marginal_states = marginal_probabilities.size();
+
+    if (method == SamplingMethod::STREAMING) {
+        auto prng = ket::internal::get_prng_(seed);
+
+        auto counts = std::vector<std::uint64_t>(n_marginal_states, 0);
+        for (const auto& [i_measured, count] : ket::internal::sample_streaming_counts_(marginal_probabilities, n_shots, prng, n_threads)) {
+            counts[i_measured] = count;
+        }
+
+        return counts;
+    }
+
+    // each thread counts its own shots, and the counts are merged once all threads are done
+    auto thread_counts = std::vector<std::vector<std::uint64_t>>(
+        n_shot_chunks_(n_shots, n_threads),
+        std::vector<std::uint64_t>(n_marginal_states, 0)
+    );
+
+    if (method == SamplingMethod::MULTINOMIAL) {
+        for_each_shot_chunk_(n_shots, n_threads, seed, [&](std::size_t i_thread, std::size_t i_begin, std::size_t i_end, ket::internal::Prng& prng) {
+            for (const auto& [i_measured, count] : ket::internal::sample_multinomial_counts_(marginal_probabilities, i_end - i_begin, prng)) {
+                thread_counts[i_thread][i_measured] += count;
+            }
+        });
+    }
+    else {
+        with_sampler_(marginal_probabilities, seed, method, [&](const auto& sampler) {
+            for_each_shot_chunk_(n_shots, n_threads, seed, [&](std::size_t i_thread, std::size_t i_begin, std::size_t i_end, ket::internal::Prng& prng) {
+                auto& counts = thread_counts[i_thread];
+                for (std::size_t i_shot {i_begin}; i_shot < i_end; ++i_shot) {
+                    ++counts[sampler(prng)];
+                }
+            });
+        });
+    }
+
+    auto counts = std::move(thread_counts[0]);
+    for (std::size_t i_thread {1}; i_thread < thread_counts.size(); ++i_thread) {
+        for (std::size_t i_measured {0}; i_measured < n_marginal_states; ++i_measured) {
+            counts[i_measured] += thread_counts[i_thread][i_measured];
+        }
+    }
+
+    return counts;
+}
+
+auto perform_measurements_as_counts_dense(
+    const Statevector& state,
+    std::size_t n_shots,
+    const std::vector<std::size_t>& marginal_qubits,
+    const QuantumNoise* noise,
+    std::optional<int> seed,
+    SamplingMethod method,
+    std::size_t n_threads
+) -> std::vector<std::uint64_t>
+{
+    if (is_applied_to_shots_(noise)) {
+        const auto marginal_bitmask = ket::internal::build_marginal_bitmask_(marginal_qubits, state.n_qubits());
+        auto prng = readout_prng_(seed, n_threads);
+
+        const auto ideal_counts = perform_measurements_as_counts_dense(state, n_shots, marginal_qubits, nullptr, seed, method, n_threads);
+
+        auto ideal_pairs = std::vector<std::pair<std::size_t, std::uint64_t>> {};
+        for (std::size_t i_measured {0}; i_measured < ideal_counts.size(); ++i_measured) {
+            if (ideal_counts[i_measured] != 0) {
+                ideal_pairs.emplace_back(i_measured, ideal_counts[i_measured]);
+            }
+        }
+
+        // the bits of the compacted outcomes only belong to the measured qubits, so only those are flipped
+        auto counts = std::vector<std::uint64_t>(ideal_counts.size(), 0);
+        for (const auto& [i_measured, count] : flip_counts_(ideal_pairs, readout_flip_probabilities_(*noise, marginal_bitmask), prng)) {
+            counts[i_measured] = count;
+        }
+
+        return counts;
+    }
+
+    // the amplitudes are streamed directly, so neither the full nor the marginal distribution is stored
+    if (method == SamplingMethod::STREAMING && noise == nullptr) {
+        const auto marginal_bitmask = ket::internal::build_marginal_bitmask_(marginal_qubits, state.n_qubits());
+        const auto measured_mask = ket::internal::measured_qubits_mask_(marginal_bitmask);
+
+        auto counts = std::vector<std::uint64_t>(std::size_t {1} << std::popcount(measured_mask), 0);
+        for (const auto& [i_measured, count] : sample_streaming_measured_counts_(state, n_shots, marginal_bitmask, nullptr, seed, n_threads)) {
+            counts[i_measured] = count;
+        }
+
+        return counts;
+    }
+
+    const auto probabilities_raw = calculate_probabilities_raw(state, noise);
+    return perform_measurements_as_counts_dense(probabilities_raw, n_shots, marginal_qubits, seed, method, n_threads);
+}
+
+auto dense_counts_to_marginal_counts(
+    const std::vector<std::uint64_t>& dense_counts,
+    std::size_t n_qubits,
+    const std::vector<std::size_t>& marginal_qubits
+) -> std::map<std::string, std::size_t>
+{
+    const auto marginal_bitmask = ket::internal::build_marginal_bitmask_(marginal_qubits, n_qubits);
+    const auto measured_mask = ket::internal::measured_qubits_mask_(marginal_bitmask);
+
+    if (dense_counts.size() != (std::size_t {1} << std::popcount(measured_mask))) {
+        throw std::runtime_error {"ERROR: the number of dense counts does not match the number of measured qubits.\n"};
+    }
 
     // the internal layout of the quantum state is little endian, so the probabilities are as well
     const auto endian = ket::Endian::LITTLE;
 
-    // REMINDER: if the entry does not exist, `std::map` will first initialize it to 0
-    for (std::size_t i_shot {0}; i_shot < n_shots; ++i_shot) {
-        const auto i_state = sampler();
+    auto measurements = std::map<std::string, std::size_t> {};
+    for (std::size_t i_measured {0}; i_measured < dense_counts.size(); ++i_measured) {
+        if (dense_counts[i_measured] == 0) {
+            continue;
+        }
+
+        const auto i_state = ket::internal::expand_bits_(i_measured, measured_mask);
         const auto bitstring = ket::internal::state_index_to_bitstring_marginal_(i_state, marginal_bitmask, endian);
-        ++measurements[bitstring];
+        measurements.emplace(bitstring, dense_counts[i_measured]);
     }
 
     return measurements;
 }
 
+auto perform_measurements_as_counts_marginal(
+    const std::vector<double>& probabilities_raw,
+    std::size_t n_shots,
+    const std::vector<std::size_t>& marginal_qubits,
+    std::optional<int> seed,
+    SamplingMethod method,
+    std::size_t n_threads
+) -> std::map<std::string, std::size_t>
+{
+    // the shots are counted by integer index, so each distinct outcome is converted to a string only once
+    const auto dense_counts = perform_measurements_as_counts_dense(probabilities_raw, n_shots, marginal_qubits, seed, method, n_threads);
+    const auto n_qubits = ket::internal::log_2_int(probabilities_raw.size());
+
+    return dense_counts_to_marginal_counts(dense_counts, n_qubits, marginal_qubits);
+}
+
 auto perform_measurements_as_counts_marginal(
     const Statevector& state,
     std::size_t n_shots,
     const std::vector<std::size_t>& marginal_qubits,
     const QuantumNoise* noise,
-    std::optional<int> seed
+    std::optional<int> seed,
+    SamplingMethod method,
+    std::size_t n_threads
 ) -> std::map<std::string, std::size_t>
 {
-    const auto probabilities_raw = calculate_probabilities_raw(state, noise);
-    return perform_measurements_as_counts_marginal(probabilities_raw, n_shots, marginal_qubits, seed);
+    // the streamed shots are sparse, so they are turned into bitstrings directly, rather than
+    // through dense counts over all of the measured outcomes
+    if (method == SamplingMethod::STREAMING && (noise == nullptr || is_applied_to_shots_(noise))) {
+        const auto marginal_bitmask = ket::internal::build_marginal_bitmask_(marginal_qubits, state.n_qubits());
+        const auto measured_mask = ket::internal::measured_qubits_mask_(marginal_bitmask);
+
+        // the internal layout of the quantum state is little endian, so the probabilities are as well
+        const auto endian = ket::Endian::LITTLE;
+
+        auto measurements = std::map<std::string, std::size_t> {};
+        for (const auto& [i_measured, count] : sample_streaming_measured_counts_(state, n_shots, marginal_bitmask, noise, seed, n_threads)) {
+            const auto i_state = ket::internal::expand_bits_(i_measured, measured_mask);
+            const auto bitstring = ket::internal::state_index_to_bitstring_marginal_(i_state, marginal_bitmask, endian);
+            measurements.emplace(bitstring, count);
+        }
+
+        return measurements;
+    }
+
+    const auto dense_counts = perform_measurements_as_counts_dense(state, n_shots, marginal_qubits, noise, seed, method, n_threads);
+    return dense_counts_to_marginal_counts(dense_counts, state.n_qubits(), marginal_qubits);
 }
 
 auto perform_measurements_as_counts_marginal(
@@ -190,18 +787,67 @@ auto perform_measurements_as_counts_marginal(
     // the internal layout of the quantum state is little endian, so the probabilities are as well
     const auto endian = ket::Endian::LITTLE;
 
+    // gates outside of the backward lightcone of the measured qubits cannot change their distribution
+    auto observed_qubits = std::vector<std::size_t> {};
+    for (std::size_t i {0}; i < n_qubits; ++i) {
+        if (marginal_bitmask[i] == 0) {
+            observed_qubits.push_back(i);
+        }
+    }
+
+    // if the initial state is a computational basis state, the qubits outside of the lightcone can
+    // be removed from the register entirely; the noise model is defined for the full register, so
+    // this reduction is only done without noise
+    const auto basis_index = ket::internal::basis_state_index_(original_state);
+    const auto kept_qubits = lightcone_qubits(circuit, observed_qubits);
+    const auto can_reduce = basis_index.has_value() && noise == nullptr && kept_qubits.size() < n_qubits && !kept_qubits.empty();
+
     auto measurements = std::map<std::string, std::size_t> {};
+    auto prng = ket::internal::get_prng_(seed);
 
-    for (std::size_t i {0}; i < n_shots; ++i) {
-        auto state = original_state;
-        ket::simulate(circuit, state);
+    if (can_reduce) {
+        const auto reduced = reduce_to_lightcone(circuit, observed_qubits);
+        const auto reduced_state = ket::internal::gather_basis_state_(*basis_index, reduced.kept_qubits);
 
-        const auto probabilities_raw = calculate_probabilities_raw(state, noise);
-        auto sampler = ket::internal::ProbabilitySampler_ {probabilities_raw, seed};
+        // each branch is sampled as soon as it is finished, so it can be dropped right after
+        ket::internal::simulate_branches_(reduced.circuit, reduced_state, n_shots, prng, [&](const SimulationBranch& branch) {
+            const auto probabilities_raw = calculate_probabilities_raw(branch.state);
 
-        const auto i_state = sampler();
-        const auto bitstring = ket::internal::state_index_to_bitstring_marginal_(i_state, marginal_bitmask, endian);
-        ++measurements[bitstring];
+            for (const auto& [i_reduced, count] : ket::internal::sample_multinomial_counts_(probabilities_raw, branch.n_shots, prng)) {
+                // every qubit outside of the lightcone is a marginal qubit, so its bit is never shown
+                const auto i_state = ket::internal::scatter_state_index_(i_reduced, reduced.kept_qubits);
+                const auto bitstring = ket::internal::state_index_to_bitstring_marginal_(i_state, marginal_bitmask, endian);
+                measurements[bitstring] += count;
+            }
+        });
+    }
+    else {
+        const auto pruned = prune_to_lightcone(circuit, observed_qubits);
+
+        const auto add_counts = [&](const auto& counts) {
+            for (const auto& [i_state, count] : counts) {
+                const auto bitstring = ket::internal::state_index_to_bitstring_marginal_(i_state, marginal_bitmask, endian);
+                measurements[bitstring] += count;
+            }
+        };
+
+        const auto noise_on_shots = is_applied_to_shots_(noise);
+        const auto probability_noise = noise_on_shots ? nullptr : noise;
+        const auto flip_probabilities = noise_on_shots
+            ? readout_flip_probabilities_(*noise, ket::internal::build_marginal_bitmask_({}, n_qubits))
+            : std::vector<double> {};
+
+        ket::internal::simulate_branches_(pruned, original_state, n_shots, prng, [&](const SimulationBranch& branch) {
+            const auto probabilities_raw = calculate_probabilities_raw(branch.state, probability_noise);
+            const auto counts = ket::internal::sample_multinomial_counts_(probabilities_raw, branch.n_shots, prng);
+
+            if (noise_on_shots) {
+                add_counts(flip_counts_(counts, flip_probabilities, prng));
+            }
+            else {
+                add_counts(counts);
+            }
+        });
     }
 
     return measurements;
@@ -211,12 +857,13 @@ auto perform_measurements_as_counts(
     const Statevector& state,
     std::size_t n_shots,
     const QuantumNoise* noise,
-    std::optional<int> seed
+    std::optional<int> seed,
+    SamplingMethod method,
+    std::size_t n_threads
 ) -> std::map<std::string, std::size_t>
 {
-    const auto probabilities_raw = calculate_probabilities_raw(state, noise);
     const auto marginal_qubits = std::vector<std::size_t> {};
-    return perform_measurements_as_counts_marginal(probabilities_raw, n_shots, marginal_qubits, seed);
+    return perform_measurements_as_counts_marginal(state, n_shots, marginal_qubits, noise, seed, method, n_threads);
 }
 
 }  // namespace ket
@@ -285,6 +932,161 @@ auto build_marginal_bitmask_(
     return marginal_bitmask;
 }
 
+auto basis_state_index_(const ket::Statevector& state) -> std::optional<std::size_t>
+{
+    auto basis_index = std::optional<std::size_t> {std::nullopt};
+
+    for (std::size_t i {0}; i < state.n_states(); ++i) {
+        if (std::norm(state[i]) < BASIS_STATE_AMPLITUDE_TOLERANCE_SQ) {
+            continue;
+        }
+
+        if (basis_index.has_value()) {
+            return std::nullopt;
+        }
+
+        basis_index = i;
+    }
+
+    return basis_index;
+}
+
+auto gather_basis_state_(std::size_t i_state, const std::vector<std::size_t>& kept_qubits) -> ket::Statevector
+{
+    auto i_reduced = std::size_t {0};
+    for (std::size_t i {0}; i < kept_qubits.size(); ++i) {
+        i_reduced |= ((i_state >> kept_qubits[i]) & 1UL) << i;
+    }
+
+    auto coefficients = std::vector<std::complex<double>>(pow_2_int(kept_qubits.size()), {0.0, 0.0});
+    coefficients[i_reduced] = {1.0, 0.0};
+
+    return ket::Statevector {std::move(coefficients)};
+}
+
+auto scatter_state_index_(std::size_t i_reduced, const std::vector<std::size_t>& kept_qubits) -> std::size_t
+{
+    auto i_state = std::size_t {0};
+    for (std::size_t i {0}; i < kept_qubits.size(); ++i) {
+        i_state |= ((i_reduced >> i) & 1UL) << kept_qubits[i];
+    }
+
+    return i_state;
+}
+
+auto sample_multinomial_counts_(
+    const std::vector<double>& probabilities,
+    std::size_t n_shots,
+    ket::internal::Prng& prng
+) -> std::vector<std::pair<std::size_t, std::size_t>>
+{
+    // the leaves of the tree are at [n_leaves, 2 * n_leaves), and node `i` has the children `2i` and
+    // `2i + 1`; each node holds the total probability of the leaves below it
+    const auto n_leaves = std::bit_ceil(std::max(probabilities.size(), std::size_t {1}));
+    auto tree = std::vector<double>(2 * n_leaves, 0.0);
+
+    std::ranges::copy(probabilities, tree.begin() + static_cast<std::ptrdiff_t>(n_leaves));
+    for (auto i_node = n_leaves - 1; i_node > 0; --i_node) {
+        tree[i_node] = tree[2 * i_node] + tree[2 * i_node + 1];
+    }
+
+    auto output = std::vector<std::pair<std::size_t, std::size_t>> {};
+
+    // depth-first over the nodes that receive shots; the right child is pushed first, so that the
+    // leaves are reached in increasing order
+    struct NodeShots
+    {
+        std::size_t i_node;
+        std::size_t n_shots;
+    };
+
+    auto stack = std::vector<NodeShots> {{.i_node=1, .n_shots=n_shots}};
+
+    while (!stack.empty()) {
+        const auto [i_node, n_node_shots] = stack.back();
+        stack.pop_back();
+
+        if (n_node_shots == 0) {
+            continue;
+        }
+
+        if (i_node >= n_leaves) {
+            output.emplace_back(i_node - n_leaves, n_node_shots);
+            continue;
+        }
+
+        const auto total = tree[i_node];
+        const auto left = tree[2 * i_node];
+        const auto left_fraction = total > 0.0 ? std::clamp(left / total, 0.0, 1.0) : 0.0;
+
+        auto binomial = std::binomial_distribution<std::size_t> {n_node_shots, left_fraction};
+        const auto n_left_shots = binomial(prng);
+
+        stack.push_back({.i_node=2 * i_node + 1, .n_shots=n_node_shots - n_left_shots});
+        stack.push_back({.i_node=2 * i_node, .n_shots=n_left_shots});
+    }
+
+    return output;
+}
+
+void flip_outcome_bits_(std::vector<std::size_t>& outcomes, const std::vector<double>& flip_probabilities, ket::internal::Prng& prng)
+{
+    const auto n_outcomes = outcomes.size();
+
+    for (std::size_t i_bit {0}; i_bit < flip_probabilities.size(); ++i_bit) {
+        const auto prob = flip_probabilities[i_bit];
+        const auto bit = std::size_t {1} << i_bit;
+
+        if (prob == 0.0 || n_outcomes == 0) {
+            continue;
+        }
+
+        if (prob == 1.0) {
+            for (auto& outcome : outcomes) {
+                outcome ^= bit;
+            }
+            continue;
+        }
+
+        // the number of outcomes skipped before the next flipped outcome follows a geometric distribution
+        auto n_skipped = std::geometric_distribution<std::size_t> {prob};
+
+        auto i_outcome = n_skipped(prng);
+        while (i_outcome < n_outcomes) {
+            outcomes[i_outcome] ^= bit;
+
+            const auto skip = n_skipped(prng);
+            if (skip >= n_outcomes - i_outcome - 1) {
+                break;
+            }
+
+            i_outcome += skip + 1;
+        }
+    }
+}
+
+auto sample_streaming_counts_(
+    const std::vector<double>& probabilities,
+    std::size_t n_shots,
+    ket::internal::Prng& prng,
+    std::size_t n_threads
+) -> std::vector<std::pair<std::size_t, std::size_t>>
+{
+    const auto probability_of = [&](std::size_t i_state) { return probabilities[i_state]; };
+    return sample_streaming_counts_impl_(probabilities.size(), probability_of, n_shots, prng, n_threads);
+}
+
+auto sample_streaming_counts_(
+    const ket::Statevector& state,
+    std::size_t n_shots,
+    ket::internal::Prng& prng,
+    std::size_t n_threads
+) -> std::vector<std::pair<std::size_t, std::size_t>>
+{
+    const auto probability_of = [&](std::size_t i_state) { return std::norm(state[i_state]); };
+    return sample_streaming_counts_impl_(state.n_states(), probability_of, n_shots, prng, n_threads);
+}
+
 ProbabilitySampler_::ProbabilitySampler_(const std::vector<double>& probabilities, std::optional<int> seed)
     : cumulative_ {calculate_cumulative_sum_(probabilities)}
     , prng_ {ket::internal::get_prng_(seed)}
@@ -296,7 +1098,14 @@ ProbabilitySampler_::ProbabilitySampler_(const std::vector<double>& probabilitie
 
 auto ProbabilitySampler_::operator()() -> std::size_t
 {
-    const auto prob = uniform_dist_(prng_);
+    return (*this)(prng_);
+}
+
+auto ProbabilitySampler_::operator()(ket::internal::Prng& prng) const -> std::size_t
+{
+    // the distribution holds no state between calls, so a copy gives the same numbers
+    auto uniform_dist = uniform_dist_;
+    const auto prob = uniform_dist(prng);
 
     const auto it_state = std::ranges::lower_bound(cumulative_, prob);
 
@@ -311,4 +1120,73 @@ auto ProbabilitySampler_::operator()() -> std::size_t
     return i_state;
 }
 
+AliasSampler_::AliasSampler_(const std::vector<double>& probabilities, std::optional<int> seed)
+    : thresholds_(probabilities.size(), 1.0)
+    , aliases_(probabilities.size(), 0)
+    , prng_ {ket::internal::get_prng_(seed)}
+{
+    const auto size = probabilities.size();
+    const auto total = std::accumulate(probabilities.begin(), probabilities.end(), 0.0);
+
+    // scale the probabilities so that their average is 1; each index starts out as either
+    // underfull (below 1) or overfull (at least 1)
+    auto scaled = std::vector<double>(size);
+    auto underfull = std::vector<std::size_t> {};
+    auto overfull = std::vector<std::size_t> {};
+
+    for (std::size_t i {0}; i < size; ++i) {
+        scaled[i] = probabilities[i] * static_cast<double>(size) / total;
+        if (scaled[i] < 1.0) {
+            underfull.push_back(i);
+        }
+        else {
+            overfull.push_back(i);
+        }
+    }
+
+    // fill up each underfull index with the probability of an overfull one
+    while (!underfull.empty() && !overfull.empty()) {
+        const auto i_under = underfull.back();
+        underfull.pop_back();
+        const auto i_over = overfull.back();
+
+        thresholds_[i_under] = scaled[i_under];
+        aliases_[i_under] = i_over;
+
+        scaled[i_over] -= (1.0 - scaled[i_under]);
+        if (scaled[i_over] < 1.0) {
+            overfull.pop_back();
+            underfull.push_back(i_over);
+        }
+    }
+
+    // any indices left over are only away from 1 due to floating-point rounding; they keep the
+    // default threshold of 1, and are always sampled as themselves
+    for (auto i : overfull) {
+        aliases_[i] = i;
+    }
+    for (auto i : underfull) {
+        aliases_[i] = i;
+    }
+}
+
+auto AliasSampler_::operator()() -> std::size_t
+{
+    return (*this)(prng_);
+}
+
+auto AliasSampler_::operator()(ket::internal::Prng& prng) const -> std::size_t
+{
+    auto uniform_dist = uniform_dist_;
+
+    const auto size = thresholds_.size();
+    const auto position = uniform_dist(prng) * static_cast<double>(size);
+
+    // the product can round up to `size` when the uniform number is just below 1
+    const auto i_state = std::min(static_cast<std::size_t>(position), size - 1);
+    const auto fraction = position - static_cast<double>(i_state);
+
+    return fraction < thresholds_[i_state] ? i_state : aliases_[i_state];
+}
+
 }  // namespace ket::internal
@@ -1,15 +1,21 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <random>
+#include <utility>
 #include <vector>
 
+#include "kettle/state/statevector.hpp"
+#include "kettle_internal/common/prng.hpp"
+
 
 namespace ket::internal
 {
 
 constexpr inline auto CUMULATIVE_END_OFFSET_FRACTION = double {1.0e-4};
+constexpr inline auto BASIS_STATE_AMPLITUDE_TOLERANCE_SQ = double {1.0e-24};
 
 /*
     We want to avoid sampling entries beyond the end of the probability distribution,
@@ -24,6 +30,77 @@ auto calculate_cumulative_sum_(const std::vector<double>& probabilities) -> std:
 
 auto build_marginal_bitmask_(const std::vector<std::size_t>& marginal_qubits, std::size_t n_qubits) -> std::vector<std::uint8_t>;
 
+/*
+    Returns the index of the computational basis state that `state` is in, or `std::nullopt` if
+    the state has more than one nonzero amplitude.
+*/
+auto basis_state_index_(const ket::Statevector& state) -> std::optional<std::size_t>;
+
+/*
+    Create the computational basis state on the register made of only `kept_qubits`, where the qubit
+    at index `i` takes the value of the qubit at index `kept_qubits[i]` in the basis state `i_state`.
+*/
+auto gather_basis_state_(std::size_t i_state, const std::vector<std::size_t>& kept_qubits) -> ket::Statevector;
+
+/*
+    The inverse of the mapping in `gather_basis_state_()`; the bits of the state index `i_reduced`
+    on the register made of `kept_qubits` are moved to their positions in the full register. All
+    other bits are set to 0.
+*/
+auto scatter_state_index_(std::size_t i_reduced, const std::vector<std::size_t>& kept_qubits) -> std::size_t;
+
+/*
+    Draws the histogram of `n_shots` measurements from `probabilities` directly, by splitting the shots
+    with a binomial draw at each node of a binary tree over the state indices; the root splits on
+    the highest bit of the index, its children on the next bit, and so on.
+
+    The histogram has the same multinomial distribution as one made from `n_shots` separate samples,
+    but the cost is O(2^n) to build the tree plus one binomial draw per node with a nonzero number of
+    shots, independent of `n_shots`. The pairs of state index and count are returned in increasing
+    order of the index, and only for indices with a nonzero count.
+*/
+auto sample_multinomial_counts_(
+    const std::vector<double>& probabilities,
+    std::size_t n_shots,
+    ket::internal::Prng& prng
+) -> std::vector<std::pair<std::size_t, std::size_t>>;
+
+/*
+    Draws the counts of `n_shots` shots without building the cumulative distribution; `n_shots` sorted
+    uniform random numbers are generated, and a single sweep over the states finds the state whose
+    interval in the cumulative distribution holds each of them. The extra memory is O(n_shots), and
+    the probabilities do not need to be normalized.
+
+    The states are split into `n_threads` blocks; the total probability of each block is found first,
+    and then each block is swept on its own thread. The pairs of state index and count are returned
+    in increasing order of the index, and only for indices with a nonzero count.
+*/
+auto sample_streaming_counts_(
+    const std::vector<double>& probabilities,
+    std::size_t n_shots,
+    Prng& prng,
+    std::size_t n_threads = 1
+) -> std::vector<std::pair<std::size_t, std::size_t>>;
+
+/*
+    Same as above, where the probabilities are calculated from the amplitudes of `state` as they are needed.
+*/
+auto sample_streaming_counts_(
+    const ket::Statevector& state,
+    std::size_t n_shots,
+    Prng& prng,
+    std::size_t n_threads = 1
+) -> std::vector<std::pair<std::size_t, std::size_t>>;
+
+/*
+    Flips the bits of each of the `outcomes`, where bit `i` is flipped with probability `flip_probabilities[i]`,
+    independently for every bit and every outcome.
+
+    Rather than drawing a uniform random number for each bit of each outcome, the gaps between the outcomes
+    where a given bit is flipped are drawn from a geometric distribution, so only the flipped bits are visited.
+*/
+void flip_outcome_bits_(std::vector<std::size_t>& outcomes, const std::vector<double>& flip_probabilities, Prng& prng);
+
 class ProbabilitySampler_
 {
 public:
@@ -31,10 +108,39 @@ public:
 
     auto operator()() -> std::size_t;
 
+    /*
+        Draws a sample with the random numbers from `prng` instead of the sampler's own generator,
+        so that one sampler can be shared by several threads.
+    */
+    auto operator()(ket::internal::Prng& prng) const -> std::size_t;
+
 private:
     std::vector<double> cumulative_;
-    std::mt19937 prng_;
+    ket::internal::Prng prng_;
     std::uniform_real_distribution<double> uniform_dist_;
 };
 
+/*
+    Samples state indices with Walker's alias method, using Vose's construction of the tables.
+
+    Each index `i` holds a threshold and an alias; a single uniform number picks an index and a
+    position within it, and the sampler returns `i` if the position is below the threshold, and
+    the alias otherwise. Building the tables takes O(2^n) time, and each sample takes O(1) time.
+*/
+class AliasSampler_
+{
+public:
+    explicit AliasSampler_(const std::vector<double>& probabilities, std::optional<int> seed = std::nullopt);
+
+    auto operator()() -> std::size_t;
+
+    auto operator()(ket::internal::Prng& prng) const -> std::size_t;
+
+private:
+    std::vector<double> thresholds_;
+    std::vector<std::size_t> aliases_;
+    ket::internal::Prng prng_;
+    std::uniform_real_distribution<double> uniform_dist_ {0.0, 1.0};
+};
+
 }  // namespace ket::internal
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 #include <map>
@@ -8,8 +12,12 @@
 
 #include "kettle/calculations/probabilities.hpp"
 
+#include "kettle_internal/calculations/measurements_internal.hpp"
 #include "kettle_internal/calculations/probabilities_internal.hpp"
+#include "kettle_internal/common/mathtools_internal.hpp"
+#include "kettle_internal/common/threads.hpp"
 #include "kettle_internal/simulation/gate_pair_generator.hpp"
+#include "kettle_internal/state/marginal_internal.hpp"
 
 /*
     This file contains code components to calculate the probabilities of each of
@@ -21,9 +29,10 @@
 namespace ket
 {
 
-QuantumNoise::QuantumNoise(std::size_t n_qubits)
+QuantumNoise::QuantumNoise(std::size_t n_qubits, NoiseApplication application)
     : n_qubits_ {n_qubits}
     , noise_(n_qubits, 0.0)
+    , application_ {application}
 {}
 
 void QuantumNoise::set(std::size_t index, double noise)
@@ -102,6 +111,34 @@ auto calculate_probabilities(const Statevector& state, const QuantumNoise* noise
     return probabilities;
 }
 
+auto calculate_marginal_probabilities_raw(
+    const std::vector<double>& probabilities_raw,
+    const std::vector<std::size_t>& marginal_qubits,
+    std::size_t n_threads
+) -> std::vector<double>
+{
+    if (!ket::internal::is_power_of_2(probabilities_raw.size())) {
+        throw std::runtime_error {"The number of probabilities must be a power of 2.\n"};
+    }
+
+    const auto n_qubits = ket::internal::log_2_int(probabilities_raw.size());
+    const auto marginal_bitmask = ket::internal::build_marginal_bitmask_(marginal_qubits, n_qubits);
+    const auto measured_mask = ket::internal::measured_qubits_mask_(marginal_bitmask);
+
+    return ket::internal::marginalize_probabilities_(probabilities_raw, measured_mask, n_threads);
+}
+
+auto calculate_marginal_probabilities_raw(
+    const Statevector& state,
+    const std::vector<std::size_t>& marginal_qubits,
+    const QuantumNoise* noise,
+    std::size_t n_threads
+) -> std::vector<double>
+{
+    const auto probabilities_raw = calculate_probabilities_raw(state, noise);
+    return calculate_marginal_probabilities_raw(probabilities_raw, marginal_qubits, n_threads);
+}
+
 }  // namespace ket
 
 namespace ket::internal
@@ -135,4 +172,53 @@ void check_noise_value_(double value)
     }
 }
 
+auto marginalize_probabilities_(
+    const std::vector<double>& probabilities,
+    std::uint64_t measured_mask,
+    std::size_t n_threads
+) -> std::vector<double>
+{
+    const auto n_states = probabilities.size();
+    const auto n_marginal_states = std::size_t {1} << std::popcount(measured_mask);
+
+    if (n_marginal_states == n_states) {
+        return probabilities;
+    }
+
+    const auto accumulate = [&](std::size_t i_begin, std::size_t i_end, std::vector<double>& output) {
+        for (std::size_t i_state {i_begin}; i_state < i_end; ++i_state) {
+            output[compact_bits_(i_state, measured_mask)] += probabilities[i_state];
+        }
+    };
+
+    auto marginal_probabilities = std::vector<double>(n_marginal_states, 0.0);
+
+    n_threads = std::clamp(n_threads, std::size_t {1}, n_states);
+    if (n_threads == 1) {
+        accumulate(0, n_states, marginal_probabilities);
+        return marginal_probabilities;
+    }
+
+    // each thread reduces its own contiguous section of the states into a separate buffer, so that
+    // no synchronization is needed until the buffers are summed at the end
+    const auto section_size = (n_states + n_threads - 1) / n_threads;
+    auto partial_sums = std::vector<std::vector<double>>(n_threads - 1, std::vector<double>(n_marginal_states, 0.0));
+
+    run_in_parallel_(n_threads, [&](std::size_t i_thread) {
+        const auto i_begin = std::min(i_thread * section_size, n_states);
+        const auto i_end = std::min(i_begin + section_size, n_states);
+        auto& output = (i_thread == 0) ? marginal_probabilities : partial_sums[i_thread - 1];
+
+        accumulate(i_begin, i_end, output);
+    });
+
+    for (const auto& partial_sum : partial_sums) {
+        for (std::size_t i_marginal {0}; i_marginal < n_marginal_states; ++i_marginal) {
+            marginal_probabilities[i_marginal] += partial_sum[i_marginal];
+        }
+    }
+
+    return marginal_probabilities;
+}
+
 }  // namespace ket::internal
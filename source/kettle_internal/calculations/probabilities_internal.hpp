@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 
@@ -13,4 +15,15 @@ void apply_noise_(double noise, std::size_t i_qubit, std::size_t n_qubits, std::
 */
 void check_noise_value_(double value);
 
+/*
+    Sums the `probabilities` of all the states whose bits at the positions of the set bits of
+    `measured_mask` are the same; the entry at index `compact_bits_(i_state, measured_mask)` of the
+    result holds the sum for state `i_state`.
+*/
+auto marginalize_probabilities_(
+    const std::vector<double>& probabilities,
+    std::uint64_t measured_mask,
+    std::size_t n_threads
+) -> std::vector<double>;
+
 }  // namespace ket::internal
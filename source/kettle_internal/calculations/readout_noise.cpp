@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "kettle/calculations/readout_noise.hpp"
+
+#include "kettle_internal/calculations/measurements_internal.hpp"
+#include "kettle_internal/state/marginal_internal.hpp"
+
+namespace
+{
+
+constexpr auto NO_BLOCK_ = std::numeric_limits<std::size_t>::max();
+
+auto make_confusion_block_(std::vector<std::size_t> qubits, Eigen::MatrixXd confusion_matrix) -> ket::ReadoutConfusionBlock
+{
+    const auto decomposition = Eigen::FullPivLU<Eigen::MatrixXd> {confusion_matrix};
+    auto inverse = decomposition.isInvertible() ? Eigen::MatrixXd {decomposition.inverse()} : Eigen::MatrixXd {};
+
+    return {std::move(qubits), std::move(confusion_matrix), std::move(inverse)};
+}
+
+void check_readout_probability_(double value)
+{
+    if (value < 0.0 || value > 1.0) {
+        throw std::runtime_error {"ERROR: a readout error probability must lie in [0, 1].\n"};
+    }
+}
+
+/*
+    Multiplies each group of the 2^k entries of `values` that only differ in the bits at `bit_positions`
+    by `matrix`, in place, where bit `k` of the index of the matrix is the bit at `bit_positions[k]`;
+    this is one pass over `values`, regardless of the number of bits in the block.
+*/
+void apply_block_matrix_(
+    std::vector<double>& values,
+    const std::vector<std::size_t>& bit_positions,
+    const Eigen::MatrixXd& matrix
+)
+{
+    // a single bit is by far the most common block, and the pairs can be updated directly
+    if (bit_positions.size() == 1) {
+        const auto bit = std::size_t {1} << bit_positions[0];
+        const auto m00 = matrix(0, 0);
+        const auto m01 = matrix(0, 1);
+        const auto m10 = matrix(1, 0);
+        const auto m11 = matrix(1, 1);
+
+        for (std::size_t i0 {0}; i0 < values.size(); ++i0) {
+            if ((i0 & bit) != 0) {
+                continue;
+            }
+
+            const auto i1 = i0 | bit;
+            const auto value0 = values[i0];
+            const auto value1 = values[i1];
+
+            values[i0] = (m00 * value0) + (m01 * value1);
+            values[i1] = (m10 * value0) + (m11 * value1);
+        }
+
+        return;
+    }
+
+    const auto n_block_states = static_cast<std::size_t>(matrix.rows());
+
+    // the offset of each entry of a group from the first entry of the group
+    auto offsets = std::vector<std::size_t>(n_block_states, 0);
+    auto block_mask = std::uint64_t {0};
+    for (std::size_t k {0}; k < bit_positions.size(); ++k) {
+        block_mask |= std::uint64_t {1} << bit_positions[k];
+
+        for (std::size_t i_block_state {0}; i_block_state < n_block_states; ++i_block_state) {
+            if (((i_block_state >> k) & 1U) == 1U) {
+                offsets[i_block_state] |= std::size_t {1} << bit_positions[k];
+            }
+        }
+    }
+
+    const auto all_mask = static_cast<std::uint64_t>(values.size() - 1);
+    const auto rest_mask = all_mask & ~block_mask;
+    const auto n_groups = values.size() / n_block_states;
+
+    auto gathered = std::vector<double>(n_block_states);
+
+    for (std::size_t i_group {0}; i_group < n_groups; ++i_group) {
+        const auto i_first = static_cast<std::size_t>(ket::internal::expand_bits_(i_group, rest_mask));
+
+        for (std::size_t i_block_state {0}; i_block_state < n_block_states; ++i_block_state) {
+            gathered[i_block_state] = values[i_first + offsets[i_block_state]];
+        }
+
+        for (std::size_t i_row {0}; i_row < n_block_states; ++i_row) {
+            auto value = 0.0;
+            for (std::size_t i_col {0}; i_col < n_block_states; ++i_col) {
+                value += matrix(static_cast<Eigen::Index>(i_row), static_cast<Eigen::Index>(i_col)) * gathered[i_col];
+            }
+
+            values[i_first + offsets[i_row]] = value;
+        }
+    }
+}
+
+}  // namespace
+
+
+namespace ket
+{
+
+ReadoutNoiseModel::ReadoutNoiseModel(std::size_t n_qubits)
+    : n_qubits_ {n_qubits}
+    , block_of_qubit_(n_qubits, NO_BLOCK_)
+{}
+
+void ReadoutNoiseModel::set_qubit_error(std::size_t qubit, double prob_0_to_1, double prob_1_to_0)
+{
+    if (qubit >= n_qubits_) {
+        throw std::runtime_error {"ERROR: qubit index out of range for the ReadoutNoiseModel.\n"};
+    }
+
+    check_readout_probability_(prob_0_to_1);
+    check_readout_probability_(prob_1_to_0);
+
+    auto confusion_matrix = Eigen::MatrixXd {2, 2};
+    confusion_matrix << 1.0 - prob_0_to_1, prob_1_to_0,
+                        prob_0_to_1,       1.0 - prob_1_to_0;
+
+    auto block = make_confusion_block_({qubit}, std::move(confusion_matrix));
+
+    const auto i_block = block_of_qubit_[qubit];
+    if (i_block == NO_BLOCK_) {
+        add_block_(std::move(block));
+    }
+    else if (blocks_[i_block].qubits.size() == 1) {
+        blocks_[i_block] = std::move(block);
+    }
+    else {
+        throw std::runtime_error {"ERROR: the qubit already belongs to a block of correlated readout errors.\n"};
+    }
+}
+
+void ReadoutNoiseModel::add_correlated_block(
+    const std::vector<std::size_t>& qubits,
+    const Eigen::MatrixXd& confusion_matrix,
+    double tolerance
+)
+{
+    if (qubits.empty()) {
+        throw std::runtime_error {"ERROR: a block of readout errors needs at least one qubit.\n"};
+    }
+
+    for (std::size_t i {0}; i < qubits.size(); ++i) {
+        if (qubits[i] >= n_qubits_) {
+            throw std::runtime_error {"ERROR: qubit index out of range for the ReadoutNoiseModel.\n"};
+        }
+
+        if (std::find(qubits.begin(), qubits.begin() + static_cast<std::ptrdiff_t>(i), qubits[i]) != qubits.begin() + static_cast<std::ptrdiff_t>(i)) {
+            throw std::runtime_error {"ERROR: a block of readout errors cannot contain the same qubit twice.\n"};
+        }
+
+        if (block_of_qubit_[qubits[i]] != NO_BLOCK_) {
+            throw std::runtime_error {"ERROR: the qubit already belongs to a block of readout errors.\n"};
+        }
+    }
+
+    const auto n_block_states = Eigen::Index {1} << qubits.size();
+    if (confusion_matrix.rows() != n_block_states || confusion_matrix.cols() != n_block_states) {
+        throw std::runtime_error {"ERROR: the confusion matrix of a block of k qubits must be 2^k x 2^k.\n"};
+    }
+
+    if ((confusion_matrix.array() < 0.0).any()) {
+        throw std::runtime_error {"ERROR: the entries of a confusion matrix cannot be negative.\n"};
+    }
+
+    for (Eigen::Index i_col {0}; i_col < n_block_states; ++i_col) {
+        if (std::fabs(confusion_matrix.col(i_col).sum() - 1.0) > tolerance) {
+            throw std::runtime_error {"ERROR: each column of a confusion matrix must sum to 1.\n"};
+        }
+    }
+
+    add_block_(make_confusion_block_(qubits, confusion_matrix));
+}
+
+void ReadoutNoiseModel::add_block_(ReadoutConfusionBlock block)
+{
+    for (auto qubit : block.qubits) {
+        block_of_qubit_[qubit] = blocks_.size();
+    }
+
+    blocks_.push_back(std::move(block));
+}
+
+void apply_readout_noise(std::vector<double>& probabilities_raw, const ReadoutNoiseModel& model)
+{
+    if (probabilities_raw.size() != (std::size_t {1} << model.n_qubits())) {
+        throw std::runtime_error {"ERROR: the number of probabilities does not match the number of qubits of the ReadoutNoiseModel.\n"};
+    }
+
+    for (const auto& block : model.blocks()) {
+        apply_block_matrix_(probabilities_raw, block.qubits, block.confusion_matrix);
+    }
+}
+
+auto mitigate_readout_counts(
+    const std::vector<std::uint64_t>& dense_counts,
+    const ReadoutNoiseModel& model,
+    const std::vector<std::size_t>& marginal_qubits
+) -> std::vector<double>
+{
+    const auto marginal_bitmask = ket::internal::build_marginal_bitmask_(marginal_qubits, model.n_qubits());
+    const auto measured_mask = ket::internal::measured_qubits_mask_(marginal_bitmask);
+
+    if (dense_counts.size() != (std::size_t {1} << std::popcount(measured_mask))) {
+        throw std::runtime_error {"ERROR: the number of dense counts does not match the number of measured qubits.\n"};
+    }
+
+    // the position of the bit of each measured qubit in the index of the dense counts
+    auto bit_position_of_qubit = std::vector<std::size_t>(model.n_qubits(), 0);
+    auto n_measured = std::size_t {0};
+    for (std::size_t i_qubit {0}; i_qubit < model.n_qubits(); ++i_qubit) {
+        if (marginal_bitmask[i_qubit] == 0) {
+            bit_position_of_qubit[i_qubit] = n_measured;
+            ++n_measured;
+        }
+    }
+
+    auto mitigated = std::vector<double>(dense_counts.begin(), dense_counts.end());
+
+    for (const auto& block : model.blocks()) {
+        const auto is_marginal = [&](auto qubit) { return marginal_bitmask[qubit] == 1; };
+        const auto n_marginal_in_block = static_cast<std::size_t>(std::ranges::count_if(block.qubits, is_marginal));
+
+        if (n_marginal_in_block == block.qubits.size()) {
+            continue;
+        }
+
+        if (n_marginal_in_block != 0) {
+            throw std::runtime_error {"ERROR: cannot mitigate a block of readout errors with both measured and marginal qubits.\n"};
+        }
+
+        if (block.inverse.size() == 0) {
+            throw std::runtime_error {"ERROR: cannot mitigate a block of readout errors with a singular confusion matrix.\n"};
+        }
+
+        auto bit_positions = std::vector<std::size_t> {};
+        bit_positions.reserve(block.qubits.size());
+        for (auto qubit : block.qubits) {
+            bit_positions.push_back(bit_position_of_qubit[qubit]);
+        }
+
+        apply_block_matrix_(mitigated, bit_positions, block.inverse);
+    }
+
+    return mitigated;
+}
+
+}  // namespace ket
@@ -653,7 +653,7 @@ template void QuantumCircuit::add_cp_gate<ControlAndTargetIndicesAndAnglesIList>
 void QuantumCircuit::add_u_gate(const Matrix2X2& gate, std::size_t target_index)
 {
     check_qubit_range_(target_index, "qubit", "U");
-    elements_.emplace_back(create::create_u_gate(target_index, ket::ClonePtr<Matrix2X2> {gate}));
+    elements_.emplace_back(create::create_u_gate(target_index, gate));
 }
 
 template <QubitIndices Container>
@@ -672,7 +672,7 @@ void QuantumCircuit::add_cu_gate(const Matrix2X2& gate, std::size_t control_inde
     check_qubit_range_(control_index, "control qubit", "CU");
     check_qubit_range_(target_index, "target qubit", "CU");
 
-    elements_.emplace_back(create::create_cu_gate(control_index, target_index, ket::ClonePtr<Matrix2X2> {gate}));
+    elements_.emplace_back(create::create_cu_gate(control_index, target_index, gate));
 }
 
 template <ControlAndTargetIndices Container>
@@ -0,0 +1,235 @@
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit/circuit_dag.hpp"
+#include "kettle/circuit/circuit_element.hpp"
+
+#include "kettle_internal/circuit/element_support.hpp"
+
+
+namespace
+{
+
+/*
+    The accesses made to a single classical bit since it was last written to.
+*/
+struct BitAccesses_
+{
+    std::optional<std::size_t> last_writer;
+    std::vector<std::size_t> readers;
+};
+
+void sort_and_remove_duplicates_(std::vector<std::size_t>& values)
+{
+    std::ranges::sort(values);
+    const auto [first, last] = std::ranges::unique(values);
+    values.erase(first, last);
+}
+
+/*
+    Returns the support of `element`; circuit loggers act on every qubit and write to every bit.
+*/
+auto node_support_(const ket::CircuitElement& element, std::size_t n_qubits, std::size_t n_bits) -> ket::internal::ElementSupport
+{
+    auto support = ket::internal::ElementSupport {};
+
+    if (element.is_circuit_logger()) {
+        for (std::size_t i {0}; i < n_qubits; ++i) {
+            support.qubits.push_back(i);
+        }
+        for (std::size_t i {0}; i < n_bits; ++i) {
+            support.bits_written.push_back(i);
+        }
+
+        return support;
+    }
+
+    ket::internal::collect_element_support(element, support);
+    sort_and_remove_duplicates_(support.qubits);
+    sort_and_remove_duplicates_(support.bits_read);
+    sort_and_remove_duplicates_(support.bits_written);
+
+    return support;
+}
+
+}  // namespace
+
+
+namespace ket
+{
+
+CircuitDAG::CircuitDAG(const QuantumCircuit& circuit)
+    : n_qubits_ {circuit.n_qubits()}
+    , n_bits_ {circuit.n_bits()}
+    , nodes_ {circuit.elements_}
+    , predecessors_(circuit.elements_.size())
+    , successors_(circuit.elements_.size())
+    , layer_indices_(circuit.elements_.size(), 0)
+    , parameter_data_ {circuit.parameter_data_}
+    , parameter_count_ {circuit.parameter_count_}
+{
+    auto last_on_qubit = std::vector<std::optional<std::size_t>>(n_qubits_);
+    auto bit_accesses = std::vector<BitAccesses_>(n_bits_);
+
+    for (std::size_t i_node {0}; i_node < nodes_.size(); ++i_node) {
+        const auto support = node_support_(nodes_[i_node], n_qubits_, n_bits_);
+        auto& preds = predecessors_[i_node];
+
+        for (auto qubit : support.qubits) {
+            if (last_on_qubit[qubit]) {
+                preds.push_back(*last_on_qubit[qubit]);
+            }
+            last_on_qubit[qubit] = i_node;
+        }
+
+        for (auto bit : support.bits_read) {
+            if (bit_accesses[bit].last_writer) {
+                preds.push_back(*bit_accesses[bit].last_writer);
+            }
+        }
+
+        for (auto bit : support.bits_written) {
+            auto& accesses = bit_accesses[bit];
+            if (accesses.last_writer) {
+                preds.push_back(*accesses.last_writer);
+            }
+            preds.insert(preds.end(), accesses.readers.begin(), accesses.readers.end());
+        }
+
+        // the reads are registered after the writes, so that a node that reads and writes the
+        // same bit does not become its own predecessor
+        for (auto bit : support.bits_written) {
+            bit_accesses[bit].last_writer = i_node;
+            bit_accesses[bit].readers.clear();
+        }
+
+        for (auto bit : support.bits_read) {
+            bit_accesses[bit].readers.push_back(i_node);
+        }
+
+        sort_and_remove_duplicates_(preds);
+        std::erase(preds, i_node);
+
+        for (auto pred : preds) {
+            successors_[pred].push_back(i_node);
+            layer_indices_[i_node] = std::max(layer_indices_[i_node], layer_indices_[pred] + 1);
+        }
+
+        depth_ = std::max(depth_, layer_indices_[i_node] + 1);
+    }
+}
+
+auto CircuitDAG::node(std::size_t index) const -> const CircuitElement&
+{
+    check_index_(index);
+    return nodes_[index];
+}
+
+auto CircuitDAG::predecessors(std::size_t index) const -> const std::vector<std::size_t>&
+{
+    check_index_(index);
+    return predecessors_[index];
+}
+
+auto CircuitDAG::successors(std::size_t index) const -> const std::vector<std::size_t>&
+{
+    check_index_(index);
+    return successors_[index];
+}
+
+auto CircuitDAG::layer_index(std::size_t index) const -> std::size_t
+{
+    check_index_(index);
+    return layer_indices_[index];
+}
+
+auto CircuitDAG::layers() const -> std::vector<std::vector<std::size_t>>
+{
+    auto output = std::vector<std::vector<std::size_t>>(depth_);
+    for (std::size_t i_node {0}; i_node < nodes_.size(); ++i_node) {
+        output[layer_indices_[i_node]].push_back(i_node);
+    }
+
+    return output;
+}
+
+auto CircuitDAG::depth() const noexcept -> std::size_t
+{
+    return depth_;
+}
+
+auto CircuitDAG::critical_path() const -> std::vector<std::size_t>
+{
+    if (nodes_.empty()) {
+        return {};
+    }
+
+    // start from the first node in the last layer, and walk backwards through the predecessors
+    // that are in the layer immediately before the current node
+    const auto last_it = std::ranges::find(layer_indices_, depth_ - 1);
+    auto current = static_cast<std::size_t>(std::distance(layer_indices_.begin(), last_it));
+
+    auto output = std::vector<std::size_t> {current};
+    while (layer_indices_[current] != 0) {
+        for (auto pred : predecessors_[current]) {
+            if (layer_indices_[pred] + 1 == layer_indices_[current]) {
+                current = pred;
+                break;
+            }
+        }
+        output.push_back(current);
+    }
+
+    std::ranges::reverse(output);
+
+    return output;
+}
+
+auto CircuitDAG::to_circuit() const -> QuantumCircuit
+{
+    auto order = std::vector<std::size_t>(nodes_.size());
+    for (std::size_t i {0}; i < order.size(); ++i) {
+        order[i] = i;
+    }
+
+    return create_circuit_(order);
+}
+
+auto CircuitDAG::to_layered_circuit() const -> QuantumCircuit
+{
+    auto order = std::vector<std::size_t> {};
+    order.reserve(nodes_.size());
+
+    for (const auto& layer : layers()) {
+        order.insert(order.end(), layer.begin(), layer.end());
+    }
+
+    return create_circuit_(order);
+}
+
+void CircuitDAG::check_index_(std::size_t index) const
+{
+    if (index >= nodes_.size()) {
+        throw std::runtime_error {"ERROR: the node index is out of range of the CircuitDAG.\n"};
+    }
+}
+
+auto CircuitDAG::create_circuit_(const std::vector<std::size_t>& order) const -> QuantumCircuit
+{
+    auto circuit = QuantumCircuit {n_qubits_, n_bits_};
+    circuit.parameter_data_ = parameter_data_;
+    circuit.parameter_count_ = parameter_count_;
+    circuit.elements_.reserve(order.size());
+
+    for (auto index : order) {
+        circuit.elements_.push_back(nodes_[index]);
+    }
+
+    return circuit;
+}
+
+}  // namespace ket
@@ -0,0 +1,59 @@
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit/circuit_element.hpp"
+#include "kettle/gates/primitive_gate.hpp"
+
+#include "kettle_internal/circuit/element_support.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_commute.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_create.hpp"
+
+namespace ket::internal
+{
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void collect_element_support(const ket::CircuitElement& element, ElementSupport& support)
+{
+    if (element.is_gate()) {
+        const auto& info = element.get_gate();
+        const auto qubits = ket::internal::commute::gate_qubit_indices(info);
+        support.qubits.insert(support.qubits.end(), qubits.begin(), qubits.end());
+
+        if (info.gate == ket::Gate::M) {
+            const auto [ignore, bit] = ket::internal::create::unpack_m_gate(info);
+            support.bits_written.push_back(bit);
+        }
+    }
+    else if (element.is_control_flow()) {
+        const auto& control_flow = element.get_control_flow();
+
+        if (control_flow.is_if_statement()) {
+            const auto& if_stmt = control_flow.get_if_statement();
+            const auto& bits = if_stmt.predicate().bit_indices_to_check();
+            support.bits_read.insert(support.bits_read.end(), bits.begin(), bits.end());
+            collect_support((*if_stmt.circuit()).circuit_elements(), support);
+        }
+        else if (control_flow.is_if_else_statement()) {
+            const auto& if_else_stmt = control_flow.get_if_else_statement();
+            const auto& bits = if_else_stmt.predicate().bit_indices_to_check();
+            support.bits_read.insert(support.bits_read.end(), bits.begin(), bits.end());
+            collect_support((*if_else_stmt.if_circuit()).circuit_elements(), support);
+            collect_support((*if_else_stmt.else_circuit()).circuit_elements(), support);
+        }
+        else {
+            throw std::runtime_error {"DEV ERROR: invalid control flow element found in `collect_element_support()`\n"};
+        }
+    }
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void collect_support(const std::vector<ket::CircuitElement>& elements, ElementSupport& support)
+{
+    for (const auto& element : elements) {
+        collect_element_support(element, support);
+    }
+}
+
+}  // namespace ket::internal
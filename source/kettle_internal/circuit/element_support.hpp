@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "kettle/circuit/circuit_element.hpp"
+
+namespace ket::internal
+{
+
+/*
+    The qubits and classical bits that a sequence of circuit elements depends on or modifies.
+
+    The indices are collected in the order they are found, and may contain duplicates.
+*/
+struct ElementSupport
+{
+    std::vector<std::size_t> qubits;
+    std::vector<std::size_t> bits_read;
+    std::vector<std::size_t> bits_written;
+};
+
+/*
+    Add the qubits and bits that `element` acts on to `support`; for control flow statements, this
+    includes the bits read by the predicate and everything inside of every branch.
+
+    Circuit loggers have no support.
+*/
+void collect_element_support(const ket::CircuitElement& element, ElementSupport& support);
+
+void collect_support(const std::vector<ket::CircuitElement>& elements, ElementSupport& support);
+
+}  // namespace ket::internal
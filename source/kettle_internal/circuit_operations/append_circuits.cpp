@@ -1,4 +1,7 @@
+#include <iterator>
 #include <stdexcept>
+#include <utility>
+
 #include "kettle/circuit/circuit.hpp"
 
 namespace
@@ -34,11 +37,42 @@ void extend_circuit(QuantumCircuit& left, const QuantumCircuit& right)
     left.parameter_data_.insert(right.parameter_data_.begin(), right.parameter_data_.end());
 }
 
+void extend_circuit(QuantumCircuit& left, QuantumCircuit&& right)
+{
+    check_matching_number_of_qubits_(left, right);
+    check_matching_number_of_bits_(left, right);
+
+    if (left.elements_.empty()) {
+        // nothing to keep on the left, so the storage of the right circuit can be taken as it is
+        left.elements_ = std::move(right.elements_);
+    }
+    else {
+        const auto n_new_elements = left.elements_.size() + right.elements_.size();
+        left.elements_.reserve(n_new_elements);
+        left.elements_.insert(
+            left.elements_.end(),
+            std::make_move_iterator(right.elements_.begin()),
+            std::make_move_iterator(right.elements_.end())
+        );
+    }
+
+    left.parameter_data_.merge(right.parameter_data_);
+
+    right.elements_.clear();
+    right.parameter_data_.clear();
+}
+
 auto append_circuits(QuantumCircuit left, const QuantumCircuit& right) -> QuantumCircuit
 {
     extend_circuit(left, right);
     return left;
 }
 
+auto append_circuits(QuantumCircuit left, QuantumCircuit&& right) -> QuantumCircuit
+{
+    extend_circuit(left, std::move(right));
+    return left;
+}
+
 
 }  // namespace ket
@@ -3,7 +3,6 @@
 
 #include "kettle/circuit/circuit.hpp"
 #include "kettle/circuit_operations/compare_circuits.hpp"
-#include "kettle/common/clone_ptr.hpp"
 #include "kettle/common/matrix2x2.hpp"
 #include "kettle/gates/common_u_gates.hpp"
 #include "kettle/gates/primitive_gate.hpp"
@@ -28,8 +27,8 @@ auto non_u_gate_to_u_gate_(const kp::EvaluatedParameterDataMap& param_map, const
 
     if (ket::internal::gate_id::is_angle_transform_gate(info.gate)) {
         const auto angle = [&]() {
-            if (info.param_expression_ptr) {
-                return kpi::Evaluator{}.evaluate(*info.param_expression_ptr, param_map);
+            if (info.param_expression_ptr()) {
+                return kpi::Evaluator{}.evaluate(*info.param_expression_ptr(), param_map);
             } else {
                 return ket::internal::create::unpack_gate_angle(info);
             }
@@ -49,19 +48,18 @@ auto as_u_gate_(const kp::EvaluatedParameterDataMap& param_map, const ket::GateI
         return info;
     }
 
-    const auto u_gate = non_u_gate_to_u_gate_(param_map, info);
-    auto unitary = ket::ClonePtr<ket::Matrix2X2> {u_gate};
+    const auto unitary = non_u_gate_to_u_gate_(param_map, info);
 
     if (ket::internal::gate_id::is_single_qubit_transform_gate(info.gate) && info.gate != G::U) {
         const auto target = ket::internal::create::unpack_single_qubit_gate_index(info);
-        const auto u_gate_info = ket::internal::create::create_u_gate(target, std::move(unitary));
+        const auto u_gate_info = ket::internal::create::create_u_gate(target, unitary);
 
         return u_gate_info;
     }
 
     if (ket::internal::gate_id::is_double_qubit_transform_gate(info.gate) && info.gate != G::CU) {
         const auto [control, target] = ket::internal::create::unpack_double_qubit_gate_indices(info);
-        const auto u_gate_info = ket::internal::create::create_cu_gate(control, target, std::move(unitary));
+        const auto u_gate_info = ket::internal::create::create_cu_gate(control, target, unitary);
 
         return u_gate_info;
     }
@@ -199,7 +197,7 @@ auto almost_eq(  // NOLINT(misc-no-recursion, readability-function-cognitive-com
                     return false;
                 }
 
-                if (!almost_eq(*new_left_gate.unitary_ptr, *new_right_gate.unitary_ptr, tol_sq)) {
+                if (!almost_eq(*new_left_gate.unitary_ptr(), *new_right_gate.unitary_ptr(), tol_sq)) {
                     return false;
                 }
             }
@@ -0,0 +1,193 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit/circuit_element.hpp"
+#include "kettle/circuit_operations/lightcone.hpp"
+#include "kettle/circuit_operations/relabel_qubits.hpp"
+#include "kettle/gates/primitive_gate.hpp"
+
+#include "kettle_internal/circuit/element_support.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_commute.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_create.hpp"
+
+
+namespace
+{
+
+auto any_marked_(const std::vector<std::size_t>& indices, const std::vector<std::uint8_t>& marks) -> bool
+{
+    for (auto index : indices) {
+        if (marks[index] != 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void mark_all_(const std::vector<std::size_t>& indices, std::vector<std::uint8_t>& marks)
+{
+    for (auto index : indices) {
+        marks[index] = 1;
+    }
+}
+
+/*
+    Walk backwards through the top-level elements of `circuit`, tracking which qubits and bits can still
+    affect the observed qubits and bits; an element is kept if it touches any of them.
+
+    Returns a flag for each top-level element indicating if it is kept, and a flag for each qubit
+    indicating if it is in the lightcone.
+*/
+auto find_lightcone_(
+    const ket::QuantumCircuit& circuit,
+    const std::vector<std::size_t>& observed_qubits,
+    const std::vector<std::size_t>& observed_bits
+) -> std::tuple<std::vector<std::uint8_t>, std::vector<std::uint8_t>>
+{
+    auto relevant_qubits = std::vector<std::uint8_t>(circuit.n_qubits(), 0);
+    auto relevant_bits = std::vector<std::uint8_t>(circuit.n_bits(), 0);
+
+    for (auto qubit : observed_qubits) {
+        if (qubit >= circuit.n_qubits()) {
+            throw std::runtime_error {"ERROR: an observed qubit index is out of range of the circuit.\n"};
+        }
+        relevant_qubits[qubit] = 1;
+    }
+
+    for (auto bit : observed_bits) {
+        if (bit >= circuit.n_bits()) {
+            throw std::runtime_error {"ERROR: an observed bit index is out of range of the circuit.\n"};
+        }
+        relevant_bits[bit] = 1;
+    }
+
+    const auto& elements = circuit.circuit_elements();
+    auto is_kept = std::vector<std::uint8_t>(elements.size(), 0);
+
+    for (std::size_t i {elements.size()}; i > 0; --i) {
+        const auto& element = elements[i - 1];
+
+        if (element.is_circuit_logger()) {
+            is_kept[i - 1] = 1;
+        }
+        else if (element.is_gate() && element.get_gate().gate == ket::Gate::M) {
+            const auto [qubit, bit] = ket::internal::create::unpack_m_gate(element.get_gate());
+
+            if (relevant_qubits[qubit] != 0 || relevant_bits[bit] != 0) {
+                is_kept[i - 1] = 1;
+
+                // the measurement unconditionally overwrites the bit, so earlier writes no longer matter
+                relevant_bits[bit] = 0;
+                relevant_qubits[qubit] = 1;
+            }
+        }
+        else if (element.is_gate()) {
+            const auto qubits = ket::internal::commute::gate_qubit_indices(element.get_gate());
+
+            if (any_marked_(qubits, relevant_qubits)) {
+                is_kept[i - 1] = 1;
+                mark_all_(qubits, relevant_qubits);
+            }
+        }
+        else if (element.is_control_flow()) {
+            auto support = ket::internal::ElementSupport {};
+            ket::internal::collect_element_support(element, support);
+
+            // the statement might not execute, so any bits it writes to are not overwritten for certain
+            if (any_marked_(support.qubits, relevant_qubits) || any_marked_(support.bits_written, relevant_bits)) {
+                is_kept[i - 1] = 1;
+                mark_all_(support.qubits, relevant_qubits);
+                mark_all_(support.bits_read, relevant_bits);
+            }
+        }
+        else {
+            throw std::runtime_error {"DEV ERROR: invalid circuit element found in `find_lightcone_()`\n"};
+        }
+    }
+
+    return {std::move(is_kept), std::move(relevant_qubits)};
+}
+
+auto marked_indices_(const std::vector<std::uint8_t>& marks) -> std::vector<std::size_t>
+{
+    auto indices = std::vector<std::size_t> {};
+    for (std::size_t i {0}; i < marks.size(); ++i) {
+        if (marks[i] != 0) {
+            indices.push_back(i);
+        }
+    }
+
+    return indices;
+}
+
+}  // namespace
+
+
+namespace ket
+{
+
+auto lightcone_qubits(
+    const QuantumCircuit& circuit,
+    const std::vector<std::size_t>& observed_qubits,
+    const std::vector<std::size_t>& observed_bits
+) -> std::vector<std::size_t>
+{
+    const auto [ignore, relevant_qubits] = find_lightcone_(circuit, observed_qubits, observed_bits);
+    return marked_indices_(relevant_qubits);
+}
+
+auto prune_to_lightcone(
+    const QuantumCircuit& circuit,
+    const std::vector<std::size_t>& observed_qubits,
+    const std::vector<std::size_t>& observed_bits
+) -> QuantumCircuit
+{
+    const auto [is_kept, ignore] = find_lightcone_(circuit, observed_qubits, observed_bits);
+
+    auto new_circuit = QuantumCircuit {circuit.n_qubits(), circuit.n_bits()};
+    new_circuit.parameter_data_ = circuit.parameter_data_;
+    new_circuit.parameter_count_ = circuit.parameter_count_;
+
+    for (std::size_t i {0}; i < circuit.elements_.size(); ++i) {
+        if (is_kept[i] != 0) {
+            new_circuit.elements_.emplace_back(circuit.elements_[i]);
+        }
+    }
+
+    return new_circuit;
+}
+
+auto reduce_to_lightcone(
+    const QuantumCircuit& circuit,
+    const std::vector<std::size_t>& observed_qubits,
+    const std::vector<std::size_t>& observed_bits
+) -> LightconeCircuit
+{
+    auto kept_qubits = lightcone_qubits(circuit, observed_qubits, observed_bits);
+
+    if (kept_qubits.empty()) {
+        throw std::runtime_error {"ERROR: cannot reduce a circuit to an empty lightcone.\n"};
+    }
+
+    // qubits outside of the lightcone are given an out-of-range index; no kept element acts on them
+    const auto n_kept_qubits = kept_qubits.size();
+    auto new_qubit_indices = std::vector<std::size_t>(circuit.n_qubits(), n_kept_qubits);
+    for (std::size_t i {0}; i < n_kept_qubits; ++i) {
+        new_qubit_indices[kept_qubits[i]] = i;
+    }
+
+    const auto pruned = prune_to_lightcone(circuit, observed_qubits, observed_bits);
+
+    return {
+        .circuit=relabel_qubits(pruned, new_qubit_indices, n_kept_qubits),
+        .kept_qubits=std::move(kept_qubits)
+    };
+}
+
+}  // namespace ket
@@ -1,4 +1,5 @@
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "kettle/circuit/circuit.hpp"
@@ -54,10 +55,15 @@ auto make_binary_controlled_circuit_naive(
         const auto control = ket::internal::get_container_index(control_qubits, i);
         const auto n_iterations = 1UL << i;
 
-        for (std::size_t i_iter {0}; i_iter < n_iterations; ++i_iter) {
-            const auto controlled_subcircuit = make_controlled_circuit(subcircuit, n_new_qubits, control, mapped_qubits);
+        // the controlled subcircuit is the same for every iteration, so it is only created once,
+        // and moved into the new circuit on the last iteration
+        auto controlled_subcircuit = make_controlled_circuit(subcircuit, n_new_qubits, control, mapped_qubits);
+
+        for (std::size_t i_iter {0}; i_iter < n_iterations - 1; ++i_iter) {
             extend_circuit(new_circuit, controlled_subcircuit);
         }
+
+        extend_circuit(new_circuit, std::move(controlled_subcircuit));
     }
 
     return new_circuit;
@@ -95,8 +101,8 @@ auto make_binary_controlled_circuit_from_binary_powers(
         const auto control = ket::internal::get_container_index(control_qubits, i);
 
         const auto& subcircuit = subcircuit_powers[i];
-        const auto controlled_subcircuit = make_controlled_circuit(subcircuit, n_new_qubits, control, mapped_qubits);
-        extend_circuit(new_circuit, controlled_subcircuit);
+        auto controlled_subcircuit = make_controlled_circuit(subcircuit, n_new_qubits, control, mapped_qubits);
+        extend_circuit(new_circuit, std::move(controlled_subcircuit));
     }
 
     return new_circuit;
@@ -0,0 +1,405 @@
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <numbers>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit/control_flow.hpp"
+#include "kettle/circuit_operations/optimize_circuit.hpp"
+#include "kettle/common/clone_ptr.hpp"
+#include "kettle/gates/primitive_gate.hpp"
+#include "kettle/parameter/parameter_expression.hpp"
+
+#include "kettle_internal/gates/primitive_gate/gate_commute.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_create.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_id.hpp"
+
+
+namespace
+{
+
+namespace cmt = ket::internal::commute;
+namespace cre = ket::internal::create;
+namespace gid = ket::internal::gate_id;
+using G = ket::Gate;
+
+/*
+    Returns the gate that multiplies with `gate` to give the identity, if that gate is also a
+    primitive gate without an angle.
+*/
+auto inverse_gate_(ket::Gate gate) -> std::optional<ket::Gate>
+{
+    switch (gate) {
+        case G::H : case G::X : case G::Y : case G::Z :
+        case G::CH : case G::CX : case G::CY : case G::CZ : {
+            return gate;
+        }
+        case G::S : return G::SDAG;
+        case G::SDAG : return G::S;
+        case G::T : return G::TDAG;
+        case G::TDAG : return G::T;
+        case G::SX : return G::SXDAG;
+        case G::SXDAG : return G::SX;
+        case G::CS : return G::CSDAG;
+        case G::CSDAG : return G::CS;
+        case G::CT : return G::CTDAG;
+        case G::CTDAG : return G::CT;
+        case G::CSX : return G::CSXDAG;
+        case G::CSXDAG : return G::CSX;
+        default : {
+            return std::nullopt;
+        }
+    }
+}
+
+/*
+    Controlled gates that are diagonal on both qubits are unchanged when the control and target
+    qubits are swapped.
+*/
+auto is_symmetric_gate_(ket::Gate gate) -> bool
+{
+    return gate == G::CZ || gate == G::CS || gate == G::CSDAG || gate == G::CT || gate == G::CTDAG || gate == G::CP;
+}
+
+auto act_on_same_qubits_(const ket::GateInfo& left, const ket::GateInfo& right) -> bool
+{
+    if (gid::is_double_qubit_transform_gate(left.gate)) {
+        const auto [left_control, left_target] = cre::unpack_double_qubit_gate_indices(left);
+        const auto [right_control, right_target] = cre::unpack_double_qubit_gate_indices(right);
+
+        if (left_control == right_control && left_target == right_target) {
+            return true;
+        }
+
+        return is_symmetric_gate_(left.gate) && left_control == right_target && left_target == right_control;
+    }
+
+    return cre::unpack_single_qubit_gate_index(left) == cre::unpack_single_qubit_gate_index(right);
+}
+
+auto is_cancelling_pair_(const ket::GateInfo& earlier, const ket::GateInfo& later) -> bool
+{
+    const auto inverse = inverse_gate_(earlier.gate);
+    return inverse && *inverse == later.gate && act_on_same_qubits_(earlier, later);
+}
+
+auto is_mergeable_pair_(const ket::GateInfo& earlier, const ket::GateInfo& later) -> bool
+{
+    return gid::is_angle_transform_gate(earlier.gate) && earlier.gate == later.gate && act_on_same_qubits_(earlier, later);
+}
+
+auto angle_expression_(const ket::GateInfo& info) -> ket::param::ParameterExpression
+{
+    if (info.param_expression_ptr()) {
+        return *info.param_expression_ptr();
+    }
+
+    return ket::param::LiteralExpression {cre::unpack_gate_angle(info)};
+}
+
+/*
+    Create the rotation gate equal to applying `earlier` and then `later`.
+*/
+auto merge_rotations_(const ket::GateInfo& earlier, const ket::GateInfo& later) -> ket::GateInfo
+{
+    namespace kp = ket::param;
+
+    const auto is_parameterized = earlier.param_expression_ptr() != nullptr || later.param_expression_ptr() != nullptr;
+
+    if (gid::is_1t1a_gate(earlier.gate)) {
+        const auto target = cre::unpack_single_qubit_gate_index(earlier);
+
+        if (!is_parameterized) {
+            const auto angle = cre::unpack_gate_angle(earlier) + cre::unpack_gate_angle(later);
+            return cre::create_one_target_one_angle_gate(earlier.gate, target, angle);
+        }
+
+        auto expression = kp::BinaryExpression {
+            kp::BinaryOperation::ADD,
+            ket::ClonePtr<kp::ParameterExpression> {angle_expression_(earlier)},
+            ket::ClonePtr<kp::ParameterExpression> {angle_expression_(later)}
+        };
+
+        return cre::create_one_target_one_parameter_gate(earlier.gate, target, std::move(expression));
+    }
+    else {
+        const auto [control, target] = cre::unpack_double_qubit_gate_indices(earlier);
+
+        if (!is_parameterized) {
+            const auto angle = cre::unpack_gate_angle(earlier) + cre::unpack_gate_angle(later);
+            return cre::create_one_control_one_target_one_angle_gate(earlier.gate, control, target, angle);
+        }
+
+        auto expression = kp::BinaryExpression {
+            kp::BinaryOperation::ADD,
+            ket::ClonePtr<kp::ParameterExpression> {angle_expression_(earlier)},
+            ket::ClonePtr<kp::ParameterExpression> {angle_expression_(later)}
+        };
+
+        return cre::create_one_control_one_target_one_parameter_gate(earlier.gate, control, target, std::move(expression));
+    }
+}
+
+/*
+    Checks if a rotation gate with a fixed angle is exactly equal to the identity, including its phase.
+
+    The RX, RY, and RZ gates (and their controlled versions) have a period of 4pi, while the P and
+    CP gates have a period of 2pi.
+*/
+auto is_identity_rotation_(const ket::GateInfo& info, double angle_tolerance) -> bool
+{
+    if (!gid::is_angle_transform_gate(info.gate) || info.param_expression_ptr()) {
+        return false;
+    }
+
+    const auto period = (info.gate == G::P || info.gate == G::CP) ? 2.0 * std::numbers::pi : 4.0 * std::numbers::pi;
+
+    auto remainder = std::fmod(cre::unpack_gate_angle(info), period);
+    if (remainder < 0.0) {
+        remainder += period;
+    }
+
+    return remainder < angle_tolerance || period - remainder < angle_tolerance;
+}
+
+/*
+    Holds the gates of the current stretch of the circuit between two barriers (circuit loggers and
+    control flow statements), and performs the backwards search for each new gate.
+*/
+class PeepholeWindow_
+{
+public:
+    PeepholeWindow_(
+        std::size_t n_qubits,
+        std::size_t window_size,
+        double angle_tolerance,
+        ket::CircuitOptimizationStatistics& statistics
+    )
+        : window_size_ {window_size}
+        , angle_tolerance_ {angle_tolerance}
+        , statistics_ {statistics}
+        , qubit_history_(n_qubits)
+    {}
+
+    void add_gate(const ket::GateInfo& info)
+    {
+        ++statistics_.n_gates_before;
+
+        if (is_identity_rotation_(info, angle_tolerance_)) {
+            ++statistics_.n_identity_gates;
+            return;
+        }
+
+        if (combine_with_earlier_gate_(info)) {
+            return;
+        }
+
+        const auto new_index = gates_.size();
+        gates_.emplace_back(info);
+
+        for (auto qubit : cmt::gate_qubit_indices(info)) {
+            qubit_history_[qubit].push_back(new_index);
+        }
+    }
+
+    /*
+        Move all the remaining gates into `elements`, and start a new stretch of the circuit.
+    */
+    void flush(std::vector<ket::CircuitElement>& elements)
+    {
+        for (auto& gate : gates_) {
+            if (gate) {
+                elements.emplace_back(std::move(*gate));
+                ++statistics_.n_gates_after;
+            }
+        }
+
+        gates_.clear();
+        for (auto& history : qubit_history_) {
+            history.clear();
+        }
+    }
+
+private:
+    std::size_t window_size_;
+    double angle_tolerance_;
+    ket::CircuitOptimizationStatistics& statistics_;
+    std::vector<std::optional<ket::GateInfo>> gates_;
+    std::vector<std::vector<std::size_t>> qubit_history_;
+
+    /*
+        Returns the positions in `gates_` of the remaining earlier gates that act on at least one of the
+        qubits of `info`, from the most recent to the least recent.
+    */
+    [[nodiscard]]
+    auto earlier_gate_indices_(const ket::GateInfo& info) const -> std::vector<std::size_t>
+    {
+        const auto qubits = cmt::gate_qubit_indices(info);
+
+        auto cursors = std::vector<std::size_t> {};
+        cursors.reserve(qubits.size());
+        for (auto qubit : qubits) {
+            cursors.push_back(qubit_history_[qubit].size());
+        }
+
+        auto output = std::vector<std::size_t> {};
+
+        while (output.size() < window_size_) {
+            // find the most recent gate among all the qubit histories
+            auto latest = std::optional<std::size_t> {};
+            for (std::size_t i {0}; i < qubits.size(); ++i) {
+                if (cursors[i] != 0) {
+                    const auto candidate = qubit_history_[qubits[i]][cursors[i] - 1];
+                    if (!latest || candidate > *latest) {
+                        latest = candidate;
+                    }
+                }
+            }
+
+            if (!latest) {
+                break;
+            }
+
+            for (std::size_t i {0}; i < qubits.size(); ++i) {
+                if (cursors[i] != 0 && qubit_history_[qubits[i]][cursors[i] - 1] == *latest) {
+                    --cursors[i];
+                }
+            }
+
+            if (gates_[*latest]) {
+                output.push_back(*latest);
+            }
+        }
+
+        return output;
+    }
+
+    /*
+        Search backwards for a gate that `info` cancels or merges with; returns `true` if one is found,
+        in which case the earlier gate is updated in place and `info` should not be added.
+    */
+    auto combine_with_earlier_gate_(const ket::GateInfo& info) -> bool
+    {
+        if (info.gate == G::M) {
+            return false;
+        }
+
+        for (auto index : earlier_gate_indices_(info)) {
+            auto& earlier = gates_[index];
+
+            if (is_cancelling_pair_(*earlier, info)) {
+                earlier = std::nullopt;
+                statistics_.n_cancelled_gates += 2;
+                return true;
+            }
+
+            if (is_mergeable_pair_(*earlier, info)) {
+                auto merged = merge_rotations_(*earlier, info);
+                ++statistics_.n_merged_gates;
+
+                if (is_identity_rotation_(merged, angle_tolerance_)) {
+                    earlier = std::nullopt;
+                    ++statistics_.n_identity_gates;
+                }
+                else {
+                    earlier = std::move(merged);
+                }
+
+                return true;
+            }
+
+            if (!cmt::gates_commute(*earlier, info)) {
+                return false;
+            }
+        }
+
+        return false;
+    }
+};
+
+}  // namespace
+
+
+namespace ket
+{
+
+// NOLINTNEXTLINE(misc-no-recursion)
+auto optimize_circuit(
+    const QuantumCircuit& circuit,
+    CircuitOptimizationStatistics& statistics,
+    std::size_t window_size,
+    double angle_tolerance
+) -> QuantumCircuit
+{
+    auto new_circuit = QuantumCircuit {circuit.n_qubits(), circuit.n_bits()};
+    new_circuit.parameter_data_ = circuit.parameter_data_;
+    new_circuit.parameter_count_ = circuit.parameter_count_;
+
+    auto window = PeepholeWindow_ {circuit.n_qubits(), window_size, angle_tolerance, statistics};
+
+    for (const auto& circuit_element : circuit.elements_) {
+        if (circuit_element.is_circuit_logger()) {
+            window.flush(new_circuit.elements_);
+            new_circuit.elements_.emplace_back(circuit_element);
+        }
+        else if (circuit_element.is_control_flow()) {
+            window.flush(new_circuit.elements_);
+
+            const auto& control_flow = circuit_element.get_control_flow();
+
+            if (control_flow.is_if_statement()) {
+                const auto& if_stmt = control_flow.get_if_statement();
+                auto new_subcircuit = optimize_circuit(*if_stmt.circuit(), statistics, window_size, angle_tolerance);
+
+                auto cfi = ClassicalIfStatement {
+                    if_stmt.predicate(),
+                    std::make_unique<QuantumCircuit>(std::move(new_subcircuit))
+                };
+
+                new_circuit.elements_.emplace_back(std::move(cfi));
+            }
+            else if (control_flow.is_if_else_statement()) {
+                const auto& if_else_stmt = control_flow.get_if_else_statement();
+                auto new_if_subcircuit = optimize_circuit(*if_else_stmt.if_circuit(), statistics, window_size, angle_tolerance);
+                auto new_else_subcircuit = optimize_circuit(*if_else_stmt.else_circuit(), statistics, window_size, angle_tolerance);
+
+                auto cfi = ClassicalIfElseStatement {
+                    if_else_stmt.predicate(),
+                    std::make_unique<QuantumCircuit>(std::move(new_if_subcircuit)),
+                    std::make_unique<QuantumCircuit>(std::move(new_else_subcircuit))
+                };
+
+                new_circuit.elements_.emplace_back(std::move(cfi));
+            }
+            else {
+                throw std::runtime_error {"DEV ERROR: invalid control flow element found in `optimize_circuit()`\n"};
+            }
+        }
+        else if (circuit_element.is_gate()) {
+            window.add_gate(circuit_element.get_gate());
+        }
+        else {
+            throw std::runtime_error {"DEV ERROR: invalid circuit element found in `optimize_circuit()`\n"};
+        }
+    }
+
+    window.flush(new_circuit.elements_);
+
+    return new_circuit;
+}
+
+auto optimize_circuit(
+    const QuantumCircuit& circuit,
+    std::size_t window_size,
+    double angle_tolerance
+) -> QuantumCircuit
+{
+    auto statistics = CircuitOptimizationStatistics {};
+    return optimize_circuit(circuit, statistics, window_size, angle_tolerance);
+}
+
+}  // namespace ket
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit/control_flow.hpp"
+#include "kettle/circuit_operations/relabel_qubits.hpp"
+#include "kettle/gates/primitive_gate.hpp"
+
+#include "kettle_internal/gates/primitive_gate/gate_commute.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_create.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_id.hpp"
+
+
+namespace
+{
+
+void check_new_qubit_index_(std::size_t new_index, std::size_t new_n_qubits)
+{
+    if (new_index >= new_n_qubits) {
+        throw std::runtime_error {"ERROR: a qubit used by the circuit is relabelled to an out-of-range qubit index.\n"};
+    }
+}
+
+void check_relabelled_gate_(const ket::GateInfo& info, std::size_t new_n_qubits)
+{
+    namespace cre = ket::internal::create;
+    namespace gid = ket::internal::gate_id;
+
+    if (gid::is_double_qubit_transform_gate(info.gate)) {
+        const auto [control, target] = cre::unpack_double_qubit_gate_indices(info);
+        check_new_qubit_index_(control, new_n_qubits);
+        check_new_qubit_index_(target, new_n_qubits);
+
+        if (control == target) {
+            throw std::runtime_error {"ERROR: relabelling the qubits maps the control and target of a gate onto the same qubit.\n"};
+        }
+    }
+    else if (info.gate == ket::Gate::M) {
+        const auto [qubit, ignore] = cre::unpack_m_gate(info);
+        check_new_qubit_index_(qubit, new_n_qubits);
+    }
+    else {
+        check_new_qubit_index_(cre::unpack_single_qubit_gate_index(info), new_n_qubits);
+    }
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void add_qubit_gate_counts_(const ket::QuantumCircuit& circuit, std::vector<std::size_t>& counts)
+{
+    for (const auto& circuit_element : circuit) {
+        if (circuit_element.is_gate()) {
+            for (auto qubit : ket::internal::commute::gate_qubit_indices(circuit_element.get_gate())) {
+                ++counts[qubit];
+            }
+        }
+        else if (circuit_element.is_control_flow()) {
+            const auto& control_flow = circuit_element.get_control_flow();
+
+            if (control_flow.is_if_statement()) {
+                add_qubit_gate_counts_(*control_flow.get_if_statement().circuit(), counts);
+            }
+            else if (control_flow.is_if_else_statement()) {
+                const auto& if_else_stmt = control_flow.get_if_else_statement();
+                add_qubit_gate_counts_(*if_else_stmt.if_circuit(), counts);
+                add_qubit_gate_counts_(*if_else_stmt.else_circuit(), counts);
+            }
+            else {
+                throw std::runtime_error {"DEV ERROR: invalid control flow element found in `qubit_gate_counts()`\n"};
+            }
+        }
+    }
+}
+
+}  // namespace
+
+
+namespace ket
+{
+
+// NOLINTNEXTLINE(misc-no-recursion)
+auto relabel_qubits(
+    const QuantumCircuit& circuit,
+    const std::vector<std::size_t>& new_qubit_indices,
+    std::size_t new_n_qubits
+) -> QuantumCircuit
+{
+    if (new_qubit_indices.size() != circuit.n_qubits()) {
+        throw std::runtime_error {"ERROR: there must be exactly one new qubit index for each qubit in the circuit.\n"};
+    }
+
+    auto new_circuit = QuantumCircuit {new_n_qubits, circuit.n_bits()};
+    new_circuit.parameter_data_ = circuit.parameter_data_;
+    new_circuit.parameter_count_ = circuit.parameter_count_;
+    new_circuit.elements_.reserve(circuit.elements_.size());
+
+    for (const auto& circuit_element : circuit.elements_) {
+        if (circuit_element.is_circuit_logger()) {
+            new_circuit.elements_.emplace_back(circuit_element);
+        }
+        else if (circuit_element.is_control_flow()) {
+            const auto& control_flow = circuit_element.get_control_flow();
+
+            if (control_flow.is_if_statement()) {
+                const auto& if_stmt = control_flow.get_if_statement();
+                auto new_subcircuit = relabel_qubits(*if_stmt.circuit(), new_qubit_indices, new_n_qubits);
+
+                auto cfi = ClassicalIfStatement {
+                    if_stmt.predicate(),
+                    std::make_unique<QuantumCircuit>(std::move(new_subcircuit))
+                };
+
+                new_circuit.elements_.emplace_back(std::move(cfi));
+            }
+            else if (control_flow.is_if_else_statement()) {
+                const auto& if_else_stmt = control_flow.get_if_else_statement();
+                auto new_if_subcircuit = relabel_qubits(*if_else_stmt.if_circuit(), new_qubit_indices, new_n_qubits);
+                auto new_else_subcircuit = relabel_qubits(*if_else_stmt.else_circuit(), new_qubit_indices, new_n_qubits);
+
+                auto cfi = ClassicalIfElseStatement {
+                    if_else_stmt.predicate(),
+                    std::make_unique<QuantumCircuit>(std::move(new_if_subcircuit)),
+                    std::make_unique<QuantumCircuit>(std::move(new_else_subcircuit))
+                };
+
+                new_circuit.elements_.emplace_back(std::move(cfi));
+            }
+            else {
+                throw std::runtime_error {"DEV ERROR: invalid control flow element found in `relabel_qubits()`\n"};
+            }
+        }
+        else if (circuit_element.is_gate()) {
+            auto new_gate_info = ket::internal::create::relabel_qubit_indices(circuit_element.get_gate(), new_qubit_indices);
+            check_relabelled_gate_(new_gate_info, new_n_qubits);
+            new_circuit.elements_.emplace_back(std::move(new_gate_info));
+        }
+        else {
+            throw std::runtime_error {"DEV ERROR: invalid circuit element found in `relabel_qubits()`\n"};
+        }
+    }
+
+    return new_circuit;
+}
+
+auto qubit_gate_counts(const QuantumCircuit& circuit) -> std::vector<std::size_t>
+{
+    auto counts = std::vector<std::size_t>(circuit.n_qubits(), 0);
+    add_qubit_gate_counts_(circuit, counts);
+
+    return counts;
+}
+
+auto hot_qubit_permutation(const QuantumCircuit& circuit) -> std::vector<std::size_t>
+{
+    const auto counts = qubit_gate_counts(circuit);
+
+    auto qubits_by_activity = std::vector<std::size_t>(circuit.n_qubits());
+    for (std::size_t i {0}; i < qubits_by_activity.size(); ++i) {
+        qubits_by_activity[i] = i;
+    }
+
+    std::ranges::stable_sort(qubits_by_activity, [&](auto left, auto right) { return counts[left] > counts[right]; });
+
+    auto new_qubit_indices = std::vector<std::size_t>(circuit.n_qubits());
+    for (std::size_t new_index {0}; new_index < qubits_by_activity.size(); ++new_index) {
+        new_qubit_indices[qubits_by_activity[new_index]] = new_index;
+    }
+
+    return new_qubit_indices;
+}
+
+auto relabel_hot_qubits(const QuantumCircuit& circuit) -> RelabelledCircuit
+{
+    auto new_qubit_indices = hot_qubit_permutation(circuit);
+    auto new_circuit = relabel_qubits(circuit, new_qubit_indices, circuit.n_qubits());
+
+    return {.circuit=std::move(new_circuit), .new_qubit_indices=std::move(new_qubit_indices)};
+}
+
+}  // namespace ket
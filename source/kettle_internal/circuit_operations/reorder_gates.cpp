@@ -0,0 +1,279 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit/control_flow.hpp"
+#include "kettle/circuit_operations/reorder_gates.hpp"
+#include "kettle/gates/primitive_gate.hpp"
+
+#include "kettle_internal/gates/primitive_gate/gate_commute.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_create.hpp"
+
+
+namespace
+{
+
+namespace cmt = ket::internal::commute;
+namespace cre = ket::internal::create;
+
+/*
+    The gates most recently applied to a single qubit; the gates in `current` all act on the qubit
+    within the same commuting family, and the gates in `previous` form the group before them.
+*/
+struct QubitGroups_
+{
+    std::optional<cmt::QubitAction> action;
+    std::vector<std::size_t> current;
+    std::vector<std::size_t> previous;
+};
+
+/*
+    The dependency graph of a stretch of gates between two barriers.
+*/
+struct GateDependencies_
+{
+    std::vector<std::vector<std::size_t>> qubits;
+    std::vector<std::vector<std::size_t>> successors;
+    std::vector<std::size_t> n_predecessors;
+    std::vector<bool> is_diagonal;
+};
+
+auto build_dependencies_(
+    const std::vector<ket::GateInfo>& gates,
+    std::size_t n_qubits,
+    std::size_t n_bits
+) -> GateDependencies_
+{
+    auto output = GateDependencies_ {
+        .qubits=std::vector<std::vector<std::size_t>>(gates.size()),
+        .successors=std::vector<std::vector<std::size_t>>(gates.size()),
+        .n_predecessors=std::vector<std::size_t>(gates.size(), 0),
+        .is_diagonal=std::vector<bool>(gates.size(), false)
+    };
+
+    auto qubit_groups = std::vector<QubitGroups_>(n_qubits);
+    auto last_measurement_on_bit = std::vector<std::optional<std::size_t>>(n_bits);
+
+    for (std::size_t i {0}; i < gates.size(); ++i) {
+        const auto& info = gates[i];
+        output.qubits[i] = cmt::gate_qubit_indices(info);
+
+        auto predecessors = std::vector<std::size_t> {};
+        auto is_diagonal = true;
+
+        for (auto qubit : output.qubits[i]) {
+            const auto action = *cmt::qubit_action(info, qubit);
+            auto& groups = qubit_groups[qubit];
+
+            if (action != cmt::QubitAction::DIAGONAL) {
+                is_diagonal = false;
+            }
+
+            if (groups.action == action && action != cmt::QubitAction::GENERAL) {
+                // this gate commutes with the current group, but not the one before it
+                predecessors.insert(predecessors.end(), groups.previous.begin(), groups.previous.end());
+                groups.current.push_back(i);
+            }
+            else {
+                predecessors.insert(predecessors.end(), groups.current.begin(), groups.current.end());
+                groups.previous = std::move(groups.current);
+                groups.current = {i};
+                groups.action = action;
+            }
+        }
+
+        if (info.gate == ket::Gate::M) {
+            const auto [ignore, bit] = cre::unpack_m_gate(info);
+            if (last_measurement_on_bit[bit]) {
+                predecessors.push_back(*last_measurement_on_bit[bit]);
+            }
+            last_measurement_on_bit[bit] = i;
+        }
+
+        std::ranges::sort(predecessors);
+        const auto [first, last] = std::ranges::unique(predecessors);
+        predecessors.erase(first, last);
+
+        for (auto predecessor : predecessors) {
+            output.successors[predecessor].push_back(i);
+        }
+
+        output.n_predecessors[i] = predecessors.size();
+        output.is_diagonal[i] = is_diagonal;
+    }
+
+    return output;
+}
+
+/*
+    Returns how strongly the gate at `candidate` should be preferred to follow the gate at `previous`.
+*/
+auto schedule_priority_(
+    const GateDependencies_& dependencies,
+    std::size_t candidate,
+    std::size_t previous
+) -> int
+{
+    const auto& candidate_qubits = dependencies.qubits[candidate];
+    const auto& previous_qubits = dependencies.qubits[previous];
+
+    const auto is_on_previous_qubits = [&](std::size_t qubit) {
+        return std::ranges::find(previous_qubits, qubit) != previous_qubits.end();
+    };
+
+    if (std::ranges::all_of(candidate_qubits, is_on_previous_qubits)) {
+        return 3;
+    }
+
+    if (dependencies.is_diagonal[candidate] && dependencies.is_diagonal[previous]) {
+        return 2;
+    }
+
+    if (std::ranges::any_of(candidate_qubits, is_on_previous_qubits)) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/*
+    Returns the order in which the gates should be placed in the new circuit.
+*/
+auto schedule_gates_(
+    const std::vector<ket::GateInfo>& gates,
+    std::size_t n_qubits,
+    std::size_t n_bits
+) -> std::vector<std::size_t>
+{
+    auto dependencies = build_dependencies_(gates, n_qubits, n_bits);
+
+    auto ready = std::vector<std::size_t> {};
+    for (std::size_t i {0}; i < gates.size(); ++i) {
+        if (dependencies.n_predecessors[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    auto order = std::vector<std::size_t> {};
+    order.reserve(gates.size());
+
+    while (!ready.empty()) {
+        // the ready gates are kept sorted, so ties are broken by the original position of the gate
+        auto chosen = std::size_t {0};
+
+        if (!order.empty()) {
+            auto best_priority = -1;
+            for (std::size_t i {0}; i < ready.size(); ++i) {
+                const auto priority = schedule_priority_(dependencies, ready[i], order.back());
+                if (priority > best_priority) {
+                    best_priority = priority;
+                    chosen = i;
+                }
+            }
+        }
+
+        const auto gate_index = ready[chosen];
+        ready.erase(ready.begin() + static_cast<std::ptrdiff_t>(chosen));
+        order.push_back(gate_index);
+
+        for (auto successor : dependencies.successors[gate_index]) {
+            --dependencies.n_predecessors[successor];
+            if (dependencies.n_predecessors[successor] == 0) {
+                ready.insert(std::ranges::upper_bound(ready, successor), successor);
+            }
+        }
+    }
+
+    return order;
+}
+
+void flush_gates_(
+    std::vector<ket::GateInfo>& gates,
+    std::vector<ket::CircuitElement>& elements,
+    std::size_t n_qubits,
+    std::size_t n_bits
+)
+{
+    for (auto index : schedule_gates_(gates, n_qubits, n_bits)) {
+        elements.emplace_back(std::move(gates[index]));
+    }
+
+    gates.clear();
+}
+
+}  // namespace
+
+
+namespace ket
+{
+
+// NOLINTNEXTLINE(misc-no-recursion)
+auto reorder_commuting_gates(const QuantumCircuit& circuit) -> QuantumCircuit
+{
+    const auto n_qubits = circuit.n_qubits();
+    const auto n_bits = circuit.n_bits();
+
+    auto new_circuit = QuantumCircuit {n_qubits, n_bits};
+    new_circuit.parameter_data_ = circuit.parameter_data_;
+    new_circuit.parameter_count_ = circuit.parameter_count_;
+    new_circuit.elements_.reserve(circuit.elements_.size());
+
+    auto pending_gates = std::vector<GateInfo> {};
+
+    for (const auto& circuit_element : circuit.elements_) {
+        if (circuit_element.is_circuit_logger()) {
+            flush_gates_(pending_gates, new_circuit.elements_, n_qubits, n_bits);
+            new_circuit.elements_.emplace_back(circuit_element);
+        }
+        else if (circuit_element.is_control_flow()) {
+            flush_gates_(pending_gates, new_circuit.elements_, n_qubits, n_bits);
+
+            const auto& control_flow = circuit_element.get_control_flow();
+
+            if (control_flow.is_if_statement()) {
+                const auto& if_stmt = control_flow.get_if_statement();
+                auto new_subcircuit = reorder_commuting_gates(*if_stmt.circuit());
+
+                auto cfi = ClassicalIfStatement {
+                    if_stmt.predicate(),
+                    std::make_unique<QuantumCircuit>(std::move(new_subcircuit))
+                };
+
+                new_circuit.elements_.emplace_back(std::move(cfi));
+            }
+            else if (control_flow.is_if_else_statement()) {
+                const auto& if_else_stmt = control_flow.get_if_else_statement();
+                auto new_if_subcircuit = reorder_commuting_gates(*if_else_stmt.if_circuit());
+                auto new_else_subcircuit = reorder_commuting_gates(*if_else_stmt.else_circuit());
+
+                auto cfi = ClassicalIfElseStatement {
+                    if_else_stmt.predicate(),
+                    std::make_unique<QuantumCircuit>(std::move(new_if_subcircuit)),
+                    std::make_unique<QuantumCircuit>(std::move(new_else_subcircuit))
+                };
+
+                new_circuit.elements_.emplace_back(std::move(cfi));
+            }
+            else {
+                throw std::runtime_error {"DEV ERROR: invalid control flow element found in `reorder_commuting_gates()`\n"};
+            }
+        }
+        else if (circuit_element.is_gate()) {
+            pending_gates.push_back(circuit_element.get_gate());
+        }
+        else {
+            throw std::runtime_error {"DEV ERROR: invalid circuit element found in `reorder_commuting_gates()`\n"};
+        }
+    }
+
+    flush_gates_(pending_gates, new_circuit.elements_, n_qubits, n_bits);
+
+    return new_circuit;
+}
+
+}  // namespace ket
@@ -1,21 +1,85 @@
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <random>
+#include <type_traits>
+#include <vector>
 
+#include "kettle/common/random_engines.hpp"
 #include "kettle_internal/common/prng.hpp"
 
-namespace ket::internal
+namespace
+{
+
+auto random_seed_() -> std::uint32_t
 {
+    thread_local auto seeder = std::mt19937 {std::random_device {}()};
+    return static_cast<std::uint32_t>(seeder());
+}
 
-auto get_prng_(std::optional<int> seed) -> std::mt19937
+auto seed_value_(std::optional<int> seed) -> std::uint32_t
 {
     if (seed) {
-        const auto seed_val = static_cast<std::mt19937::result_type>(seed.value());
-        return std::mt19937 {seed_val};
+        return static_cast<std::uint32_t>(seed.value());
     }
     else {
-        auto device = std::random_device {};
-        return std::mt19937 {device()};
+        return random_seed_();
+    }
+}
+
+/*
+    The engines are split into streams in different ways; this is a template so that only the branch
+    for the chosen engine is instantiated.
+*/
+template <typename Engine>
+auto make_prng_streams_(std::uint32_t base_seed, std::size_t n_streams) -> std::vector<Engine>
+{
+    auto prngs = std::vector<Engine> {};
+    prngs.reserve(n_streams);
+
+    if constexpr (std::is_same_v<Engine, ket::Xoshiro256PlusPlus>) {
+        auto prng = Engine {base_seed};
+        for (std::size_t i_stream {0}; i_stream < n_streams; ++i_stream) {
+            prngs.push_back(prng);
+            prng.jump();
+        }
+    }
+    else if constexpr (std::is_same_v<Engine, ket::Philox4x32>) {
+        for (std::size_t i_stream {0}; i_stream < n_streams; ++i_stream) {
+            prngs.emplace_back(base_seed, i_stream);
+        }
+    }
+    else {
+        if (n_streams == 1) {
+            prngs.emplace_back(base_seed);
+            return prngs;
+        }
+
+        // mixing the index of the stream into the seed sequence gives generators with unrelated initial
+        // states, even for consecutive indices
+        for (std::size_t i_stream {0}; i_stream < n_streams; ++i_stream) {
+            auto sequence = std::seed_seq {base_seed, static_cast<std::uint32_t>(i_stream)};
+            prngs.emplace_back(sequence);
+        }
     }
+
+    return prngs;
+}
+
+}  // namespace
+
+
+namespace ket::internal
+{
+
+auto get_prng_(std::optional<int> seed) -> Prng
+{
+    return Prng {seed_value_(seed)};
+}
+
+auto get_prng_streams_(std::optional<int> seed, std::size_t n_streams) -> std::vector<Prng>
+{
+    return make_prng_streams_<Prng>(seed_value_(seed), n_streams);
 }
 
 }  // namespace ket::internal
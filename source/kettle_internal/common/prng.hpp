@@ -1,8 +1,12 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
 #include <optional>
 #include <random>
+#include <vector>
+
+#include "kettle/common/random_engines.hpp"
 
 /*
     This header file contains functions related to random number generation and sampling.
@@ -11,6 +15,20 @@
 namespace ket::internal
 {
 
+/*
+    The engine used for all of the random numbers drawn inside the library; it is chosen when the
+    library is built, with the `KETTLE_PRNG_ENGINE` CMake option.
+
+    The default of `std::mt19937` keeps the results for a given seed the same as in earlier versions.
+*/
+#if defined(KETTLE_PRNG_ENGINE_XOSHIRO256PP)
+using Prng = ket::Xoshiro256PlusPlus;
+#elif defined(KETTLE_PRNG_ENGINE_PHILOX4X32)
+using Prng = ket::Philox4x32;
+#else
+using Prng = std::mt19937;
+#endif
+
 /*
     A concept to mimic 'std::discrete_distribution'; namely, the type must produces random
     integers on the interval '[​0​, n)', where the probability of each individual integer 'i' is
@@ -21,7 +39,7 @@ namespace ket::internal
     to produce certain outcomes.
 */
 template <typename T>
-concept DiscreteDistribution = requires(T t, std::mt19937& prng)
+concept DiscreteDistribution = requires(T t, Prng& prng)
 {
     typename T::result_type;
     T {{0.0, 1.0}};
@@ -37,13 +55,29 @@ concept DiscreteDistribution = requires(T t, std::mt19937& prng)
     to produce certain outcomes.
 */
 template <typename T>
-concept UniformIntDistribution = requires(T t, std::mt19937& prng)
+concept UniformIntDistribution = requires(T t, Prng& prng)
 {
     typename T::result_type;
     T {0, 1};
     { t(prng) } -> std::integral;
 };
 
-auto get_prng_(std::optional<int> seed) -> std::mt19937;
+/*
+    Creates the engine for `seed`; without a seed, the seed is drawn from a generator that is seeded
+    from `std::random_device` once per thread, since opening the random device is slow.
+*/
+auto get_prng_(std::optional<int> seed) -> Prng;
+
+/*
+    Creates `n_streams` generators, each producing its own stream of random numbers, so that the
+    work done with them can be split across threads. The streams are derived from `seed` and the
+    index of each stream, so a given seed and number of streams always give the same generators:
+      - `std::mt19937`: the seed and the index are mixed in a `std::seed_seq`
+      - `Xoshiro256PlusPlus`: each stream starts 2^128 outputs after the previous one, with `jump()`
+      - `Philox4x32`: the index is used as the stream of the counter
+
+    A single stream is the same as the generator made by `get_prng_()`.
+*/
+auto get_prng_streams_(std::optional<int> seed, std::size_t n_streams) -> std::vector<Prng>;
 
 }  // namespace ket::internal
@@ -0,0 +1,153 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+#include "kettle/common/random_engines.hpp"
+
+namespace
+{
+
+auto splitmix64_(std::uint64_t& state) noexcept -> std::uint64_t
+{
+    state += 0x9e3779b97f4a7c15ULL;
+
+    auto output = state;
+    output = (output ^ (output >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    output = (output ^ (output >> 27U)) * 0x94d049bb133111ebULL;
+
+    return output ^ (output >> 31U);
+}
+
+constexpr auto PHILOX_MULTIPLIER_0 = std::uint64_t {0xd2511f53};
+constexpr auto PHILOX_MULTIPLIER_1 = std::uint64_t {0xcd9e8d57};
+constexpr auto PHILOX_WEYL_0 = std::uint32_t {0x9e3779b9};
+constexpr auto PHILOX_WEYL_1 = std::uint32_t {0xbb67ae85};
+constexpr auto PHILOX_N_ROUNDS = std::size_t {10};
+
+auto lower_32_bits_(std::uint64_t value) noexcept -> std::uint32_t
+{
+    return static_cast<std::uint32_t>(value & 0xffffffffULL);
+}
+
+auto upper_32_bits_(std::uint64_t value) noexcept -> std::uint32_t
+{
+    return static_cast<std::uint32_t>(value >> 32U);
+}
+
+}  // namespace
+
+
+namespace ket
+{
+
+Xoshiro256PlusPlus::Xoshiro256PlusPlus(std::uint64_t seed)
+    : state_ {}
+{
+    for (auto& word : state_) {
+        word = splitmix64_(seed);
+    }
+}
+
+Xoshiro256PlusPlus::Xoshiro256PlusPlus(const state_type& state)
+    : state_ {state}
+{
+    if (state_ == state_type {0, 0, 0, 0}) {
+        throw std::runtime_error {"ERROR: the state of a Xoshiro256PlusPlus engine cannot be all zeros.\n"};
+    }
+}
+
+void Xoshiro256PlusPlus::discard(std::uint64_t n_outputs) noexcept
+{
+    for (std::uint64_t i {0}; i < n_outputs; ++i) {
+        (*this)();
+    }
+}
+
+void Xoshiro256PlusPlus::jump() noexcept
+{
+    constexpr auto jump_polynomial = state_type {
+        0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+    };
+
+    auto jumped = state_type {0, 0, 0, 0};
+
+    for (auto word : jump_polynomial) {
+        for (unsigned int i_bit {0}; i_bit < 64; ++i_bit) {
+            if ((word & (std::uint64_t {1} << i_bit)) != 0) {
+                for (std::size_t i {0}; i < jumped.size(); ++i) {
+                    jumped[i] ^= state_[i];
+                }
+            }
+            (*this)();
+        }
+    }
+
+    state_ = jumped;
+}
+
+Philox4x32::Philox4x32(std::uint64_t seed, std::uint64_t stream) noexcept
+    : key_ {lower_32_bits_(seed), upper_32_bits_(seed)}
+    , stream_ {stream}
+{}
+
+void Philox4x32::discard(std::uint64_t n_outputs) noexcept
+{
+    const auto n_available = static_cast<std::uint64_t>(outputs_.size() - i_output_);
+    if (n_outputs < n_available) {
+        i_output_ += static_cast<std::size_t>(n_outputs);
+        return;
+    }
+
+    // skip all the whole blocks without computing them
+    n_outputs -= n_available;
+    i_block_ += n_outputs / outputs_.size();
+    i_output_ = outputs_.size();
+
+    const auto n_remaining = static_cast<std::size_t>(n_outputs % outputs_.size());
+    if (n_remaining != 0) {
+        refill_();
+        i_output_ = n_remaining;
+    }
+}
+
+auto Philox4x32::block(const counter_type& counter, const key_type& key) noexcept -> counter_type
+{
+    auto output = counter;
+    auto round_key = key;
+
+    for (std::size_t i_round {0}; i_round < PHILOX_N_ROUNDS; ++i_round) {
+        if (i_round != 0) {
+            round_key[0] += PHILOX_WEYL_0;
+            round_key[1] += PHILOX_WEYL_1;
+        }
+
+        const auto product0 = PHILOX_MULTIPLIER_0 * output[0];
+        const auto product1 = PHILOX_MULTIPLIER_1 * output[2];
+
+        output = counter_type {
+            upper_32_bits_(product1) ^ output[1] ^ round_key[0],
+            lower_32_bits_(product1),
+            upper_32_bits_(product0) ^ output[3] ^ round_key[1],
+            lower_32_bits_(product0)
+        };
+    }
+
+    return output;
+}
+
+void Philox4x32::refill_() noexcept
+{
+    const auto counter = counter_type {
+        lower_32_bits_(i_block_),
+        upper_32_bits_(i_block_),
+        lower_32_bits_(stream_),
+        upper_32_bits_(stream_)
+    };
+
+    outputs_ = block(counter, key_);
+    i_output_ = 0;
+    ++i_block_;
+}
+
+}  // namespace ket
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+    This header file contains the helpers shared by the parts of the library that spawn threads.
+
+    Only `std::thread` is used, since `std::jthread` is not available in every standard library
+    the library is built with.
+*/
+
+namespace ket::internal
+{
+
+/*
+    A `std::thread` that is joined when it goes out of scope, like a `std::jthread` without the
+    stop token; this way, a thread is never left running (or terminates the program) when the
+    scope that spawned it is left early by an exception.
+*/
+class JoiningThread
+{
+public:
+    template <typename Function>
+    explicit JoiningThread(Function&& function)
+        : thread_ {std::forward<Function>(function)}
+    {}
+
+    ~JoiningThread()
+    {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    JoiningThread(const JoiningThread& other) = delete;
+    JoiningThread(JoiningThread&& other) noexcept = default;
+    auto operator=(const JoiningThread& other) -> JoiningThread& = delete;
+    auto operator=(JoiningThread&& other) -> JoiningThread& = delete;
+
+private:
+    std::thread thread_;
+};
+
+/*
+    Calls `function(i_thread)` for each `i_thread` in `[0, n_threads)`, each on its own thread, and
+    rethrows the first exception thrown by any of them once they have all finished.
+
+    The calling thread does the work of thread 0 instead of waiting idle, so only `n_threads - 1`
+    threads are spawned; with a single thread (or zero, which is treated as one), none are.
+*/
+template <typename Function>
+void run_in_parallel_(std::size_t n_threads, const Function& function)
+{
+    if (n_threads <= 1) {
+        function(std::size_t {0});
+        return;
+    }
+
+    auto exceptions = std::vector<std::exception_ptr>(n_threads);
+
+    const auto run = [&](std::size_t i_thread) {
+        try {
+            function(i_thread);
+        }
+        catch (...) {
+            exceptions[i_thread] = std::current_exception();
+        }
+    };
+
+    {
+        auto threads = std::vector<JoiningThread> {};
+        threads.reserve(n_threads - 1);
+
+        for (std::size_t i_thread {1}; i_thread < n_threads; ++i_thread) {
+            threads.emplace_back([&run, i_thread]() { run(i_thread); });
+        }
+
+        run(0);
+    }
+
+    for (const auto& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+}  // namespace ket::internal
@@ -0,0 +1,182 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <variant>
+
+#include "kettle/common/matrix2x2.hpp"
+#include "kettle/gates/primitive_gate.hpp"
+#include "kettle/parameter/parameter_expression.hpp"
+
+
+namespace ket::internal
+{
+
+/*
+    The unitary matrix or parameter expression of a `GateInfo` instance, shared between all the copies
+    of that instance; the payload is never modified after it is created, so sharing it is safe.
+*/
+class GatePayload
+{
+public:
+    explicit GatePayload(Matrix2X2 unitary)
+        : value_ {unitary}
+    {}
+
+    explicit GatePayload(ket::param::ParameterExpression param_expression)
+        : value_ {std::move(param_expression)}
+    {}
+
+    [[nodiscard]]
+    auto unitary_ptr() const noexcept -> const Matrix2X2*
+    {
+        return std::get_if<Matrix2X2>(&value_);
+    }
+
+    [[nodiscard]]
+    auto param_expression_ptr() const noexcept -> const ket::param::ParameterExpression*
+    {
+        return std::get_if<ket::param::ParameterExpression>(&value_);
+    }
+
+    void acquire() const noexcept
+    {
+        ref_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*
+        Returns `true` if the last reference to the payload was released.
+    */
+    [[nodiscard]]
+    auto release() const noexcept -> bool
+    {
+        return ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+private:
+    std::variant<Matrix2X2, ket::param::ParameterExpression> value_;
+    mutable std::atomic<std::size_t> ref_count_ {1};
+};
+
+}  // namespace ket::internal
+
+
+namespace ket
+{
+
+static_assert(sizeof(GateInfo) <= 24, "GateInfo must fit in a 24-byte record");
+
+GateInfo::GateInfo(Gate gate_, std::uint32_t arg0_, std::uint32_t arg1_, double arg2_) noexcept
+    : gate {gate_}
+    , arg0 {arg0_}
+    , arg1 {arg1_}
+    , angle_ {arg2_}
+{}
+
+GateInfo::GateInfo(Gate gate_, std::uint32_t arg0_, std::uint32_t arg1_, Matrix2X2 unitary)
+    : gate {gate_}
+    , arg0 {arg0_}
+    , arg1 {arg1_}
+    , has_payload_ {true}
+    , payload_ {new ket::internal::GatePayload {unitary}}
+{}
+
+GateInfo::GateInfo(Gate gate_, std::uint32_t arg0_, std::uint32_t arg1_, ket::param::ParameterExpression param_expression)
+    : gate {gate_}
+    , arg0 {arg0_}
+    , arg1 {arg1_}
+    , has_payload_ {true}
+    , payload_ {new ket::internal::GatePayload {std::move(param_expression)}}
+{}
+
+GateInfo::~GateInfo()
+{
+    release_();
+}
+
+GateInfo::GateInfo(const GateInfo& other) noexcept
+    : gate {other.gate}
+    , arg0 {other.arg0}
+    , arg1 {other.arg1}
+    , has_payload_ {other.has_payload_}
+    , angle_ {0.0}
+{
+    if (has_payload_) {
+        payload_ = other.payload_;
+        payload_->acquire();
+    }
+    else {
+        angle_ = other.angle_;
+    }
+}
+
+GateInfo::GateInfo(GateInfo&& other) noexcept
+    : gate {other.gate}
+    , arg0 {other.arg0}
+    , arg1 {other.arg1}
+    , has_payload_ {other.has_payload_}
+    , angle_ {0.0}
+{
+    if (has_payload_) {
+        payload_ = other.payload_;
+        other.has_payload_ = false;
+        other.angle_ = 0.0;
+    }
+    else {
+        angle_ = other.angle_;
+    }
+}
+
+auto GateInfo::operator=(const GateInfo& other) noexcept -> GateInfo&
+{
+    if (this != &other) {
+        auto copy = GateInfo {other};
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+auto GateInfo::operator=(GateInfo&& other) noexcept -> GateInfo&
+{
+    if (this != &other) {
+        release_();
+
+        gate = other.gate;
+        arg0 = other.arg0;
+        arg1 = other.arg1;
+        has_payload_ = other.has_payload_;
+
+        if (has_payload_) {
+            payload_ = other.payload_;
+            other.has_payload_ = false;
+            other.angle_ = 0.0;
+        }
+        else {
+            angle_ = other.angle_;
+        }
+    }
+
+    return *this;
+}
+
+auto GateInfo::unitary_ptr() const noexcept -> const Matrix2X2*
+{
+    return has_payload_ ? payload_->unitary_ptr() : nullptr;
+}
+
+auto GateInfo::param_expression_ptr() const noexcept -> const ket::param::ParameterExpression*
+{
+    return has_payload_ ? payload_->param_expression_ptr() : nullptr;
+}
+
+void GateInfo::release_() noexcept
+{
+    if (has_payload_ && payload_->release()) {
+        delete payload_;  // NOLINT(cppcoreguidelines-owning-memory)
+    }
+
+    has_payload_ = false;
+}
+
+}  // namespace ket
@@ -0,0 +1,105 @@
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include "kettle/gates/primitive_gate.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_commute.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_create.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_id.hpp"
+
+namespace ket::internal::commute
+{
+
+namespace create = ket::internal::create;
+namespace gate_id = ket::internal::gate_id;
+
+auto target_action(ket::Gate gate) -> QubitAction
+{
+    using G = ket::Gate;
+
+    switch (gate) {
+        case G::Z : case G::S : case G::SDAG : case G::T : case G::TDAG : case G::RZ : case G::P :
+        case G::CZ : case G::CS : case G::CSDAG : case G::CT : case G::CTDAG : case G::CRZ : case G::CP : {
+            return QubitAction::DIAGONAL;
+        }
+        case G::X : case G::SX : case G::SXDAG : case G::RX :
+        case G::CX : case G::CSX : case G::CSXDAG : case G::CRX : {
+            return QubitAction::X_AXIS;
+        }
+        case G::Y : case G::RY : case G::CY : case G::CRY : {
+            return QubitAction::Y_AXIS;
+        }
+        default : {
+            return QubitAction::GENERAL;
+        }
+    }
+}
+
+auto qubit_action(const ket::GateInfo& info, std::size_t qubit) -> std::optional<QubitAction>
+{
+    if (gate_id::is_double_qubit_transform_gate(info.gate)) {
+        const auto [control, target] = create::unpack_double_qubit_gate_indices(info);
+        if (control == qubit) {
+            return QubitAction::DIAGONAL;
+        }
+        if (target == qubit) {
+            return target_action(info.gate);
+        }
+        return std::nullopt;
+    }
+
+    if (info.gate == ket::Gate::M) {
+        const auto [measured_qubit, ignore] = create::unpack_m_gate(info);
+        if (measured_qubit == qubit) {
+            return QubitAction::GENERAL;
+        }
+        return std::nullopt;
+    }
+
+    if (create::unpack_single_qubit_gate_index(info) == qubit) {
+        return target_action(info.gate);
+    }
+    return std::nullopt;
+}
+
+auto gate_qubit_indices(const ket::GateInfo& info) -> std::vector<std::size_t>
+{
+    if (gate_id::is_double_qubit_transform_gate(info.gate)) {
+        const auto [control, target] = create::unpack_double_qubit_gate_indices(info);
+        return {control, target};
+    }
+
+    if (info.gate == ket::Gate::M) {
+        const auto [qubit, ignore] = create::unpack_m_gate(info);
+        return {qubit};
+    }
+
+    return {create::unpack_single_qubit_gate_index(info)};
+}
+
+auto gates_commute(const ket::GateInfo& left, const ket::GateInfo& right) -> bool
+{
+    if (left.gate == ket::Gate::M && right.gate == ket::Gate::M) {
+        const auto [ignore0, left_bit] = create::unpack_m_gate(left);
+        const auto [ignore1, right_bit] = create::unpack_m_gate(right);
+        if (left_bit == right_bit) {
+            return false;
+        }
+    }
+
+    for (auto qubit : gate_qubit_indices(left)) {
+        const auto right_action = qubit_action(right, qubit);
+        if (!right_action) {
+            continue;
+        }
+
+        const auto left_action = qubit_action(left, qubit);
+        if (*left_action == QubitAction::GENERAL || *left_action != *right_action) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace ket::internal::commute
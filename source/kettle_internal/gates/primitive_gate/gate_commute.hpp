@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "kettle/gates/primitive_gate.hpp"
+
+namespace ket::internal::commute
+{
+
+/*
+    On each qubit it acts on, a gate is a linear combination of products of operators that all belong
+    to one of these commuting families. Two gates that act within the same family on every qubit they
+    share commute with each other.
+
+    The control qubit of a controlled gate is always acted on diagonally.
+*/
+enum class QubitAction : std::uint8_t
+{
+    DIAGONAL,
+    X_AXIS,
+    Y_AXIS,
+    GENERAL
+};
+
+/*
+    Returns how the gate acts on its target qubit.
+*/
+auto target_action(ket::Gate gate) -> QubitAction;
+
+/*
+    Returns how the gate acts on `qubit`, or `std::nullopt` if it does not act on `qubit`.
+*/
+auto qubit_action(const ket::GateInfo& info, std::size_t qubit) -> std::optional<QubitAction>;
+
+/*
+    Returns the indices of the qubits the gate acts on; the control qubit comes first for controlled gates.
+*/
+auto gate_qubit_indices(const ket::GateInfo& info) -> std::vector<std::size_t>;
+
+/*
+    Returns `true` if swapping the order of the two gates is guaranteed not to change the action of the
+    circuit. This is a sufficient condition, and not a necessary one; some pairs of gates commute even
+    though this function returns `false`.
+
+    Measurements do not commute with any gate that acts on the measured qubit, or with other measurements
+    that write to the same classical bit.
+*/
+auto gates_commute(const ket::GateInfo& left, const ket::GateInfo& right) -> bool;
+
+}  // namespace ket::internal::commute
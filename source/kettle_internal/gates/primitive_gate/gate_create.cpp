@@ -1,9 +1,12 @@
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
 #include <tuple>
+#include <utility>
+#include <vector>
 
-#include "kettle/common/clone_ptr.hpp"
 #include "kettle/common/matrix2x2.hpp"
 
 #include "kettle/gates/primitive_gate.hpp"
@@ -19,14 +22,21 @@ namespace ket::internal::create
 /*
     Parameters indicating to the developer that a given gate does not use a certain data member in
     a ket::GateInfo instance.
-
-    Note that DUMMY_ARG3 cannot be constexpr, because ClonePtr holds `std::unique_ptr<T>`, which is
-    not constexpr in C++20 (only in C++23).
 */
-constexpr inline auto DUMMY_ARG1 = std::size_t {0};
+constexpr inline auto DUMMY_ARG1 = std::uint32_t {0};
 constexpr inline auto DUMMY_ARG2 = double {0.0};
-const inline auto DUMMY_ARG3 = ket::ClonePtr<ket::Matrix2X2> {nullptr};
-const inline auto DUMMY_ARG4 = ket::ClonePtr<ket::param::ParameterExpression> {nullptr};
+
+/*
+    The qubit and bit indices are stored as 32-bit integers in a ket::GateInfo instance.
+*/
+auto as_index_arg_(std::size_t index) -> std::uint32_t
+{
+    if (index > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error {"ERROR: qubit and bit indices of a gate must fit in 32 bits.\n"};
+    }
+
+    return static_cast<std::uint32_t>(index);
+}
 
 /*
     Create a single-qubit gate with no parameters.
@@ -37,7 +47,7 @@ auto create_one_target_gate(ket::Gate gate, std::size_t target_index) -> ket::Ga
         throw std::runtime_error {"DEV ERROR: invalid one-target gate provided.\n"};
     }
 
-    return {.gate=gate, .arg0=target_index, .arg1=DUMMY_ARG1, .arg2=DUMMY_ARG2, .unitary_ptr=DUMMY_ARG3, .param_expression_ptr=DUMMY_ARG4};
+    return {gate, as_index_arg_(target_index), DUMMY_ARG1, DUMMY_ARG2};
 }
 
 /*
@@ -57,7 +67,7 @@ auto create_one_target_one_angle_gate(ket::Gate gate, std::size_t target_index,
         throw std::runtime_error {"DEV ERROR: invalid one-target-one-angle gate provided.\n"};
     }
 
-    return {.gate=gate, .arg0=target_index, .arg1=DUMMY_ARG1, .arg2=theta, .unitary_ptr=DUMMY_ARG3, .param_expression_ptr=DUMMY_ARG4};
+    return {gate, as_index_arg_(target_index), DUMMY_ARG1, theta};
 }
 
 /*
@@ -65,7 +75,7 @@ auto create_one_target_one_angle_gate(ket::Gate gate, std::size_t target_index,
 */
 auto unpack_one_target_one_angle_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, double>
 {
-    return {info.arg0, info.arg2};  // target index, angle
+    return {info.arg0, info.arg2()};  // target index, angle
 }
 
 /*
@@ -77,22 +87,15 @@ auto create_one_target_one_parameter_gate(ket::Gate gate, std::size_t target_ind
         throw std::runtime_error {"DEV ERROR: invalid one-target-one-angle gate provided.\n"};
     }
 
-    return {
-        .gate=gate,
-        .arg0=target_index,
-        .arg1=DUMMY_ARG1,
-        .arg2=DUMMY_ARG2,
-        .unitary_ptr=DUMMY_ARG3,
-        .param_expression_ptr=ket::ClonePtr {std::move(param_expression)}
-    };
+    return {gate, as_index_arg_(target_index), DUMMY_ARG1, std::move(param_expression)};
 }
 
 /*
     Returns the `{target_qubit, param_expression_ptr}` of a single-qubit gate with an angle parameter.
 */
-auto unpack_one_target_one_parameter_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, const ket::ClonePtr<ket::param::ParameterExpression>&>
+auto unpack_one_target_one_parameter_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, const ket::param::ParameterExpression*>
 {
-    return {info.arg0, info.param_expression_ptr};  // target index, param_expression_ptr
+    return {info.arg0, info.param_expression_ptr()};  // target index, param_expression_ptr
 }
 
 /*
@@ -104,7 +107,7 @@ auto create_one_control_one_target_gate(ket::Gate gate, std::size_t control_inde
         throw std::runtime_error {"DEV ERROR: invalid one-control-one-target gate provided.\n"};
     }
 
-    return {.gate=gate, .arg0=control_index, .arg1=target_index, .arg2=DUMMY_ARG2, .unitary_ptr=DUMMY_ARG3, .param_expression_ptr=DUMMY_ARG4};
+    return {gate, as_index_arg_(control_index), as_index_arg_(target_index), DUMMY_ARG2};
 }
 
 /*
@@ -124,7 +127,7 @@ auto create_one_control_one_target_one_angle_gate(ket::Gate gate, std::size_t co
         throw std::runtime_error {"DEV ERROR: invalid one-control-one-target-one-angle gate provided.\n"};
     }
 
-    return {.gate=gate, .arg0=control_index, .arg1=target_index, .arg2=theta, .unitary_ptr=DUMMY_ARG3, .param_expression_ptr=DUMMY_ARG4};
+    return {gate, as_index_arg_(control_index), as_index_arg_(target_index), theta};
 }
 
 /*
@@ -132,7 +135,7 @@ auto create_one_control_one_target_one_angle_gate(ket::Gate gate, std::size_t co
 */
 auto unpack_one_control_one_target_one_angle_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, std::size_t, double>
 {
-    return {info.arg0, info.arg1, info.arg2};  // control index, target index, angle
+    return {info.arg0, info.arg1, info.arg2()};  // control index, target index, angle
 }
 
 auto create_one_control_one_target_one_parameter_gate(
@@ -146,53 +149,46 @@ auto create_one_control_one_target_one_parameter_gate(
         throw std::runtime_error {"DEV ERROR: invalid one-control-one-target-one-angle gate provided.\n"};
     }
 
-    return {
-        .gate=gate,
-        .arg0=control_index,
-        .arg1=target_index,
-        .arg2=DUMMY_ARG2,
-        .unitary_ptr=DUMMY_ARG3,
-        .param_expression_ptr=ket::ClonePtr {std::move(param_expression)}
-    };
+    return {gate, as_index_arg_(control_index), as_index_arg_(target_index), std::move(param_expression)};
 }
 
-auto unpack_one_control_one_target_one_parameter_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, std::size_t, const ket::ClonePtr<ket::param::ParameterExpression>&>
+auto unpack_one_control_one_target_one_parameter_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, std::size_t, const ket::param::ParameterExpression*>
 {
-    return {info.arg0, info.arg1, info.param_expression_ptr};  // control index, target index, param_expression_ptr
+    return {info.arg0, info.arg1, info.param_expression_ptr()};  // control index, target index, param_expression_ptr
 }
 
 
 /*
     Create a U-gate, which applies the 2x2 unitary matrix `unitary` to the qubit at index `target_index`.
 */
-auto create_u_gate(std::size_t target_index, ket::ClonePtr<ket::Matrix2X2> unitary) -> ket::GateInfo
+auto create_u_gate(std::size_t target_index, const ket::Matrix2X2& unitary) -> ket::GateInfo
 {
-    return {.gate=ket::Gate::U, .arg0=target_index, .arg1=DUMMY_ARG1, .arg2=DUMMY_ARG2, .unitary_ptr=std::move(unitary), .param_expression_ptr=DUMMY_ARG4};
+    return {ket::Gate::U, as_index_arg_(target_index), DUMMY_ARG1, unitary};
 }
 
 /*
     Returns the `{target_qubit, unitary_ptr}` of a U-gate.
 */
-auto unpack_u_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, const ket::ClonePtr<ket::Matrix2X2>&>
+auto unpack_u_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, const ket::Matrix2X2*>
 {
-    return {info.arg0, info.unitary_ptr};  // target index, unitary_ptr
+    return {info.arg0, info.unitary_ptr()};  // target index, unitary_ptr
 }
 
 /*
     Create a CU-gate, which applies the 2x2 unitary matrix `unitary` to the qubit at index `target_index`,
     controlled by the qubit at index `control_index`.
 */
-auto create_cu_gate(std::size_t control_index, std::size_t target_index, ket::ClonePtr<ket::Matrix2X2> unitary) -> ket::GateInfo
+auto create_cu_gate(std::size_t control_index, std::size_t target_index, const ket::Matrix2X2& unitary) -> ket::GateInfo
 {
-    return {.gate=ket::Gate::CU, .arg0=control_index, .arg1=target_index, .arg2=DUMMY_ARG2, .unitary_ptr=std::move(unitary), .param_expression_ptr=DUMMY_ARG4};
+    return {ket::Gate::CU, as_index_arg_(control_index), as_index_arg_(target_index), unitary};
 }
 
 /*
     Returns the `{control_qubit, target_qubit, unitary_ptr}` of a CU-gate.
 */
-auto unpack_cu_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, std::size_t, const ket::ClonePtr<ket::Matrix2X2>&>
+auto unpack_cu_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, std::size_t, const ket::Matrix2X2*>
 {
-    return {info.arg0, info.arg1, info.unitary_ptr};  // control index, target index, unitary_ptr
+    return {info.arg0, info.arg1, info.unitary_ptr()};  // control index, target index, unitary_ptr
 }
 
 /*
@@ -200,7 +196,7 @@ auto unpack_cu_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, std::s
 */
 auto create_m_gate(std::size_t qubit_index, std::size_t bit_index) -> ket::GateInfo
 {
-    return {.gate=ket::Gate::M, .arg0=qubit_index, .arg1=bit_index, .arg2=DUMMY_ARG2, .unitary_ptr=DUMMY_ARG3, .param_expression_ptr=DUMMY_ARG4};
+    return {ket::Gate::M, as_index_arg_(qubit_index), as_index_arg_(bit_index), DUMMY_ARG2};
 }
 
 /*
@@ -232,15 +228,30 @@ auto unpack_double_qubit_gate_indices(const ket::GateInfo& info) -> std::tuple<s
 */
 auto unpack_gate_angle(const ket::GateInfo& info) -> double
 {
-    return info.arg2;  // angle
+    return info.arg2();  // angle
 }
 
 /*
     Returns the `unitary_ptr` of a U-gate or CU-gate.
 */
-auto unpack_unitary_matrix(const ket::GateInfo& info) -> const ket::ClonePtr<ket::Matrix2X2>&
+auto unpack_unitary_matrix(const ket::GateInfo& info) -> const ket::Matrix2X2*
 {
-    return info.unitary_ptr;  // unitary_ptr
+    return info.unitary_ptr();  // unitary_ptr
+}
+
+/*
+    Returns a copy of `info`, where each qubit index `i` the gate acts on is replaced by `new_qubit_indices[i]`.
+*/
+auto relabel_qubit_indices(const ket::GateInfo& info, const std::vector<std::size_t>& new_qubit_indices) -> ket::GateInfo
+{
+    auto new_info = info;
+    new_info.arg0 = as_index_arg_(new_qubit_indices[info.arg0]);  // target index, control index, or measured qubit index
+
+    if (gate_id::is_double_qubit_transform_gate(info.gate)) {
+        new_info.arg1 = as_index_arg_(new_qubit_indices[info.arg1]);  // target index
+    }
+
+    return new_info;
 }
 
 }  // namespace ket::internal::create
@@ -3,8 +3,8 @@
 #include <cmath>
 #include <cstddef>
 #include <tuple>
+#include <vector>
 
-#include "kettle/common/clone_ptr.hpp"
 #include "kettle/common/matrix2x2.hpp"
 #include "kettle/parameter/parameter_expression.hpp"
 
@@ -42,7 +42,7 @@ auto create_one_target_one_parameter_gate(ket::Gate gate, std::size_t target_ind
 /*
     Returns the `{target_qubit, param_expression_ptr}` of a single-qubit gate with an angle parameter.
 */
-auto unpack_one_target_one_parameter_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, const ket::ClonePtr<ket::param::ParameterExpression>&>;
+auto unpack_one_target_one_parameter_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, const ket::param::ParameterExpression*>;
 
 /*
     Create a controlled gate with no parameters.
@@ -73,28 +73,28 @@ auto create_one_control_one_target_one_parameter_gate(
 
 auto unpack_one_control_one_target_one_parameter_gate(
     const ket::GateInfo& info
-) -> std::tuple<std::size_t, std::size_t, const ket::ClonePtr<ket::param::ParameterExpression>&>;
+) -> std::tuple<std::size_t, std::size_t, const ket::param::ParameterExpression*>;
 
 /*
     Create a U-gate, which applies the 2x2 unitary matrix `unitary` to the qubit at index `target_index`.
 */
-auto create_u_gate(std::size_t target_index, ket::ClonePtr<ket::Matrix2X2> unitary) -> ket::GateInfo;
+auto create_u_gate(std::size_t target_index, const ket::Matrix2X2& unitary) -> ket::GateInfo;
 
 /*
     Returns the `{target_qubit, unitary_ptr}` of a U-gate.
 */
-auto unpack_u_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, const ket::ClonePtr<ket::Matrix2X2>&>;
+auto unpack_u_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, const ket::Matrix2X2*>;
 
 /*
     Create a CU-gate, which applies the 2x2 unitary matrix `unitary` to the qubit at index `target_index`,
     controlled by the qubit at index `control_index`.
 */
-auto create_cu_gate(std::size_t control_index, std::size_t target_index, ket::ClonePtr<ket::Matrix2X2> unitary) -> ket::GateInfo;
+auto create_cu_gate(std::size_t control_index, std::size_t target_index, const ket::Matrix2X2& unitary) -> ket::GateInfo;
 
 /*
     Returns the `{control_qubit, target_qubit, unitary_ptr}` of a CU-gate.
 */
-auto unpack_cu_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, std::size_t, const ket::ClonePtr<ket::Matrix2X2>&>;
+auto unpack_cu_gate(const ket::GateInfo& info) -> std::tuple<std::size_t, std::size_t, const ket::Matrix2X2*>;
 
 /*
     Create an M-gate, which measures the qubit at `qubit_index`, and stores the result at `bit_index`.
@@ -124,6 +124,14 @@ auto unpack_gate_angle(const ket::GateInfo& info) -> double;
 /*
     Returns the `unitary_ptr` of a U-gate or CU-gate.
 */
-auto unpack_unitary_matrix(const ket::GateInfo& info) -> const ket::ClonePtr<ket::Matrix2X2>&;
+auto unpack_unitary_matrix(const ket::GateInfo& info) -> const ket::Matrix2X2*;
+
+/*
+    Returns a copy of `info`, where each qubit index `i` the gate acts on is replaced by `new_qubit_indices[i]`.
+
+    The classical bit of an M-gate, the angle, the parameter expression and the unitary matrix are all
+    copied unchanged.
+*/
+auto relabel_qubit_indices(const ket::GateInfo& info, const std::vector<std::size_t>& new_qubit_indices) -> ket::GateInfo;
 
 }  // namespace ket::internal::create
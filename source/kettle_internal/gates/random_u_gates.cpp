@@ -3,14 +3,16 @@
 #include <random>
 
 #include "kettle/common/matrix2x2.hpp"
+#include "kettle/common/random_engines.hpp"
 #include "kettle/gates/random_u_gates.hpp"
 #include "kettle_internal/common/prng.hpp"
 
 
-namespace ket
+namespace
 {
 
-auto generate_random_unitary2x2(std::mt19937& prng) -> ket::Matrix2X2
+template <std::uniform_random_bit_generator Engine>
+auto generate_random_unitary2x2_(Engine& prng) -> ket::Matrix2X2
 {
     // NOTE: the variable names for the angles don't have any general meaning
     auto uniform = std::uniform_real_distribution<double> {0.0, 1.0};
@@ -35,6 +37,27 @@ auto generate_random_unitary2x2(std::mt19937& prng) -> ket::Matrix2X2
     return {.elem00=elem00, .elem01=elem01, .elem10=elem10, .elem11=elem11};
 }
 
+}  // namespace
+
+
+namespace ket
+{
+
+auto generate_random_unitary2x2(std::mt19937& prng) -> ket::Matrix2X2
+{
+    return generate_random_unitary2x2_(prng);
+}
+
+auto generate_random_unitary2x2(Xoshiro256PlusPlus& prng) -> ket::Matrix2X2
+{
+    return generate_random_unitary2x2_(prng);
+}
+
+auto generate_random_unitary2x2(Philox4x32& prng) -> ket::Matrix2X2
+{
+    return generate_random_unitary2x2_(prng);
+}
+
 auto generate_random_unitary2x2(int seed) -> ket::Matrix2X2
 {
     auto prng = ket::internal::get_prng_(seed);
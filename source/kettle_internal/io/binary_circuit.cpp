@@ -0,0 +1,754 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit/control_flow.hpp"
+#include "kettle/circuit/control_flow_predicate.hpp"
+#include "kettle/circuit_loggers/circuit_logger.hpp"
+#include "kettle/common/clone_ptr.hpp"
+#include "kettle/common/matrix2x2.hpp"
+#include "kettle/gates/primitive_gate.hpp"
+#include "kettle/io/binary_circuit.hpp"
+#include "kettle/io/read_tangelo_file.hpp"
+#include "kettle/parameter/parameter.hpp"
+#include "kettle/parameter/parameter_expression.hpp"
+
+#include "kettle_internal/gates/primitive_gate/gate_create.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_id.hpp"
+#include "kettle_internal/io/mapped_file.hpp"
+#include "kettle_internal/io/text_cursor.hpp"
+
+
+namespace
+{
+
+namespace cre = ket::internal::create;
+namespace gid = ket::internal::gate_id;
+namespace kp = ket::param;
+
+constexpr auto BINARY_CIRCUIT_MAGIC = std::array<char, 8> {'K', 'E', 'T', 'C', 'I', 'R', 'C', '\0'};
+
+// the decoder is recursive, so the nesting in a file is capped to keep a corrupt file from overflowing the stack
+constexpr auto MAX_SUBCIRCUIT_DEPTH_ = std::size_t {256};
+constexpr auto MAX_EXPRESSION_DEPTH_ = std::size_t {1024};
+
+enum class ElementKind_ : std::uint8_t
+{
+    GATE,
+    IF_STATEMENT,
+    IF_ELSE_STATEMENT,
+    CLASSICAL_REGISTER_LOGGER,
+    STATEVECTOR_LOGGER,
+    DENSITY_MATRIX_LOGGER
+};
+
+enum class GatePayloadKind_ : std::uint8_t
+{
+    ANGLE,
+    UNITARY,
+    PARAMETER_EXPRESSION
+};
+
+enum class ExpressionKind_ : std::uint8_t
+{
+    PARAMETER,
+    LITERAL,
+    BINARY
+};
+
+[[noreturn]]
+void throw_invalid_file_(const char* reason)
+{
+    auto err_msg = std::stringstream {};
+    err_msg << "ERROR: invalid binary circuit file; " << reason << '\n';
+
+    throw std::runtime_error {err_msg.str()};
+}
+
+/*
+    Appends values to a byte buffer in little-endian order.
+*/
+class ByteWriter_
+{
+public:
+    void write_u8(std::uint8_t value)
+    {
+        buffer_.push_back(static_cast<char>(value));
+    }
+
+    void write_u32(std::uint32_t value)
+    {
+        for (std::size_t i {0}; i < 4; ++i) {
+            write_u8(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void write_u64(std::uint64_t value)
+    {
+        for (std::size_t i {0}; i < 8; ++i) {
+            write_u8(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void write_f64(double value)
+    {
+        write_u64(std::bit_cast<std::uint64_t>(value));
+    }
+
+    void write_complex(const std::complex<double>& value)
+    {
+        write_f64(value.real());
+        write_f64(value.imag());
+    }
+
+    void write_string(const std::string& value)
+    {
+        write_u64(value.size());
+        buffer_.append(value);
+    }
+
+    void write_raw(std::span<const char> values)
+    {
+        buffer_.append(values.begin(), values.end());
+    }
+
+    [[nodiscard]]
+    auto buffer() const noexcept -> const std::string&
+    {
+        return buffer_;
+    }
+
+private:
+    std::string buffer_;
+};
+
+/*
+    Reads values in little-endian order from a span of bytes, throwing if the span is too short.
+*/
+class ByteReader_
+{
+public:
+    explicit ByteReader_(std::span<const std::byte> bytes)
+        : bytes_ {bytes}
+    {}
+
+    auto read_u8() -> std::uint8_t
+    {
+        check_remaining_(1);
+        return std::to_integer<std::uint8_t>(bytes_[position_++]);
+    }
+
+    auto read_u32() -> std::uint32_t
+    {
+        check_remaining_(4);
+
+        auto value = std::uint32_t {0};
+        for (std::size_t i {0}; i < 4; ++i) {
+            value |= std::to_integer<std::uint32_t>(bytes_[position_++]) << (8 * i);
+        }
+
+        return value;
+    }
+
+    auto read_u64() -> std::uint64_t
+    {
+        check_remaining_(8);
+
+        auto value = std::uint64_t {0};
+        for (std::size_t i {0}; i < 8; ++i) {
+            value |= std::to_integer<std::uint64_t>(bytes_[position_++]) << (8 * i);
+        }
+
+        return value;
+    }
+
+    auto read_f64() -> double
+    {
+        return std::bit_cast<double>(read_u64());
+    }
+
+    auto read_complex() -> std::complex<double>
+    {
+        const auto real = read_f64();
+        const auto imag = read_f64();
+
+        return {real, imag};
+    }
+
+    auto read_string() -> std::string
+    {
+        const auto size = read_size();
+        check_remaining_(size);
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        const auto* begin = reinterpret_cast<const char*>(bytes_.data() + position_);
+        position_ += size;
+
+        return {begin, size};
+    }
+
+    /*
+        Reads a 64-bit size; a size can never be larger than the number of bytes left in the file,
+        which protects against allocating huge containers for a corrupted file.
+    */
+    auto read_size() -> std::size_t
+    {
+        const auto size = read_u64();
+        if (size > bytes_.size() - position_) {
+            throw_invalid_file_("a size is larger than the rest of the file");
+        }
+
+        return static_cast<std::size_t>(size);
+    }
+
+    [[nodiscard]]
+    auto is_at_end() const noexcept -> bool
+    {
+        return position_ == bytes_.size();
+    }
+
+private:
+    std::span<const std::byte> bytes_;
+    std::size_t position_ {0};
+
+    void check_remaining_(std::size_t n_bytes) const
+    {
+        if (n_bytes > bytes_.size() - position_) {
+            throw_invalid_file_("the file ends unexpectedly");
+        }
+    }
+};
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void write_expression_(ByteWriter_& writer, const kp::ParameterExpression& expression)
+{
+    if (const auto* parameter = std::get_if<kp::Parameter>(&expression)) {
+        writer.write_u8(static_cast<std::uint8_t>(ExpressionKind_::PARAMETER));
+        writer.write_raw({reinterpret_cast<const char*>(parameter->id().data()), kp::PARAMETER_ID_SIZE});  // NOLINT(*reinterpret-cast*)
+        writer.write_string(parameter->name());
+    }
+    else if (const auto* literal = std::get_if<kp::LiteralExpression>(&expression)) {
+        writer.write_u8(static_cast<std::uint8_t>(ExpressionKind_::LITERAL));
+        writer.write_f64(literal->value);
+    }
+    else {
+        const auto& binary = std::get<kp::BinaryExpression>(expression);
+        writer.write_u8(static_cast<std::uint8_t>(ExpressionKind_::BINARY));
+        writer.write_u8(static_cast<std::uint8_t>(binary.operation));
+        write_expression_(writer, *binary.left);
+        write_expression_(writer, *binary.right);
+    }
+}
+
+auto read_parameter_id_(ByteReader_& reader) -> kp::ParameterID
+{
+    auto id = kp::ParameterID {};
+    for (auto& byte : id) {
+        byte = reader.read_u8();
+    }
+
+    return id;
+}
+
+/*
+    Reads a parameter expression, whose parameters must all be among the `parameters` of the circuit.
+*/
+// NOLINTNEXTLINE(misc-no-recursion)
+auto read_expression_(
+    ByteReader_& reader,
+    const kp::ParameterDataMap& parameters,
+    std::size_t depth = 0
+) -> kp::ParameterExpression
+{
+    if (depth >= MAX_EXPRESSION_DEPTH_) {
+        throw_invalid_file_("the parameter expressions are nested too deeply");
+    }
+
+    const auto kind = static_cast<ExpressionKind_>(reader.read_u8());
+
+    if (kind == ExpressionKind_::PARAMETER) {
+        const auto id = read_parameter_id_(reader);
+        auto name = reader.read_string();
+
+        if (!parameters.contains(id)) {
+            throw_invalid_file_("a parameter expression refers to a parameter that is not in the circuit");
+        }
+
+        return kp::Parameter {std::move(name), id};
+    }
+    else if (kind == ExpressionKind_::LITERAL) {
+        return kp::LiteralExpression {reader.read_f64()};
+    }
+    else if (kind == ExpressionKind_::BINARY) {
+        const auto operation = static_cast<kp::BinaryOperation>(reader.read_u8());
+        if (operation != kp::BinaryOperation::ADD && operation != kp::BinaryOperation::MUL) {
+            throw_invalid_file_("unknown binary operation in a parameter expression");
+        }
+
+        auto left = read_expression_(reader, parameters, depth + 1);
+        auto right = read_expression_(reader, parameters, depth + 1);
+
+        return kp::BinaryExpression {
+            .operation=operation,
+            .left=ket::ClonePtr<kp::ParameterExpression> {std::move(left)},
+            .right=ket::ClonePtr<kp::ParameterExpression> {std::move(right)}
+        };
+    }
+    else {
+        throw_invalid_file_("unknown kind of parameter expression");
+    }
+}
+
+void write_gate_(ByteWriter_& writer, const ket::GateInfo& info)
+{
+    writer.write_u8(static_cast<std::uint8_t>(ElementKind_::GATE));
+    writer.write_u8(static_cast<std::uint8_t>(info.gate));
+    writer.write_u32(info.arg0);
+    writer.write_u32(info.arg1);
+
+    if (const auto* unitary = info.unitary_ptr()) {
+        writer.write_u8(static_cast<std::uint8_t>(GatePayloadKind_::UNITARY));
+        writer.write_complex(unitary->elem00);
+        writer.write_complex(unitary->elem01);
+        writer.write_complex(unitary->elem10);
+        writer.write_complex(unitary->elem11);
+    }
+    else if (const auto* expression = info.param_expression_ptr()) {
+        writer.write_u8(static_cast<std::uint8_t>(GatePayloadKind_::PARAMETER_EXPRESSION));
+        write_expression_(writer, *expression);
+    }
+    else {
+        writer.write_u8(static_cast<std::uint8_t>(GatePayloadKind_::ANGLE));
+        writer.write_f64(info.arg2());
+    }
+}
+
+auto read_gate_(
+    ByteReader_& reader,
+    std::size_t n_qubits,
+    std::size_t n_bits,
+    const kp::ParameterDataMap& parameters
+) -> ket::GateInfo
+{
+    const auto gate_value = reader.read_u8();
+    if (gate_value > static_cast<std::uint8_t>(ket::Gate::M)) {
+        throw_invalid_file_("unknown gate");
+    }
+
+    const auto gate = static_cast<ket::Gate>(gate_value);
+    const auto arg0 = std::size_t {reader.read_u32()};
+    const auto arg1 = std::size_t {reader.read_u32()};
+    const auto payload_kind = static_cast<GatePayloadKind_>(reader.read_u8());
+
+    const auto check_qubit = [&](std::size_t index) {
+        if (index >= n_qubits) {
+            throw_invalid_file_("a gate acts on a qubit outside of the circuit");
+        }
+    };
+
+    const auto read_unitary = [&]() {
+        if (payload_kind != GatePayloadKind_::UNITARY) {
+            throw_invalid_file_("a U-gate or CU-gate is missing its unitary matrix");
+        }
+
+        const auto elem00 = reader.read_complex();
+        const auto elem01 = reader.read_complex();
+        const auto elem10 = reader.read_complex();
+        const auto elem11 = reader.read_complex();
+
+        return ket::Matrix2X2 {.elem00=elem00, .elem01=elem01, .elem10=elem10, .elem11=elem11};
+    };
+
+    const auto check_no_payload = [&]() {
+        if (payload_kind != GatePayloadKind_::ANGLE) {
+            throw_invalid_file_("a gate without parameters holds a payload");
+        }
+        [[maybe_unused]] const auto ignore = reader.read_f64();
+    };
+
+    if (gate == ket::Gate::M) {
+        check_qubit(arg0);
+        if (arg1 >= n_bits) {
+            throw_invalid_file_("a measurement writes to a bit outside of the circuit");
+        }
+        check_no_payload();
+
+        return cre::create_m_gate(arg0, arg1);
+    }
+
+    if (gid::is_single_qubit_transform_gate(gate)) {
+        check_qubit(arg0);
+
+        if (gate == ket::Gate::U) {
+            return cre::create_u_gate(arg0, read_unitary());
+        }
+        else if (gid::is_one_target_one_angle_transform_gate(gate)) {
+            if (payload_kind == GatePayloadKind_::PARAMETER_EXPRESSION) {
+                return cre::create_one_target_one_parameter_gate(gate, arg0, read_expression_(reader, parameters));
+            }
+            else if (payload_kind == GatePayloadKind_::ANGLE) {
+                return cre::create_one_target_one_angle_gate(gate, arg0, reader.read_f64());
+            }
+            else {
+                throw_invalid_file_("a rotation gate holds a unitary matrix");
+            }
+        }
+        else {
+            check_no_payload();
+            return cre::create_one_target_gate(gate, arg0);
+        }
+    }
+
+    // the remaining gates are all double-qubit gates
+    check_qubit(arg0);
+    check_qubit(arg1);
+
+    if (gate == ket::Gate::CU) {
+        return cre::create_cu_gate(arg0, arg1, read_unitary());
+    }
+    else if (gid::is_one_control_one_target_one_angle_transform_gate(gate)) {
+        if (payload_kind == GatePayloadKind_::PARAMETER_EXPRESSION) {
+            return cre::create_one_control_one_target_one_parameter_gate(gate, arg0, arg1, read_expression_(reader, parameters));
+        }
+        else if (payload_kind == GatePayloadKind_::ANGLE) {
+            return cre::create_one_control_one_target_one_angle_gate(gate, arg0, arg1, reader.read_f64());
+        }
+        else {
+            throw_invalid_file_("a rotation gate holds a unitary matrix");
+        }
+    }
+    else {
+        check_no_payload();
+        return cre::create_one_control_one_target_gate(gate, arg0, arg1);
+    }
+}
+
+void write_predicate_(ByteWriter_& writer, const ket::ControlFlowPredicate& predicate)
+{
+    writer.write_u8(static_cast<std::uint8_t>(predicate.control_kind()));
+    writer.write_u64(predicate.bit_indices_to_check().size());
+
+    for (auto bit_index : predicate.bit_indices_to_check()) {
+        writer.write_u64(bit_index);
+    }
+
+    for (auto expected_bit : predicate.expected_bits()) {
+        writer.write_u8(static_cast<std::uint8_t>(expected_bit));
+    }
+}
+
+auto read_predicate_(ByteReader_& reader, std::size_t n_bits) -> ket::ControlFlowPredicate
+{
+    const auto control_kind = static_cast<ket::ControlFlowBooleanKind>(reader.read_u8());
+    if (control_kind != ket::ControlFlowBooleanKind::IF && control_kind != ket::ControlFlowBooleanKind::IF_NOT) {
+        throw_invalid_file_("unknown kind of control flow predicate");
+    }
+
+    const auto size = reader.read_size();
+
+    auto bit_indices = std::vector<std::size_t>(size);
+    for (auto& bit_index : bit_indices) {
+        bit_index = static_cast<std::size_t>(reader.read_u64());
+        if (bit_index >= n_bits) {
+            throw_invalid_file_("a control flow predicate checks a bit outside of the circuit");
+        }
+    }
+
+    auto expected_bits = std::vector<int>(size);
+    for (auto& expected_bit : expected_bits) {
+        expected_bit = static_cast<int>(reader.read_u8());
+    }
+
+    return {std::move(bit_indices), std::move(expected_bits), control_kind};
+}
+
+}  // namespace
+
+
+namespace ket::internal
+{
+
+/*
+    Encodes and decodes the contents of a `QuantumCircuit` in the binary circuit format; this
+    needs direct access to the elements and parameters of the circuit.
+*/
+class BinaryCircuitCodec
+{
+public:
+    // NOLINTNEXTLINE(misc-no-recursion)
+    static void write_circuit(ByteWriter_& writer, const QuantumCircuit& circuit)
+    {
+        writer.write_u64(circuit.n_qubits_);
+        writer.write_u64(circuit.n_bits_);
+        writer.write_u64(circuit.parameter_count_);
+
+        // the parameters are sorted by ID, so that saving the same circuit twice gives the same file
+        auto parameters = std::vector<const ket::param::ParameterDataMap::value_type*> {};
+        parameters.reserve(circuit.parameter_data_.size());
+        for (const auto& entry : circuit.parameter_data_) {
+            parameters.push_back(&entry);
+        }
+        std::ranges::sort(parameters, [](const auto* left, const auto* right) { return left->first < right->first; });
+
+        writer.write_u64(parameters.size());
+        for (const auto* entry : parameters) {
+            const auto& [id, data] = *entry;
+            writer.write_raw({reinterpret_cast<const char*>(id.data()), kp::PARAMETER_ID_SIZE});  // NOLINT(*reinterpret-cast*)
+            writer.write_string(data.name);
+            writer.write_u8(data.value.has_value() ? 1 : 0);
+            writer.write_f64(data.value.value_or(0.0));
+            writer.write_u64(data.count);
+        }
+
+        writer.write_u64(circuit.elements_.size());
+        for (const auto& element : circuit.elements_) {
+            write_element_(writer, element);
+        }
+    }
+
+    static auto read_circuit(ByteReader_& reader) -> QuantumCircuit
+    {
+        return read_circuit_(reader, nullptr, 0);
+    }
+
+private:
+    /*
+        Reads a circuit, or a subcircuit of a control flow statement in `parent`; the subcircuit is
+        simulated on the same state as its parent, so it cannot have more qubits or bits than it.
+    */
+    // NOLINTNEXTLINE(misc-no-recursion)
+    static auto read_circuit_(ByteReader_& reader, const QuantumCircuit* parent, std::size_t depth) -> QuantumCircuit
+    {
+        if (depth >= MAX_SUBCIRCUIT_DEPTH_) {
+            throw_invalid_file_("the control flow statements are nested too deeply");
+        }
+
+        const auto n_qubits = static_cast<std::size_t>(reader.read_u64());
+        const auto n_bits = static_cast<std::size_t>(reader.read_u64());
+
+        if (parent != nullptr && (n_qubits > parent->n_qubits_ || n_bits > parent->n_bits_)) {
+            throw_invalid_file_("a subcircuit has more qubits or bits than the circuit that holds it");
+        }
+
+        auto circuit = QuantumCircuit {n_qubits, n_bits};
+        circuit.parameter_count_ = static_cast<std::size_t>(reader.read_u64());
+
+        const auto n_parameters = reader.read_size();
+        for (std::size_t i {0}; i < n_parameters; ++i) {
+            const auto id = read_parameter_id_(reader);
+            auto name = reader.read_string();
+            const auto has_value = reader.read_u8() != 0;
+            const auto value = reader.read_f64();
+            const auto count = static_cast<std::size_t>(reader.read_u64());
+
+            auto data = ket::param::ParameterData {
+                .value=has_value ? std::optional<double> {value} : std::nullopt,
+                .name=std::move(name),
+                .count=count
+            };
+            circuit.parameter_data_.emplace(id, std::move(data));
+        }
+
+        const auto n_elements = reader.read_size();
+        circuit.elements_.reserve(n_elements);
+        for (std::size_t i {0}; i < n_elements; ++i) {
+            read_element_(reader, circuit, depth);
+        }
+
+        return circuit;
+    }
+
+    // NOLINTNEXTLINE(misc-no-recursion)
+    static void write_element_(ByteWriter_& writer, const CircuitElement& element)
+    {
+        if (element.is_gate()) {
+            write_gate_(writer, element.get_gate());
+        }
+        else if (element.is_control_flow()) {
+            const auto& control_flow = element.get_control_flow();
+
+            if (control_flow.is_if_statement()) {
+                const auto& if_stmt = control_flow.get_if_statement();
+                writer.write_u8(static_cast<std::uint8_t>(ElementKind_::IF_STATEMENT));
+                write_predicate_(writer, if_stmt.predicate());
+                write_circuit(writer, *if_stmt.circuit());
+            }
+            else if (control_flow.is_if_else_statement()) {
+                const auto& if_else_stmt = control_flow.get_if_else_statement();
+                writer.write_u8(static_cast<std::uint8_t>(ElementKind_::IF_ELSE_STATEMENT));
+                write_predicate_(writer, if_else_stmt.predicate());
+                write_circuit(writer, *if_else_stmt.if_circuit());
+                write_circuit(writer, *if_else_stmt.else_circuit());
+            }
+            else {
+                throw std::runtime_error {"DEV ERROR: invalid control flow element found in `save_binary_circuit()`\n"};
+            }
+        }
+        else if (element.is_circuit_logger()) {
+            const auto& logger = element.get_circuit_logger();
+
+            if (logger.is_classical_register_circuit_logger()) {
+                writer.write_u8(static_cast<std::uint8_t>(ElementKind_::CLASSICAL_REGISTER_LOGGER));
+            }
+            else if (logger.is_statevector_circuit_logger()) {
+                writer.write_u8(static_cast<std::uint8_t>(ElementKind_::STATEVECTOR_LOGGER));
+            }
+            else if (logger.is_density_matrix_circuit_logger()) {
+                writer.write_u8(static_cast<std::uint8_t>(ElementKind_::DENSITY_MATRIX_LOGGER));
+            }
+            else {
+                throw std::runtime_error {"DEV ERROR: invalid circuit logger found in `save_binary_circuit()`\n"};
+            }
+        }
+        else {
+            throw std::runtime_error {"DEV ERROR: invalid circuit element found in `save_binary_circuit()`\n"};
+        }
+    }
+
+    // NOLINTNEXTLINE(misc-no-recursion)
+    static void read_element_(ByteReader_& reader, QuantumCircuit& circuit, std::size_t depth)
+    {
+        const auto kind = static_cast<ElementKind_>(reader.read_u8());
+
+        switch (kind) {
+            case ElementKind_::GATE : {
+                circuit.elements_.emplace_back(read_gate_(reader, circuit.n_qubits_, circuit.n_bits_, circuit.parameter_data_));
+                break;
+            }
+            case ElementKind_::IF_STATEMENT : {
+                auto predicate = read_predicate_(reader, circuit.n_bits_);
+                auto subcircuit = read_circuit_(reader, &circuit, depth + 1);
+
+                circuit.elements_.emplace_back(ClassicalIfStatement {
+                    std::move(predicate),
+                    std::make_unique<QuantumCircuit>(std::move(subcircuit))
+                });
+                break;
+            }
+            case ElementKind_::IF_ELSE_STATEMENT : {
+                auto predicate = read_predicate_(reader, circuit.n_bits_);
+                auto if_subcircuit = read_circuit_(reader, &circuit, depth + 1);
+                auto else_subcircuit = read_circuit_(reader, &circuit, depth + 1);
+
+                circuit.elements_.emplace_back(ClassicalIfElseStatement {
+                    std::move(predicate),
+                    std::make_unique<QuantumCircuit>(std::move(if_subcircuit)),
+                    std::make_unique<QuantumCircuit>(std::move(else_subcircuit))
+                });
+                break;
+            }
+            case ElementKind_::CLASSICAL_REGISTER_LOGGER : {
+                circuit.elements_.emplace_back(ClassicalRegisterCircuitLogger {});
+                break;
+            }
+            case ElementKind_::STATEVECTOR_LOGGER : {
+                circuit.elements_.emplace_back(StatevectorCircuitLogger {});
+                break;
+            }
+            case ElementKind_::DENSITY_MATRIX_LOGGER : {
+                circuit.elements_.emplace_back(CircuitLogger {DensityMatrixCircuitLogger {}});
+                break;
+            }
+            default : {
+                throw_invalid_file_("unknown kind of circuit element");
+            }
+        }
+    }
+};
+
+}  // namespace ket::internal
+
+
+namespace ket
+{
+
+void save_binary_circuit(std::ostream& outstream, const QuantumCircuit& circuit)
+{
+    auto writer = ByteWriter_ {};
+    writer.write_raw(BINARY_CIRCUIT_MAGIC);
+    writer.write_u32(BINARY_CIRCUIT_FORMAT_VERSION);
+    ket::internal::BinaryCircuitCodec::write_circuit(writer, circuit);
+
+    const auto& buffer = writer.buffer();
+    outstream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+void save_binary_circuit(const std::filesystem::path& filepath, const QuantumCircuit& circuit)
+{
+    auto outstream = std::ofstream {filepath, std::ios::binary};
+
+    if (!outstream.is_open()) {
+        auto err_msg = std::stringstream {};
+        err_msg << "ERROR: unable to open file to save binary circuit: \n";
+        err_msg << "'" << filepath << "'\n";
+
+        throw std::ios::failure {err_msg.str()};
+    }
+
+    save_binary_circuit(outstream, circuit);
+}
+
+auto read_binary_circuit(std::span<const std::byte> bytes) -> QuantumCircuit
+{
+    auto reader = ByteReader_ {bytes};
+
+    for (auto character : BINARY_CIRCUIT_MAGIC) {
+        if (reader.read_u8() != static_cast<std::uint8_t>(character)) {
+            throw_invalid_file_("the file does not start with the binary circuit magic string");
+        }
+    }
+
+    if (reader.read_u32() != BINARY_CIRCUIT_FORMAT_VERSION) {
+        throw_invalid_file_("unsupported format version");
+    }
+
+    auto circuit = ket::internal::BinaryCircuitCodec::read_circuit(reader);
+
+    if (!reader.is_at_end()) {
+        throw_invalid_file_("unexpected data found after the circuit");
+    }
+
+    return circuit;
+}
+
+auto load_binary_circuit(std::istream& instream) -> QuantumCircuit
+{
+    // the format does not store the size of the circuit, so the whole stream belongs to it
+    const auto contents = ket::internal::read_all_text(instream);
+
+    return read_binary_circuit(std::as_bytes(std::span {contents}));
+}
+
+auto load_binary_circuit(const std::filesystem::path& filepath) -> QuantumCircuit
+{
+    const auto file = ket::internal::MappedFile {filepath};
+
+    return read_binary_circuit(file.bytes());
+}
+
+void convert_tangelo_to_binary_circuit(
+    std::size_t n_qubits,
+    const std::filesystem::path& tangelo_filepath,
+    std::size_t n_skip_lines,
+    const std::filesystem::path& binary_filepath
+)
+{
+    const auto circuit = read_tangelo_circuit(n_qubits, tangelo_filepath, n_skip_lines);
+    save_binary_circuit(binary_filepath, circuit);
+}
+
+}  // namespace ket
@@ -0,0 +1,523 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define KETTLE_HAS_PWRITE
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "kettle/common/mathtools.hpp"
+#include "kettle/io/binary_statevector.hpp"
+#include "kettle/state/endian.hpp"
+#include "kettle/state/statevector.hpp"
+
+#include "kettle_internal/common/threads.hpp"
+#include "kettle_internal/io/binary_statevector_internal.hpp"
+#include "kettle_internal/io/mapped_file.hpp"
+
+
+namespace
+{
+
+constexpr auto BINARY_STATEVECTOR_MAGIC = std::array<char, 8> {'K', 'E', 'T', 'S', 'T', 'A', 'T', '\0'};
+
+constexpr auto BYTES_PER_AMPLITUDE = std::size_t {16};
+
+// the amplitudes are encoded into a buffer of this many amplitudes (1 MiB) before each write
+constexpr auto AMPLITUDES_PER_BLOCK = std::size_t {1} << 16;
+
+[[noreturn]]
+void throw_invalid_file_(const char* reason)
+{
+    auto err_msg = std::stringstream {};
+    err_msg << "ERROR: invalid binary statevector file; " << reason << '\n';
+
+    throw std::runtime_error {err_msg.str()};
+}
+
+[[noreturn]]
+void throw_unable_to_write_(const std::filesystem::path& filepath)
+{
+    auto err_msg = std::stringstream {};
+    err_msg << "ERROR: unable to open file to save binary statevector: \n";
+    err_msg << "'" << filepath << "'\n";
+
+    throw std::ios::failure {err_msg.str()};
+}
+
+void store_u32_(std::byte* output, std::uint32_t value)
+{
+    for (std::size_t i {0}; i < 4; ++i) {
+        output[i] = static_cast<std::byte>(value >> (8 * i));  // NOLINT(*pointer-arithmetic*)
+    }
+}
+
+void store_u64_(std::byte* output, std::uint64_t value)
+{
+    for (std::size_t i {0}; i < 8; ++i) {
+        output[i] = static_cast<std::byte>(value >> (8 * i));  // NOLINT(*pointer-arithmetic*)
+    }
+}
+
+auto load_u32_(const std::byte* input) -> std::uint32_t
+{
+    auto value = std::uint32_t {0};
+    for (std::size_t i {0}; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(input[i]) << (8 * i);  // NOLINT(*pointer-arithmetic*)
+    }
+
+    return value;
+}
+
+auto load_u64_(const std::byte* input) -> std::uint64_t
+{
+    auto value = std::uint64_t {0};
+    for (std::size_t i {0}; i < 8; ++i) {
+        value |= static_cast<std::uint64_t>(input[i]) << (8 * i);  // NOLINT(*pointer-arithmetic*)
+    }
+
+    return value;
+}
+
+/*
+    The checksum is the sum of a hash of each 64-bit word of the amplitudes, mixed with the position
+    of the word; a sum does not depend on the order in which the words are visited, so separate
+    sections of the amplitudes can be checksummed in parallel, and the results added together.
+*/
+constexpr auto checksum_word_(std::uint64_t word, std::uint64_t position) noexcept -> std::uint64_t
+{
+    // the finalizer of the splitmix64 generator
+    auto value = word + ((position + 1) * 0x9e3779b97f4a7c15ULL);
+    value = (value ^ (value >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27U)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31U);
+}
+
+constexpr auto checksum_amplitude_(std::uint64_t real_bits, std::uint64_t imag_bits, std::size_t i_file) noexcept -> std::uint64_t
+{
+    return checksum_word_(real_bits, 2 * i_file) + checksum_word_(imag_bits, 2 * i_file + 1);
+}
+
+auto amplitude_at_(const ket::Statevector& state, ket::Endian endian, std::size_t i_file) -> const std::complex<double>&
+{
+    if (endian == ket::Endian::LITTLE) {
+        return state[i_file];
+    }
+    else {
+        return state[ket::endian_flip(i_file, state.n_qubits())];
+    }
+}
+
+/*
+    Encodes the amplitudes at the file indices `[i_begin, i_end)` into `buffer`, and returns their checksum.
+*/
+auto encode_amplitudes_(
+    const ket::Statevector& state,
+    ket::Endian endian,
+    std::size_t i_begin,
+    std::size_t i_end,
+    std::vector<std::byte>& buffer
+) -> std::uint64_t
+{
+    buffer.resize((i_end - i_begin) * BYTES_PER_AMPLITUDE);
+
+    auto checksum = std::uint64_t {0};
+    auto* output = buffer.data();
+
+    for (std::size_t i_file {i_begin}; i_file < i_end; ++i_file) {
+        const auto& amplitude = amplitude_at_(state, endian, i_file);
+        const auto real_bits = std::bit_cast<std::uint64_t>(amplitude.real());
+        const auto imag_bits = std::bit_cast<std::uint64_t>(amplitude.imag());
+
+        store_u64_(output, real_bits);
+        store_u64_(output + 8, imag_bits);  // NOLINT(*pointer-arithmetic*)
+        output += BYTES_PER_AMPLITUDE;  // NOLINT(*pointer-arithmetic*)
+
+        checksum += checksum_amplitude_(real_bits, imag_bits, i_file);
+    }
+
+    return checksum;
+}
+
+auto checksum_amplitudes_(const ket::Statevector& state, ket::Endian endian) -> std::uint64_t
+{
+    auto checksum = std::uint64_t {0};
+    for (std::size_t i_file {0}; i_file < state.n_states(); ++i_file) {
+        const auto& amplitude = amplitude_at_(state, endian, i_file);
+        const auto real_bits = std::bit_cast<std::uint64_t>(amplitude.real());
+        const auto imag_bits = std::bit_cast<std::uint64_t>(amplitude.imag());
+
+        checksum += checksum_amplitude_(real_bits, imag_bits, i_file);
+    }
+
+    return checksum;
+}
+
+auto encode_header_(const ket::Statevector& state, ket::Endian endian, std::uint64_t checksum)
+    -> std::array<std::byte, ket::BINARY_STATEVECTOR_HEADER_SIZE>
+{
+    auto header = std::array<std::byte, ket::BINARY_STATEVECTOR_HEADER_SIZE> {};
+
+    std::ranges::transform(BINARY_STATEVECTOR_MAGIC, header.begin(), [](char ch) { return static_cast<std::byte>(ch); });
+    store_u32_(&header[8], ket::BINARY_STATEVECTOR_FORMAT_VERSION);
+    store_u32_(&header[12], endian == ket::Endian::LITTLE ? 0 : 1);
+    store_u64_(&header[16], state.n_qubits());
+    store_u64_(&header[24], state.n_states());
+    store_u64_(&header[32], checksum);
+
+    return header;
+}
+
+/*
+    Decodes and validates the header at the start of `bytes`, without looking at the amplitudes.
+*/
+auto decode_header_fields_(std::span<const std::byte> bytes) -> ket::BinaryStatevectorHeader
+{
+    if (!ket::internal::has_binary_statevector_magic(bytes) || bytes.size() < ket::BINARY_STATEVECTOR_HEADER_SIZE) {
+        throw_invalid_file_("the file does not start with the expected header");
+    }
+
+    const auto version = load_u32_(&bytes[8]);
+    if (version != ket::BINARY_STATEVECTOR_FORMAT_VERSION) {
+        throw_invalid_file_("the format version is not supported");
+    }
+
+    const auto endian_flag = load_u32_(&bytes[12]);
+    if (endian_flag > 1) {
+        throw_invalid_file_("the endianness flag is invalid");
+    }
+
+    const auto n_qubits = static_cast<std::size_t>(load_u64_(&bytes[16]));
+    const auto n_states = static_cast<std::size_t>(load_u64_(&bytes[24]));
+    if (n_qubits >= 64 || n_states != (std::size_t {1} << n_qubits)) {
+        throw_invalid_file_("the number of states does not match the number of qubits");
+    }
+
+    // the size of the file must be representable, or the size check below would wrap around
+    if (n_states > (SIZE_MAX - ket::BINARY_STATEVECTOR_HEADER_SIZE) / BYTES_PER_AMPLITUDE) {
+        throw_invalid_file_("the number of states is too large");
+    }
+
+    return {
+        .version=version,
+        .endian=(endian_flag == 0 ? ket::Endian::LITTLE : ket::Endian::BIG),
+        .n_qubits=n_qubits,
+        .n_states=n_states,
+        .checksum=load_u64_(&bytes[32])
+    };
+}
+
+auto file_size_(const ket::BinaryStatevectorHeader& header) -> std::size_t
+{
+    return ket::BINARY_STATEVECTOR_HEADER_SIZE + header.n_states * BYTES_PER_AMPLITUDE;
+}
+
+/*
+    Decodes and validates the header at the start of `bytes`; the size of `bytes` must match the
+    number of amplitudes given in the header.
+*/
+auto decode_header_(std::span<const std::byte> bytes) -> ket::BinaryStatevectorHeader
+{
+    const auto header = decode_header_fields_(bytes);
+
+    if (bytes.size() != file_size_(header)) {
+        throw_invalid_file_("the size of the file does not match the number of states");
+    }
+
+    return header;
+}
+
+/*
+    Reads the bytes `[i_begin, output.size())` of `output` from `instream`, and throws if the stream
+    ends before all of them are read.
+*/
+void read_bytes_(std::istream& instream, std::vector<std::byte>& output, std::size_t i_begin)
+{
+    const auto n_bytes = static_cast<std::streamsize>(output.size() - i_begin);
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    instream.read(reinterpret_cast<char*>(output.data() + i_begin), n_bytes);
+
+    if (instream.gcount() != n_bytes) {
+        throw_invalid_file_("the stream ends before the end of the statevector");
+    }
+}
+
+/*
+    Decodes the amplitudes at the file indices `[i_begin, i_end)` from the `bytes` of a whole file,
+    and returns their checksum.
+*/
+auto decode_amplitudes_(
+    std::span<const std::byte> bytes,
+    std::size_t i_begin,
+    std::size_t i_end,
+    std::complex<double>* output
+) -> std::uint64_t
+{
+    auto checksum = std::uint64_t {0};
+    const auto* input = &bytes[ket::BINARY_STATEVECTOR_HEADER_SIZE + i_begin * BYTES_PER_AMPLITUDE];
+
+    for (std::size_t i_file {i_begin}; i_file < i_end; ++i_file) {
+        const auto real_bits = load_u64_(input);
+        const auto imag_bits = load_u64_(input + 8);  // NOLINT(*pointer-arithmetic*)
+        input += BYTES_PER_AMPLITUDE;  // NOLINT(*pointer-arithmetic*)
+
+        *output = {std::bit_cast<double>(real_bits), std::bit_cast<double>(imag_bits)};
+        ++output;  // NOLINT(*pointer-arithmetic*)
+
+        checksum += checksum_amplitude_(real_bits, imag_bits, i_file);
+    }
+
+    return checksum;
+}
+
+#if defined(KETTLE_HAS_PWRITE)
+
+void write_all_at_(int file_descriptor, std::span<const std::byte> bytes, std::size_t offset)
+{
+    while (!bytes.empty()) {
+        const auto n_written = ::pwrite(file_descriptor, bytes.data(), bytes.size(), static_cast<off_t>(offset));
+        if (n_written < 0) {
+            throw std::ios::failure {"ERROR: failed to write the binary statevector to the file.\n"};
+        }
+
+        const auto n_written_ = static_cast<std::size_t>(n_written);
+        bytes = bytes.subspan(n_written_);
+        offset += n_written_;
+    }
+}
+
+/*
+    Encodes and writes the amplitudes at the file indices `[i_begin, i_end)` block by block, and
+    returns their checksum.
+*/
+auto write_amplitudes_at_(
+    int file_descriptor,
+    const ket::Statevector& state,
+    ket::Endian endian,
+    std::size_t i_begin,
+    std::size_t i_end
+) -> std::uint64_t
+{
+    auto checksum = std::uint64_t {0};
+    auto buffer = std::vector<std::byte> {};
+
+    for (auto i_block_begin = i_begin; i_block_begin < i_end; i_block_begin += AMPLITUDES_PER_BLOCK) {
+        const auto i_block_end = std::min(i_block_begin + AMPLITUDES_PER_BLOCK, i_end);
+        checksum += encode_amplitudes_(state, endian, i_block_begin, i_block_end, buffer);
+
+        const auto offset = ket::BINARY_STATEVECTOR_HEADER_SIZE + i_block_begin * BYTES_PER_AMPLITUDE;
+        write_all_at_(file_descriptor, buffer, offset);
+    }
+
+    return checksum;
+}
+
+void save_binary_statevector_posix_(
+    const std::filesystem::path& filepath,
+    const ket::Statevector& state,
+    ket::Endian endian,
+    ket::FileSyncPolicy sync_policy,
+    std::size_t n_threads
+)
+{
+    const auto file_descriptor = ::open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);  // NOLINT(*vararg*)
+    if (file_descriptor == -1) {
+        throw_unable_to_write_(filepath);
+    }
+
+    try {
+        const auto n_states = state.n_states();
+        const auto file_size = ket::BINARY_STATEVECTOR_HEADER_SIZE + n_states * BYTES_PER_AMPLITUDE;
+        if (::ftruncate(file_descriptor, static_cast<off_t>(file_size)) == -1) {
+            throw std::ios::failure {"ERROR: failed to resize the file for the binary statevector.\n"};
+        }
+
+        // each thread encodes and writes its own contiguous section of the amplitudes
+        n_threads = std::clamp(n_threads, std::size_t {1}, n_states);
+        const auto section_size = (n_states + n_threads - 1) / n_threads;
+
+        auto checksums = std::vector<std::uint64_t>(n_threads, 0);
+
+        ket::internal::run_in_parallel_(n_threads, [&](std::size_t i_thread) {
+            const auto i_begin = std::min(i_thread * section_size, n_states);
+            const auto i_end = std::min(i_begin + section_size, n_states);
+            checksums[i_thread] = write_amplitudes_at_(file_descriptor, state, endian, i_begin, i_end);
+        });
+
+        // the checksum is only known once all the amplitudes are written, so the header comes last
+        auto checksum = std::uint64_t {0};
+        for (auto value : checksums) {
+            checksum += value;
+        }
+
+        write_all_at_(file_descriptor, encode_header_(state, endian, checksum), 0);
+
+        if (sync_policy == ket::FileSyncPolicy::SYNC_ON_CLOSE && ::fsync(file_descriptor) == -1) {
+            throw std::ios::failure {"ERROR: failed to sync the binary statevector file to the storage device.\n"};
+        }
+    }
+    catch (...) {
+        ::close(file_descriptor);
+        throw;
+    }
+
+    if (::close(file_descriptor) == -1) {
+        throw std::ios::failure {"ERROR: failed to close the binary statevector file.\n"};
+    }
+}
+
+#endif
+
+}  // namespace
+
+
+namespace ket::internal
+{
+
+auto has_binary_statevector_magic(std::span<const std::byte> bytes) -> bool
+{
+    if (bytes.size() < BINARY_STATEVECTOR_MAGIC.size()) {
+        return false;
+    }
+
+    return std::ranges::equal(
+        bytes.first(BINARY_STATEVECTOR_MAGIC.size()),
+        BINARY_STATEVECTOR_MAGIC,
+        [](std::byte byte, char ch) { return byte == static_cast<std::byte>(ch); }
+    );
+}
+
+auto may_start_binary_statevector(std::istream& instream) -> bool
+{
+    return instream.peek() == std::char_traits<char>::to_int_type(BINARY_STATEVECTOR_MAGIC[0]);
+}
+
+}  // namespace ket::internal
+
+
+namespace ket
+{
+
+void save_binary_statevector(
+    std::ostream& outstream,
+    const Statevector& state,
+    Endian endian
+)
+{
+    // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto header = encode_header_(state, endian, checksum_amplitudes_(state, endian));
+    outstream.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(header.size()));
+
+    auto buffer = std::vector<std::byte> {};
+    for (std::size_t i_begin {0}; i_begin < state.n_states(); i_begin += AMPLITUDES_PER_BLOCK) {
+        const auto i_end = std::min(i_begin + AMPLITUDES_PER_BLOCK, state.n_states());
+        std::ignore = encode_amplitudes_(state, endian, i_begin, i_end, buffer);
+
+        outstream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    }
+    // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+void save_binary_statevector(
+    const std::filesystem::path& filepath,
+    const Statevector& state,
+    Endian endian,
+    [[maybe_unused]] FileSyncPolicy sync_policy,
+    [[maybe_unused]] std::size_t n_threads
+)
+{
+#if defined(KETTLE_HAS_PWRITE)
+    save_binary_statevector_posix_(filepath, state, endian, sync_policy, n_threads);
+#else
+    // without positional writes, the file is written serially, and the data can only be flushed
+    // to the operating system rather than synced to the storage device
+    auto outstream = std::ofstream {filepath, std::ios::binary};
+
+    if (!outstream.is_open()) {
+        throw_unable_to_write_(filepath);
+    }
+
+    save_binary_statevector(outstream, state, endian);
+    outstream.flush();
+#endif
+}
+
+auto read_binary_statevector(std::span<const std::byte> bytes) -> Statevector
+{
+    const auto header = decode_header_(bytes);
+
+    auto amplitudes = std::vector<std::complex<double>>(header.n_states);
+    const auto checksum = decode_amplitudes_(bytes, 0, header.n_states, amplitudes.data());
+
+    if (checksum != header.checksum) {
+        throw_invalid_file_("the checksum does not match the amplitudes");
+    }
+
+    return Statevector {std::move(amplitudes), header.endian};
+}
+
+auto load_binary_statevector(std::istream& instream) -> Statevector
+{
+    // the header gives the size of the statevector, so only its own bytes are taken from the stream
+    auto contents = std::vector<std::byte>(BINARY_STATEVECTOR_HEADER_SIZE);
+    read_bytes_(instream, contents, 0);
+
+    const auto total_size = file_size_(decode_header_fields_(contents));
+
+    // grow the buffer as the amplitudes arrive, so a corrupt header cannot cause a huge allocation up front
+    while (contents.size() < total_size) {
+        const auto i_begin = contents.size();
+        contents.resize(std::min(total_size, i_begin + AMPLITUDES_PER_BLOCK * BYTES_PER_AMPLITUDE));
+        read_bytes_(instream, contents, i_begin);
+    }
+
+    return read_binary_statevector(contents);
+}
+
+auto load_binary_statevector(const std::filesystem::path& filepath) -> Statevector
+{
+    const auto file = ket::internal::MappedFile {filepath};
+    return read_binary_statevector(file.bytes());
+}
+
+auto load_binary_statevector_header(const std::filesystem::path& filepath) -> BinaryStatevectorHeader
+{
+    const auto file = ket::internal::MappedFile {filepath};
+    return decode_header_(file.bytes());
+}
+
+auto load_binary_statevector_slice(
+    const std::filesystem::path& filepath,
+    std::size_t i_begin,
+    std::size_t i_end
+) -> std::vector<std::complex<double>>
+{
+    const auto file = ket::internal::MappedFile {filepath};
+    const auto header = decode_header_(file.bytes());
+
+    if (i_begin > i_end || i_end > header.n_states) {
+        throw std::runtime_error {"ERROR: the slice of amplitudes is out of range of the binary statevector.\n"};
+    }
+
+    auto amplitudes = std::vector<std::complex<double>>(i_end - i_begin);
+    std::ignore = decode_amplitudes_(file.bytes(), i_begin, i_end, amplitudes.data());
+
+    return amplitudes;
+}
+
+}  // namespace ket
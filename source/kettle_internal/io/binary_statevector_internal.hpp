@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <span>
+
+
+namespace ket::internal
+{
+
+/*
+    Returns `true` if `bytes` starts with the magic string of the binary statevector format.
+*/
+auto has_binary_statevector_magic(std::span<const std::byte> bytes) -> bool;
+
+/*
+    Returns `true` if the next character in `instream` is the first character of the magic string of
+    the binary statevector format; nothing is consumed, and the text formats never start with it.
+*/
+auto may_start_binary_statevector(std::istream& instream) -> bool;
+
+}  // namespace ket::internal
@@ -0,0 +1,106 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <sstream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define KETTLE_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "kettle_internal/io/mapped_file.hpp"
+
+
+namespace
+{
+
+[[noreturn]]
+void throw_unable_to_read_(const std::filesystem::path& filepath)
+{
+    auto err_msg = std::stringstream {};
+    err_msg << "ERROR: unable to read file : '" << filepath << "'\n";
+
+    throw std::ios::failure {err_msg.str()};
+}
+
+}  // namespace
+
+
+namespace ket::internal
+{
+
+#if defined(KETTLE_HAS_MMAP)
+
+MappedFile::MappedFile(const std::filesystem::path& filepath)
+{
+    const auto file_descriptor = ::open(filepath.c_str(), O_RDONLY);  // NOLINT(*vararg*)
+    if (file_descriptor == -1) {
+        throw_unable_to_read_(filepath);
+    }
+
+    struct stat file_status {};
+    if (::fstat(file_descriptor, &file_status) == -1) {
+        ::close(file_descriptor);
+        throw_unable_to_read_(filepath);
+    }
+
+    size_ = static_cast<std::size_t>(file_status.st_size);
+
+    // `mmap()` does not accept a length of zero, and there is nothing to map anyways
+    if (size_ != 0) {
+        void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (address == MAP_FAILED) {  // NOLINT(*cstyle-cast*, *int-to-ptr*)
+            ::close(file_descriptor);
+            throw_unable_to_read_(filepath);
+        }
+
+        // the file is read from start to end, so let the kernel read ahead aggressively
+        ::madvise(address, size_, MADV_SEQUENTIAL);
+
+        data_ = static_cast<const std::byte*>(address);
+        is_mapped_ = true;
+    }
+
+    // the mapping stays valid after the file descriptor is closed
+    ::close(file_descriptor);
+}
+
+MappedFile::~MappedFile()
+{
+    if (is_mapped_) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        ::munmap(const_cast<std::byte*>(data_), size_);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& filepath)
+{
+    auto instream = std::ifstream {filepath, std::ios::binary | std::ios::ate};
+    if (!instream.is_open()) {
+        throw_unable_to_read_(filepath);
+    }
+
+    size_ = static_cast<std::size_t>(instream.tellg());
+    buffer_.resize(size_);
+
+    instream.seekg(0);
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (!instream.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(size_))) {
+        throw_unable_to_read_(filepath);
+    }
+
+    data_ = buffer_.data();
+}
+
+MappedFile::~MappedFile() = default;
+
+#endif
+
+}  // namespace ket::internal
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+
+namespace ket::internal
+{
+
+/*
+    A read-only view of the full contents of a file.
+
+    On POSIX systems the file is memory-mapped, so the bytes are paged in directly from the page
+    cache as they are read, without being copied into a separate buffer first. On other systems
+    the file is read into memory with a single call.
+*/
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::filesystem::path& filepath);
+
+    ~MappedFile();
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile(MappedFile&& other) = delete;
+    auto operator=(const MappedFile& other) -> MappedFile& = delete;
+    auto operator=(MappedFile&& other) -> MappedFile& = delete;
+
+    [[nodiscard]]
+    auto bytes() const noexcept -> std::span<const std::byte>
+    {
+        return {data_, size_};
+    }
+
+    [[nodiscard]]
+    auto text() const noexcept -> std::string_view
+    {
+        return {reinterpret_cast<const char*>(data_), size_};  // NOLINT(*reinterpret-cast*)
+    }
+
+private:
+    const std::byte* data_ {nullptr};
+    std::size_t size_ {0};
+    bool is_mapped_ {false};
+    std::vector<std::byte> buffer_;
+};
+
+}  // namespace ket::internal
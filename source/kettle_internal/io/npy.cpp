@@ -0,0 +1,480 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include "kettle/common/mathtools.hpp"
+#include "kettle/io/npy.hpp"
+#include "kettle/state/endian.hpp"
+#include "kettle/state/statevector.hpp"
+
+#include "kettle_internal/io/mapped_file.hpp"
+#include "kettle_internal/io/text_cursor.hpp"
+
+
+namespace
+{
+
+constexpr auto NPY_MAGIC = std::string_view {"\x93NUMPY"};
+
+// the header of a file is padded with spaces so that the data starts at a multiple of this alignment
+constexpr auto NPY_HEADER_ALIGNMENT = std::size_t {64};
+
+// the elements are encoded into a buffer of this many bytes before each write
+constexpr auto BYTES_PER_BLOCK = std::size_t {1} << 20;
+
+enum class NpyElementKind_ : std::uint8_t
+{
+    COMPLEX128,
+    COMPLEX64,
+    FLOAT64,
+    FLOAT32
+};
+
+/*
+    The information in the header of a `.npy` file needed to read a one-dimensional array.
+*/
+struct NpyArrayInfo_
+{
+    NpyElementKind_ kind;
+    bool is_big_endian;
+    std::size_t n_elements;
+    std::span<const std::byte> data;
+};
+
+[[noreturn]]
+void throw_invalid_file_(std::string_view reason)
+{
+    auto err_msg = std::stringstream {};
+    err_msg << "ERROR: invalid .npy file; " << reason << '\n';
+
+    throw std::runtime_error {err_msg.str()};
+}
+
+[[noreturn]]
+void throw_unable_to_write_(const std::filesystem::path& filepath)
+{
+    auto err_msg = std::stringstream {};
+    err_msg << "ERROR: unable to open file to save .npy array: \n";
+    err_msg << "'" << filepath << "'\n";
+
+    throw std::ios::failure {err_msg.str()};
+}
+
+auto load_uint_(const std::byte* input, std::size_t n_bytes, bool is_big_endian) -> std::uint64_t
+{
+    auto value = std::uint64_t {0};
+    for (std::size_t i {0}; i < n_bytes; ++i) {
+        const auto shift = is_big_endian ? 8 * (n_bytes - 1 - i) : 8 * i;
+        value |= static_cast<std::uint64_t>(input[i]) << shift;  // NOLINT(*pointer-arithmetic*)
+    }
+
+    return value;
+}
+
+void store_u64_(std::byte* output, std::uint64_t value)
+{
+    for (std::size_t i {0}; i < 8; ++i) {
+        output[i] = static_cast<std::byte>(value >> (8 * i));  // NOLINT(*pointer-arithmetic*)
+    }
+}
+
+auto element_size_(NpyElementKind_ kind) -> std::size_t
+{
+    switch (kind) {
+        case NpyElementKind_::COMPLEX128 : return 16;
+        case NpyElementKind_::COMPLEX64 : return 8;
+        case NpyElementKind_::FLOAT64 : return 8;
+        case NpyElementKind_::FLOAT32 : return 4;
+    }
+
+    throw std::runtime_error {"DEV ERROR: unknown .npy element kind.\n"};
+}
+
+auto load_f64_(const std::byte* input, bool is_big_endian) -> double
+{
+    return std::bit_cast<double>(load_uint_(input, 8, is_big_endian));
+}
+
+auto load_f32_(const std::byte* input, bool is_big_endian) -> double
+{
+    const auto bits = static_cast<std::uint32_t>(load_uint_(input, 4, is_big_endian));
+    return static_cast<double>(std::bit_cast<float>(bits));
+}
+
+/*
+    Returns the text of the value of `key` in the Python dictionary literal of the header, which
+    starts right after the ':' that follows the key.
+*/
+auto find_header_value_(std::string_view header, std::string_view key) -> std::string_view
+{
+    for (const auto quote : {'\'', '"'}) {
+        const auto quoted_key = std::string {quote} + std::string {key} + quote;
+        const auto i_key = header.find(quoted_key);
+        if (i_key == std::string_view::npos) {
+            continue;
+        }
+
+        const auto i_colon = header.find(':', i_key + quoted_key.size());
+        if (i_colon == std::string_view::npos) {
+            break;
+        }
+
+        return header.substr(i_colon + 1);
+    }
+
+    throw_invalid_file_(std::string {"the header has no '"} + std::string {key} + "' entry");
+}
+
+auto parse_descr_(std::string_view header) -> std::tuple<NpyElementKind_, bool>
+{
+    auto cursor = ket::internal::TextCursor {find_header_value_(header, "descr")};
+    const auto quote = cursor.read_char();
+
+    auto descr = cursor.remaining();
+    descr = descr.substr(0, descr.find(quote));
+
+    if (descr.size() < 2 || (descr[0] != '<' && descr[0] != '>')) {
+        throw_invalid_file_("the byte order of the elements must be '<' or '>'");
+    }
+
+    const auto is_big_endian = descr[0] == '>';
+    const auto type_name = descr.substr(1);
+
+    if (type_name == "c16") {
+        return {NpyElementKind_::COMPLEX128, is_big_endian};
+    }
+    else if (type_name == "c8") {
+        return {NpyElementKind_::COMPLEX64, is_big_endian};
+    }
+    else if (type_name == "f8") {
+        return {NpyElementKind_::FLOAT64, is_big_endian};
+    }
+    else if (type_name == "f4") {
+        return {NpyElementKind_::FLOAT32, is_big_endian};
+    }
+    else {
+        throw_invalid_file_(std::string {"the element type '"} + std::string {descr} + "' is not supported");
+    }
+}
+
+auto parse_shape_(std::string_view header) -> std::size_t
+{
+    auto cursor = ket::internal::TextCursor {find_header_value_(header, "shape")};
+
+    if (cursor.read_char() != '(') {
+        throw_invalid_file_("the shape is not a tuple");
+    }
+
+    if (cursor.peek() == ')') {
+        throw_invalid_file_("only one-dimensional arrays are supported");
+    }
+
+    const auto n_elements = cursor.read_integer<std::size_t>();
+
+    // a one-dimensional shape looks like "(8,)"
+    if (cursor.peek() == ',') {
+        std::ignore = cursor.read_char();
+    }
+
+    if (cursor.peek() != ')') {
+        throw_invalid_file_("only one-dimensional arrays are supported");
+    }
+
+    return n_elements;
+}
+
+auto parse_npy_array_info_(std::span<const std::byte> bytes) -> NpyArrayInfo_
+{
+    const auto text = std::string_view {reinterpret_cast<const char*>(bytes.data()), bytes.size()};  // NOLINT(*reinterpret-cast*)
+
+    if (!text.starts_with(NPY_MAGIC) || text.size() < NPY_MAGIC.size() + 2) {
+        throw_invalid_file_("the file does not start with the expected magic string");
+    }
+
+    // version 1.0 stores the length of the header in 2 bytes, and versions 2.0 and 3.0 use 4 bytes
+    const auto major_version = static_cast<std::uint8_t>(bytes[NPY_MAGIC.size()]);
+    if (major_version < 1 || major_version > 3) {
+        throw_invalid_file_("the format version is not supported");
+    }
+
+    const auto length_size = std::size_t {major_version == 1 ? 2U : 4U};
+    const auto i_header = NPY_MAGIC.size() + 2 + length_size;
+    if (bytes.size() < i_header) {
+        throw_invalid_file_("the file ends before the header");
+    }
+
+    const auto header_size = static_cast<std::size_t>(load_uint_(&bytes[NPY_MAGIC.size() + 2], length_size, false));
+    if (bytes.size() < i_header + header_size) {
+        throw_invalid_file_("the file ends before the end of the header");
+    }
+
+    const auto header = text.substr(i_header, header_size);
+    const auto [kind, is_big_endian] = parse_descr_(header);
+    const auto n_elements = parse_shape_(header);
+
+    // the size of the data must be representable, or the size check below would wrap around
+    if (n_elements > SIZE_MAX / element_size_(kind)) {
+        throw_invalid_file_("the number of elements is too large");
+    }
+
+    const auto data = bytes.subspan(i_header + header_size);
+    if (data.size() != n_elements * element_size_(kind)) {
+        throw_invalid_file_("the size of the data does not match the shape of the array");
+    }
+
+    return {.kind=kind, .is_big_endian=is_big_endian, .n_elements=n_elements, .data=data};
+}
+
+auto decode_element_(const NpyArrayInfo_& info, std::size_t index) -> std::complex<double>
+{
+    const auto* input = &info.data[index * element_size_(info.kind)];
+
+    switch (info.kind) {
+        case NpyElementKind_::COMPLEX128 : {
+            return {load_f64_(input, info.is_big_endian), load_f64_(input + 8, info.is_big_endian)};  // NOLINT(*pointer-arithmetic*)
+        }
+        case NpyElementKind_::COMPLEX64 : {
+            return {load_f32_(input, info.is_big_endian), load_f32_(input + 4, info.is_big_endian)};  // NOLINT(*pointer-arithmetic*)
+        }
+        case NpyElementKind_::FLOAT64 : {
+            return {load_f64_(input, info.is_big_endian), 0.0};
+        }
+        case NpyElementKind_::FLOAT32 : {
+            return {load_f32_(input, info.is_big_endian), 0.0};
+        }
+    }
+
+    throw std::runtime_error {"DEV ERROR: unknown .npy element kind.\n"};
+}
+
+/*
+    Writes the magic string, version and header of a one-dimensional array of `n_elements` elements of type `descr`.
+*/
+void write_npy_header_(std::ostream& outstream, std::string_view descr, std::size_t n_elements)
+{
+    auto header = std::string {"{'descr': '"};
+    header += descr;
+    header += "', 'fortran_order': False, 'shape': (";
+    header += std::to_string(n_elements);
+    header += ",), }";
+
+    const auto padded_size = [&](std::size_t prefix_size) {
+        const auto unpadded_size = prefix_size + header.size() + 1;
+        return ((unpadded_size + NPY_HEADER_ALIGNMENT - 1) / NPY_HEADER_ALIGNMENT) * NPY_HEADER_ALIGNMENT;
+    };
+
+    // version 1.0 is used unless the length of the header does not fit into its 2-byte field
+    auto prefix_size = NPY_MAGIC.size() + 4;
+    const auto is_version1 = padded_size(prefix_size) - prefix_size < (std::size_t {1} << 16);
+    if (!is_version1) {
+        prefix_size += 2;
+    }
+
+    // the header is padded with spaces, and ends with a newline
+    header.append(padded_size(prefix_size) - prefix_size - header.size() - 1, ' ');
+    header += '\n';
+
+    outstream.write(NPY_MAGIC.data(), static_cast<std::streamsize>(NPY_MAGIC.size()));
+    outstream.put(static_cast<char>(is_version1 ? 1 : 2));
+    outstream.put(0);
+
+    const auto length_size = is_version1 ? 2 : 4;
+    for (int i {0}; i < length_size; ++i) {
+        outstream.put(static_cast<char>((header.size() >> (8 * i)) & 0xFFU));
+    }
+
+    outstream.write(header.data(), static_cast<std::streamsize>(header.size()));
+}
+
+/*
+    Encodes the 64-bit words given by `word_at(i)` for `i` in `[0, n_words)` in little-endian order,
+    and writes them block by block.
+*/
+template <typename WordFunction>
+void write_npy_words_(std::ostream& outstream, std::size_t n_words, const WordFunction& word_at)
+{
+    constexpr auto words_per_block = BYTES_PER_BLOCK / 8;
+
+    auto buffer = std::vector<std::byte> {};
+    for (std::size_t i_begin {0}; i_begin < n_words; i_begin += words_per_block) {
+        const auto i_end = std::min(i_begin + words_per_block, n_words);
+        buffer.resize((i_end - i_begin) * 8);
+
+        for (std::size_t i {i_begin}; i < i_end; ++i) {
+            store_u64_(&buffer[(i - i_begin) * 8], word_at(i));
+        }
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        outstream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    }
+}
+
+auto open_output_file_(const std::filesystem::path& filepath) -> std::ofstream
+{
+    auto outstream = std::ofstream {filepath, std::ios::binary};
+
+    if (!outstream.is_open()) {
+        throw_unable_to_write_(filepath);
+    }
+
+    return outstream;
+}
+
+}  // namespace
+
+
+namespace ket
+{
+
+auto read_npy_statevector(
+    std::span<const std::byte> bytes,
+    Endian input_endian
+) -> Statevector
+{
+    const auto info = parse_npy_array_info_(bytes);
+
+    if (!std::has_single_bit(info.n_elements)) {
+        throw_invalid_file_("the number of amplitudes of a statevector must be a power of 2");
+    }
+
+    auto amplitudes = std::vector<std::complex<double>>(info.n_elements);
+    for (std::size_t i {0}; i < info.n_elements; ++i) {
+        amplitudes[i] = decode_element_(info, i);
+    }
+
+    return Statevector {std::move(amplitudes), input_endian};
+}
+
+auto load_npy_statevector(
+    std::istream& instream,
+    Endian input_endian
+) -> Statevector
+{
+    const auto contents = ket::internal::read_all_text(instream);
+    return read_npy_statevector(std::as_bytes(std::span {contents}), input_endian);
+}
+
+auto load_npy_statevector(
+    const std::filesystem::path& filepath,
+    Endian input_endian
+) -> Statevector
+{
+    const auto file = ket::internal::MappedFile {filepath};
+    return read_npy_statevector(file.bytes(), input_endian);
+}
+
+auto read_npy_real_array(std::span<const std::byte> bytes) -> std::vector<double>
+{
+    const auto info = parse_npy_array_info_(bytes);
+
+    if (info.kind != NpyElementKind_::FLOAT64 && info.kind != NpyElementKind_::FLOAT32) {
+        throw_invalid_file_("the elements of a real-valued array must be 'f8' or 'f4'");
+    }
+
+    auto output = std::vector<double>(info.n_elements);
+    for (std::size_t i {0}; i < info.n_elements; ++i) {
+        output[i] = decode_element_(info, i).real();
+    }
+
+    return output;
+}
+
+auto load_npy_real_array(const std::filesystem::path& filepath) -> std::vector<double>
+{
+    const auto file = ket::internal::MappedFile {filepath};
+    return read_npy_real_array(file.bytes());
+}
+
+void save_npy_statevector(
+    std::ostream& outstream,
+    const Statevector& state,
+    Endian output_endian
+)
+{
+    const auto n_qubits = state.n_qubits();
+    const auto amplitude_at = [&](std::size_t i_file) -> const std::complex<double>& {
+        if (output_endian == Endian::LITTLE) {
+            return state[i_file];
+        }
+        else {
+            return state[ket::endian_flip(i_file, n_qubits)];
+        }
+    };
+
+    write_npy_header_(outstream, "<c16", state.n_states());
+    write_npy_words_(outstream, 2 * state.n_states(), [&](std::size_t i_word) {
+        const auto& amplitude = amplitude_at(i_word / 2);
+        const auto part = (i_word % 2 == 0) ? amplitude.real() : amplitude.imag();
+
+        return std::bit_cast<std::uint64_t>(part);
+    });
+}
+
+void save_npy_statevector(
+    const std::filesystem::path& filepath,
+    const Statevector& state,
+    Endian output_endian
+)
+{
+    auto outstream = open_output_file_(filepath);
+    save_npy_statevector(outstream, state, output_endian);
+}
+
+void save_npy_probabilities(std::ostream& outstream, const std::vector<double>& probabilities)
+{
+    write_npy_header_(outstream, "<f8", probabilities.size());
+    write_npy_words_(outstream, probabilities.size(), [&](std::size_t i) {
+        return std::bit_cast<std::uint64_t>(probabilities[i]);
+    });
+}
+
+void save_npy_probabilities(const std::filesystem::path& filepath, const std::vector<double>& probabilities)
+{
+    auto outstream = open_output_file_(filepath);
+    save_npy_probabilities(outstream, probabilities);
+}
+
+void save_npy_counts(
+    std::ostream& outstream,
+    const std::map<std::size_t, std::size_t>& counts,
+    std::size_t n_states
+)
+{
+    if (!counts.empty() && counts.rbegin()->first >= n_states) {
+        throw std::runtime_error {"ERROR: the counts hold a state outside of the range of `n_states`.\n"};
+    }
+
+    auto histogram = std::vector<std::uint64_t>(n_states, 0);
+    for (const auto& [state_index, count] : counts) {
+        histogram[state_index] = count;
+    }
+
+    write_npy_header_(outstream, "<u8", n_states);
+    write_npy_words_(outstream, n_states, [&](std::size_t i) { return histogram[i]; });
+}
+
+void save_npy_counts(
+    const std::filesystem::path& filepath,
+    const std::map<std::size_t, std::size_t>& counts,
+    std::size_t n_states
+)
+{
+    auto outstream = open_output_file_(filepath);
+    save_npy_counts(outstream, counts, n_states);
+}
+
+}  // namespace ket
@@ -1,78 +1,75 @@
 #include <complex>
 #include <iostream>
 #include <filesystem>
-#include <fstream>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
 #include "kettle/state/statevector.hpp"
 #include "kettle/io/numpy_statevector.hpp"
 
+#include "kettle_internal/io/mapped_file.hpp"
+#include "kettle_internal/io/text_cursor.hpp"
+
 namespace
 {
 
-auto read_complex_numpy_format_(std::istream& stream) -> std::complex<double>
+auto read_complex_numpy_format_(ket::internal::TextCursor& cursor) -> std::complex<double>
 {
     // reads in text that looks like (1.23456e005+5.43210e002j) into a std::complex<double> instance
-    double real;  // NOLINT(cppcoreguidelines-init-variables)
-    double imag;  // NOLINT(cppcoreguidelines-init-variables)
-    char ch;  // NOLINT(cppcoreguidelines-init-variables)
-
-    stream >> ch; // '('
-    stream >> real;
-    stream >> imag;
-    stream >> ch; // 'j'
-    stream >> ch; // ')'
+    std::ignore = cursor.read_char();  // '('
+    const auto real = cursor.read_double();
+    const auto imag = cursor.read_double();
+    std::ignore = cursor.read_char();  // 'j'
+    std::ignore = cursor.read_char();  // ')'
 
     return {real, imag};
 }
 
-}  // namespace
-
-
-namespace ket
+auto parse_numpy_statevector_(std::string_view text, ket::Endian input_endian) -> ket::Statevector
 {
+    auto cursor = ket::internal::TextCursor {text};
 
-auto read_numpy_statevector(
-    std::istream& instream,
-    Endian input_endian
-) -> Statevector
-{
     // the very first line contains the number of qubits
-    const auto n_qubits = [&]() {
-        std::size_t n_qubits_;  // NOLINT(cppcoreguidelines-init-variables)
-        instream >> n_qubits_;
-
-        return n_qubits_;
-    }();
-
+    const auto n_qubits = cursor.read_integer<std::size_t>();
     const auto n_states = 1UL << n_qubits;
 
     auto amplitudes = std::vector<std::complex<double>> {};
     amplitudes.reserve(n_states);
 
     for (std::size_t i {0}; i < n_states; ++i) {
-        amplitudes.push_back(read_complex_numpy_format_(instream));
+        amplitudes.push_back(read_complex_numpy_format_(cursor));
     }
 
-    return Statevector {std::move(amplitudes), input_endian};
+    return ket::Statevector {std::move(amplitudes), input_endian};
 }
 
+}  // namespace
+
+
+namespace ket
+{
+
 auto read_numpy_statevector(
-    const std::filesystem::path& filepath,
+    std::istream& instream,
     Endian input_endian
 ) -> Statevector
 {
-    auto instream = std::ifstream {filepath};
-
-    if (!instream.is_open()) {
-        auto err_msg = std::stringstream {};
-        err_msg << "ERROR: unable to open file for statevector: \n";
-        err_msg << "'" << filepath << "'\n";
+    // the first line holds the number of qubits, and each of the next lines holds one amplitude
+    auto text = ket::internal::read_text_with_tokens(instream, 1);
+    const auto n_qubits = ket::internal::TextCursor {text}.read_integer<std::size_t>();
+    text += ket::internal::read_text_with_tokens(instream, 1UL << n_qubits);
 
-        throw std::ios::failure {err_msg.str()};
-    }
+    return parse_numpy_statevector_(text, input_endian);
+}
 
-    return read_numpy_statevector(instream, input_endian);
+auto read_numpy_statevector(
+    const std::filesystem::path& filepath,
+    Endian input_endian
+) -> Statevector
+{
+    const auto file = ket::internal::MappedFile {filepath};
+    return parse_numpy_statevector_(file.text(), input_endian);
 }
 
 }  // namespace ket
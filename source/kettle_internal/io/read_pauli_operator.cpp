@@ -1,14 +1,16 @@
 #include <cstddef>
 #include <filesystem>
-#include <format>
-#include <fstream>
-#include <sstream>
-#include <string>
+#include <complex>
+#include <string_view>
+#include <tuple>
 #include <unordered_map>
 
 #include "kettle/operator/pauli/pauli_operator.hpp"
 #include "kettle/io/read_pauli_operator.hpp"
 
+#include "kettle_internal/io/mapped_file.hpp"
+#include "kettle_internal/io/text_cursor.hpp"
+
 /*
     This file contains the `read_pauli_operator()` function, which takes an output file
     from the Python qpe_dipolar_planar_rotor project, and reads it into a `PauliOperator`
@@ -23,39 +25,39 @@ const auto MAP_PAULI_GATE_STRING_TO_TERM = std::unordered_map<char, ket::PauliTe
 };
 
 
-namespace ket
+namespace
 {
 
-auto read_pauli_operator(std::istream& instream, std::size_t n_qubits) -> ket::PauliOperator
+auto parse_pauli_operator_(std::string_view text, std::size_t n_qubits) -> ket::PauliOperator
 {
     auto pauli_op = ket::PauliOperator {n_qubits};
+    auto text_cursor = ket::internal::TextCursor {text};
 
-    char ch;  // NOLINT
-    std::string line;  // NOLINT
+    // the lines are walked one at a time, like `std::getline()`, so that blank lines are not skipped
+    while (!text_cursor.remaining().empty()) {
+        auto cursor = ket::internal::TextCursor {text_cursor.read_line()};
 
-    while (std::getline(instream, line)) {
-        auto linestream = std::stringstream {line};
-
-        double real;  // NOLINT
-        double imag;  // NOLINT
-        linestream >> real;
-        linestream >> imag;
+        // a line with only whitespace holds no coefficient, and adds an identity term with a zero
+        // coefficient, as the stream-based reader always did
+        if (cursor.is_at_end()) {
+            pauli_op.add(std::complex<double> {0.0, 0.0}, ket::SparsePauliString {n_qubits});
+            continue;
+        }
 
+        const auto real = cursor.read_double();
+        const auto imag = cursor.read_double();
         const auto coeff = std::complex<double> {real, imag};
 
-        linestream >> ch; // :
+        std::ignore = cursor.read_char();  // ':'
 
         auto pauli_string = ket::SparsePauliString {n_qubits};
 
-        while (linestream >> ch) {
-            if (ch == '(') {
-                std::size_t qubit_index;  // NOLINT
-                char pauli_gate;  // NOLINT
-
-                linestream >> qubit_index;
-                linestream >> ch;  // ,
-                linestream >> pauli_gate;
-                linestream >> ch;  // )
+        while (!cursor.is_at_end()) {
+            if (cursor.read_char() == '(') {
+                const auto qubit_index = cursor.read_integer<std::size_t>();
+                std::ignore = cursor.read_char();  // ','
+                const auto pauli_gate = cursor.read_char();
+                std::ignore = cursor.read_char();  // ')'
 
                 const auto pauli_term = MAP_PAULI_GATE_STRING_TO_TERM.at(pauli_gate);
                 pauli_string.add(qubit_index, pauli_term);
@@ -68,14 +70,22 @@ auto read_pauli_operator(std::istream& instream, std::size_t n_qubits) -> ket::P
     return pauli_op;
 }
 
-auto read_pauli_operator(const std::filesystem::path& filepath, std::size_t n_qubits) -> ket::PauliOperator
+}  // namespace
+
+
+namespace ket
 {
-    auto instream = std::ifstream {filepath};
-    if (!instream.is_open()) {
-        throw std::ios::failure {std::format("ERROR: unable to open: {}", filepath.c_str())};
-    }
 
-    return read_pauli_operator(instream, n_qubits);
+auto read_pauli_operator(std::istream& instream, std::size_t n_qubits) -> ket::PauliOperator
+{
+    const auto text = ket::internal::read_all_text(instream);
+    return parse_pauli_operator_(text, n_qubits);
+}
+
+auto read_pauli_operator(const std::filesystem::path& filepath, std::size_t n_qubits) -> ket::PauliOperator
+{
+    const auto file = ket::internal::MappedFile {filepath};
+    return parse_pauli_operator_(file.text(), n_qubits);
 }
 
 }  // namespace ket
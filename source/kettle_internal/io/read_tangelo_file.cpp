@@ -1,9 +1,14 @@
+#include <algorithm>
+#include <array>
+#include <complex>
 #include <cstddef>
 #include <filesystem>
 #include <fstream>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <tuple>
 
 #include "kettle/gates/primitive_gate.hpp"
 #include "kettle/circuit/circuit.hpp"
@@ -12,164 +17,206 @@
 #include "kettle_internal/gates/primitive_gate/gate_id.hpp"
 #include "kettle_internal/gates/primitive_gate_map.hpp"
 #include "kettle_internal/io/io_control_flow.hpp"
+#include "kettle_internal/io/text_cursor.hpp"
 
 namespace
 {
 
 /*
-    Certain names of primitive gates do not match between the tangelo codebase and this codebase;
-    this function converts tangelo-specific names to names used here.
+    An entry of the table that maps the name of a gate in a tangelo file to the gate it represents.
+
+    Certain names of primitive gates do not match between the tangelo codebase and this codebase
+    (for example, tangelo uses 'CNOT' for the 'CX' gate), and tangelo has a SWAP gate, which is
+    not a primitive gate here; the table holds entries for both.
 */
-auto tangelo_to_local_name_(const std::string& name) -> std::string
+struct TangeloGateEntry_
 {
-    if (name == "CPHASE") {
-        return "CP";
-    }
-    else if (name == "CNOT") {
-        return "CX";
+    std::string_view name;
+    ket::Gate gate;
+    bool is_swap;
+};
+
+constexpr auto TANGELO_GATE_ENTRIES_ = std::array<TangeloGateEntry_, 35> {{
+    {.name="H", .gate=ket::Gate::H, .is_swap=false},
+    {.name="X", .gate=ket::Gate::X, .is_swap=false},
+    {.name="Y", .gate=ket::Gate::Y, .is_swap=false},
+    {.name="Z", .gate=ket::Gate::Z, .is_swap=false},
+    {.name="S", .gate=ket::Gate::S, .is_swap=false},
+    {.name="SDAG", .gate=ket::Gate::SDAG, .is_swap=false},
+    {.name="T", .gate=ket::Gate::T, .is_swap=false},
+    {.name="TDAG", .gate=ket::Gate::TDAG, .is_swap=false},
+    {.name="SX", .gate=ket::Gate::SX, .is_swap=false},
+    {.name="SXDAG", .gate=ket::Gate::SXDAG, .is_swap=false},
+    {.name="RX", .gate=ket::Gate::RX, .is_swap=false},
+    {.name="RY", .gate=ket::Gate::RY, .is_swap=false},
+    {.name="RZ", .gate=ket::Gate::RZ, .is_swap=false},
+    {.name="P", .gate=ket::Gate::P, .is_swap=false},
+    {.name="CH", .gate=ket::Gate::CH, .is_swap=false},
+    {.name="CX", .gate=ket::Gate::CX, .is_swap=false},
+    {.name="CY", .gate=ket::Gate::CY, .is_swap=false},
+    {.name="CZ", .gate=ket::Gate::CZ, .is_swap=false},
+    {.name="CS", .gate=ket::Gate::CS, .is_swap=false},
+    {.name="CSDAG", .gate=ket::Gate::CSDAG, .is_swap=false},
+    {.name="CT", .gate=ket::Gate::CT, .is_swap=false},
+    {.name="CTDAG", .gate=ket::Gate::CTDAG, .is_swap=false},
+    {.name="CSX", .gate=ket::Gate::CSX, .is_swap=false},
+    {.name="CSXDAG", .gate=ket::Gate::CSXDAG, .is_swap=false},
+    {.name="CRX", .gate=ket::Gate::CRX, .is_swap=false},
+    {.name="CRY", .gate=ket::Gate::CRY, .is_swap=false},
+    {.name="CRZ", .gate=ket::Gate::CRZ, .is_swap=false},
+    {.name="CP", .gate=ket::Gate::CP, .is_swap=false},
+    {.name="U", .gate=ket::Gate::U, .is_swap=false},
+    {.name="CU", .gate=ket::Gate::CU, .is_swap=false},
+    {.name="M", .gate=ket::Gate::M, .is_swap=false},
+    {.name="CNOT", .gate=ket::Gate::CX, .is_swap=false},
+    {.name="CPHASE", .gate=ket::Gate::CP, .is_swap=false},
+    {.name="PHASE", .gate=ket::Gate::P, .is_swap=false},
+    {.name="SWAP", .gate=ket::Gate::M, .is_swap=true},  // the gate is unused for the SWAP entry
+}};
+
+constexpr auto TANGELO_GATE_TABLE_SIZE_ = std::size_t {64};
+
+/*
+    A perfect hash for the names in `TANGELO_GATE_ENTRIES_`; every name lands in a different slot,
+    so a lookup needs a single string comparison.
+*/
+constexpr auto tangelo_gate_hash_(std::string_view name) noexcept -> std::size_t
+{
+    if (name.empty()) {
+        return 0;
     }
-    else if (name == "PHASE") {
-        return "P";
+
+    const auto first = static_cast<std::size_t>(static_cast<unsigned char>(name.front()));
+    const auto last = static_cast<std::size_t>(static_cast<unsigned char>(name.back()));
+    const auto second = name.size() > 1 ? static_cast<std::size_t>(static_cast<unsigned char>(name[1])) : 0;
+
+    return (17 * first + 20 * last + 32 * name.size() + second) % TANGELO_GATE_TABLE_SIZE_;
+}
+
+constexpr auto create_tangelo_gate_table_()
+{
+    auto table = std::array<const TangeloGateEntry_*, TANGELO_GATE_TABLE_SIZE_> {};
+    for (const auto& entry : TANGELO_GATE_ENTRIES_) {
+        table[tangelo_gate_hash_(entry.name)] = &entry;
     }
-    else {
-        return name;
+
+    return table;
+}
+
+constexpr auto has_no_hash_collisions_() -> bool
+{
+    const auto table = create_tangelo_gate_table_();
+    return std::ranges::all_of(TANGELO_GATE_ENTRIES_, [&](const auto& entry) {
+        return table[tangelo_gate_hash_(entry.name)] == &entry;
+    });
+}
+
+static_assert(has_no_hash_collisions_(), "DEV ERROR: the tangelo gate names must have unique hashes.");
+
+constexpr auto TANGELO_GATE_TABLE_ = create_tangelo_gate_table_();
+
+auto find_tangelo_gate_(std::string_view name) -> const TangeloGateEntry_&
+{
+    const auto* entry = TANGELO_GATE_TABLE_[tangelo_gate_hash_(name)];
+
+    if (entry == nullptr || entry->name != name) {
+        auto err_msg = std::stringstream {};
+        err_msg << "Unknown gate found in `read_tangelo_file()` : " << name << '\n';
+        throw std::runtime_error {err_msg.str()};
     }
+
+    return *entry;
 }
 
-void parse_swap_gate_(ket::QuantumCircuit& circuit, std::stringstream& stream)
+/*
+    Parses text that looks like "target : [3]", and returns the index in the brackets.
+*/
+auto parse_labelled_index_(ket::internal::TextCursor& cursor) -> std::size_t
 {
-    std::string dummy_str;
-    char dummy_ch;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t target_qubit0;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t target_qubit1;  // NOLINT(cppcoreguidelines-init-variables)
-
-    stream >> dummy_str;    // 'target'
-    stream >> dummy_str;    // ':'
-    stream >> dummy_ch;     // '['
-    stream >> target_qubit0; // target qubit 0
-    stream >> dummy_ch;     // ','
-    stream >> target_qubit1; // target qubit 1
-    stream >> dummy_ch;     // ']'
+    std::ignore = cursor.read_word();  // 'target', 'control', or 'bit'
+    std::ignore = cursor.read_word();  // ':'
+    std::ignore = cursor.read_char();  // '['
+    const auto index = cursor.read_integer<std::size_t>();
+    std::ignore = cursor.read_char();  // ']'
 
-    circuit.add_swap_gate(target_qubit0, target_qubit1);
+    return index;
 }
 
-void parse_one_target_gate_(ket::Gate gate, ket::QuantumCircuit& circuit, std::stringstream& stream)
+/*
+    Parses text that looks like "parameter : 1.5707963", and returns the angle.
+*/
+auto parse_labelled_angle_(ket::internal::TextCursor& cursor) -> double
 {
-    std::string dummy_str;
-    char dummy_ch;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t target_qubit;  // NOLINT(cppcoreguidelines-init-variables)
+    std::ignore = cursor.read_word();  // 'parameter'
+    std::ignore = cursor.read_word();  // ':'
+
+    return cursor.read_double();
+}
 
-    stream >> dummy_str;    // 'target'
-    stream >> dummy_str;    // ':'
-    stream >> dummy_ch;     // '['
-    stream >> target_qubit; // target qubit
-    stream >> dummy_ch;     // ']'
+void parse_swap_gate_(ket::QuantumCircuit& circuit, ket::internal::TextCursor& cursor)
+{
+    std::ignore = cursor.read_word();  // 'target'
+    std::ignore = cursor.read_word();  // ':'
+    std::ignore = cursor.read_char();  // '['
+    const auto target_qubit0 = cursor.read_integer<std::size_t>();
+    std::ignore = cursor.read_char();  // ','
+    const auto target_qubit1 = cursor.read_integer<std::size_t>();
+    std::ignore = cursor.read_char();  // ']'
+
+    circuit.add_swap_gate(target_qubit0, target_qubit1);
+}
+
+void parse_one_target_gate_(ket::Gate gate, ket::QuantumCircuit& circuit, ket::internal::TextCursor& cursor)
+{
+    const auto target_qubit = parse_labelled_index_(cursor);
 
     const auto func = ket::internal::GATE_TO_FUNCTION_1T.at(gate);
     (circuit.*func)(target_qubit);
 }
 
-void parse_one_control_one_target_gate_(ket::Gate gate, ket::QuantumCircuit& circuit, std::stringstream& stream)
+void parse_one_control_one_target_gate_(ket::Gate gate, ket::QuantumCircuit& circuit, ket::internal::TextCursor& cursor)
 {
-    std::string dummy_str;
-    char dummy_ch;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t target_qubit;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t control_qubit;  // NOLINT(cppcoreguidelines-init-variables)
-
-    stream >> dummy_str;    // 'target'
-    stream >> dummy_str;    // ':'
-    stream >> dummy_ch;     // '['
-    stream >> target_qubit; // target qubit
-    stream >> dummy_ch;     // ']'
-    stream >> dummy_str;    // 'control'
-    stream >> dummy_str;    // ':'
-    stream >> dummy_ch;     // '['
-    stream >> control_qubit; // control qubit
-    stream >> dummy_ch;     // ']'
+    const auto target_qubit = parse_labelled_index_(cursor);
+    const auto control_qubit = parse_labelled_index_(cursor);
 
     const auto func = ket::internal::GATE_TO_FUNCTION_1C1T.at(gate);
     (circuit.*func)(control_qubit, target_qubit);
 }
 
-void parse_one_target_one_angle_gate_(ket::Gate gate, ket::QuantumCircuit& circuit, std::stringstream& stream)
+void parse_one_target_one_angle_gate_(ket::Gate gate, ket::QuantumCircuit& circuit, ket::internal::TextCursor& cursor)
 {
-    std::string dummy_str;
-    char dummy_ch;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t target_qubit;  // NOLINT(cppcoreguidelines-init-variables)
-    double angle;  // NOLINT(cppcoreguidelines-init-variables)
-
-    stream >> dummy_str;    // 'target'
-    stream >> dummy_str;    // ':'
-    stream >> dummy_ch;     // '['
-    stream >> target_qubit; // target qubit
-    stream >> dummy_ch;     // ']'
-    stream >> dummy_str;    // 'parameter'
-    stream >> dummy_str;    // ':'
-    stream >> angle;        // angle
+    const auto target_qubit = parse_labelled_index_(cursor);
+    const auto angle = parse_labelled_angle_(cursor);
 
     const auto func = ket::internal::GATE_TO_FUNCTION_1T1A.at(gate);
     (circuit.*func)(target_qubit, angle);
 }
 
-void parse_one_control_one_target_one_angle_gate_(ket::Gate gate, ket::QuantumCircuit& circuit, std::stringstream& stream)
+void parse_one_control_one_target_one_angle_gate_(ket::Gate gate, ket::QuantumCircuit& circuit, ket::internal::TextCursor& cursor)
 {
-    std::string dummy_str;
-    char dummy_ch;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t target_qubit;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t control_qubit;  // NOLINT(cppcoreguidelines-init-variables)
-    double angle;  // NOLINT(cppcoreguidelines-init-variables)
-
-    stream >> dummy_str;    // 'target'
-    stream >> dummy_str;    // ':'
-    stream >> dummy_ch;     // '['
-    stream >> target_qubit; // target qubit
-    stream >> dummy_ch;     // ']'
-    stream >> dummy_str;    // 'control'
-    stream >> dummy_str;    // ':'
-    stream >> dummy_ch;     // '['
-    stream >> control_qubit; // control qubit
-    stream >> dummy_ch;     // ']'
-    stream >> dummy_str;    // 'parameter'
-    stream >> dummy_str;    // ':'
-    stream >> angle;        // angle
+    const auto target_qubit = parse_labelled_index_(cursor);
+    const auto control_qubit = parse_labelled_index_(cursor);
+    const auto angle = parse_labelled_angle_(cursor);
 
     const auto func = ket::internal::GATE_TO_FUNCTION_1C1T1A.at(gate);
     (circuit.*func)(control_qubit, target_qubit, angle);
 }
 
-void parse_m_gate_(ket::QuantumCircuit& circuit, std::stringstream& stream)
+void parse_m_gate_(ket::QuantumCircuit& circuit, ket::internal::TextCursor& cursor)
 {
-    std::string dummy_str;
-    char dummy_ch;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t qubit;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t bit;  // NOLINT(cppcoreguidelines-init-variables)
-
-    stream >> dummy_str;    // 'target'
-    stream >> dummy_str;    // ':'
-    stream >> dummy_ch;     // '['
-    stream >> qubit;        // qubit
-    stream >> dummy_ch;     // ']'
-    stream >> dummy_str;    // 'bit'
-    stream >> dummy_str;    // ':'
-    stream >> dummy_ch;     // '['
-    stream >> bit;          // bit
-    stream >> dummy_ch;     // ']'
+    const auto qubit = parse_labelled_index_(cursor);
+    const auto bit = parse_labelled_index_(cursor);
 
     circuit.add_m_gate(qubit, bit);
 }
 
-auto parse_complex_(std::stringstream& stream) -> std::complex<double>
+auto parse_complex_(ket::internal::TextCursor& cursor) -> std::complex<double>
 {
-    char dummy_char;  // NOLINT(cppcoreguidelines-init-variables)
-    double real;  // NOLINT(cppcoreguidelines-init-variables)
-    double imag;  // NOLINT(cppcoreguidelines-init-variables)
-
-    stream >> dummy_char;    // '['
-    stream >> real;          // real component
-    stream >> dummy_char;    // ','
-    stream >> imag;          // imaginary component
-    stream >> dummy_char;    // ']'
+    std::ignore = cursor.read_char();  // '['
+    const auto real = cursor.read_double();
+    std::ignore = cursor.read_char();  // ','
+    const auto imag = cursor.read_double();
+    std::ignore = cursor.read_char();  // ']'
 
     return {real, imag};
 }
@@ -180,58 +227,121 @@ auto parse_matrix2x2_(std::istream& stream) -> ket::Matrix2X2
     std::string second_line;
 
     std::getline(stream, first_line);
-
-    auto sstream_first = std::stringstream {first_line};
-
     std::getline(stream, second_line);
-    auto sstream_second = std::stringstream {second_line};
 
-    const auto elem00 = parse_complex_(sstream_first);
-    const auto elem01 = parse_complex_(sstream_first);
-    const auto elem10 = parse_complex_(sstream_second);
-    const auto elem11 = parse_complex_(sstream_second);
+    auto cursor_first = ket::internal::TextCursor {first_line};
+    auto cursor_second = ket::internal::TextCursor {second_line};
+
+    const auto elem00 = parse_complex_(cursor_first);
+    const auto elem01 = parse_complex_(cursor_first);
+    const auto elem10 = parse_complex_(cursor_second);
+    const auto elem11 = parse_complex_(cursor_second);
 
     return {.elem00=elem00, .elem01=elem01, .elem10=elem10, .elem11=elem11};
 }
 
-void parse_u_gate_(ket::QuantumCircuit& circuit, std::stringstream& gateline_stream, std::istream& circuit_stream)
+void parse_u_gate_(ket::QuantumCircuit& circuit, ket::internal::TextCursor& cursor, std::istream& circuit_stream)
 {
-    std::string dummy_str;
-    char dummy_ch;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t target_qubit;  // NOLINT(cppcoreguidelines-init-variables)
-
-    gateline_stream >> dummy_str;    // 'target'
-    gateline_stream >> dummy_str;    // ':'
-    gateline_stream >> dummy_ch;     // '['
-    gateline_stream >> target_qubit; // target qubit
-    gateline_stream >> dummy_ch;     // ']'
+    const auto target_qubit = parse_labelled_index_(cursor);
 
     const auto unitary = parse_matrix2x2_(circuit_stream);
     circuit.add_u_gate(unitary, target_qubit);
 }
 
-void parse_cu_gate_(ket::QuantumCircuit& circuit, std::stringstream& gateline_stream, std::istream& circuit_stream)
+void parse_cu_gate_(ket::QuantumCircuit& circuit, ket::internal::TextCursor& cursor, std::istream& circuit_stream)
 {
-    std::string dummy_str;
-    char dummy_ch;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t target_qubit;  // NOLINT(cppcoreguidelines-init-variables)
-    std::size_t control_qubit;  // NOLINT(cppcoreguidelines-init-variables)
-
-    gateline_stream >> dummy_str;    // 'target'
-    gateline_stream >> dummy_str;    // ':'
-    gateline_stream >> dummy_ch;     // '['
-    gateline_stream >> target_qubit; // target qubit
-    gateline_stream >> dummy_ch;     // ']'
-    gateline_stream >> dummy_str;    // 'control'
-    gateline_stream >> dummy_str;    // ':'
-    gateline_stream >> dummy_ch;     // '['
-    gateline_stream >> control_qubit; // control qubit
-    gateline_stream >> dummy_ch;     // ']'
+    const auto target_qubit = parse_labelled_index_(cursor);
+    const auto control_qubit = parse_labelled_index_(cursor);
 
     const auto unitary = parse_matrix2x2_(circuit_stream);
     circuit.add_cu_gate(unitary, control_qubit, target_qubit);
 }
 
+/*
+    Parses a single line of a tangelo file and adds the gate or control flow statement it describes
+    to `circuit`; U-gates, CU-gates and control flow statements read their remaining lines from `stream`.
+*/
+void parse_tangelo_line_(  // NOLINT(misc-no-recursion, readability-function-cognitive-complexity)
+    ket::QuantumCircuit& circuit,
+    std::string_view line,
+    std::istream& stream
+)
+{
+    namespace gid = ket::internal::gate_id;
+    namespace io_par = ket::internal::parse;
+    using G = ket::Gate;
+
+    constexpr auto n_whitespace = ket::internal::CONTROL_FLOW_WHITESPACE_DEFAULT;
+
+    auto cursor = ket::internal::TextCursor {line};
+    const auto name = cursor.read_word();
+
+    if (name.empty()) {
+        return;
+    }
+
+    if (name == "IF") {
+        auto predicate_stream = std::stringstream {std::string {cursor.remaining()}};
+        auto predicate = io_par::parse_control_flow_predicate_(predicate_stream);
+
+        auto if_circuit = ket::read_tangelo_circuit(circuit.n_qubits(), stream, 0, n_whitespace);
+        circuit.add_if_statement(std::move(predicate), std::move(if_circuit));
+
+        return;
+    }
+
+    if (name == "ELSE") {
+        const auto n_elements = circuit.n_circuit_elements();
+        const auto top_element = circuit[n_elements - 1];
+        circuit.pop_back();
+
+        if (!top_element.is_control_flow() || !top_element.get_control_flow().is_if_statement()) {
+            throw std::runtime_error {"ERROR: encountered an 'ELSE' statement, but no previous matching 'IF' statement was found.\n"};
+        }
+
+        const auto& if_stmt = top_element.get_control_flow().get_if_statement();
+
+        auto else_circuit = ket::read_tangelo_circuit(circuit.n_qubits(), stream, 0, n_whitespace);
+        circuit.add_if_else_statement(if_stmt.predicate(), *if_stmt.circuit(), std::move(else_circuit));
+        return;
+    }
+
+    const auto& entry = find_tangelo_gate_(name);
+
+    // handle the special cases where tangelo has primitive gates that don't exist in the local code
+    if (entry.is_swap) {
+        parse_swap_gate_(circuit, cursor);
+        return;
+    }
+
+    const auto gate = entry.gate;
+
+    if (gid::is_one_target_transform_gate(gate)) {
+        parse_one_target_gate_(gate, circuit, cursor);
+    }
+    else if (gid::is_one_control_one_target_transform_gate(gate)) {
+        parse_one_control_one_target_gate_(gate, circuit, cursor);
+    }
+    else if (gid::is_one_target_one_angle_transform_gate(gate)) {
+        parse_one_target_one_angle_gate_(gate, circuit, cursor);
+    }
+    else if (gid::is_one_control_one_target_one_angle_transform_gate(gate)) {
+        parse_one_control_one_target_one_angle_gate_(gate, circuit, cursor);
+    }
+    else if (gate == G::M) {
+        parse_m_gate_(circuit, cursor);
+    }
+    else if (gate == G::U) {
+        parse_u_gate_(circuit, cursor, stream);
+    }
+    else if (gate == G::CU) {
+        parse_cu_gate_(circuit, cursor, stream);
+    }
+    else {
+        throw std::runtime_error {"DEV ERROR: A gate type with no implemented conversion has been encountered.\n"};
+    }
+}
+
 }  // namespace
 
 
@@ -245,12 +355,6 @@ auto read_tangelo_circuit(  // NOLINT(misc-no-recursion, readability-function-co
     std::optional<std::size_t> line_starts_with_spaces
 ) -> QuantumCircuit
 {
-    namespace gid = ket::internal::gate_id;
-    namespace io_par = ket::internal::parse;
-    using G = ket::Gate;
-
-    constexpr auto n_whitespace = ket::internal::CONTROL_FLOW_WHITESPACE_DEFAULT;
-
     auto circuit = ket::QuantumCircuit {n_qubits};
 
     std::string line;
@@ -261,8 +365,6 @@ auto read_tangelo_circuit(  // NOLINT(misc-no-recursion, readability-function-co
 
     auto curr_pos = stream.tellg();
     while (std::getline(stream, line)) {
-        auto gatestream = std::stringstream {line};
-
         // if the start of the line needs to satisfy a certain condition, and it doesn't; break early
         if (line_starts_with_spaces.has_value())
         {
@@ -274,83 +376,7 @@ auto read_tangelo_circuit(  // NOLINT(misc-no-recursion, readability-function-co
             }
         }
 
-        std::string name;
-        gatestream >> name;
-
-        if (name == "") {
-            continue;
-        }
-
-        if (name == "IF") {
-            auto predicate = io_par::parse_control_flow_predicate_(gatestream);
-            
-            auto if_circuit = read_tangelo_circuit(n_qubits, stream, 0, n_whitespace);
-            circuit.add_if_statement(std::move(predicate), std::move(if_circuit));
-
-            continue;
-        }
-
-        if (name == "ELSE") {
-            const auto n_elements = circuit.n_circuit_elements();
-            const auto top_element = circuit[n_elements - 1];
-            circuit.pop_back();
-
-            if (!top_element.is_control_flow() || !top_element.get_control_flow().is_if_statement()) {
-                throw std::runtime_error {"ERROR: encountered an 'ELSE' statement, but no previous matching 'IF' statement was found.\n"};
-            }
-
-            const auto& if_stmt = top_element.get_control_flow().get_if_statement();
-
-            auto else_circuit = read_tangelo_circuit(n_qubits, stream, 0, n_whitespace);
-            circuit.add_if_else_statement(if_stmt.predicate(), *if_stmt.circuit(), std::move(else_circuit));
-            continue;
-        }
-
-        const auto local_name = tangelo_to_local_name_(name);
-
-        // handle the special cases where tangelo has primitive gates that don't exist in the local code
-        if (local_name == "SWAP") {
-            parse_swap_gate_(circuit, gatestream);
-            continue;
-        }
-
-        // attempt to parse the gate
-        const auto gate = [&]() {
-            try {
-                return ket::internal::PRIMITIVE_GATES_TO_STRING.at_reverse(local_name);
-            }
-            catch (const std::runtime_error& e) {
-                auto err_msg = std::stringstream {};
-                err_msg << "Unknown gate found in `read_tangelo_file()` : " << local_name << '\n';
-                throw std::runtime_error {err_msg.str()};
-            }
-        }();
-
-        if (gid::is_one_target_transform_gate(gate)) {
-            parse_one_target_gate_(gate, circuit, gatestream);
-        }
-        else if (gid::is_one_control_one_target_transform_gate(gate)) {
-            parse_one_control_one_target_gate_(gate, circuit, gatestream);
-        }
-        else if (gid::is_one_target_one_angle_transform_gate(gate)) {
-            parse_one_target_one_angle_gate_(gate, circuit, gatestream);
-        }
-        else if (gid::is_one_control_one_target_one_angle_transform_gate(gate)) {
-            parse_one_control_one_target_one_angle_gate_(gate, circuit, gatestream);
-        }
-        else if (gate == G::M) {
-            parse_m_gate_(circuit, gatestream);
-        }
-        else if (gate == G::U) {
-            parse_u_gate_(circuit, gatestream, stream);
-        }
-        else if (gate == G::CU) {
-            parse_cu_gate_(circuit, gatestream, stream);
-        }
-        else {
-            throw std::runtime_error {"DEV ERROR: A gate type with no implemented conversion has been encountered.\n"};
-        }
-
+        parse_tangelo_line_(circuit, line, stream);
         curr_pos = stream.tellg();
     }
 
@@ -375,4 +401,42 @@ auto read_tangelo_circuit(
     return read_tangelo_circuit(n_qubits, instream, n_skip_lines);
 }
 
+TangeloCircuitReader::TangeloCircuitReader(std::size_t n_qubits, std::istream& stream, std::size_t n_skip_lines)
+    : n_qubits_ {n_qubits}
+    , stream_ {&stream}
+{
+    std::string line;
+
+    for (std::size_t i {0}; i < n_skip_lines; ++i) {
+        std::getline(*stream_, line);
+    }
+}
+
+auto TangeloCircuitReader::read_block(std::size_t n_elements) -> QuantumCircuit
+{
+    auto circuit = ket::QuantumCircuit {n_qubits_};
+
+    const auto ends_on_if_statement = [&]() {
+        if (circuit.n_circuit_elements() == 0) {
+            return false;
+        }
+
+        const auto& last = circuit[circuit.n_circuit_elements() - 1];
+        return last.is_control_flow() && last.get_control_flow().is_if_statement();
+    };
+
+    std::string line;
+
+    while (!is_done_ && (circuit.n_circuit_elements() < n_elements || ends_on_if_statement())) {
+        if (!std::getline(*stream_, line)) {
+            is_done_ = true;
+            break;
+        }
+
+        parse_tangelo_line_(circuit, line, *stream_);
+    }
+
+    return circuit;
+}
+
 }  // namespace ket
@@ -3,12 +3,19 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <tuple>
 #include <vector>
 
 #include "kettle/common/mathtools.hpp"
 #include "kettle/state/statevector.hpp"
+#include "kettle/io/binary_statevector.hpp"
 #include "kettle/io/statevector.hpp"
 
+#include "kettle_internal/io/binary_statevector_internal.hpp"
+#include "kettle_internal/io/mapped_file.hpp"
+#include "kettle_internal/io/text_cursor.hpp"
+
 namespace
 {
 
@@ -65,6 +72,49 @@ auto format_complex_(const std::complex<double>& value) -> std::string
     return output.str();
 }
 
+// the number of whitespace-separated tokens in the two header lines
+constexpr auto N_HEADER_TOKENS_ = std::size_t {6};
+
+struct TextStatevectorHeader_
+{
+    ket::Endian endian;
+    std::size_t n_states;
+};
+
+auto parse_header_(ket::internal::TextCursor& cursor) -> TextStatevectorHeader_
+{
+    // the first line contains the endianness
+    std::ignore = cursor.read_word();  // 'ENDIANNESS:'
+    const auto endian = string_to_endian_(std::string {cursor.read_word()});
+
+    // the next line contains the number of states
+    std::ignore = cursor.read_word();  // 'NUMBER'
+    std::ignore = cursor.read_word();  // 'OF'
+    std::ignore = cursor.read_word();  // 'STATES:'
+    const auto n_states = cursor.read_integer<std::size_t>();
+
+    return {.endian=endian, .n_states=n_states};
+}
+
+auto parse_statevector_(std::string_view text) -> ket::Statevector
+{
+    auto cursor = ket::internal::TextCursor {text};
+    const auto [endian, n_states] = parse_header_(cursor);
+
+    // the remaining lines contain the amplitudes
+    auto amplitudes = std::vector<std::complex<double>> {};
+    amplitudes.reserve(n_states);
+
+    for (std::size_t i {0}; i < n_states; ++i) {
+        const auto real = cursor.read_double();
+        const auto imag = cursor.read_double();
+
+        amplitudes.emplace_back(real, imag);
+    }
+
+    return ket::Statevector {std::move(amplitudes), endian};
+}
+
 }  // namespace
 
 
@@ -112,60 +162,28 @@ void save_statevector(
 
 auto load_statevector(std::istream& instream) -> Statevector
 {
-    // the first line contains the endianness
-    const auto endian = [&]() {
-        std::string dummy;
-        std::string endian_str;
-
-        instream >> dummy;  // 'ENDIANNESS'
-        instream >> endian_str;
-
-        return string_to_endian_(endian_str);
-    }();
-
-    // the next line contains the number of states
-    const auto n_states = [&]() {
-        std::string dummy;
-        std::size_t n_states_;  // NOLINT(cppcoreguidelines-init-variables)
-
-        instream >> dummy;  // 'NUMBER'
-        instream >> dummy;  // 'OF'
-        instream >> dummy;  // 'STATES'
-        instream >> n_states_;
-
-        return n_states_;
-    }();
-
-    // the remaining lines contain the amplitudes
-    auto amplitudes = std::vector<std::complex<double>> {};
-    amplitudes.reserve(n_states);
-
-    for (std::size_t i {0}; i < n_states; ++i) {
-        double real;  // NOLINT(cppcoreguidelines-init-variables)
-        double imag;  // NOLINT(cppcoreguidelines-init-variables)
-
-        instream >> real;
-        instream >> imag;
-
-        amplitudes.emplace_back(real, imag);
+    if (ket::internal::may_start_binary_statevector(instream)) {
+        return load_binary_statevector(instream);
     }
 
-    return Statevector {amplitudes, endian};
+    // the two header lines hold 6 tokens, and each of the next lines holds the two parts of an amplitude
+    auto text = ket::internal::read_text_with_tokens(instream, N_HEADER_TOKENS_);
+    auto header_cursor = ket::internal::TextCursor {text};
+    const auto header = parse_header_(header_cursor);
+    text += ket::internal::read_text_with_tokens(instream, 2 * header.n_states);
+
+    return parse_statevector_(text);
 }
 
 auto load_statevector(const std::filesystem::path& filepath) -> Statevector
 {
-    auto instream = std::ifstream {filepath};
+    const auto file = ket::internal::MappedFile {filepath};
 
-    if (!instream.is_open()) {
-        auto err_msg = std::stringstream {};
-        err_msg << "ERROR: unable to open file to load statevector: \n";
-        err_msg << "'" << filepath << "'\n";
-
-        throw std::ios::failure {err_msg.str()};
+    if (ket::internal::has_binary_statevector_magic(file.bytes())) {
+        return read_binary_statevector(file.bytes());
     }
 
-    return load_statevector(instream);
+    return parse_statevector_(file.text());
 }
 
 }  // namespace ket
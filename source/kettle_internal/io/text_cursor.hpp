@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+
+/*
+    This header file contains the `TextCursor` class, a tokenizer shared by the readers of the text
+    file formats (tangelo circuits, Pauli operators, and statevectors).
+*/
+
+namespace ket::internal
+{
+
+/*
+    A cursor over a buffer of text, that reads whitespace-separated tokens and numbers in place,
+    without copying them into a stream first; numbers are parsed with `std::from_chars()`, or with
+    `std::strtod()` for floating-point numbers where `std::from_chars()` does not support them.
+
+    Like `operator>>` on a stream, each read skips any leading whitespace, and a number may start
+    with a '+' sign. Unlike a stream, a read that fails throws a `std::runtime_error`, instead of
+    silently setting a fail bit.
+*/
+class TextCursor
+{
+public:
+    explicit constexpr TextCursor(std::string_view text) noexcept
+        : text_ {text}
+    {}
+
+    /*
+        Returns `true` if only whitespace remains in the text.
+    */
+    [[nodiscard]]
+    constexpr auto is_at_end() noexcept -> bool
+    {
+        skip_whitespace_();
+        return position_ == text_.size();
+    }
+
+    /*
+        Returns the next non-whitespace character without consuming it, or '\0' at the end of the text.
+    */
+    [[nodiscard]]
+    constexpr auto peek() noexcept -> char
+    {
+        skip_whitespace_();
+        return position_ == text_.size() ? '\0' : text_[position_];
+    }
+
+    /*
+        Returns the text that has not been read yet.
+    */
+    [[nodiscard]]
+    constexpr auto remaining() const noexcept -> std::string_view
+    {
+        return text_.substr(position_);
+    }
+
+    auto read_char() -> char
+    {
+        skip_whitespace_();
+        check_not_at_end_();
+
+        return text_[position_++];
+    }
+
+    /*
+        Reads the characters up to the next whitespace character or the end of the text.
+    */
+    auto read_word() -> std::string_view
+    {
+        skip_whitespace_();
+
+        const auto start = position_;
+        while (position_ < text_.size() && !is_whitespace_(text_[position_])) {
+            ++position_;
+        }
+
+        return text_.substr(start, position_ - start);
+    }
+
+    /*
+        Reads the characters up to the next newline or the end of the text, without skipping any
+        leading whitespace; the newline itself is consumed, but not returned.
+    */
+    auto read_line() -> std::string_view
+    {
+        const auto start = position_;
+        const auto end = text_.find('\n', start);
+
+        if (end == std::string_view::npos) {
+            position_ = text_.size();
+            return text_.substr(start);
+        }
+
+        position_ = end + 1;
+        return text_.substr(start, end - start);
+    }
+
+    template <std::integral Integer>
+    auto read_integer() -> Integer
+    {
+        skip_whitespace_();
+        skip_plus_sign_();
+
+        auto value = Integer {};
+        const auto* begin = text_.data() + position_;
+        const auto* end = text_.data() + text_.size();
+        const auto [ptr, error] = std::from_chars(begin, end, value);
+
+        if (error != std::errc {}) {
+            throw_invalid_number_();
+        }
+
+        position_ += static_cast<std::size_t>(ptr - begin);
+        return value;
+    }
+
+    /*
+        Reads a floating-point number; `std::from_chars()` is used where the standard library provides
+        its floating-point overloads, and `std::strtod()` is used otherwise (e.g. older versions of libc++).
+    */
+    auto read_double() -> double
+    {
+        skip_whitespace_();
+        skip_plus_sign_();
+
+#if defined(__cpp_lib_to_chars)
+        auto value = double {};
+        const auto* begin = text_.data() + position_;
+        const auto* end = text_.data() + text_.size();
+        const auto [ptr, error] = std::from_chars(begin, end, value);
+
+        if (error != std::errc {}) {
+            throw_invalid_number_();
+        }
+
+        position_ += static_cast<std::size_t>(ptr - begin);
+        return value;
+#else
+        return read_double_with_strtod_();
+#endif
+    }
+
+    /*
+        Skips characters until `delimiter` is found; the delimiter itself is not consumed.
+    */
+    constexpr void skip_until(char delimiter) noexcept
+    {
+        while (position_ < text_.size() && text_[position_] != delimiter) {
+            ++position_;
+        }
+    }
+
+private:
+    std::string_view text_;
+    std::size_t position_ {0};
+
+    static constexpr auto is_whitespace_(char ch) noexcept -> bool
+    {
+        return ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r' || ch == '\v' || ch == '\f';
+    }
+
+    constexpr void skip_whitespace_() noexcept
+    {
+        while (position_ < text_.size() && is_whitespace_(text_[position_])) {
+            ++position_;
+        }
+    }
+
+#if !defined(__cpp_lib_to_chars)
+    // long enough for any number written with the 17 significant digits needed to round trip a double
+    static constexpr auto MAX_DOUBLE_TOKEN_SIZE_ = std::size_t {127};
+
+    /*
+        `std::strtod()` needs a null-terminated string, and the text is not null-terminated after each
+        number, so the token is copied into a bounded local buffer first.
+    */
+    auto read_double_with_strtod_() -> double
+    {
+        auto token_size = std::size_t {0};
+        while (position_ + token_size < text_.size() && !is_whitespace_(text_[position_ + token_size])) {
+            ++token_size;
+        }
+
+        auto buffer = std::array<char, MAX_DOUBLE_TOKEN_SIZE_ + 1> {};
+        const auto n_copied = std::min(token_size, MAX_DOUBLE_TOKEN_SIZE_);
+        text_.copy(buffer.data(), n_copied, position_);
+
+        char* ptr = nullptr;  // NOLINT(cppcoreguidelines-init-variables)
+        errno = 0;
+        const auto value = std::strtod(buffer.data(), &ptr);
+
+        const auto n_parsed = static_cast<std::size_t>(ptr - buffer.data());
+
+        // a number that fills the whole buffer may have been cut off, so it cannot be trusted
+        if (n_parsed == 0 || n_parsed == MAX_DOUBLE_TOKEN_SIZE_ || errno == ERANGE) {
+            throw_invalid_number_();
+        }
+
+        position_ += n_parsed;
+        return value;
+    }
+#endif
+
+    constexpr void skip_plus_sign_() noexcept
+    {
+        if (position_ < text_.size() && text_[position_] == '+') {
+            ++position_;
+        }
+    }
+
+    void check_not_at_end_() const
+    {
+        if (position_ == text_.size()) {
+            throw std::runtime_error {"ERROR: unexpected end of text while parsing.\n"};
+        }
+    }
+
+    [[noreturn]]
+    void throw_invalid_number_() const
+    {
+        auto err_msg = std::string {"ERROR: expected a number while parsing, found : '"};
+        err_msg += remaining().substr(0, 32);
+        err_msg += "'\n";
+
+        throw std::runtime_error {err_msg};
+    }
+};
+
+/*
+    Reads everything left in `instream` into a single string, in bulk.
+*/
+inline auto read_all_text(std::istream& instream) -> std::string
+{
+    auto output = std::string {};
+
+    char buffer[1 << 16];  // NOLINT(*avoid-c-arrays*)
+    while (instream.read(buffer, sizeof(buffer)) || instream.gcount() > 0) {
+        output.append(buffer, static_cast<std::size_t>(instream.gcount()));
+    }
+
+    return output;
+}
+
+/*
+    Reads whole lines from `instream` into a single string, until the lines hold `n_tokens`
+    whitespace-separated tokens (or the stream ends). Unlike `read_all_text()`, nothing past the
+    line with the last of these tokens is consumed, so the stream can hold more data after them.
+*/
+inline auto read_text_with_tokens(std::istream& instream, std::size_t n_tokens) -> std::string
+{
+    auto output = std::string {};
+    auto line = std::string {};
+    auto n_tokens_read = std::size_t {0};
+
+    while (n_tokens_read < n_tokens && std::getline(instream, line)) {
+        auto cursor = TextCursor {line};
+        while (!cursor.is_at_end()) {
+            std::ignore = cursor.read_word();
+            ++n_tokens_read;
+        }
+
+        output += line;
+        output += '\n';
+    }
+
+    return output;
+}
+
+}  // namespace ket::internal
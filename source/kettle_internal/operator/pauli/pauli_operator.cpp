@@ -1,18 +1,75 @@
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <complex>
+#include <cstddef>
 #include <initializer_list>
+#include <stdexcept>
 #include <vector>
 
 #include "kettle/common/mathtools.hpp"
 #include "kettle/operator/pauli/pauli_operator.hpp"
 #include "kettle/operator/pauli/sparse_pauli_string.hpp"
-#include "kettle/simulation/simulate_pauli.hpp"
 #include "kettle/state/statevector.hpp"
 
 /*
     This file contains the `PauliOperator` class for 
 */
 
+namespace
+{
+
+/*
+    A Pauli string written as `phase * X^x_mask * Z^z_mask`, where bit `i` of each mask is set if the
+    corresponding operator acts on qubit `i`; since Y = iXZ, each Y term contributes a factor of i to
+    the phase, on top of the phase of the string itself.
+*/
+struct PauliStringMasks_
+{
+    std::size_t x_mask;
+    std::size_t z_mask;
+    std::complex<double> phase;
+};
+
+auto pauli_string_masks_(const ket::SparsePauliString& pauli_string) -> PauliStringMasks_
+{
+    using PT = ket::PauliTerm;
+
+    auto x_mask = std::size_t {0};
+    auto z_mask = std::size_t {0};
+    auto n_y_terms = std::size_t {0};
+
+    for (const auto& [qubit_index, pauli_term] : pauli_string.terms()) {
+        const auto bit = std::size_t {1} << qubit_index;
+
+        if (pauli_term == PT::X || pauli_term == PT::Y) {
+            x_mask |= bit;
+        }
+
+        if (pauli_term == PT::Z || pauli_term == PT::Y) {
+            z_mask |= bit;
+        }
+
+        if (pauli_term == PT::Y) {
+            ++n_y_terms;
+        }
+    }
+
+    const auto powers_of_i = std::array<std::complex<double>, 4> {{{1.0, 0.0}, {0.0, 1.0}, {-1.0, 0.0}, {0.0, -1.0}}};
+    const auto phase = ket::PAULI_PHASE_MAP.at(pauli_string.phase()) * powers_of_i[n_y_terms % 4];
+
+    return {.x_mask=x_mask, .z_mask=z_mask, .phase=phase};
+}
+
+void check_matching_number_of_qubits_(const ket::SparsePauliString& pauli_string, const ket::Statevector& state)
+{
+    if (pauli_string.n_qubits() != state.n_qubits()) {
+        throw std::runtime_error {"ERROR: the SparsePauliString and the state have different numbers of qubits.\n"};
+    }
+}
+
+}  // namespace
+
 namespace ket
 {
 
@@ -78,13 +135,7 @@ auto expectation_value(const PauliOperator& pauli_op, const Statevector& state)
     auto expval = std::complex<double> {};
 
     for (const auto& [coeff, sparse_pauli_string] : pauli_op.weighted_pauli_strings()) {
-        auto ket = state;
-        simulate(sparse_pauli_string, ket);
-
-        const auto inner_prod = inner_product(state, ket);
-        const auto phase = PAULI_PHASE_MAP.at(sparse_pauli_string.phase());
-
-        expval += (coeff * phase * inner_prod);
+        expval += coeff * expectation_value(sparse_pauli_string, state);
     }
 
     return expval;
@@ -93,15 +144,29 @@ auto expectation_value(const PauliOperator& pauli_op, const Statevector& state)
 
 auto expectation_value(const SparsePauliString& sparse_pauli_string, const Statevector& state) -> std::complex<double>
 {
-    auto ket = state;
-    simulate(sparse_pauli_string, ket);
+    check_matching_number_of_qubits_(sparse_pauli_string, state);
 
-    const auto inner_prod = inner_product(state, ket);
-    const auto phase = PAULI_PHASE_MAP.at(sparse_pauli_string.phase());
+    const auto masks = pauli_string_masks_(sparse_pauli_string);
+    const auto n_states = state.n_states();
 
-    const auto expval = phase * inner_prod;
+    // the diagonal strings (only I and Z) are the most common ones, and only need the probabilities
+    if (masks.x_mask == 0) {
+        auto sum = 0.0;
+        for (std::size_t i {0}; i < n_states; ++i) {
+            const auto sign = (std::popcount(i & masks.z_mask) % 2 == 0) ? 1.0 : -1.0;
+            sum += sign * std::norm(state[i]);
+        }
 
-    return expval;
+        return masks.phase * sum;
+    }
+
+    auto sum = std::complex<double> {};
+    for (std::size_t i {0}; i < n_states; ++i) {
+        const auto sign = (std::popcount(i & masks.z_mask) % 2 == 0) ? 1.0 : -1.0;
+        sum += sign * (std::conj(state[i ^ masks.x_mask]) * state[i]);
+    }
+
+    return masks.phase * sum;
 }
 
 auto almost_eq(
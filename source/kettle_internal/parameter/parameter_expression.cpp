@@ -56,7 +56,7 @@ auto unpack_target_and_angle(
     const ket::GateInfo& info
 ) -> std::tuple<std::size_t, double>
 {
-    if (info.param_expression_ptr) {
+    if (info.param_expression_ptr()) {
         auto [target_qubit, param_expression_ptr] = ki::create::unpack_one_target_one_parameter_gate(info);
         auto angle = Evaluator{}.evaluate(*param_expression_ptr, parameter_values_map);
 
@@ -71,7 +71,7 @@ auto unpack_control_target_and_angle(
     const ket::GateInfo& info
 ) -> std::tuple<std::size_t, std::size_t, double>
 {
-    if (info.param_expression_ptr) {
+    if (info.param_expression_ptr()) {
         auto [control_qubit, target_qubit, param_expression_ptr] = ki::create::unpack_one_control_one_target_one_parameter_gate(info);
         auto angle = Evaluator{}.evaluate(*param_expression_ptr, parameter_values_map);
 
@@ -0,0 +1,124 @@
+#include <complex>
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+#include "kettle/common/matrix2x2.hpp"
+#include "kettle/state/sparse_statevector.hpp"
+
+#include "kettle_internal/simulation/operations_sparse.hpp"
+
+namespace
+{
+
+constexpr auto is_zero_(const std::complex<double>& value) noexcept -> bool
+{
+    return value.real() == 0.0 && value.imag() == 0.0;
+}
+
+}  // namespace
+
+namespace ket::internal
+{
+
+void apply_u_gate_sparse(
+    ket::SparseStatevector& state,
+    const ket::Matrix2X2& mat,
+    std::size_t target_index,
+    std::optional<std::size_t> control_index
+)
+{
+    const auto target_mask = std::size_t {1} << target_index;
+    const auto control_mask = control_index ? (std::size_t {1} << *control_index) : std::size_t {0};
+    const auto is_active = [control_mask](std::size_t index) { return (index & control_mask) == control_mask; };
+
+    auto& amplitudes = state.amplitudes();
+
+    // diagonal gates (Z, S, T, RZ, P, etc.) never change the support; only the phases
+    if (is_zero_(mat.elem01) && is_zero_(mat.elem10)) {
+        for (auto& [index, amplitude] : amplitudes) {
+            if (is_active(index)) {
+                amplitude *= ((index & target_mask) == 0) ? mat.elem00 : mat.elem11;
+            }
+        }
+
+        state.prune();
+        return;
+    }
+
+    auto new_amplitudes = ket::SparseStatevector::AmplitudeMap {};
+    new_amplitudes.reserve(2 * amplitudes.size());
+
+    // each basis state contributes to itself and to its partner with the target bit flipped;
+    // multiplying by an exact zero matrix element would only add entries that get pruned anyway
+    const auto add_contribution = [&](std::size_t index, const std::complex<double>& factor, const std::complex<double>& amplitude) {
+        if (!is_zero_(factor)) {
+            new_amplitudes[index] += factor * amplitude;
+        }
+    };
+
+    for (const auto& [index, amplitude] : amplitudes) {
+        if (!is_active(index)) {
+            new_amplitudes[index] += amplitude;
+            continue;
+        }
+
+        const auto index0 = index & ~target_mask;
+        const auto index1 = index | target_mask;
+
+        if ((index & target_mask) == 0) {
+            add_contribution(index0, mat.elem00, amplitude);
+            add_contribution(index1, mat.elem10, amplitude);
+        }
+        else {
+            add_contribution(index0, mat.elem01, amplitude);
+            add_contribution(index1, mat.elem11, amplitude);
+        }
+    }
+
+    amplitudes = std::move(new_amplitudes);
+    state.prune();
+}
+
+auto probabilities_of_collapsed_states_sparse_(
+    const ket::SparseStatevector& state,
+    std::size_t qubit_index
+) -> std::tuple<double, double>
+{
+    const auto qubit_mask = std::size_t {1} << qubit_index;
+
+    auto prob_of_0_states = double {0.0};
+    auto prob_of_1_states = double {0.0};
+
+    for (const auto& [index, amplitude] : state.amplitudes()) {
+        if ((index & qubit_mask) == 0) {
+            prob_of_0_states += std::norm(amplitude);
+        }
+        else {
+            prob_of_1_states += std::norm(amplitude);
+        }
+    }
+
+    return {prob_of_0_states, prob_of_1_states};
+}
+
+void collapse_and_renormalize_sparse_(
+    ket::SparseStatevector& state,
+    std::size_t qubit_index,
+    int measured_state,
+    double norm_of_surviving_state
+)
+{
+    const auto qubit_mask = std::size_t {1} << qubit_index;
+    const auto surviving_bits = (measured_state == 0) ? std::size_t {0} : qubit_mask;
+
+    auto& amplitudes = state.amplitudes();
+    std::erase_if(amplitudes, [&](const auto& pair) { return (pair.first & qubit_mask) != surviving_bits; });
+
+    for (auto& [ignore, amplitude] : amplitudes) {
+        amplitude *= norm_of_surviving_state;
+    }
+}
+
+}  // namespace ket::internal
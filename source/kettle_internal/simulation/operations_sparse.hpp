@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <tuple>
+
+#include "kettle/common/matrix2x2.hpp"
+#include "kettle/state/sparse_statevector.hpp"
+
+/*
+    This header file contains the operations performed on the SparseStatevector object.
+
+    Each operation only visits the basis states in the support of the state, so the cost of
+    applying a gate scales with the number of nonzero amplitudes rather than with 2^n.
+*/
+
+namespace ket::internal
+{
+
+/*
+    Apply the 2x2 unitary `mat` to the qubit at `target_index`.
+
+    If `control_index` is given, the unitary only acts on the basis states where the control qubit
+    is set. Diagonal unitaries are applied in place; all other unitaries rebuild the support.
+*/
+void apply_u_gate_sparse(
+    ket::SparseStatevector& state,
+    const ket::Matrix2X2& mat,
+    std::size_t target_index,
+    std::optional<std::size_t> control_index = std::nullopt
+);
+
+/*
+    Calculate the probabilities of measuring the qubit at `qubit_index` in the 0 and 1 states.
+*/
+auto probabilities_of_collapsed_states_sparse_(
+    const ket::SparseStatevector& state,
+    std::size_t qubit_index
+) -> std::tuple<double, double>;
+
+/*
+    Remove all basis states where the qubit at `qubit_index` is not in `measured_state`, and
+    renormalize the remaining amplitudes by multiplying them by `norm_of_surviving_state`.
+*/
+void collapse_and_renormalize_sparse_(
+    ket::SparseStatevector& state,
+    std::size_t qubit_index,
+    int measured_state,
+    double norm_of_surviving_state
+);
+
+}  // namespace ket::internal
@@ -1,4 +1,9 @@
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <optional>
+#include <random>
 #include <stdexcept>
 #include <type_traits>
 #include <vector>
@@ -12,10 +17,12 @@
 
 #include "kettle/simulation/simulate.hpp"
 
+#include "kettle_internal/common/prng.hpp"
 #include "kettle_internal/gates/primitive_gate/gate_create.hpp"
 #include "kettle_internal/parameter/parameter_expression_internal.hpp"
 #include "kettle_internal/simulation/gate_pair_generator.hpp"
 #include "kettle_internal/simulation/measure.hpp"
+#include "kettle_internal/simulation/simulate_branches.hpp"
 #include "kettle_internal/simulation/simulate_utils.hpp"
 #include "kettle_internal/simulation/operations.hpp"
 
@@ -414,6 +421,48 @@ void simulate_gate_info_(
     }
 }
 
+using Elements = std::reference_wrapper<const std::vector<ket::CircuitElement>>;
+
+/*
+    Pushes the elements of the subcircuit chosen by `control_flow` (if any) onto the stack of
+    elements to be simulated, based on the current values in the classical register.
+*/
+void push_control_flow_elements_(
+    const ket::ClassicalControlFlowInstruction& control_flow,
+    const ket::ClassicalRegister& cregister,
+    std::vector<Elements>& elements_stack,
+    std::vector<std::size_t>& instruction_pointers
+)
+{
+    if (control_flow.is_if_statement()) {
+        const auto& if_stmt = control_flow.get_if_statement();
+
+        if (if_stmt(cregister)) {
+            const auto& subcircuit = *if_stmt.circuit();
+            elements_stack.push_back(std::ref(subcircuit.circuit_elements()));
+            instruction_pointers.push_back(0);
+        }
+    }
+    else if (control_flow.is_if_else_statement()) {
+        const auto& if_else_stmt = control_flow.get_if_else_statement();
+
+        // NOTE: omitting the return type here causes a dangling reference
+        const auto& subcircuit = [&]() -> const ket::QuantumCircuit& {
+            if (if_else_stmt(cregister)) {
+                return *if_else_stmt.if_circuit();
+            } else {
+                return *if_else_stmt.else_circuit();
+            }
+        }();
+
+        elements_stack.push_back(std::ref(subcircuit.circuit_elements()));
+        instruction_pointers.push_back(0);
+    }
+    else {
+        throw std::runtime_error {"DEV ERROR: unimplemented control flow in `push_control_flow_elements_()`\n"};
+    }
+}
+
 auto simulate_loop_body_iterative_(  // NOLINT(readability-function-cognitive-complexity)
     const ket::QuantumCircuit& circuit,
     ket::Statevector& state,
@@ -424,8 +473,6 @@ auto simulate_loop_body_iterative_(  // NOLINT(readability-function-cognitive-co
     ket::ClassicalRegister& cregister
 ) -> std::vector<ket::CircuitLogger>
 {
-    using Elements = std::reference_wrapper<const std::vector<ket::CircuitElement>>;
-
     auto elements_stack = std::vector<Elements> {};
     elements_stack.push_back(std::ref(circuit.circuit_elements()));
 
@@ -468,35 +515,7 @@ auto simulate_loop_body_iterative_(  // NOLINT(readability-function-cognitive-co
             }
         }
         else if (element.is_control_flow()) {
-            const auto& control_flow = element.get_control_flow();
-
-            if (control_flow.is_if_statement()) {
-                const auto& if_stmt = control_flow.get_if_statement();
-
-                if (if_stmt(cregister)) {
-                    const auto& subcircuit = *if_stmt.circuit();
-                    elements_stack.push_back(std::ref(subcircuit.circuit_elements()));
-                    instruction_pointers.push_back(0);
-                }
-            }
-            else if (control_flow.is_if_else_statement()) {
-                const auto& if_else_stmt = control_flow.get_if_else_statement();
-
-                // NOTE: omitting the return type here causes a dangling reference
-                const auto& subcircuit = [&]() -> const ket::QuantumCircuit& {
-                    if (if_else_stmt(cregister)) {
-                        return *if_else_stmt.if_circuit();
-                    } else {
-                        return *if_else_stmt.else_circuit();
-                    }
-                }();
-
-                elements_stack.push_back(std::ref(subcircuit.circuit_elements()));
-                instruction_pointers.push_back(0);
-            }
-            else {
-                throw std::runtime_error {"DEV ERROR: unimplemented control flow in `simulate_loop_body_iterative_()`\n"};
-            }
+            push_control_flow_elements_(element.get_control_flow(), cregister, elements_stack, instruction_pointers);
         }
         else if (element.is_gate()) {
             const auto gate_info = element.get_gate();
@@ -520,6 +539,111 @@ auto simulate_loop_body_iterative_(  // NOLINT(readability-function-cognitive-co
     return circuit_loggers;
 }
 
+/*
+    A branch of the shot-branching simulation, together with the position in the circuit where its
+    simulation should continue.
+*/
+struct PendingBranch_
+{
+    ket::SimulationBranch branch;
+    std::vector<Elements> elements_stack;
+    std::vector<std::size_t> instruction_pointers;
+};
+
+/*
+    Continues the simulation of `pending` until the end of the circuit; at each measurement, the shots
+    of the branch are split between the two outcomes, and if both outcomes receive shots, the branch
+    for the outcome of 1 is copied and pushed onto `pending_branches` to be simulated later.
+*/
+void simulate_pending_branch_(  // NOLINT(readability-function-cognitive-complexity)
+    const kpi::MapVariant& parameter_values_map,
+    PendingBranch_& pending,
+    std::vector<PendingBranch_>& pending_branches,
+    ket::internal::Prng& prng
+)
+{
+    namespace cre = ki::create;
+
+    const auto n_qubits = pending.branch.state.n_qubits();
+
+    const auto n_single_gate_pairs = ki::number_of_single_qubit_gate_pairs_(n_qubits);
+    const auto single_pair = ki::FlatIndexPair<std::size_t> {.i_lower=0, .i_upper=n_single_gate_pairs};
+
+    const auto n_double_gate_pairs = ki::number_of_double_qubit_gate_pairs_(n_qubits);
+    const auto double_pair = ki::FlatIndexPair<std::size_t> {.i_lower=0, .i_upper=n_double_gate_pairs};
+
+    auto& [branch, elements_stack, instruction_pointers] = pending;
+
+    while (elements_stack.size() != 0) {
+        const auto& elements = elements_stack.back();
+        const auto i_ptr = instruction_pointers.back();
+
+        ++instruction_pointers.back();
+
+        if (i_ptr >= elements.get().size()) {
+            elements_stack.pop_back();
+            instruction_pointers.pop_back();
+            continue;
+        }
+
+        const auto& element = elements.get()[i_ptr];
+
+        if (element.is_circuit_logger()) {
+            // the loggers record a single trajectory, which no longer exists when the shots are branched
+            continue;
+        }
+        else if (element.is_control_flow()) {
+            push_control_flow_elements_(element.get_control_flow(), branch.cregister, elements_stack, instruction_pointers);
+        }
+        else if (element.is_gate() && element.get_gate().gate == ket::Gate::M) {
+            const auto gate_info = element.get_gate();
+            [[maybe_unused]]
+            const auto [ignore, bit_index] = cre::unpack_m_gate(gate_info);
+
+            const auto [prob_of_0_states, prob_of_1_states] = ki::probabilities_of_collapsed_states_(branch.state, gate_info);
+            const auto prob_of_1 = prob_of_1_states / (prob_of_0_states + prob_of_1_states);
+
+            auto distribution = std::binomial_distribution<std::size_t> {branch.n_shots, prob_of_1};
+            const auto n_shots_1 = distribution(prng);
+            const auto n_shots_0 = branch.n_shots - n_shots_1;
+
+            if (n_shots_0 != 0 && n_shots_1 != 0) {
+                auto other = pending;
+                ki::collapse_and_renormalize_<0>(other.branch.state, gate_info, std::sqrt(1.0 / prob_of_1_states));
+                other.branch.cregister.set(bit_index, 1);
+                other.branch.n_shots = n_shots_1;
+                pending_branches.push_back(std::move(other));
+            }
+
+            if (n_shots_0 != 0) {
+                ki::collapse_and_renormalize_<1>(branch.state, gate_info, std::sqrt(1.0 / prob_of_0_states));
+                branch.cregister.set(bit_index, 0);
+                branch.n_shots = n_shots_0;
+            }
+            else {
+                ki::collapse_and_renormalize_<0>(branch.state, gate_info, std::sqrt(1.0 / prob_of_1_states));
+                branch.cregister.set(bit_index, 1);
+            }
+        }
+        else if (element.is_gate()) {
+            // the measurement gates are handled above, so the thread id and seed are never used
+            simulate_gate_info_(
+                parameter_values_map,
+                branch.state,
+                single_pair,
+                double_pair,
+                element.get_gate(),
+                MEASURING_THREAD_ID,
+                std::nullopt,
+                branch.cregister
+            );
+        }
+        else {
+            throw std::runtime_error {"DEV ERROR: unimplemented circuit element in `simulate_pending_branch_()`\n"};
+        }
+    }
+}
+
 void check_valid_number_of_qubits_(const ket::QuantumCircuit& circuit, const ket::Statevector& state)
 {
     if (circuit.n_qubits() != state.n_qubits()) {
@@ -559,6 +683,39 @@ void StatevectorSimulator::run(const QuantumCircuit& circuit, Statevector& state
     has_been_run_ = true;
 }
 
+void StatevectorSimulator::resume(const QuantumCircuit& circuit, Statevector& state, std::optional<int> prng_seed)
+{
+    namespace ki = ket::internal;
+
+    if (!cregister_) {
+        run(circuit, state, prng_seed);
+        return;
+    }
+
+    check_valid_number_of_qubits_(circuit, state);
+
+    if ((*cregister_).n_bits() != circuit.n_bits()) {
+        throw std::runtime_error {"ERROR: cannot resume a simulation with a circuit with a different number of bits.\n"};
+    }
+
+    const auto n_single_gate_pairs = ki::number_of_single_qubit_gate_pairs_(circuit.n_qubits());
+    const auto single_pair = ki::FlatIndexPair<std::size_t> {.i_lower=0, .i_upper=n_single_gate_pairs};
+
+    const auto n_double_gate_pairs = ki::number_of_double_qubit_gate_pairs_(circuit.n_qubits());
+    const auto double_pair = ki::FlatIndexPair<std::size_t> {.i_lower=0, .i_upper=n_double_gate_pairs};
+
+    const auto thread_id = MEASURING_THREAD_ID;
+
+    auto new_loggers = simulate_loop_body_iterative_(circuit, state, single_pair, double_pair, thread_id, prng_seed, *cregister_);
+    circuit_loggers_.insert(
+        circuit_loggers_.end(),
+        std::make_move_iterator(new_loggers.begin()),
+        std::make_move_iterator(new_loggers.end())
+    );
+
+    has_been_run_ = true;
+}
+
 [[nodiscard]]
 auto StatevectorSimulator::has_been_run() const -> bool
 {
@@ -596,10 +753,67 @@ void simulate(const QuantumCircuit& circuit, Statevector& state, std::optional<i
     simulator.run(circuit, state, prng_seed);
 }
 
+auto simulate_branches(
+    const QuantumCircuit& circuit,
+    const Statevector& state,
+    std::size_t n_shots,
+    std::optional<int> prng_seed
+) -> std::vector<SimulationBranch>
+{
+    auto prng = ki::get_prng_(prng_seed);
+
+    auto branches = std::vector<SimulationBranch> {};
+    ki::simulate_branches_(circuit, state, n_shots, prng, [&](SimulationBranch& branch) {
+        branches.push_back(std::move(branch));
+    });
+
+    return branches;
+}
 
 }  // namespace ket
 
 
+namespace ket::internal
+{
+
+void simulate_branches_(
+    const ket::QuantumCircuit& circuit,
+    const ket::Statevector& state,
+    std::size_t n_shots,
+    ket::internal::Prng& prng,
+    const std::function<void(ket::SimulationBranch&)>& visit_branch
+)
+{
+    check_valid_number_of_qubits_(circuit, state);
+
+    if (n_shots == 0) {
+        return;
+    }
+
+    const auto& parameter_values_map = kpi::create_parameter_values_map(circuit.parameter_data_map());
+
+    auto pending_branches = std::vector<PendingBranch_> {};
+    pending_branches.push_back(PendingBranch_ {
+        .branch = ket::SimulationBranch {.state = state, .cregister = ket::ClassicalRegister {circuit.n_bits()}, .n_shots = n_shots},
+        .elements_stack = {std::ref(circuit.circuit_elements())},
+        .instruction_pointers = {0}
+    });
+
+    // the branches are simulated depth-first, and each finished branch is handed to the visitor and
+    // then dropped, so only the branches split off along the path to the current branch are held in
+    // memory at once
+    while (!pending_branches.empty()) {
+        auto pending = std::move(pending_branches.back());
+        pending_branches.pop_back();
+
+        simulate_pending_branch_(parameter_values_map, pending, pending_branches, prng);
+        visit_branch(pending.branch);
+    }
+}
+
+}  // namespace ket::internal
+
+
 // void simulate_multithreaded_loop_(
 //     std::barrier<>& sync_point,
 //     const ket::QuantumCircuit& circuit,
@@ -0,0 +1,414 @@
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit/circuit_element.hpp"
+#include "kettle/common/matrix2x2.hpp"
+#include "kettle/gates/primitive_gate.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/simulation/simulate_density_matrix.hpp"
+#include "kettle/simulation/simulate_sparse.hpp"
+#include "kettle/state/density_matrix.hpp"
+#include "kettle/state/sparse_statevector.hpp"
+#include "kettle/state/statevector.hpp"
+
+#include "kettle/simulation/simulate_auto.hpp"
+
+#include "kettle_internal/gates/primitive_gate/gate_create.hpp"
+
+
+namespace
+{
+
+constexpr auto SIZE_T_DIGITS = static_cast<std::size_t>(std::numeric_limits<std::size_t>::digits);
+constexpr auto BYTES_PER_AMPLITUDE = std::size_t {sizeof(std::complex<double>)};
+
+// the density matrix simulator needs a buffer the same size as the density matrix itself
+constexpr auto DENSITY_MATRIX_BUFFER_FACTOR = std::size_t {2};
+
+/*
+    Calculate `2^exponent * factor`, saturating at the largest `std::size_t` instead of overflowing.
+*/
+auto saturating_scaled_pow_2_(std::size_t exponent, std::size_t factor) -> std::size_t
+{
+    constexpr auto max_value = std::numeric_limits<std::size_t>::max();
+
+    if (exponent >= SIZE_T_DIGITS || factor > (max_value >> exponent)) {
+        return max_value;
+    }
+
+    return factor << exponent;
+}
+
+auto saturating_multiply_(std::size_t left, std::size_t right) -> std::size_t
+{
+    constexpr auto max_value = std::numeric_limits<std::size_t>::max();
+
+    if (left != 0 && right > max_value / left) {
+        return max_value;
+    }
+
+    return left * right;
+}
+
+auto is_zero_(const std::complex<double>& value) -> bool
+{
+    return value.real() == 0.0 && value.imag() == 0.0;
+}
+
+/*
+    A unitary that is diagonal or anti-diagonal maps each basis state onto a single basis state.
+*/
+auto is_non_branching_matrix_(const ket::Matrix2X2& mat) -> bool
+{
+    const auto is_diagonal = is_zero_(mat.elem01) && is_zero_(mat.elem10);
+    const auto is_antidiagonal = is_zero_(mat.elem00) && is_zero_(mat.elem11);
+
+    return is_diagonal || is_antidiagonal;
+}
+
+auto is_branching_gate_(const ket::GateInfo& info) -> bool
+{
+    using G = ket::Gate;
+
+    switch (info.gate) {
+        case G::H : [[fallthrough]];
+        case G::SX : [[fallthrough]];
+        case G::SXDAG : [[fallthrough]];
+        case G::RX : [[fallthrough]];
+        case G::RY : [[fallthrough]];
+        case G::CH : [[fallthrough]];
+        case G::CSX : [[fallthrough]];
+        case G::CSXDAG : [[fallthrough]];
+        case G::CRX : [[fallthrough]];
+        case G::CRY : {
+            return true;
+        }
+        case G::U : [[fallthrough]];
+        case G::CU : {
+            return !is_non_branching_matrix_(*ket::internal::create::unpack_unitary_matrix(info));
+        }
+        default : {
+            return false;
+        }
+    }
+}
+
+auto is_clifford_gate_(ket::Gate gate) -> bool
+{
+    using G = ket::Gate;
+
+    return gate == G::H || gate == G::X || gate == G::Y || gate == G::Z
+        || gate == G::S || gate == G::SDAG || gate == G::SX || gate == G::SXDAG
+        || gate == G::CX || gate == G::CY || gate == G::CZ || gate == G::M;
+}
+
+void analyze_elements_(const std::vector<ket::CircuitElement>& elements, ket::CircuitAnalysis& analysis)
+{
+    for (const auto& element : elements) {
+        if (element.is_gate()) {
+            const auto& info = element.get_gate();
+
+            if (info.gate == ket::Gate::M) {
+                ++analysis.n_measurements;
+            }
+            else {
+                ++analysis.n_gates;
+            }
+
+            if (is_branching_gate_(info)) {
+                ++analysis.n_branching_gates;
+            }
+
+            analysis.is_clifford = analysis.is_clifford && is_clifford_gate_(info.gate);
+        }
+        else if (element.is_control_flow()) {
+            analysis.has_control_flow = true;
+            const auto& control_flow = element.get_control_flow();
+
+            if (control_flow.is_if_statement()) {
+                analyze_elements_((*control_flow.get_if_statement().circuit()).circuit_elements(), analysis);
+            }
+            else if (control_flow.is_if_else_statement()) {
+                const auto& if_else_stmt = control_flow.get_if_else_statement();
+                analyze_elements_((*if_else_stmt.if_circuit()).circuit_elements(), analysis);
+                analyze_elements_((*if_else_stmt.else_circuit()).circuit_elements(), analysis);
+            }
+            else {
+                throw std::runtime_error {"DEV ERROR: unimplemented control flow in `analyze_elements_()`\n"};
+            }
+        }
+        else if (element.is_circuit_logger()) {
+            analysis.has_circuit_loggers = true;
+        }
+        else {
+            throw std::runtime_error {"DEV ERROR: unimplemented circuit element in `analyze_elements_()`\n"};
+        }
+    }
+}
+
+auto estimated_memory_(ket::SimulationBackend backend, const ket::CircuitAnalysis& analysis) -> std::size_t
+{
+    using B = ket::SimulationBackend;
+
+    switch (backend) {
+        case B::STATEVECTOR : {
+            return saturating_scaled_pow_2_(analysis.n_qubits, BYTES_PER_AMPLITUDE);
+        }
+        case B::SPARSE_STATEVECTOR : {
+            return saturating_multiply_(analysis.max_support_size, ket::SPARSE_STATEVECTOR_BYTES_PER_AMPLITUDE);
+        }
+        case B::DENSITY_MATRIX : {
+            const auto n_bytes = DENSITY_MATRIX_BUFFER_FACTOR * BYTES_PER_AMPLITUDE;
+            return saturating_scaled_pow_2_(saturating_multiply_(2, analysis.n_qubits), n_bytes);
+        }
+        default : {
+            throw std::runtime_error {"DEV ERROR: unimplemented backend in `estimated_memory_()`\n"};
+        }
+    }
+}
+
+auto forced_backend_decision_(
+    ket::SimulationBackend backend,
+    const ket::CircuitAnalysis& analysis
+) -> ket::BackendDecision
+{
+    if (backend == ket::SimulationBackend::DENSITY_MATRIX && analysis.has_circuit_loggers) {
+        throw std::runtime_error {"ERROR: the density matrix simulator does not support circuit loggers.\n"};
+    }
+
+    auto reason = std::stringstream {};
+    reason << "the " << ket::simulation_backend_name(backend) << " backend was forced by the selection options";
+
+    return {
+        .backend=backend,
+        .analysis=analysis,
+        .estimated_memory=estimated_memory_(backend, analysis),
+        .reason=reason.str()
+    };
+}
+
+auto make_initial_state_(
+    ket::SimulationBackend backend,
+    const ket::Statevector& initial_state
+) -> std::variant<ket::Statevector, ket::SparseStatevector, ket::DensityMatrix>
+{
+    using B = ket::SimulationBackend;
+
+    switch (backend) {
+        case B::STATEVECTOR : {
+            return initial_state;
+        }
+        case B::SPARSE_STATEVECTOR : {
+            return ket::SparseStatevector {initial_state};
+        }
+        case B::DENSITY_MATRIX : {
+            return ket::statevector_to_density_matrix(initial_state);
+        }
+        default : {
+            throw std::runtime_error {"DEV ERROR: unimplemented backend in `make_initial_state_()`\n"};
+        }
+    }
+}
+
+auto run_backend_(
+    const ket::QuantumCircuit& circuit,
+    ket::BackendDecision decision,
+    std::variant<ket::Statevector, ket::SparseStatevector, ket::DensityMatrix> state,
+    std::optional<int> prng_seed
+) -> ket::AutoSimulationResult
+{
+    using B = ket::SimulationBackend;
+
+    switch (decision.backend) {
+        case B::STATEVECTOR : {
+            auto simulator = ket::StatevectorSimulator {};
+            simulator.run(circuit, std::get<ket::Statevector>(state), prng_seed);
+            auto cregister = simulator.classical_register();
+            return {.decision=std::move(decision), .state=std::move(state), .classical_register=std::move(cregister)};
+        }
+        case B::SPARSE_STATEVECTOR : {
+            auto simulator = ket::SparseStatevectorSimulator {};
+            simulator.run(circuit, std::get<ket::SparseStatevector>(state), prng_seed);
+            auto cregister = simulator.classical_register();
+            return {.decision=std::move(decision), .state=std::move(state), .classical_register=std::move(cregister)};
+        }
+        case B::DENSITY_MATRIX : {
+            auto simulator = ket::DensityMatrixSimulator {circuit.n_qubits()};
+            simulator.run(circuit, std::get<ket::DensityMatrix>(state), prng_seed);
+            auto cregister = simulator.classical_register();
+            return {.decision=std::move(decision), .state=std::move(state), .classical_register=std::move(cregister)};
+        }
+        default : {
+            throw std::runtime_error {"DEV ERROR: unimplemented backend in `run_backend_()`\n"};
+        }
+    }
+}
+
+auto count_nonzero_amplitudes_(const ket::Statevector& state) -> std::size_t
+{
+    auto count = std::size_t {0};
+    for (std::size_t i {0}; i < state.n_states(); ++i) {
+        if (std::norm(state[i]) >= ket::SPARSE_STATEVECTOR_PRUNING_TOLERANCE_SQ) {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+}  // namespace
+
+
+namespace ket
+{
+
+auto simulation_backend_name(SimulationBackend backend) -> std::string
+{
+    using B = SimulationBackend;
+
+    switch (backend) {
+        case B::STATEVECTOR : {
+            return "STATEVECTOR";
+        }
+        case B::SPARSE_STATEVECTOR : {
+            return "SPARSE_STATEVECTOR";
+        }
+        case B::DENSITY_MATRIX : {
+            return "DENSITY_MATRIX";
+        }
+        default : {
+            throw std::runtime_error {"DEV ERROR: unimplemented backend in `simulation_backend_name()`\n"};
+        }
+    }
+}
+
+auto analyze_circuit(const QuantumCircuit& circuit, std::size_t initial_support_size) -> CircuitAnalysis
+{
+    auto analysis = CircuitAnalysis {
+        .n_qubits=circuit.n_qubits(),
+        .n_gates=0,
+        .n_measurements=0,
+        .n_branching_gates=0,
+        .is_clifford=true,
+        .has_control_flow=false,
+        .has_circuit_loggers=false,
+        .max_support_size=0
+    };
+
+    analyze_elements_(circuit.circuit_elements(), analysis);
+
+    // each branching gate can at most double the support, and the support can never be larger
+    // than the total number of basis states
+    const auto n_states = saturating_scaled_pow_2_(analysis.n_qubits, 1);
+    const auto branched_support = saturating_scaled_pow_2_(analysis.n_branching_gates, initial_support_size);
+    analysis.max_support_size = std::min(n_states, branched_support);
+
+    return analysis;
+}
+
+auto select_backend(const CircuitAnalysis& analysis, const BackendSelectionOptions& options) -> BackendDecision
+{
+    using B = SimulationBackend;
+
+    if (options.forced_backend) {
+        return forced_backend_decision_(*options.forced_backend, analysis);
+    }
+
+    const auto dense_memory = estimated_memory_(B::STATEVECTOR, analysis);
+    const auto sparse_memory = estimated_memory_(B::SPARSE_STATEVECTOR, analysis);
+
+    const auto sparse_fits = sparse_memory <= options.memory_budget;
+    const auto dense_fits = dense_memory <= options.memory_budget;
+    const auto sparse_is_smaller = static_cast<double>(sparse_memory) <= options.sparse_memory_fraction * static_cast<double>(dense_memory);
+
+    auto reason = std::stringstream {};
+    reason << "the state has at most " << analysis.max_support_size << " nonzero amplitudes out of 2^";
+    reason << analysis.n_qubits << " basis states (" << analysis.n_branching_gates << " branching gates); ";
+
+    auto backend = B::STATEVECTOR;
+    if (sparse_fits && sparse_is_smaller) {
+        backend = B::SPARSE_STATEVECTOR;
+        reason << "the sparse statevector needs far less memory than the dense statevector";
+    }
+    else if (dense_fits) {
+        backend = B::STATEVECTOR;
+        reason << "the dense statevector fits in the memory budget";
+    }
+    else if (sparse_fits) {
+        backend = B::SPARSE_STATEVECTOR;
+        reason << "only the sparse statevector fits in the memory budget";
+    }
+    else {
+        auto err_msg = std::stringstream {};
+        err_msg << "ERROR: no available simulator can run the circuit within the memory budget of ";
+        err_msg << options.memory_budget << " bytes.\n";
+        err_msg << "Estimated dense statevector memory  : " << dense_memory << " bytes\n";
+        err_msg << "Estimated sparse statevector memory : " << sparse_memory << " bytes\n";
+        throw std::runtime_error {err_msg.str()};
+    }
+
+    if (analysis.is_clifford) {
+        reason << "; the circuit only contains Clifford gates, but no stabilizer simulator is available";
+    }
+
+    return {
+        .backend=backend,
+        .analysis=analysis,
+        .estimated_memory=estimated_memory_(backend, analysis),
+        .reason=reason.str()
+    };
+}
+
+auto simulate_auto(
+    const QuantumCircuit& circuit,
+    const std::string& initial_bitstring,
+    const BackendSelectionOptions& options,
+    Endian input_endian,
+    std::optional<int> prng_seed
+) -> AutoSimulationResult
+{
+    auto decision = select_backend(analyze_circuit(circuit, 1), options);
+
+    // a basis state never needs to be created as a dense state unless the chosen simulator is dense
+    auto state = [&]() -> std::variant<Statevector, SparseStatevector, DensityMatrix> {
+        switch (decision.backend) {
+            case SimulationBackend::SPARSE_STATEVECTOR : {
+                return SparseStatevector {initial_bitstring, input_endian};
+            }
+            case SimulationBackend::DENSITY_MATRIX : {
+                return DensityMatrix {initial_bitstring, input_endian};
+            }
+            default : {
+                return Statevector {initial_bitstring, input_endian};
+            }
+        }
+    }();
+
+    return run_backend_(circuit, std::move(decision), std::move(state), prng_seed);
+}
+
+auto simulate_auto(
+    const QuantumCircuit& circuit,
+    const Statevector& initial_state,
+    const BackendSelectionOptions& options,
+    std::optional<int> prng_seed
+) -> AutoSimulationResult
+{
+    const auto initial_support_size = count_nonzero_amplitudes_(initial_state);
+    auto decision = select_backend(analyze_circuit(circuit, initial_support_size), options);
+    auto state = make_initial_state_(decision.backend, initial_state);
+
+    return run_backend_(circuit, std::move(decision), std::move(state), prng_seed);
+}
+
+}  // namespace ket
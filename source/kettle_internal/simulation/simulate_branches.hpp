@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/state/statevector.hpp"
+#include "kettle_internal/common/prng.hpp"
+
+
+namespace ket::internal
+{
+
+/*
+    Same as `ket::simulate_branches()`, except that the random numbers used to split the shots are
+    drawn from `prng`, and each finished branch is passed to `visit_branch` as soon as it is done,
+    instead of being collected. The branch is dropped once `visit_branch` returns (the visitor may
+    move from it), so the branches never have to be in memory all at once.
+
+    The visitor may keep drawing from `prng`; the remaining branches then continue from its new state.
+*/
+void simulate_branches_(
+    const ket::QuantumCircuit& circuit,
+    const ket::Statevector& state,
+    std::size_t n_shots,
+    ket::internal::Prng& prng,
+    const std::function<void(ket::SimulationBranch&)>& visit_branch
+);
+
+}  // namespace ket::internal
@@ -0,0 +1,38 @@
+#include <optional>
+#include <stdexcept>
+
+#include "kettle/circuit/classical_register.hpp"
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit_operations/relabel_qubits.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/simulation/simulate_relabelled.hpp"
+#include "kettle/state/permute_qubits.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+namespace ket
+{
+
+auto simulate_with_hot_qubits_first(
+    const QuantumCircuit& circuit,
+    Statevector& state,
+    std::optional<int> prng_seed
+) -> ClassicalRegister
+{
+    if (circuit.n_qubits() != state.n_qubits()) {
+        throw std::runtime_error {"Invalid simulation; circuit and state have different number of qubits."};
+    }
+
+    const auto relabelled = relabel_hot_qubits(circuit);
+
+    auto relabelled_state = permute_qubits(state, relabelled.new_qubit_indices);
+
+    auto simulator = StatevectorSimulator {};
+    simulator.run(relabelled.circuit, relabelled_state, prng_seed);
+
+    state = permute_qubits(relabelled_state, inverse_qubit_permutation(relabelled.new_qubit_indices));
+
+    return simulator.classical_register();
+}
+
+}  // namespace ket
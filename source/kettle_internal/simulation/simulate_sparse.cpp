@@ -0,0 +1,268 @@
+#include <cmath>
+#include <functional>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "kettle/circuit/classical_register.hpp"
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit_loggers/circuit_logger.hpp"
+#include "kettle/common/matrix2x2.hpp"
+#include "kettle/gates/common_u_gates.hpp"
+#include "kettle/gates/primitive_gate.hpp"
+#include "kettle/state/sparse_statevector.hpp"
+
+#include "kettle/simulation/simulate_sparse.hpp"
+
+#include "kettle_internal/common/prng.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_create.hpp"
+#include "kettle_internal/gates/primitive_gate/gate_id.hpp"
+#include "kettle_internal/parameter/parameter_expression_internal.hpp"
+#include "kettle_internal/simulation/operations_sparse.hpp"
+
+
+namespace ki = ket::internal;
+namespace kpi = ket::param::internal;
+
+namespace
+{
+
+/*
+    Perform a measurement at the target qubit index, which collapses the state.
+
+    The random number generation mirrors `ki::simulate_measurement_()` for the `Statevector`, so that
+    both simulators produce the same measurement outcomes for the same seed.
+*/
+auto simulate_measurement_sparse_(
+    ket::SparseStatevector& state,
+    std::size_t qubit_index,
+    std::optional<int> seed
+) -> int
+{
+    const auto [prob_of_0_states, prob_of_1_states] = ki::probabilities_of_collapsed_states_sparse_(state, qubit_index);
+
+    auto prng = ki::get_prng_(seed);
+    auto coin_flipper = std::discrete_distribution<int> {{prob_of_0_states, prob_of_1_states}};
+
+    const auto collapsed_state = coin_flipper(prng);
+
+    if (collapsed_state == 0) {
+        const auto norm = std::sqrt(1.0 / prob_of_0_states);
+        ki::collapse_and_renormalize_sparse_(state, qubit_index, 0, norm);
+    }
+    else {
+        const auto norm = std::sqrt(1.0 / prob_of_1_states);
+        ki::collapse_and_renormalize_sparse_(state, qubit_index, 1, norm);
+    }
+
+    return collapsed_state;
+}
+
+void simulate_gate_info_sparse_(
+    const kpi::MapVariant& parameter_values_map,
+    ket::SparseStatevector& state,
+    const ket::GateInfo& gate_info,
+    std::optional<int> prng_seed,
+    ket::ClassicalRegister& c_register
+)
+{
+    namespace cre = ki::create;
+    namespace gid = ki::gate_id;
+    using G = ket::Gate;
+
+    const auto gate = gate_info.gate;
+
+    if (gid::is_1t_gate(gate)) {
+        const auto target_index = cre::unpack_single_qubit_gate_index(gate_info);
+        ki::apply_u_gate_sparse(state, ket::non_angle_gate(gate), target_index);
+    }
+    else if (gid::is_1t1a_gate(gate)) {
+        const auto [target_index, theta] = kpi::unpack_target_and_angle(parameter_values_map, gate_info);
+        ki::apply_u_gate_sparse(state, ket::angle_gate(gate, theta), target_index);
+    }
+    else if (gid::is_1c1t_gate(gate)) {
+        const auto [control_index, target_index] = cre::unpack_double_qubit_gate_indices(gate_info);
+        ki::apply_u_gate_sparse(state, ket::non_angle_gate(gate), target_index, control_index);
+    }
+    else if (gid::is_1c1t1a_gate(gate)) {
+        const auto [control_index, target_index, theta] = kpi::unpack_control_target_and_angle(parameter_values_map, gate_info);
+        ki::apply_u_gate_sparse(state, ket::angle_gate(gate, theta), target_index, control_index);
+    }
+    else if (gate == G::U) {
+        const auto target_index = cre::unpack_single_qubit_gate_index(gate_info);
+        const auto& unitary_ptr = cre::unpack_unitary_matrix(gate_info);
+        ki::apply_u_gate_sparse(state, *unitary_ptr, target_index);
+    }
+    else if (gate == G::CU) {
+        const auto [control_index, target_index] = cre::unpack_double_qubit_gate_indices(gate_info);
+        const auto& unitary_ptr = cre::unpack_unitary_matrix(gate_info);
+        ki::apply_u_gate_sparse(state, *unitary_ptr, target_index, control_index);
+    }
+    else if (gate == G::M) {
+        const auto [qubit_index, bit_index] = cre::unpack_m_gate(gate_info);
+        const auto measured = simulate_measurement_sparse_(state, qubit_index, prng_seed);
+        c_register.set(bit_index, measured);
+    }
+    else {
+        throw std::runtime_error {"DEV ERROR: unimplemented gate in `simulate_gate_info_sparse_()`\n"};
+    }
+}
+
+auto simulate_loop_body_iterative_sparse_(  // NOLINT(readability-function-cognitive-complexity)
+    const ket::QuantumCircuit& circuit,
+    ket::SparseStatevector& state,
+    std::optional<int> prng_seed,
+    ket::ClassicalRegister& cregister
+) -> std::vector<ket::CircuitLogger>
+{
+    using Elements = std::reference_wrapper<const std::vector<ket::CircuitElement>>;
+
+    auto elements_stack = std::vector<Elements> {};
+    elements_stack.push_back(std::ref(circuit.circuit_elements()));
+
+    auto instruction_pointers = std::vector<std::size_t> {};
+    instruction_pointers.push_back(0);
+
+    auto circuit_loggers = std::vector<ket::CircuitLogger> {};
+
+    const auto& parameter_values_map = kpi::create_parameter_values_map(circuit.parameter_data_map());
+
+    while (elements_stack.size() != 0) {
+        const auto& elements = elements_stack.back();
+        const auto i_ptr = instruction_pointers.back();
+
+        ++instruction_pointers.back();
+
+        if (i_ptr >= elements.get().size()) {
+            elements_stack.pop_back();
+            instruction_pointers.pop_back();
+            continue;
+        }
+
+        const auto& element = elements.get()[i_ptr];
+
+        if (element.is_circuit_logger()) {
+            const auto& logger = element.get_circuit_logger();
+
+            if (logger.is_classical_register_circuit_logger()) {
+                auto cregister_logger = logger.get_classical_register_circuit_logger();
+                cregister_logger.add_classical_register(cregister);
+                circuit_loggers.emplace_back(std::move(cregister_logger));
+            }
+            else if (logger.is_statevector_circuit_logger()) {
+                auto statevector_logger = logger.get_statevector_circuit_logger();
+                statevector_logger.add_statevector(ket::to_statevector(state));
+                circuit_loggers.emplace_back(std::move(statevector_logger));
+            }
+            else {
+                throw std::runtime_error {"DEV ERROR: unimplemented circuit logger in `simulate_loop_body_iterative_sparse_()`\n"};
+            }
+        }
+        else if (element.is_control_flow()) {
+            const auto& control_flow = element.get_control_flow();
+
+            if (control_flow.is_if_statement()) {
+                const auto& if_stmt = control_flow.get_if_statement();
+
+                if (if_stmt(cregister)) {
+                    const auto& subcircuit = *if_stmt.circuit();
+                    elements_stack.push_back(std::ref(subcircuit.circuit_elements()));
+                    instruction_pointers.push_back(0);
+                }
+            }
+            else if (control_flow.is_if_else_statement()) {
+                const auto& if_else_stmt = control_flow.get_if_else_statement();
+
+                // NOTE: omitting the return type here causes a dangling reference
+                const auto& subcircuit = [&]() -> const ket::QuantumCircuit& {
+                    if (if_else_stmt(cregister)) {
+                        return *if_else_stmt.if_circuit();
+                    } else {
+                        return *if_else_stmt.else_circuit();
+                    }
+                }();
+
+                elements_stack.push_back(std::ref(subcircuit.circuit_elements()));
+                instruction_pointers.push_back(0);
+            }
+            else {
+                throw std::runtime_error {"DEV ERROR: unimplemented control flow in `simulate_loop_body_iterative_sparse_()`\n"};
+            }
+        }
+        else if (element.is_gate()) {
+            simulate_gate_info_sparse_(parameter_values_map, state, element.get_gate(), prng_seed, cregister);
+        }
+        else {
+            throw std::runtime_error {"DEV ERROR: unimplemented circuit element in `simulate_loop_body_iterative_sparse_()`\n"};
+        }
+    }
+
+    return circuit_loggers;
+}
+
+void check_valid_number_of_qubits_(const ket::QuantumCircuit& circuit, const ket::SparseStatevector& state)
+{
+    if (circuit.n_qubits() != state.n_qubits()) {
+        throw std::runtime_error {"Invalid simulation; circuit and state have different number of qubits."};
+    }
+
+    if (circuit.n_qubits() == 0) {
+        throw std::runtime_error {"Cannot simulate a circuit or state with zero qubits."};
+    }
+}
+
+}  // namespace
+
+namespace ket
+{
+
+void SparseStatevectorSimulator::run(const QuantumCircuit& circuit, SparseStatevector& state, std::optional<int> prng_seed)
+{
+    check_valid_number_of_qubits_(circuit, state);
+
+    cregister_ = ket::ClonePtr<ClassicalRegister> {ClassicalRegister {circuit.n_bits()}};
+
+    circuit_loggers_ = simulate_loop_body_iterative_sparse_(circuit, state, prng_seed, *cregister_);
+
+    has_been_run_ = true;
+}
+
+[[nodiscard]]
+auto SparseStatevectorSimulator::has_been_run() const -> bool
+{
+    return has_been_run_;
+}
+
+[[nodiscard]]
+auto SparseStatevectorSimulator::classical_register() const -> const ClassicalRegister&
+{
+    if (!cregister_) {
+        throw std::runtime_error {"ERROR: Cannot access classical register; no simulation has been run\n"};
+    }
+
+    return *cregister_;
+}
+
+auto SparseStatevectorSimulator::classical_register() -> ClassicalRegister&
+{
+    if (!cregister_) {
+        throw std::runtime_error {"ERROR: Cannot access classical register; no simulation has been run\n"};
+    }
+
+    return *cregister_;
+}
+
+[[nodiscard]]
+auto SparseStatevectorSimulator::circuit_loggers() const -> const std::vector<CircuitLogger>&
+{
+    return circuit_loggers_;
+}
+
+void simulate(const QuantumCircuit& circuit, SparseStatevector& state, std::optional<int> prng_seed)
+{
+    auto simulator = SparseStatevectorSimulator {};
+    simulator.run(circuit, state, prng_seed);
+}
+
+}  // namespace ket
@@ -0,0 +1,195 @@
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/io/read_tangelo_file.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/simulation/simulate_tangelo_stream.hpp"
+#include "kettle/state/statevector.hpp"
+
+#include "kettle_internal/common/threads.hpp"
+
+
+namespace
+{
+
+constexpr auto MAX_QUEUED_BLOCKS_ = std::size_t {2};
+
+/*
+    A bounded queue of parsed blocks, passed from the thread that parses the circuit to the thread
+    that simulates it.
+*/
+class BlockQueue_
+{
+public:
+    /*
+        Blocks until there is room in the queue; returns `false` if the consumer has stopped.
+    */
+    auto push(ket::QuantumCircuit block) -> bool
+    {
+        auto lock = std::unique_lock {mutex_};
+        has_room_.wait(lock, [&] { return blocks_.size() < MAX_QUEUED_BLOCKS_ || is_stopped_; });
+
+        if (is_stopped_) {
+            return false;
+        }
+
+        blocks_.push_back(std::move(block));
+        has_block_.notify_one();
+
+        return true;
+    }
+
+    /*
+        Blocks until a block is available; returns `std::nullopt` once the producer has finished
+        and every block has been taken.
+    */
+    auto pop() -> std::optional<ket::QuantumCircuit>
+    {
+        auto lock = std::unique_lock {mutex_};
+        has_block_.wait(lock, [&] { return !blocks_.empty() || is_finished_; });
+
+        if (blocks_.empty()) {
+            if (error_) {
+                std::rethrow_exception(error_);
+            }
+
+            return std::nullopt;
+        }
+
+        auto block = std::move(blocks_.front());
+        blocks_.pop_front();
+        has_room_.notify_one();
+
+        return block;
+    }
+
+    void finish(std::exception_ptr error = nullptr)
+    {
+        auto lock = std::unique_lock {mutex_};
+        is_finished_ = true;
+        error_ = std::move(error);
+        has_block_.notify_one();
+    }
+
+    void stop()
+    {
+        auto lock = std::unique_lock {mutex_};
+        is_stopped_ = true;
+        has_room_.notify_one();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable has_room_;
+    std::condition_variable has_block_;
+    std::deque<ket::QuantumCircuit> blocks_;
+    bool is_finished_ {false};
+    bool is_stopped_ {false};
+    std::exception_ptr error_ {nullptr};
+};
+
+void parse_blocks_(ket::TangeloCircuitReader& reader, BlockQueue_& queue, std::size_t block_size)
+{
+    try {
+        while (!reader.is_done()) {
+            auto block = reader.read_block(block_size);
+
+            if (block.n_circuit_elements() == 0) {
+                continue;
+            }
+
+            if (!queue.push(std::move(block))) {
+                break;
+            }
+        }
+
+        queue.finish();
+    }
+    catch (...) {
+        queue.finish(std::current_exception());
+    }
+}
+
+}  // namespace
+
+
+namespace ket
+{
+
+void simulate_tangelo_stream(
+    StatevectorSimulator& simulator,
+    std::istream& stream,
+    std::size_t n_skip_lines,
+    Statevector& state,
+    std::optional<int> prng_seed,
+    std::size_t block_size
+)
+{
+    if (block_size == 0) {
+        throw std::runtime_error {"ERROR: the block size of a streamed simulation must be positive.\n"};
+    }
+
+    auto reader = TangeloCircuitReader {state.n_qubits(), stream, n_skip_lines};
+    auto queue = BlockQueue_ {};
+
+    // the first block is simulated with `run()`, so that any results of a previous simulation are discarded
+    auto is_first_block = true;
+
+    // the producer is joined when this function returns, including when the simulation throws
+    const auto producer = ket::internal::JoiningThread {[&] { parse_blocks_(reader, queue, block_size); }};
+
+    try {
+        while (auto block = queue.pop()) {
+            if (is_first_block) {
+                simulator.run(*block, state, prng_seed);
+                is_first_block = false;
+            }
+            else {
+                simulator.resume(*block, state, prng_seed);
+            }
+        }
+    }
+    catch (...) {
+        queue.stop();
+        throw;
+    }
+
+    // an empty circuit still counts as a simulation
+    if (is_first_block) {
+        simulator.run(QuantumCircuit {state.n_qubits()}, state, prng_seed);
+    }
+}
+
+void simulate_tangelo_stream(
+    StatevectorSimulator& simulator,
+    const std::filesystem::path& filepath,
+    std::size_t n_skip_lines,
+    Statevector& state,
+    std::optional<int> prng_seed,
+    std::size_t block_size
+)
+{
+    auto instream = std::ifstream {filepath};
+
+    if (!instream.is_open()) {
+        auto err_msg = std::stringstream {};
+        err_msg << "ERROR: unable to read tangelo circuit from : '" << filepath << "'\n";
+
+        throw std::ios::failure {err_msg.str()};
+    }
+
+    simulate_tangelo_stream(simulator, instream, n_skip_lines, state, prng_seed, block_size);
+}
+
+}  // namespace ket
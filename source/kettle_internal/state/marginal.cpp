@@ -13,6 +13,13 @@
 #include "kettle_internal/common/utils_internal.hpp"
 #include "kettle_internal/state/marginal_internal.hpp"
 
+// the BMI2 instructions gather and scatter the bits of a mask in a single instruction; they are only
+// used when the target architecture is known to support them at compile time (e.g. with `-mbmi2`)
+#if defined(__BMI2__) && defined(__x86_64__)
+#include <immintrin.h>
+#define KETTLE_HAS_PEXT
+#endif
+
 namespace ket::internal
 {
 
@@ -42,6 +49,56 @@ auto state_index_to_bitstring_marginal_(
     return bitstring;
 }
 
+auto compact_bits_(std::uint64_t value, std::uint64_t mask) noexcept -> std::uint64_t
+{
+#if defined(KETTLE_HAS_PEXT)
+    return _pext_u64(value, mask);
+#else
+    auto output = std::uint64_t {0};
+    for (auto i_output = std::uint64_t {1}; mask != 0; mask &= (mask - 1), i_output <<= 1U) {
+        const auto lowest = mask & (~mask + 1);
+        if ((value & lowest) != 0) {
+            output |= i_output;
+        }
+    }
+
+    return output;
+#endif
+}
+
+auto expand_bits_(std::uint64_t value, std::uint64_t mask) noexcept -> std::uint64_t
+{
+#if defined(KETTLE_HAS_PEXT)
+    return _pdep_u64(value, mask);
+#else
+    auto output = std::uint64_t {0};
+    for (auto i_input = std::uint64_t {1}; mask != 0; mask &= (mask - 1), i_input <<= 1U) {
+        const auto lowest = mask & (~mask + 1);
+        if ((value & i_input) != 0) {
+            output |= lowest;
+        }
+    }
+
+    return output;
+#endif
+}
+
+auto measured_qubits_mask_(const std::vector<std::uint8_t>& marginal_bitmask) -> std::uint64_t
+{
+    if (marginal_bitmask.size() > 64) {
+        throw std::runtime_error {"ERROR: the measured qubits cannot be packed into a 64-bit state index.\n"};
+    }
+
+    auto mask = std::uint64_t {0};
+    for (std::size_t i {0}; i < marginal_bitmask.size(); ++i) {
+        if (marginal_bitmask[i] == 0) {
+            mask |= std::uint64_t {1} << i;
+        }
+    }
+
+    return mask;
+}
+
 template <MarginalBitsSide Side>
 auto are_all_marginal_bits_on_side_(const std::string& marginal_bitstring) -> bool
 {
@@ -22,6 +22,24 @@ auto state_index_to_bitstring_marginal_(
     ket::Endian input_endian
 ) -> std::string;
 
+/*
+    Gathers the bits of `value` at the positions of the set bits of `mask`, and packs them into the
+    lowest bits of the result, in the same order; for example, with `mask = 0b1010`, the bits at
+    positions 1 and 3 of `value` become the bits at positions 0 and 1 of the result.
+*/
+auto compact_bits_(std::uint64_t value, std::uint64_t mask) noexcept -> std::uint64_t;
+
+/*
+    The inverse of `compact_bits_()`; the lowest bits of `value` are moved to the positions of the set
+    bits of `mask`, in the same order, and all other bits are 0.
+*/
+auto expand_bits_(std::uint64_t value, std::uint64_t mask) noexcept -> std::uint64_t;
+
+/*
+    Returns the mask with the bits set for the qubits that are not marginalized.
+*/
+auto measured_qubits_mask_(const std::vector<std::uint8_t>& marginal_bitmask) -> std::uint64_t;
+
 template <MarginalBitsSide Side>
 auto are_all_marginal_bits_on_side_(const std::string& marginal_bitstring) -> bool;
 
@@ -0,0 +1,86 @@
+#include <bit>
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "kettle/state/permute_qubits.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+namespace
+{
+
+void check_valid_permutation_(const std::vector<std::size_t>& new_qubit_indices)
+{
+    auto is_used = std::vector<bool>(new_qubit_indices.size(), false);
+
+    for (auto new_index : new_qubit_indices) {
+        if (new_index >= new_qubit_indices.size() || is_used[new_index]) {
+            throw std::runtime_error {"ERROR: the new qubit indices must be a permutation of the qubit indices.\n"};
+        }
+
+        is_used[new_index] = true;
+    }
+}
+
+}  // namespace
+
+
+namespace ket
+{
+
+auto permute_qubits(
+    const Statevector& state,
+    const std::vector<std::size_t>& new_qubit_indices
+) -> Statevector
+{
+    if (new_qubit_indices.size() != state.n_qubits()) {
+        throw std::runtime_error {"ERROR: there must be exactly one new qubit index for each qubit in the state.\n"};
+    }
+
+    check_valid_permutation_(new_qubit_indices);
+
+    // the destination of each single-bit index; the destination of any other index is the
+    // bitwise OR of the destinations of its set bits
+    auto new_bit_masks = std::vector<std::size_t> {};
+    new_bit_masks.reserve(new_qubit_indices.size());
+    for (auto new_index : new_qubit_indices) {
+        new_bit_masks.push_back(std::size_t {1} << new_index);
+    }
+
+    const auto n_states = state.n_states();
+    auto new_coefficients = std::vector<std::complex<double>>(n_states);
+
+    // walk through the indices in Gray code order, so that only one bit changes between
+    // consecutive indices, and the permuted index can be updated with a single XOR
+    auto old_index = std::size_t {0};
+    auto new_index = std::size_t {0};
+
+    for (std::size_t step {0}; step < n_states; ++step) {
+        if (step != 0) {
+            const auto flipped_bit = static_cast<std::size_t>(std::countr_zero(step));
+            old_index ^= (std::size_t {1} << flipped_bit);
+            new_index ^= new_bit_masks[flipped_bit];
+        }
+
+        new_coefficients[new_index] = state[old_index];
+    }
+
+    return Statevector {std::move(new_coefficients)};
+}
+
+auto inverse_qubit_permutation(const std::vector<std::size_t>& new_qubit_indices) -> std::vector<std::size_t>
+{
+    check_valid_permutation_(new_qubit_indices);
+
+    auto inverse = std::vector<std::size_t>(new_qubit_indices.size());
+    for (std::size_t i {0}; i < new_qubit_indices.size(); ++i) {
+        inverse[new_qubit_indices[i]] = i;
+    }
+
+    return inverse;
+}
+
+}  // namespace ket
@@ -6,18 +6,17 @@
 #include <random>
 #include <vector>
 
+#include "kettle/common/random_engines.hpp"
 #include "kettle_internal/common/prng.hpp"
 #include "kettle/state/statevector.hpp"
 #include "kettle/state/random.hpp"
 
 
-namespace ket
+namespace
 {
 
-/*
-    Generate a random `Statevector` instance, taking the PRNG directly.
-*/
-auto generate_random_state(std::size_t n_qubits, std::mt19937& prng) -> Statevector
+template <std::uniform_random_bit_generator Engine>
+auto generate_random_state_(std::size_t n_qubits, Engine& prng) -> ket::Statevector
 {
     if (n_qubits == 0) {
         throw std::runtime_error {"Cannot generate a quantum state with 0 qubits.\n"};
@@ -57,7 +56,31 @@ auto generate_random_state(std::size_t n_qubits, std::mt19937& prng) -> Statevec
         amplitudes.emplace_back(x, y);
     }
 
-    return Statevector {amplitudes};
+    return ket::Statevector {amplitudes};
+}
+
+}  // namespace
+
+
+namespace ket
+{
+
+/*
+    Generate a random `Statevector` instance, taking the PRNG directly.
+*/
+auto generate_random_state(std::size_t n_qubits, std::mt19937& prng) -> Statevector
+{
+    return generate_random_state_(n_qubits, prng);
+}
+
+auto generate_random_state(std::size_t n_qubits, Xoshiro256PlusPlus& prng) -> Statevector
+{
+    return generate_random_state_(n_qubits, prng);
+}
+
+auto generate_random_state(std::size_t n_qubits, Philox4x32& prng) -> Statevector
+{
+    return generate_random_state_(n_qubits, prng);
 }
 
 /*
@@ -0,0 +1,190 @@
+#include <cmath>
+#include <complex>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "kettle/common/mathtools.hpp"
+#include "kettle/state/endian.hpp"
+#include "kettle/state/qubit_state_conversion.hpp"
+#include "kettle/state/sparse_statevector.hpp"
+#include "kettle/state/statevector.hpp"
+
+#include "kettle_internal/common/mathtools_internal.hpp"
+#include "kettle_internal/state/bitstring_utils.hpp"
+
+namespace ket
+{
+
+SparseStatevector::SparseStatevector(std::size_t n_qubits, double pruning_tolerance_sq)
+    : n_qubits_ {n_qubits}
+    , n_states_ {0}
+    , pruning_tolerance_sq_ {pruning_tolerance_sq}
+{
+    check_valid_number_of_qubits_();
+    n_states_ = ket::internal::pow_2_int(n_qubits_);
+    amplitudes_[0] = {1.0, 0.0};
+}
+
+SparseStatevector::SparseStatevector(
+    std::size_t n_qubits,
+    AmplitudeMap amplitudes,
+    double normalization_tolerance,
+    double pruning_tolerance_sq
+)
+    : n_qubits_ {n_qubits}
+    , n_states_ {0}
+    , pruning_tolerance_sq_ {pruning_tolerance_sq}
+    , amplitudes_ {std::move(amplitudes)}
+{
+    check_valid_number_of_qubits_();
+    n_states_ = ket::internal::pow_2_int(n_qubits_);
+
+    for (const auto& [index, ignore] : amplitudes_) {
+        check_index_(index);
+    }
+
+    check_normalization_of_amplitudes_(normalization_tolerance);
+    prune();
+}
+
+SparseStatevector::SparseStatevector(
+    const std::string& computational_state,
+    Endian input_endian,
+    double pruning_tolerance_sq
+)
+    : n_qubits_ {computational_state.size()}
+    , n_states_ {0}
+    , pruning_tolerance_sq_ {pruning_tolerance_sq}
+{
+    ket::internal::check_bitstring_is_valid_nonmarginal_(computational_state);
+    check_valid_number_of_qubits_();
+    n_states_ = ket::internal::pow_2_int(n_qubits_);
+
+    const auto index = bitstring_to_state_index(computational_state, input_endian);
+    amplitudes_[index] = {1.0, 0.0};
+}
+
+SparseStatevector::SparseStatevector(const Statevector& state, double pruning_tolerance_sq)
+    : n_qubits_ {state.n_qubits()}
+    , n_states_ {state.n_states()}
+    , pruning_tolerance_sq_ {pruning_tolerance_sq}
+{
+    for (std::size_t i {0}; i < state.n_states(); ++i) {
+        if (std::norm(state[i]) >= pruning_tolerance_sq_) {
+            amplitudes_[i] = state[i];
+        }
+    }
+}
+
+auto SparseStatevector::at(std::size_t index) const -> std::complex<double>
+{
+    check_index_(index);
+
+    const auto it = amplitudes_.find(index);
+    if (it == amplitudes_.end()) {
+        return {0.0, 0.0};
+    }
+
+    return it->second;
+}
+
+auto SparseStatevector::at(const std::string& bitstring, Endian endian) const -> std::complex<double>
+{
+    if (bitstring.size() != n_qubits_) {
+        throw std::runtime_error {"ERROR: the bitstring must have one bit per qubit in the SparseStatevector.\n"};
+    }
+
+    return at(bitstring_to_state_index(bitstring, endian));
+}
+
+void SparseStatevector::prune()
+{
+    std::erase_if(amplitudes_, [&](const auto& pair) { return std::norm(pair.second) < pruning_tolerance_sq_; });
+}
+
+void SparseStatevector::check_valid_number_of_qubits_() const
+{
+    if (n_qubits_ == 0) {
+        throw std::runtime_error {"There must be at least 1 qubit in the SparseStatevector.\n"};
+    }
+
+    // the state indices are stored in a `std::size_t`, and `n_states()` must also fit
+    if (n_qubits_ >= static_cast<std::size_t>(std::numeric_limits<std::size_t>::digits)) {
+        auto err_msg = std::stringstream {};
+        err_msg << "ERROR: the SparseStatevector supports at most ";
+        err_msg << (std::numeric_limits<std::size_t>::digits - 1) << " qubits.\n";
+        err_msg << "Found n_qubits = " << n_qubits_ << '\n';
+        throw std::runtime_error {err_msg.str()};
+    }
+}
+
+void SparseStatevector::check_index_(std::size_t index) const
+{
+    if (index >= n_states_) {
+        throw std::runtime_error {"Out-of-bounds access for the quantum state.\n"};
+    }
+}
+
+void SparseStatevector::check_normalization_of_amplitudes_(double normalization_tolerance) const
+{
+    auto sum_of_squared_norms = double {0.0};
+    for (const auto& [ignore, amplitude] : amplitudes_) {
+        sum_of_squared_norms += std::norm(amplitude);
+    }
+
+    const auto expected = 1.0;
+    const auto is_normalized = std::fabs(sum_of_squared_norms - expected) < normalization_tolerance;
+
+    if (!is_normalized) {
+        auto err_msg = std::stringstream {};
+        err_msg << "The provided amplitudes are not properly normalized.\n";
+        err_msg << "Found sum of squared norms : ";
+        err_msg << std::fixed << std::setprecision(14) << sum_of_squared_norms;
+        throw std::runtime_error {err_msg.str()};
+    }
+}
+
+auto to_statevector(const SparseStatevector& state) -> Statevector
+{
+    auto coefficients = std::vector<std::complex<double>>(state.n_states(), {0.0, 0.0});
+    for (const auto& [index, amplitude] : state.amplitudes()) {
+        coefficients[index] = amplitude;
+    }
+
+    return Statevector {std::move(coefficients)};
+}
+
+auto almost_eq(
+    const SparseStatevector& left,
+    const SparseStatevector& right,
+    double tolerance_sq
+) noexcept -> bool
+{
+    if (left.n_qubits() != right.n_qubits()) {
+        return false;
+    }
+
+    // an index in the support of one state may have been pruned from the other
+    const auto zero = std::complex<double> {0.0, 0.0};
+    const auto all_match = [&](const SparseStatevector& first, const SparseStatevector& second) {
+        for (const auto& [index, amplitude] : first.amplitudes()) {
+            const auto it = second.amplitudes().find(index);
+            const auto other = (it == second.amplitudes().end()) ? zero : it->second;
+
+            if (!almost_eq(amplitude, other, tolerance_sq)) {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    return all_match(left, right) && all_match(right, left);
+}
+
+}  // namespace ket
@@ -0,0 +1,651 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "kettle/calculations/measurements.hpp"
+#include "kettle/calculations/probabilities.hpp"
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/state/statevector.hpp"
+
+#include "kettle_internal/calculations/measurements_internal.hpp"
+#include "kettle_internal/common/prng.hpp"
+#include "kettle_internal/state/marginal_internal.hpp"
+
+
+TEST_CASE("AliasSampler_ follows the distribution")
+{
+    const auto probabilities = std::vector<double> {0.1, 0.0, 0.4, 0.05, 0.0, 0.3, 0.15, 0.0};
+    constexpr auto n_shots = std::size_t {200000};
+
+    auto sampler = ket::internal::AliasSampler_ {probabilities, 1234};
+
+    auto counts = std::vector<std::size_t>(probabilities.size(), 0);
+    for (std::size_t i {0}; i < n_shots; ++i) {
+        ++counts[sampler()];
+    }
+
+    for (std::size_t i {0}; i < probabilities.size(); ++i) {
+        const auto fraction = static_cast<double>(counts[i]) / static_cast<double>(n_shots);
+        REQUIRE_THAT(fraction, Catch::Matchers::WithinAbs(probabilities[i], 0.005));
+
+        // states with no probability are never sampled
+        if (probabilities[i] == 0.0) {
+            REQUIRE(counts[i] == 0);
+        }
+    }
+}
+
+TEST_CASE("AliasSampler_ with a single possible state")
+{
+    const auto probabilities = std::vector<double> {0.0, 0.0, 1.0, 0.0};
+    auto sampler = ket::internal::AliasSampler_ {probabilities, 5};
+
+    for (std::size_t i {0}; i < 1000; ++i) {
+        REQUIRE(sampler() == 2);
+    }
+}
+
+TEST_CASE("sample_multinomial_counts_ follows the distribution")
+{
+    const auto probabilities = std::vector<double> {0.1, 0.0, 0.4, 0.05, 0.0, 0.3, 0.15, 0.0};
+
+    SECTION("counts are in increasing order, and only for possible states")
+    {
+        auto prng = ket::internal::get_prng_(42);
+        const auto counts = ket::internal::sample_multinomial_counts_(probabilities, 100000, prng);
+
+        auto total = std::size_t {0};
+        for (std::size_t i {0}; i < counts.size(); ++i) {
+            const auto [i_state, count] = counts[i];
+            REQUIRE(probabilities[i_state] > 0.0);
+            REQUIRE(count > 0);
+
+            if (i > 0) {
+                REQUIRE(counts[i - 1].first < i_state);
+            }
+
+            const auto fraction = static_cast<double>(count) / 100000.0;
+            REQUIRE_THAT(fraction, Catch::Matchers::WithinAbs(probabilities[i_state], 0.01));
+
+            total += count;
+        }
+
+        REQUIRE(total == 100000);
+    }
+
+    SECTION("the cost does not depend on the number of shots")
+    {
+        constexpr auto n_shots = std::size_t {1000000000000};
+
+        auto prng = ket::internal::get_prng_(7);
+        const auto counts = ket::internal::sample_multinomial_counts_(probabilities, n_shots, prng);
+
+        auto total = std::size_t {0};
+        for (const auto& [i_state, count] : counts) {
+            const auto fraction = static_cast<double>(count) / static_cast<double>(n_shots);
+            REQUIRE_THAT(fraction, Catch::Matchers::WithinAbs(probabilities[i_state], 1.0e-5));
+            total += count;
+        }
+
+        REQUIRE(total == n_shots);
+    }
+
+    SECTION("no shots")
+    {
+        auto prng = ket::internal::get_prng_(7);
+        REQUIRE(ket::internal::sample_multinomial_counts_(probabilities, 0, prng).empty());
+    }
+}
+
+TEST_CASE("sample_streaming_counts_ follows the distribution")
+{
+    const auto probabilities = std::vector<double> {0.1, 0.0, 0.4, 0.05, 0.0, 0.3, 0.15, 0.0};
+
+    SECTION("counts are in increasing order, and only for possible states")
+    {
+        const auto n_threads = GENERATE(std::size_t {1}, std::size_t {3}, std::size_t {8}, std::size_t {16});
+
+        auto prng = ket::internal::get_prng_(42);
+        const auto counts = ket::internal::sample_streaming_counts_(probabilities, 100000, prng, n_threads);
+
+        auto total = std::size_t {0};
+        for (std::size_t i {0}; i < counts.size(); ++i) {
+            const auto [i_state, count] = counts[i];
+            REQUIRE(probabilities[i_state] > 0.0);
+            REQUIRE(count > 0);
+
+            if (i > 0) {
+                REQUIRE(counts[i - 1].first < i_state);
+            }
+
+            const auto fraction = static_cast<double>(count) / 100000.0;
+            REQUIRE_THAT(fraction, Catch::Matchers::WithinAbs(probabilities[i_state], 0.01));
+
+            total += count;
+        }
+
+        REQUIRE(total == 100000);
+    }
+
+    SECTION("the number of threads does not change the counts")
+    {
+        // the partial sums of these probabilities are exact, so the blocks split the thresholds exactly
+        const auto dyadic = std::vector<double> {0.125, 0.0, 0.25, 0.0625, 0.0, 0.3125, 0.25, 0.0};
+
+        auto prng0 = ket::internal::get_prng_(7);
+        auto prng1 = ket::internal::get_prng_(7);
+
+        const auto counts0 = ket::internal::sample_streaming_counts_(dyadic, 10000, prng0, 1);
+        const auto counts1 = ket::internal::sample_streaming_counts_(dyadic, 10000, prng1, 4);
+
+        REQUIRE(counts0 == counts1);
+    }
+
+    SECTION("states with a zero probability are never sampled, even in blocks with no other states")
+    {
+        // the trailing blocks hold only zeros; any threshold left over to them by rounding must go to
+        // the last state with a nonzero probability, in an earlier block
+        auto tail_zeros = std::vector<double>(64, 0.0);
+        for (std::size_t i {0}; i < 7; ++i) {
+            tail_zeros[i] = 0.1 * static_cast<double>(i + 1) / 3.0;
+        }
+
+        const auto n_threads = GENERATE(std::size_t {2}, std::size_t {8}, std::size_t {64});
+        const auto seed = GENERATE(1, 2, 3, 4, 5);
+
+        auto prng = ket::internal::get_prng_(seed);
+        const auto counts = ket::internal::sample_streaming_counts_(tail_zeros, 100000, prng, n_threads);
+
+        auto total = std::size_t {0};
+        for (std::size_t i {0}; i < counts.size(); ++i) {
+            REQUIRE(tail_zeros[counts[i].first] > 0.0);
+
+            if (i > 0) {
+                REQUIRE(counts[i - 1].first < counts[i].first);
+            }
+
+            total += counts[i].second;
+        }
+
+        REQUIRE(total == 100000);
+    }
+
+    SECTION("the probabilities do not need to be normalized")
+    {
+        const auto unnormalized = std::vector<double> {0.0, 3.0, 0.0, 1.0};
+
+        auto prng = ket::internal::get_prng_(7);
+        const auto counts = ket::internal::sample_streaming_counts_(unnormalized, 100000, prng);
+
+        REQUIRE(counts.size() == 2);
+        REQUIRE(counts[0].first == 1);
+        REQUIRE_THAT(static_cast<double>(counts[0].second) / 100000.0, Catch::Matchers::WithinAbs(0.75, 0.01));
+    }
+
+    SECTION("the statevector overload matches the probabilities")
+    {
+        const auto state = ket::Statevector {{{0.0, 0.5}, {0.5, 0.0}, {0.0, 0.0}, {-0.5, 0.5}}};
+
+        auto prng0 = ket::internal::get_prng_(7);
+        auto prng1 = ket::internal::get_prng_(7);
+
+        const auto from_state = ket::internal::sample_streaming_counts_(state, 1000, prng0, 2);
+        const auto from_probabilities = ket::internal::sample_streaming_counts_(ket::calculate_probabilities_raw(state), 1000, prng1, 2);
+
+        REQUIRE(from_state == from_probabilities);
+    }
+
+    SECTION("no shots")
+    {
+        auto prng = ket::internal::get_prng_(7);
+        REQUIRE(ket::internal::sample_streaming_counts_(probabilities, 0, prng).empty());
+    }
+
+    SECTION("throws if every probability is zero")
+    {
+        const auto zeros = std::vector<double> {0.0, 0.0, 0.0, 0.0};
+
+        auto prng = ket::internal::get_prng_(7);
+        REQUIRE_THROWS_AS(ket::internal::sample_streaming_counts_(zeros, 10, prng), std::runtime_error);
+    }
+}
+
+TEST_CASE("perform_measurements with different sampling methods")
+{
+    // the state (|00> + |11>) / sqrt(2) on qubits 0 and 1, with qubit 2 in the |1> state
+    const auto state = []() {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate(0);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_x_gate(2);
+
+        auto state_ = ket::Statevector {3};
+        ket::simulate(circuit, state_);
+
+        return state_;
+    }();
+
+    const auto method = GENERATE(ket::SamplingMethod::CUMULATIVE, ket::SamplingMethod::ALIAS, ket::SamplingMethod::MULTINOMIAL, ket::SamplingMethod::STREAMING);
+    constexpr auto n_shots = std::size_t {10000};
+
+    SECTION("memory")
+    {
+        const auto memory = ket::perform_measurements_as_memory(state, n_shots, nullptr, 42, method);
+
+        REQUIRE(memory.size() == n_shots);
+        for (auto i_state : memory) {
+            REQUIRE((i_state == 4 || i_state == 7));
+        }
+
+        // the same seed gives the same measurements
+        REQUIRE(memory == ket::perform_measurements_as_memory(state, n_shots, nullptr, 42, method));
+    }
+
+    SECTION("counts")
+    {
+        const auto counts = ket::perform_measurements_as_counts(state, n_shots, nullptr, 42, method);
+
+        REQUIRE(counts.size() == 2);
+        REQUIRE(counts.at("001") + counts.at("111") == n_shots);
+        REQUIRE_THAT(static_cast<double>(counts.at("111")) / n_shots, Catch::Matchers::WithinAbs(0.5, 0.03));
+    }
+
+    SECTION("marginal counts")
+    {
+        const auto counts = ket::perform_measurements_as_counts_marginal(state, n_shots, {0, 1}, nullptr, 42, method);
+
+        REQUIRE(counts.size() == 1);
+        REQUIRE(counts.at("xx1") == n_shots);
+    }
+}
+
+TEST_CASE("perform_measurements with several threads")
+{
+    // qubit 0 is in |1>, and qubits 1 and 2 are in an equal superposition
+    const auto probabilities = std::vector<double> {0.0, 0.25, 0.0, 0.25, 0.0, 0.25, 0.0, 0.25};
+
+    const auto method = GENERATE(ket::SamplingMethod::CUMULATIVE, ket::SamplingMethod::ALIAS, ket::SamplingMethod::MULTINOMIAL, ket::SamplingMethod::STREAMING);
+    const auto n_threads = GENERATE(std::size_t {1}, std::size_t {3}, std::size_t {8});
+    constexpr auto n_shots = std::size_t {10001};
+
+    SECTION("memory")
+    {
+        const auto memory = ket::perform_measurements_as_memory(probabilities, n_shots, 42, method, n_threads);
+
+        REQUIRE(memory.size() == n_shots);
+        for (auto i_state : memory) {
+            REQUIRE(i_state % 2 == 1);
+        }
+
+        // the same seed and number of threads give the same measurements
+        REQUIRE(memory == ket::perform_measurements_as_memory(probabilities, n_shots, 42, method, n_threads));
+    }
+
+    SECTION("counts")
+    {
+        const auto counts = ket::perform_measurements_as_counts_raw(probabilities, n_shots, 42, method, n_threads);
+
+        auto total = std::size_t {0};
+        for (const auto& [i_state, count] : counts) {
+            REQUIRE(i_state % 2 == 1);
+            REQUIRE_THAT(static_cast<double>(count) / n_shots, Catch::Matchers::WithinAbs(0.25, 0.03));
+            total += count;
+        }
+
+        REQUIRE(counts.size() == 4);
+        REQUIRE(total == n_shots);
+        REQUIRE(counts == ket::perform_measurements_as_counts_raw(probabilities, n_shots, 42, method, n_threads));
+    }
+
+    SECTION("dense counts match the marginal counts")
+    {
+        const auto dense = ket::perform_measurements_as_counts_dense(probabilities, n_shots, {1}, 42, method, n_threads);
+        const auto marginal = ket::perform_measurements_as_counts_marginal(probabilities, n_shots, {1}, 42, method, n_threads);
+
+        REQUIRE(dense[0] == 0);
+        REQUIRE(dense[2] == 0);
+        REQUIRE(dense[1] + dense[3] == n_shots);
+        REQUIRE(ket::dense_counts_to_marginal_counts(dense, 3, {1}) == marginal);
+    }
+}
+
+TEST_CASE("flip_outcome_bits_()")
+{
+    constexpr auto n_outcomes = std::size_t {100000};
+    auto prng = ket::internal::get_prng_(42);
+
+    SECTION("bits with probabilities of 0 and 1")
+    {
+        auto outcomes = std::vector<std::size_t>(n_outcomes, 0b0101);
+        ket::internal::flip_outcome_bits_(outcomes, {0.0, 1.0, 0.0, 1.0}, prng);
+
+        for (auto outcome : outcomes) {
+            REQUIRE(outcome == 0b1111);
+        }
+    }
+
+    SECTION("each bit is flipped with its own probability")
+    {
+        const auto flip_probabilities = std::vector<double> {0.3, 0.0, 0.05, 0.9};
+
+        auto outcomes = std::vector<std::size_t>(n_outcomes, 0);
+        ket::internal::flip_outcome_bits_(outcomes, flip_probabilities, prng);
+
+        for (std::size_t i_bit {0}; i_bit < flip_probabilities.size(); ++i_bit) {
+            const auto n_flipped = std::ranges::count_if(outcomes, [&](auto outcome) { return ((outcome >> i_bit) & 1U) == 1U; });
+            const auto fraction = static_cast<double>(n_flipped) / static_cast<double>(n_outcomes);
+            REQUIRE_THAT(fraction, Catch::Matchers::WithinAbs(flip_probabilities[i_bit], 0.01));
+        }
+    }
+
+    SECTION("no outcomes")
+    {
+        auto outcomes = std::vector<std::size_t> {};
+        ket::internal::flip_outcome_bits_(outcomes, {0.5, 1.0}, prng);
+
+        REQUIRE(outcomes.empty());
+    }
+}
+
+TEST_CASE("readout noise applied to the shots")
+{
+    // qubit 0 is in |1>, qubit 1 is in an equal superposition, qubit 2 is in |0>
+    const auto state = []() {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_x_gate(0);
+        circuit.add_h_gate(1);
+
+        auto state_ = ket::Statevector {3};
+        ket::simulate(circuit, state_);
+
+        return state_;
+    }();
+
+    const auto make_noise = [](ket::NoiseApplication application) {
+        auto noise = ket::QuantumNoise {3, application};
+        noise.set(0, 0.1);
+        noise.set(2, 0.25);
+
+        return noise;
+    };
+
+    const auto noise_on_shots = make_noise(ket::NoiseApplication::SHOTS);
+    const auto noise_on_probabilities = make_noise(ket::NoiseApplication::PROBABILITIES);
+
+    const auto method = GENERATE(ket::SamplingMethod::CUMULATIVE, ket::SamplingMethod::MULTINOMIAL, ket::SamplingMethod::STREAMING);
+    constexpr auto n_shots = std::size_t {100000};
+
+    SECTION("counts have the same distribution as noise on the probabilities")
+    {
+        const auto probabilities = ket::calculate_probabilities_raw(state, &noise_on_probabilities);
+        const auto counts = ket::perform_measurements_as_counts_raw(state, n_shots, &noise_on_shots, 42, method, 3);
+
+        auto total = std::size_t {0};
+        for (const auto& [i_state, count] : counts) {
+            const auto fraction = static_cast<double>(count) / static_cast<double>(n_shots);
+            REQUIRE_THAT(fraction, Catch::Matchers::WithinAbs(probabilities[i_state], 0.01));
+            total += count;
+        }
+
+        REQUIRE(total == n_shots);
+        REQUIRE(counts == ket::perform_measurements_as_counts_raw(state, n_shots, &noise_on_shots, 42, method, 3));
+    }
+
+    SECTION("zero threads are the same as one, and the bit flips do not reuse the sampling stream")
+    {
+        const auto counts0 = ket::perform_measurements_as_counts_raw(state, n_shots, &noise_on_shots, 42, method, 0);
+        const auto counts1 = ket::perform_measurements_as_counts_raw(state, n_shots, &noise_on_shots, 42, method, 1);
+
+        REQUIRE(counts0 == counts1);
+    }
+
+    SECTION("memory")
+    {
+        const auto memory = ket::perform_measurements_as_memory(state, n_shots, &noise_on_shots, 42, method);
+
+        const auto n_qubit0_flipped = std::ranges::count_if(memory, [](auto i_state) { return (i_state & 0b001U) == 0; });
+        const auto n_qubit2_flipped = std::ranges::count_if(memory, [](auto i_state) { return (i_state & 0b100U) != 0; });
+
+        REQUIRE(memory.size() == n_shots);
+        REQUIRE_THAT(static_cast<double>(n_qubit0_flipped) / n_shots, Catch::Matchers::WithinAbs(0.1, 0.01));
+        REQUIRE_THAT(static_cast<double>(n_qubit2_flipped) / n_shots, Catch::Matchers::WithinAbs(0.25, 0.01));
+    }
+
+    SECTION("only the noise of the measured qubits matters")
+    {
+        const auto counts = ket::perform_measurements_as_counts_marginal(state, n_shots, {1, 2}, &noise_on_shots, 42, method);
+
+        REQUIRE(counts.size() == 2);
+        REQUIRE(counts.at("1xx") + counts.at("0xx") == n_shots);
+        REQUIRE_THAT(static_cast<double>(counts.at("0xx")) / n_shots, Catch::Matchers::WithinAbs(0.1, 0.01));
+    }
+}
+
+TEST_CASE("readout noise applied to the shots of a circuit")
+{
+    auto circuit = ket::QuantumCircuit {2};
+    circuit.add_x_gate(0);
+    circuit.add_m_gate(0);
+
+    auto noise = ket::QuantumNoise {2, ket::NoiseApplication::SHOTS};
+    noise.set(1, 0.2);
+
+    constexpr auto n_shots = std::size_t {100000};
+    const auto counts = ket::perform_measurements_as_counts_marginal(circuit, ket::Statevector {2}, n_shots, {}, &noise, 42);
+
+    REQUIRE(counts.size() == 2);
+    REQUIRE(counts.at("10") + counts.at("11") == n_shots);
+    REQUIRE_THAT(static_cast<double>(counts.at("11")) / n_shots, Catch::Matchers::WithinAbs(0.2, 0.01));
+}
+
+TEST_CASE("get_prng_streams_()")
+{
+    SECTION("a single stream is the same as get_prng_()")
+    {
+        auto streams = ket::internal::get_prng_streams_(42, 1);
+        auto prng = ket::internal::get_prng_(42);
+
+        REQUIRE(streams.size() == 1);
+        REQUIRE(streams[0]() == prng());
+    }
+
+    SECTION("the streams are reproducible and differ from each other")
+    {
+        auto streams0 = ket::internal::get_prng_streams_(42, 4);
+        auto streams1 = ket::internal::get_prng_streams_(42, 4);
+
+        REQUIRE(streams0.size() == 4);
+        REQUIRE(streams0 == streams1);
+
+        for (std::size_t i {0}; i < streams0.size(); ++i) {
+            for (std::size_t j {i + 1}; j < streams0.size(); ++j) {
+                REQUIRE(streams0[i] != streams0[j]);
+            }
+        }
+    }
+}
+
+TEST_CASE("perform_measurements_as_counts_marginal() with a circuit")
+{
+    constexpr auto n_shots = std::size_t {10000};
+
+    SECTION("the shots are independent, even with a seed")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_cx_gate(0, 1);
+
+        const auto counts = ket::perform_measurements_as_counts_marginal(circuit, ket::Statevector {"00"}, n_shots, {}, nullptr, 42);
+
+        REQUIRE(counts.size() == 2);
+        REQUIRE(counts.at("00") + counts.at("11") == n_shots);
+        REQUIRE_THAT(static_cast<double>(counts.at("11")) / n_shots, Catch::Matchers::WithinAbs(0.5, 0.03));
+
+        // the same seed gives the same counts
+        REQUIRE(counts == ket::perform_measurements_as_counts_marginal(circuit, ket::Statevector {"00"}, n_shots, {}, nullptr, 42));
+    }
+
+    SECTION("mid-circuit measurement with control flow")
+    {
+        // qubit 1 is flipped only if qubit 0 is measured as 1, and qubit 2 is put into superposition afterwards
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate(0);
+        circuit.add_m_gate(0);
+        circuit.add_if_statement(0, [] {
+            auto subcircuit = ket::QuantumCircuit {3};
+            subcircuit.add_x_gate(1);
+            return subcircuit;
+        }());
+        circuit.add_h_gate(2);
+
+        const auto counts = ket::perform_measurements_as_counts_marginal(circuit, ket::Statevector {"000"}, n_shots, {}, nullptr, 42);
+
+        auto total = std::size_t {0};
+        for (const auto& [bitstring, count] : counts) {
+            REQUIRE(bitstring[0] == bitstring[1]);
+            REQUIRE_THAT(static_cast<double>(count) / n_shots, Catch::Matchers::WithinAbs(0.25, 0.03));
+            total += count;
+        }
+
+        REQUIRE(counts.size() == 4);
+        REQUIRE(total == n_shots);
+    }
+}
+
+TEST_CASE("perform_measurements_as_counts_dense()")
+{
+    // qubit 0 is in |1>, qubit 1 is in an equal superposition, qubit 2 is in |0>, qubit 3 is in |1>
+    const auto state = []() {
+        auto circuit = ket::QuantumCircuit {4};
+        circuit.add_x_gate({0, 3});
+        circuit.add_h_gate(1);
+
+        auto state_ = ket::Statevector {4};
+        ket::simulate(circuit, state_);
+
+        return state_;
+    }();
+
+    const auto method = GENERATE(ket::SamplingMethod::CUMULATIVE, ket::SamplingMethod::ALIAS, ket::SamplingMethod::MULTINOMIAL, ket::SamplingMethod::STREAMING);
+    constexpr auto n_shots = std::size_t {4096};
+
+    SECTION("the measured qubits are packed in increasing order")
+    {
+        // the measured qubits are 0, 2 and 3; they become bits 0, 1 and 2 of the dense index
+        const auto counts = ket::perform_measurements_as_counts_dense(state, n_shots, {1}, nullptr, 42, method);
+
+        REQUIRE(counts.size() == 8);
+        REQUIRE(counts[0b101] == n_shots);
+    }
+
+    SECTION("without marginal qubits")
+    {
+        const auto counts = ket::perform_measurements_as_counts_dense(state, n_shots, {}, nullptr, 42, method);
+
+        REQUIRE(counts.size() == 16);
+        REQUIRE(counts[0b1001] + counts[0b1011] == n_shots);
+    }
+
+    SECTION("conversion matches the bitstring counts")
+    {
+        const auto marginal_qubits = std::vector<std::size_t> {2};
+        const auto dense = ket::perform_measurements_as_counts_dense(state, n_shots, marginal_qubits, nullptr, 42, method);
+        const auto expected = ket::perform_measurements_as_counts_marginal(state, n_shots, marginal_qubits, nullptr, 42, method);
+
+        REQUIRE(ket::dense_counts_to_marginal_counts(dense, 4, marginal_qubits) == expected);
+    }
+
+    SECTION("conversion with the wrong number of counts throws")
+    {
+        REQUIRE_THROWS_AS(ket::dense_counts_to_marginal_counts(std::vector<std::uint64_t>(8, 0), 4, {}), std::runtime_error);
+    }
+}
+
+TEST_CASE("perform_measurements_as_counts_marginal() with the streaming sampler")
+{
+    // qubits 0 and 2 are in equal superpositions, qubit 4 is in |1>, and the others are in |0>
+    const auto state = []() {
+        auto circuit = ket::QuantumCircuit {6};
+        circuit.add_h_gate({0, 2});
+        circuit.add_x_gate(4);
+
+        auto state_ = ket::Statevector {6};
+        ket::simulate(circuit, state_);
+
+        return state_;
+    }();
+
+    auto noise = ket::QuantumNoise {6, ket::NoiseApplication::SHOTS};
+    noise.set(4, 0.2);
+    noise.set(5, 0.1);
+
+    const auto marginal_qubits = std::vector<std::size_t> {1, 3, 5};
+    const auto n_threads = GENERATE(std::size_t {1}, std::size_t {3});
+    const auto use_noise = GENERATE(false, true);
+    const auto* noise_ptr = use_noise ? &noise : nullptr;
+    constexpr auto n_shots = std::size_t {100000};
+
+    const auto method = ket::SamplingMethod::STREAMING;
+    const auto counts = ket::perform_measurements_as_counts_marginal(state, n_shots, marginal_qubits, noise_ptr, 42, method, n_threads);
+
+    SECTION("matches the conversion of the dense counts")
+    {
+        const auto dense = ket::perform_measurements_as_counts_dense(state, n_shots, marginal_qubits, noise_ptr, 42, method, n_threads);
+        REQUIRE(counts == ket::dense_counts_to_marginal_counts(dense, 6, marginal_qubits));
+    }
+
+    SECTION("follows the distribution of the measured qubits")
+    {
+        // with noise, the shots of qubit 4 are flipped to 0 with probability 0.2
+        const auto prob_of_qubit4_set = use_noise ? 0.8 : 1.0;
+
+        auto total = std::size_t {0};
+        auto n_qubit4_set = std::size_t {0};
+        for (const auto& [bitstring, count] : counts) {
+            REQUIRE(bitstring[1] == 'x');
+            REQUIRE(bitstring[3] == 'x');
+            REQUIRE(bitstring[5] == 'x');
+
+            total += count;
+            if (bitstring[4] == '1') {
+                n_qubit4_set += count;
+            }
+        }
+
+        REQUIRE(total == n_shots);
+        REQUIRE_THAT(static_cast<double>(n_qubit4_set) / n_shots, Catch::Matchers::WithinAbs(prob_of_qubit4_set, 0.01));
+    }
+
+    SECTION("without marginal qubits, through perform_measurements_as_counts()")
+    {
+        const auto all_counts = ket::perform_measurements_as_counts(state, n_shots, noise_ptr, 42, method, n_threads);
+        const auto dense = ket::perform_measurements_as_counts_dense(state, n_shots, {}, noise_ptr, 42, method, n_threads);
+
+        REQUIRE(all_counts == ket::dense_counts_to_marginal_counts(dense, 6, {}));
+    }
+}
+
+TEST_CASE("compact_bits_() and expand_bits_()")
+{
+    REQUIRE(ket::internal::compact_bits_(0b1010, 0b1010) == 0b11);
+    REQUIRE(ket::internal::compact_bits_(0b0110, 0b1010) == 0b01);
+    REQUIRE(ket::internal::compact_bits_(0b1111, 0) == 0);
+    REQUIRE(ket::internal::expand_bits_(0b11, 0b1010) == 0b1010);
+    REQUIRE(ket::internal::expand_bits_(0b10, 0b1010) == 0b1000);
+
+    const auto mask = std::uint64_t {0b1101'0110'0011};
+    for (std::uint64_t value {0}; value < (1U << 7); ++value) {
+        REQUIRE(ket::internal::compact_bits_(ket::internal::expand_bits_(value, mask), mask) == value);
+    }
+}
@@ -1,5 +1,7 @@
 #include <cmath>
+#include <cstddef>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <map>
 #include <vector>
@@ -162,3 +164,58 @@ TEST_CASE("probabilities")
         }
     }
 }
+
+TEST_CASE("calculate_marginal_probabilities_raw()")
+{
+    // 3 qubits, with unequal probabilities for every state
+    const auto probabilities = std::vector<double> {0.01, 0.02, 0.04, 0.08, 0.10, 0.15, 0.25, 0.35};
+
+    SECTION("no marginal qubits")
+    {
+        const auto actual = ket::calculate_marginal_probabilities_raw(probabilities, {});
+        REQUIRE_THAT(actual, Catch::Matchers::Approx(probabilities));
+    }
+
+    SECTION("qubit 1 is marginalized")
+    {
+        // bit 0 of the output is qubit 0, bit 1 is qubit 2
+        const auto expected = std::vector<double> {0.01 + 0.04, 0.02 + 0.08, 0.10 + 0.25, 0.15 + 0.35};
+        const auto n_threads = GENERATE(std::size_t {1}, std::size_t {2}, std::size_t {3}, std::size_t {16});
+
+        const auto actual = ket::calculate_marginal_probabilities_raw(probabilities, {1}, n_threads);
+        REQUIRE_THAT(actual, Catch::Matchers::Approx(expected));
+    }
+
+    SECTION("qubits 0 and 2 are marginalized")
+    {
+        const auto expected = std::vector<double> {0.01 + 0.02 + 0.10 + 0.15, 0.04 + 0.08 + 0.25 + 0.35};
+        const auto n_threads = GENERATE(std::size_t {1}, std::size_t {4});
+
+        const auto actual = ket::calculate_marginal_probabilities_raw(probabilities, {0, 2}, n_threads);
+        REQUIRE_THAT(actual, Catch::Matchers::Approx(expected));
+    }
+
+    SECTION("all qubits are marginalized")
+    {
+        const auto actual = ket::calculate_marginal_probabilities_raw(probabilities, {0, 1, 2}, 2);
+        REQUIRE_THAT(actual, Catch::Matchers::Approx(std::vector<double> {1.0}));
+    }
+
+    SECTION("from a statevector")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate(0);
+        circuit.add_x_gate(2);
+
+        auto state = ket::Statevector {"000"};
+        ket::simulate(circuit, state);
+
+        const auto actual = ket::calculate_marginal_probabilities_raw(state, {0});
+        REQUIRE_THAT(actual, Catch::Matchers::Approx(std::vector<double> {0.0, 0.0, 1.0, 0.0}));
+    }
+
+    SECTION("throws with an out-of-range marginal qubit")
+    {
+        REQUIRE_THROWS_AS(ket::calculate_marginal_probabilities_raw(probabilities, {3}), std::runtime_error);
+    }
+}
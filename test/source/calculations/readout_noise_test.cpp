@@ -0,0 +1,262 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "kettle/calculations/measurements.hpp"
+#include "kettle/calculations/probabilities.hpp"
+#include "kettle/calculations/readout_noise.hpp"
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/state/statevector.hpp"
+
+static constexpr auto ABS_TOL = 1.0e-12;
+
+/*
+    The probability of reading out `i_measured` from the state `i_prepared`, with the full confusion matrix
+    built explicitly as the tensor product of the blocks.
+*/
+static auto brute_force_confusion(const ket::ReadoutNoiseModel& model, std::size_t i_measured, std::size_t i_prepared) -> double
+{
+    auto prob = 1.0;
+    for (const auto& block : model.blocks()) {
+        auto i_block_measured = Eigen::Index {0};
+        auto i_block_prepared = Eigen::Index {0};
+        for (std::size_t k {0}; k < block.qubits.size(); ++k) {
+            i_block_measured |= static_cast<Eigen::Index>((i_measured >> block.qubits[k]) & 1U) << k;
+            i_block_prepared |= static_cast<Eigen::Index>((i_prepared >> block.qubits[k]) & 1U) << k;
+        }
+
+        prob *= block.confusion_matrix(i_block_measured, i_block_prepared);
+    }
+
+    // qubits outside of every block are read out without errors
+    auto block_mask = std::size_t {0};
+    for (const auto& block : model.blocks()) {
+        for (auto qubit : block.qubits) {
+            block_mask |= std::size_t {1} << qubit;
+        }
+    }
+
+    if ((i_measured & ~block_mask) != (i_prepared & ~block_mask)) {
+        return 0.0;
+    }
+
+    return prob;
+}
+
+static auto correlated_matrix() -> Eigen::MatrixXd
+{
+    auto matrix = Eigen::MatrixXd {4, 4};
+    matrix << 0.90, 0.05, 0.10, 0.00,
+              0.05, 0.80, 0.00, 0.10,
+              0.05, 0.05, 0.85, 0.15,
+              0.00, 0.10, 0.05, 0.75;
+
+    return matrix;
+}
+
+
+TEST_CASE("apply_readout_noise()")
+{
+    SECTION("symmetric errors match QuantumNoise")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate({0, 1});
+        circuit.add_cx_gate(1, 2);
+
+        auto state = ket::Statevector {3};
+        ket::simulate(circuit, state);
+
+        auto noise = ket::QuantumNoise {3};
+        auto model = ket::ReadoutNoiseModel {3};
+        for (std::size_t i_qubit {0}; i_qubit < 3; ++i_qubit) {
+            const auto prob = 0.05 * static_cast<double>(i_qubit + 1);
+            noise.set(i_qubit, prob);
+            model.set_qubit_error(i_qubit, prob, prob);
+        }
+
+        const auto expected = ket::calculate_probabilities_raw(state, &noise);
+
+        auto actual = ket::calculate_probabilities_raw(state);
+        ket::apply_readout_noise(actual, model);
+
+        for (std::size_t i {0}; i < expected.size(); ++i) {
+            REQUIRE_THAT(actual[i], Catch::Matchers::WithinAbs(expected[i], ABS_TOL));
+        }
+    }
+
+    SECTION("asymmetric error of a single qubit")
+    {
+        auto model = ket::ReadoutNoiseModel {1};
+        model.set_qubit_error(0, 0.05, 0.2);
+
+        auto from_one = std::vector<double> {0.0, 1.0};
+        ket::apply_readout_noise(from_one, model);
+
+        REQUIRE_THAT(from_one[0], Catch::Matchers::WithinAbs(0.2, ABS_TOL));
+        REQUIRE_THAT(from_one[1], Catch::Matchers::WithinAbs(0.8, ABS_TOL));
+
+        auto from_zero = std::vector<double> {1.0, 0.0};
+        ket::apply_readout_noise(from_zero, model);
+
+        REQUIRE_THAT(from_zero[0], Catch::Matchers::WithinAbs(0.95, ABS_TOL));
+        REQUIRE_THAT(from_zero[1], Catch::Matchers::WithinAbs(0.05, ABS_TOL));
+    }
+
+    SECTION("correlated block matches the full tensor product")
+    {
+        auto model = ket::ReadoutNoiseModel {4};
+        model.add_correlated_block({3, 1}, correlated_matrix());
+        model.set_qubit_error(0, 0.1, 0.3);
+
+        const auto probabilities = std::vector<double> {
+            0.01, 0.02, 0.03, 0.04, 0.05, 0.06, 0.07, 0.08, 0.09, 0.10, 0.11, 0.12, 0.13, 0.04, 0.03, 0.02
+        };
+
+        auto actual = probabilities;
+        ket::apply_readout_noise(actual, model);
+
+        for (std::size_t i_measured {0}; i_measured < 16; ++i_measured) {
+            auto expected = 0.0;
+            for (std::size_t i_prepared {0}; i_prepared < 16; ++i_prepared) {
+                expected += brute_force_confusion(model, i_measured, i_prepared) * probabilities[i_prepared];
+            }
+
+            REQUIRE_THAT(actual[i_measured], Catch::Matchers::WithinAbs(expected, ABS_TOL));
+        }
+    }
+
+    SECTION("throws with the wrong number of probabilities")
+    {
+        const auto model = ket::ReadoutNoiseModel {2};
+        auto probabilities = std::vector<double> {0.5, 0.5};
+
+        REQUIRE_THROWS_AS(ket::apply_readout_noise(probabilities, model), std::runtime_error);
+    }
+}
+
+
+TEST_CASE("mitigate_readout_counts()")
+{
+    // with these entries, the noisy counts of the ideal counts below are exact integers
+    auto dyadic_matrix = Eigen::MatrixXd {4, 4};
+    dyadic_matrix << 0.750, 0.125, 0.125, 0.000,
+                     0.125, 0.750, 0.000, 0.125,
+                     0.125, 0.000, 0.750, 0.125,
+                     0.000, 0.125, 0.125, 0.750;
+
+    auto model = ket::ReadoutNoiseModel {3};
+    model.add_correlated_block({0, 2}, dyadic_matrix);
+    model.set_qubit_error(1, 0.25, 0.125);
+
+    SECTION("undoes the noise applied to exact counts")
+    {
+        const auto ideal = std::vector<double> {1024.0, 0.0, 2048.0, 512.0, 0.0, 3072.0, 0.0, 1536.0};
+
+        auto noisy = ideal;
+        ket::apply_readout_noise(noisy, model);
+
+        const auto noisy_counts = std::vector<std::uint64_t>(noisy.begin(), noisy.end());
+        const auto mitigated = ket::mitigate_readout_counts(noisy_counts, model);
+
+        for (std::size_t i {0}; i < ideal.size(); ++i) {
+            REQUIRE_THAT(mitigated[i], Catch::Matchers::WithinAbs(ideal[i], 1.0e-8));
+        }
+    }
+
+    SECTION("undoes the noise on sampled counts")
+    {
+        const auto ideal = std::vector<double> {0.125, 0.0, 0.25, 0.0625, 0.0, 0.375, 0.0, 0.1875};
+
+        auto noisy = ideal;
+        ket::apply_readout_noise(noisy, model);
+
+        constexpr auto n_shots = std::size_t {1} << 20;
+        const auto counts = ket::perform_measurements_as_counts_dense(noisy, n_shots, {}, 42, ket::SamplingMethod::MULTINOMIAL);
+        const auto mitigated = ket::mitigate_readout_counts(counts, model);
+
+        for (std::size_t i {0}; i < ideal.size(); ++i) {
+            REQUIRE_THAT(mitigated[i] / static_cast<double>(n_shots), Catch::Matchers::WithinAbs(ideal[i], 0.005));
+        }
+    }
+
+    SECTION("marginal qubits outside of the measured blocks are skipped")
+    {
+        // qubits 0 and 2 are measured; the ideal counts are indexed by (qubit 0, qubit 2)
+        const auto ideal = std::vector<double> {1024.0, 2048.0, 512.0, 1536.0};
+
+        auto noisy = ideal;
+        auto measured_model = ket::ReadoutNoiseModel {2};
+        measured_model.add_correlated_block({0, 1}, dyadic_matrix);
+        ket::apply_readout_noise(noisy, measured_model);
+
+        const auto noisy_counts = std::vector<std::uint64_t>(noisy.begin(), noisy.end());
+        const auto mitigated = ket::mitigate_readout_counts(noisy_counts, model, {1});
+
+        for (std::size_t i {0}; i < ideal.size(); ++i) {
+            REQUIRE_THAT(mitigated[i], Catch::Matchers::WithinAbs(ideal[i], 1.0e-8));
+        }
+    }
+
+    SECTION("throws if a block has both measured and marginal qubits")
+    {
+        const auto counts = std::vector<std::uint64_t> {1, 2, 3, 4};
+        REQUIRE_THROWS_AS(ket::mitigate_readout_counts(counts, model, {0}), std::runtime_error);
+    }
+
+    SECTION("throws with the wrong number of counts")
+    {
+        const auto counts = std::vector<std::uint64_t> {1, 2, 3, 4};
+        REQUIRE_THROWS_AS(ket::mitigate_readout_counts(counts, model), std::runtime_error);
+    }
+
+    SECTION("throws with a singular confusion matrix")
+    {
+        auto singular_model = ket::ReadoutNoiseModel {1};
+        singular_model.set_qubit_error(0, 0.5, 0.5);
+
+        const auto counts = std::vector<std::uint64_t> {10, 20};
+        REQUIRE_THROWS_AS(ket::mitigate_readout_counts(counts, singular_model), std::runtime_error);
+    }
+}
+
+
+TEST_CASE("ReadoutNoiseModel")
+{
+    auto model = ket::ReadoutNoiseModel {4};
+
+    SECTION("setting the error of a qubit again replaces it")
+    {
+        model.set_qubit_error(2, 0.1, 0.1);
+        model.set_qubit_error(2, 0.0, 0.2);
+
+        REQUIRE(model.blocks().size() == 1);
+        REQUIRE_THAT(model.blocks()[0].confusion_matrix(0, 1), Catch::Matchers::WithinAbs(0.2, ABS_TOL));
+    }
+
+    SECTION("throws if a qubit is in two blocks")
+    {
+        model.add_correlated_block({0, 1}, correlated_matrix());
+
+        REQUIRE_THROWS_AS(model.set_qubit_error(1, 0.1, 0.1), std::runtime_error);
+        REQUIRE_THROWS_AS(model.add_correlated_block({1, 2}, correlated_matrix()), std::runtime_error);
+    }
+
+    SECTION("throws with invalid blocks")
+    {
+        const auto identity = Eigen::MatrixXd {Eigen::MatrixXd::Identity(4, 4)};
+        const auto not_stochastic = Eigen::MatrixXd {Eigen::MatrixXd::Constant(4, 4, 0.5)};
+
+        REQUIRE_THROWS_AS(model.add_correlated_block({0, 1, 2}, identity), std::runtime_error);
+        REQUIRE_THROWS_AS(model.add_correlated_block({0, 0}, identity), std::runtime_error);
+        REQUIRE_THROWS_AS(model.add_correlated_block({0, 4}, identity), std::runtime_error);
+        REQUIRE_THROWS_AS(model.add_correlated_block({0, 1}, not_stochastic), std::runtime_error);
+        REQUIRE_THROWS_AS(model.set_qubit_error(0, 1.5, 0.0), std::runtime_error);
+    }
+}
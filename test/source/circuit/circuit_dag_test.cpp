@@ -0,0 +1,185 @@
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit/circuit_dag.hpp"
+#include "kettle/circuit_operations/compare_circuits.hpp"
+#include "kettle/parameter/parameter.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/statevector.hpp"
+
+using Indices = std::vector<std::size_t>;
+using Layers = std::vector<std::vector<std::size_t>>;
+
+
+TEST_CASE("CircuitDAG with gates only")
+{
+    auto circuit = ket::QuantumCircuit {4};
+    circuit.add_h_gate(0);        // 0
+    circuit.add_h_gate(1);        // 1
+    circuit.add_cx_gate(0, 1);    // 2
+    circuit.add_x_gate(3);        // 3
+    circuit.add_cx_gate(1, 2);    // 4
+    circuit.add_rz_gate(0, 0.5);  // 5
+
+    const auto dag = ket::CircuitDAG {circuit};
+
+    REQUIRE(dag.n_nodes() == 6);
+    REQUIRE(dag.n_qubits() == 4);
+
+    SECTION("edges")
+    {
+        REQUIRE_THAT(dag.predecessors(0), Catch::Matchers::Equals(Indices {}));
+        REQUIRE_THAT(dag.predecessors(2), Catch::Matchers::Equals(Indices {0, 1}));
+        REQUIRE_THAT(dag.predecessors(4), Catch::Matchers::Equals(Indices {2}));
+        REQUIRE_THAT(dag.successors(2), Catch::Matchers::Equals(Indices {4, 5}));
+        REQUIRE_THAT(dag.successors(3), Catch::Matchers::Equals(Indices {}));
+    }
+
+    SECTION("layers and depth")
+    {
+        REQUIRE_THAT(dag.layers(), Catch::Matchers::Equals(Layers {{0, 1, 3}, {2}, {4, 5}}));
+        REQUIRE(dag.depth() == 3);
+        REQUIRE(dag.layer_index(5) == 2);
+    }
+
+    SECTION("critical path")
+    {
+        REQUIRE_THAT(dag.critical_path(), Catch::Matchers::Equals(Indices {0, 2, 4}));
+    }
+
+    SECTION("conversion to a circuit")
+    {
+        REQUIRE(ket::almost_eq(dag.to_circuit(), circuit));
+
+        auto expected_layered = ket::QuantumCircuit {4};
+        expected_layered.add_h_gate(0);
+        expected_layered.add_h_gate(1);
+        expected_layered.add_x_gate(3);
+        expected_layered.add_cx_gate(0, 1);
+        expected_layered.add_cx_gate(1, 2);
+        expected_layered.add_rz_gate(0, 0.5);
+
+        REQUIRE(ket::almost_eq(dag.to_layered_circuit(), expected_layered));
+    }
+
+    SECTION("out of range node indices throw")
+    {
+        REQUIRE_THROWS_AS(dag.node(6), std::runtime_error);
+        REQUIRE_THROWS_AS(dag.predecessors(6), std::runtime_error);
+    }
+}
+
+TEST_CASE("CircuitDAG with measurements and control flow")
+{
+    SECTION("reading a bit depends on the measurement that wrote it")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate(0);                  // 0
+        circuit.add_m_gate(0, 0);               // 1
+        circuit.add_h_gate(2);                  // 2
+        circuit.add_if_statement(0, [] {        // 3
+            auto circ = ket::QuantumCircuit {3};
+            circ.add_x_gate(1);
+            return circ;
+        }());
+        circuit.add_x_gate(1);                  // 4
+
+        const auto dag = ket::CircuitDAG {circuit};
+
+        REQUIRE_THAT(dag.predecessors(3), Catch::Matchers::Equals(Indices {1}));
+        REQUIRE_THAT(dag.predecessors(4), Catch::Matchers::Equals(Indices {3}));
+        REQUIRE_THAT(dag.layers(), Catch::Matchers::Equals(Layers {{0, 2}, {1}, {3}, {4}}));
+    }
+
+    SECTION("overwriting a bit waits for the earlier reads")
+    {
+        auto circuit = ket::QuantumCircuit {3, 1};
+        circuit.add_m_gate(0, 0);               // 0
+        circuit.add_if_statement(0, [] {        // 1
+            auto circ = ket::QuantumCircuit {3, 1};
+            circ.add_x_gate(1);
+            return circ;
+        }());
+        circuit.add_m_gate(2, 0);               // 2
+
+        const auto dag = ket::CircuitDAG {circuit};
+
+        REQUIRE_THAT(dag.predecessors(2), Catch::Matchers::Equals(Indices {0, 1}));
+    }
+
+    SECTION("circuit loggers depend on everything before them")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_h_gate(1);
+        circuit.add_statevector_circuit_logger();
+        circuit.add_x_gate(0);
+
+        const auto dag = ket::CircuitDAG {circuit};
+
+        REQUIRE_THAT(dag.predecessors(2), Catch::Matchers::Equals(Indices {0, 1}));
+        REQUIRE_THAT(dag.predecessors(3), Catch::Matchers::Equals(Indices {2}));
+        REQUIRE(dag.depth() == 3);
+    }
+
+    SECTION("round trip is lossless")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        const auto id = circuit.add_ry_gate(0, 0.25, ket::param::parameterized {});
+        circuit.add_cx_gate(0, 1);
+        circuit.add_m_gate(1, 1);
+        circuit.add_if_else_statement(1,
+            [] { auto circ = ket::QuantumCircuit {3}; circ.add_x_gate(2); return circ; }(),
+            [] { auto circ = ket::QuantumCircuit {3}; circ.add_h_gate(2); return circ; }()
+        );
+        circuit.add_rx_gate(2, id);
+
+        const auto dag = ket::CircuitDAG {circuit};
+        auto recreated = dag.to_circuit();
+
+        REQUIRE(ket::almost_eq(recreated, circuit));
+
+        // the parameters are carried over as well
+        recreated.set_parameter_value(id, 1.0);
+        circuit.set_parameter_value(id, 1.0);
+        REQUIRE(ket::almost_eq(recreated, circuit));
+    }
+}
+
+TEST_CASE("CircuitDAG layered circuit is equivalent")
+{
+    auto circuit = ket::QuantumCircuit {4};
+    circuit.add_h_gate({0, 1, 2, 3});
+    circuit.add_cx_gate(0, 1);
+    circuit.add_ry_gate(3, 0.3);
+    circuit.add_cx_gate(2, 3);
+    circuit.add_crz_gate(1, 2, 0.7);
+    circuit.add_t_gate(0);
+    circuit.add_cy_gate(3, 0);
+
+    const auto layered = ket::CircuitDAG {circuit}.to_layered_circuit();
+
+    auto state = ket::generate_random_state(4, 42);
+    auto layered_state = state;
+
+    ket::simulate(circuit, state);
+    ket::simulate(layered, layered_state);
+
+    REQUIRE(ket::almost_eq(state, layered_state));
+}
+
+TEST_CASE("CircuitDAG of an empty circuit")
+{
+    const auto dag = ket::CircuitDAG {ket::QuantumCircuit {2}};
+
+    REQUIRE(dag.n_nodes() == 0);
+    REQUIRE(dag.depth() == 0);
+    REQUIRE(dag.layers().empty());
+    REQUIRE(dag.critical_path().empty());
+}
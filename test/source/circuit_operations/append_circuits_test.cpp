@@ -1,9 +1,13 @@
+#include <stdexcept>
+#include <utility>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include "kettle/circuit/circuit.hpp"
 #include "kettle/gates/common_u_gates.hpp"
 #include "kettle/circuit_operations/append_circuits.hpp"
 #include "kettle/circuit_operations/compare_circuits.hpp"
+#include "kettle/parameter/parameter.hpp"
 
 
 TEST_CASE("append_circuits working")
@@ -227,3 +231,75 @@ TEST_CASE("extend_circuit() with control flow")
         }
     }
 }
+
+TEST_CASE("extend_circuit() and append_circuits() with an rvalue right circuit")
+{
+    const auto add_right_gates = [](ket::QuantumCircuit& circuit) {
+        circuit.add_h_gate({1, 2});
+        circuit.add_m_gate(1, 0);
+        circuit.add_if_statement(0, [] {
+            auto subcircuit = ket::QuantumCircuit {3, 1};
+            subcircuit.add_u_gate(ket::x_gate(), 2);
+            return subcircuit;
+        }());
+    };
+
+    SECTION("non-empty left circuit")
+    {
+        auto left = ket::QuantumCircuit {3, 1};
+        left.add_x_gate(0);
+
+        auto right = ket::QuantumCircuit {3, 1};
+        add_right_gates(right);
+
+        auto expected = ket::QuantumCircuit {3, 1};
+        expected.add_x_gate(0);
+        add_right_gates(expected);
+
+        ket::extend_circuit(left, std::move(right));
+
+        REQUIRE(ket::almost_eq(left, expected));
+    }
+
+    SECTION("empty left circuit")
+    {
+        auto right = ket::QuantumCircuit {3, 1};
+        add_right_gates(right);
+
+        auto expected = ket::QuantumCircuit {3, 1};
+        add_right_gates(expected);
+
+        const auto combined = ket::append_circuits(ket::QuantumCircuit {3, 1}, std::move(right));
+
+        REQUIRE(ket::almost_eq(combined, expected));
+    }
+
+    SECTION("parameters are moved over")
+    {
+        auto left = ket::QuantumCircuit {1};
+        left.add_x_gate(0);
+
+        auto right = ket::QuantumCircuit {1};
+        const auto id = right.add_rx_gate(0, 0.5, ket::param::parameterized {});
+
+        auto expected = ket::QuantumCircuit {1};
+        expected.add_x_gate(0);
+        expected.add_rx_gate(0, 0.5);
+
+        auto combined = ket::append_circuits(std::move(left), std::move(right));
+        REQUIRE(ket::almost_eq(combined, expected));
+
+        combined.set_parameter_value(id, 0.25);
+
+        auto expected_after = ket::QuantumCircuit {1};
+        expected_after.add_x_gate(0);
+        expected_after.add_rx_gate(0, 0.25);
+        REQUIRE(ket::almost_eq(combined, expected_after));
+    }
+
+    SECTION("mismatched circuits throw")
+    {
+        auto left = ket::QuantumCircuit {2};
+        REQUIRE_THROWS_AS(ket::extend_circuit(left, ket::QuantumCircuit {3}), std::runtime_error);
+    }
+}
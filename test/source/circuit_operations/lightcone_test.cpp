@@ -0,0 +1,214 @@
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include "kettle/calculations/measurements.hpp"
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit_operations/compare_circuits.hpp"
+#include "kettle/circuit_operations/lightcone.hpp"
+#include "kettle/parameter/parameter.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/state/density_matrix.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/statevector.hpp"
+#include "kettle_internal/common/state_test_utils.hpp"
+
+namespace ki = ket::internal;
+
+
+TEST_CASE("lightcone_qubits()")
+{
+    auto circuit = ket::QuantumCircuit {5};
+    circuit.add_h_gate(0);
+    circuit.add_cx_gate(0, 1);
+    circuit.add_cx_gate(2, 3);
+    circuit.add_x_gate(4);
+    circuit.add_cx_gate(1, 4);
+
+    SECTION("single qubit at the end of a chain")
+    {
+        REQUIRE_THAT(ket::lightcone_qubits(circuit, {4}), Catch::Matchers::Equals(std::vector<std::size_t> {0, 1, 4}));
+    }
+
+    SECTION("the control qubit of a later gate is included")
+    {
+        // the CX gate after the interaction between qubits 0 and 1 cannot affect qubit 0
+        REQUIRE_THAT(ket::lightcone_qubits(circuit, {0}), Catch::Matchers::Equals(std::vector<std::size_t> {0, 1}));
+    }
+
+    SECTION("independent subsystem")
+    {
+        REQUIRE_THAT(ket::lightcone_qubits(circuit, {3}), Catch::Matchers::Equals(std::vector<std::size_t> {2, 3}));
+    }
+
+    SECTION("out of range indices throw")
+    {
+        REQUIRE_THROWS_AS(ket::lightcone_qubits(circuit, {5}), std::runtime_error);
+        REQUIRE_THROWS_AS(ket::lightcone_qubits(circuit, {0}, {5}), std::runtime_error);
+    }
+}
+
+TEST_CASE("prune_to_lightcone()")
+{
+    SECTION("drops gates outside of the lightcone")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate(0);
+        circuit.add_h_gate(2);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_rz_gate(2, 0.5);
+        circuit.add_cx_gate(2, 1);
+        circuit.add_x_gate(2);
+
+        auto expected = ket::QuantumCircuit {3};
+        expected.add_h_gate(0);
+        expected.add_cx_gate(0, 1);
+
+        const auto pruned = ket::prune_to_lightcone(circuit, {0});
+        REQUIRE(ket::almost_eq(pruned, expected));
+    }
+
+    SECTION("new parameters do not reuse the names of existing ones")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        const auto id0 = circuit.add_rx_gate(0, 0.5, ket::param::parameterized {});
+        circuit.add_h_gate(1);
+
+        auto pruned = ket::prune_to_lightcone(circuit, {0});
+        const auto id1 = pruned.add_ry_gate(0, 0.25, ket::param::parameterized {});
+
+        const auto& parameters = pruned.parameter_data_map();
+        REQUIRE(parameters.at(id0).name != parameters.at(id1).name);
+    }
+
+    SECTION("keeps measurements into observed bits, and the gates before them")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_x_gate(1);
+        circuit.add_m_gate(1, 0);
+        circuit.add_h_gate(0);
+
+        const auto pruned = ket::prune_to_lightcone(circuit, {}, {0});
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_x_gate(1);
+        expected.add_m_gate(1, 0);
+
+        REQUIRE(ket::almost_eq(pruned, expected));
+    }
+
+    SECTION("an overwritten bit does not keep earlier measurements")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_m_gate(0, 0);
+        circuit.add_m_gate(1, 0);
+
+        const auto pruned = ket::prune_to_lightcone(circuit, {}, {0});
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_m_gate(1, 0);
+
+        REQUIRE(ket::almost_eq(pruned, expected));
+    }
+
+    SECTION("control flow statements pull in the bits they read")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate(2);
+        circuit.add_m_gate(2, 2);
+        circuit.add_h_gate(1);
+        circuit.add_if_statement(2, [] { auto circ = ket::QuantumCircuit {3}; circ.add_x_gate(0); return circ; }());
+
+        REQUIRE_THAT(ket::lightcone_qubits(circuit, {0}), Catch::Matchers::Equals(std::vector<std::size_t> {0, 2}));
+
+        const auto pruned = ket::prune_to_lightcone(circuit, {0});
+        REQUIRE(pruned.n_circuit_elements() == 3);
+    }
+
+    SECTION("control flow statements outside of the lightcone are removed")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_m_gate(1, 1);
+        circuit.add_if_statement(1, [] { auto circ = ket::QuantumCircuit {2}; circ.add_x_gate(1); return circ; }());
+        circuit.add_x_gate(0);
+
+        const auto pruned = ket::prune_to_lightcone(circuit, {0});
+        REQUIRE(pruned.n_circuit_elements() == 1);
+    }
+
+    SECTION("the reduced state of the observed qubits is unchanged")
+    {
+        auto circuit = ket::QuantumCircuit {4};
+        circuit.add_h_gate({0, 1, 2, 3});
+        circuit.add_cx_gate(0, 1);
+        circuit.add_crx_gate(2, 3, 0.3);
+        circuit.add_ry_gate(1, 1.1);
+        circuit.add_cx_gate(1, 2);
+        circuit.add_rz_gate(3, 0.7);
+        circuit.add_cx_gate(3, 2);
+
+        auto original_state = ket::generate_random_state(4, 2468);
+        auto pruned_state = original_state;
+
+        ket::simulate(circuit, original_state);
+        ket::simulate(ket::prune_to_lightcone(circuit, {0, 1}), pruned_state);
+
+        const auto original_reduced = ket::partial_trace(ket::statevector_to_density_matrix(original_state), {2, 3});
+        const auto pruned_reduced = ket::partial_trace(ket::statevector_to_density_matrix(pruned_state), {2, 3});
+
+        REQUIRE(ki::almost_eq_with_print_(original_reduced, pruned_reduced));
+    }
+}
+
+TEST_CASE("reduce_to_lightcone()")
+{
+    auto circuit = ket::QuantumCircuit {4};
+    circuit.add_x_gate(3);
+    circuit.add_h_gate(0);
+    circuit.add_cx_gate(3, 1);
+    circuit.add_cx_gate(0, 2);
+
+    const auto reduced = ket::reduce_to_lightcone(circuit, {1});
+
+    REQUIRE_THAT(reduced.kept_qubits, Catch::Matchers::Equals(std::vector<std::size_t> {1, 3}));
+    REQUIRE(reduced.circuit.n_qubits() == 2);
+
+    auto expected = ket::QuantumCircuit {2, 4};
+    expected.add_x_gate(1);
+    expected.add_cx_gate(1, 0);
+
+    REQUIRE(ket::almost_eq(reduced.circuit, expected));
+}
+
+TEST_CASE("perform_measurements_as_counts_marginal() with a circuit uses the lightcone")
+{
+    // the qubits 1 and 2 are entangled with each other, but not with qubit 0
+    auto circuit = ket::QuantumCircuit {3};
+    circuit.add_x_gate(0);
+    circuit.add_h_gate(1);
+    circuit.add_cx_gate(1, 2);
+
+    SECTION("basis state input")
+    {
+        const auto counts = ket::perform_measurements_as_counts_marginal(circuit, ket::Statevector {"000"}, 100, {1, 2});
+
+        REQUIRE(counts.size() == 1);
+        REQUIRE(counts.at("1xx") == 100);
+    }
+
+    SECTION("superposition input")
+    {
+        // qubit 0 starts in the |+> state
+        const auto state = ket::Statevector {{{M_SQRT1_2, 0.0}, {M_SQRT1_2, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}}};
+        const auto counts = ket::perform_measurements_as_counts_marginal(circuit, state, 100, {0});
+
+        for (const auto& [bitstring, count] : counts) {
+            REQUIRE((bitstring == "x00" || bitstring == "x11"));
+        }
+    }
+}
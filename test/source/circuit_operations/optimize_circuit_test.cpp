@@ -0,0 +1,347 @@
+#include <cmath>
+#include <cstddef>
+#include <random>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit_operations/compare_circuits.hpp"
+#include "kettle/circuit_operations/optimize_circuit.hpp"
+#include "kettle/parameter/parameter.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+TEST_CASE("optimize_circuit() cancels pairs of gates")
+{
+    SECTION("self-inverse single-qubit gates")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_h_gate(0);
+        circuit.add_x_gate(1);
+        circuit.add_x_gate(1);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(optimized.n_circuit_elements() == 0);
+    }
+
+    SECTION("gates and their adjoints")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_s_gate(0);
+        circuit.add_sdag_gate(0);
+        circuit.add_tdag_gate(1);
+        circuit.add_t_gate(1);
+        circuit.add_sx_gate(0);
+        circuit.add_sxdag_gate(0);
+        circuit.add_cs_gate(0, 1);
+        circuit.add_csdag_gate(0, 1);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(optimized.n_circuit_elements() == 0);
+    }
+
+    SECTION("nested pairs cancel from the inside out")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_s_gate(1);
+        circuit.add_sdag_gate(1);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_h_gate(0);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(optimized.n_circuit_elements() == 0);
+    }
+
+    SECTION("CX gates with swapped control and target do not cancel")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_cx_gate(0, 1);
+        circuit.add_cx_gate(1, 0);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(ket::almost_eq(optimized, circuit));
+    }
+
+    SECTION("CZ gates with swapped control and target cancel")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_cz_gate(0, 1);
+        circuit.add_cz_gate(1, 0);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(optimized.n_circuit_elements() == 0);
+    }
+
+    SECTION("different gates do not cancel")
+    {
+        auto circuit = ket::QuantumCircuit {1};
+        circuit.add_s_gate(0);
+        circuit.add_s_gate(0);
+        circuit.add_x_gate(0);
+        circuit.add_y_gate(0);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(ket::almost_eq(optimized, circuit));
+    }
+}
+
+TEST_CASE("optimize_circuit() merges rotations")
+{
+    SECTION("fixed angles")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_rz_gate(0, 0.25);
+        circuit.add_rz_gate(0, 0.5);
+        circuit.add_crx_gate(0, 1, 1.0);
+        circuit.add_crx_gate(0, 1, -0.25);
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_rz_gate(0, 0.75);
+        expected.add_crx_gate(0, 1, 0.75);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(ket::almost_eq(optimized, expected));
+    }
+
+    SECTION("rotations that add up to the identity are removed")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_rx_gate(0, M_PI);
+        circuit.add_rx_gate(0, -M_PI);
+        circuit.add_p_gate(1, M_PI);
+        circuit.add_p_gate(1, M_PI);
+        circuit.add_ry_gate(1, 0.0);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(optimized.n_circuit_elements() == 0);
+    }
+
+    SECTION("RZ rotations that add up to 2pi are kept")
+    {
+        // RZ(2pi) = -I; removing it would change the phase of the state
+        auto circuit = ket::QuantumCircuit {1};
+        circuit.add_rz_gate(0, M_PI);
+        circuit.add_rz_gate(0, M_PI);
+
+        auto expected = ket::QuantumCircuit {1};
+        expected.add_rz_gate(0, 2.0 * M_PI);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(ket::almost_eq(optimized, expected));
+    }
+
+    SECTION("parameterized angles")
+    {
+        auto circuit = ket::QuantumCircuit {1};
+        const auto id = circuit.add_rx_gate(0, 0.25, ket::param::parameterized {});
+        circuit.add_rx_gate(0, 0.5);
+
+        auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(optimized.n_circuit_elements() == 1);
+
+        auto expected = ket::QuantumCircuit {1};
+        expected.add_rx_gate(0, 0.75);
+        REQUIRE(ket::almost_eq(optimized, expected));
+
+        // the merged gate still depends on the parameter
+        optimized.set_parameter_value(id, 1.5);
+
+        auto expected_changed = ket::QuantumCircuit {1};
+        expected_changed.add_rx_gate(0, 2.0);
+        REQUIRE(ket::almost_eq(optimized, expected_changed));
+    }
+
+    SECTION("parameterized rotations are never removed as identities")
+    {
+        auto circuit = ket::QuantumCircuit {1};
+        circuit.add_rz_gate(0, 0.5, ket::param::parameterized {});
+        circuit.add_rz_gate(0, -0.5);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(optimized.n_circuit_elements() == 1);
+    }
+}
+
+TEST_CASE("optimize_circuit() looks through commuting gates")
+{
+    SECTION("diagonal gate on the control qubit")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_cx_gate(0, 1);
+        circuit.add_rz_gate(0, 0.3);
+        circuit.add_cx_gate(0, 1);
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_rz_gate(0, 0.3);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(ket::almost_eq(optimized, expected));
+    }
+
+    SECTION("X-axis gate on the target qubit")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_rx_gate(1, 0.2);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_rx_gate(1, 0.3);
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_rx_gate(1, 0.5);
+        expected.add_cx_gate(0, 1);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(ket::almost_eq(optimized, expected));
+    }
+
+    SECTION("non-commuting gates block the search")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_cx_gate(0, 1);
+        circuit.add_h_gate(0);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_rz_gate(1, 0.1);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_rz_gate(1, 0.2);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(ket::almost_eq(optimized, circuit));
+    }
+
+    SECTION("the window size limits how far back the search goes")
+    {
+        auto circuit = ket::QuantumCircuit {1};
+        circuit.add_x_gate(0);
+        circuit.add_rx_gate(0, 0.2);
+        circuit.add_x_gate(0);
+
+        auto expected = ket::QuantumCircuit {1};
+        expected.add_rx_gate(0, 0.2);
+
+        REQUIRE(ket::almost_eq(ket::optimize_circuit(circuit), expected));
+        REQUIRE(ket::almost_eq(ket::optimize_circuit(circuit, 1), circuit));
+    }
+}
+
+TEST_CASE("optimize_circuit() with barriers")
+{
+    SECTION("measurements block the qubit they measure")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_h_gate(1);
+        circuit.add_m_gate(0);
+        circuit.add_h_gate(0);
+        circuit.add_h_gate(1);
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_h_gate(0);
+        expected.add_m_gate(0);
+        expected.add_h_gate(0);
+
+        const auto optimized = ket::optimize_circuit(circuit);
+        REQUIRE(ket::almost_eq(optimized, expected));
+    }
+
+    SECTION("control flow blocks all qubits, and the subcircuits are optimized")
+    {
+        auto subcircuit = ket::QuantumCircuit {2};
+        subcircuit.add_z_gate(1);
+        subcircuit.add_z_gate(1);
+        subcircuit.add_x_gate(1);
+
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_m_gate(1);
+        circuit.add_if_statement(1, subcircuit);
+        circuit.add_h_gate(0);
+
+        auto expected_subcircuit = ket::QuantumCircuit {2};
+        expected_subcircuit.add_x_gate(1);
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_h_gate(0);
+        expected.add_m_gate(1);
+        expected.add_if_statement(1, expected_subcircuit);
+        expected.add_h_gate(0);
+
+        auto statistics = ket::CircuitOptimizationStatistics {};
+        const auto optimized = ket::optimize_circuit(circuit, statistics);
+
+        REQUIRE(ket::almost_eq(optimized, expected));
+        REQUIRE(statistics.n_gates_before == 6);
+        REQUIRE(statistics.n_gates_after == 4);
+        REQUIRE(statistics.n_cancelled_gates == 2);
+    }
+}
+
+TEST_CASE("optimize_circuit() statistics")
+{
+    auto circuit = ket::QuantumCircuit {2};
+    circuit.add_h_gate(0);
+    circuit.add_h_gate(0);
+    circuit.add_rz_gate(1, 0.1);
+    circuit.add_rz_gate(1, 0.2);
+    circuit.add_rz_gate(1, -0.3);
+    circuit.add_cx_gate(0, 1);
+
+    auto statistics = ket::CircuitOptimizationStatistics {};
+    const auto optimized = ket::optimize_circuit(circuit, statistics);
+
+    REQUIRE(optimized.n_circuit_elements() == 1);
+    REQUIRE(statistics.n_gates_before == 6);
+    REQUIRE(statistics.n_gates_after == 1);
+    REQUIRE(statistics.n_cancelled_gates == 2);
+    REQUIRE(statistics.n_merged_gates == 2);
+    REQUIRE(statistics.n_identity_gates == 1);
+}
+
+TEST_CASE("optimize_circuit() preserves the action of random circuits")
+{
+    const auto seed = GENERATE(1, 2, 3, 4, 5);
+    const auto n_qubits = std::size_t {3};
+
+    auto prng = std::mt19937 {static_cast<std::mt19937::result_type>(seed)};
+    auto gate_dist = std::uniform_int_distribution<int> {0, 9};
+    auto qubit_dist = std::uniform_int_distribution<std::size_t> {0, n_qubits - 1};
+    auto angle_dist = std::uniform_real_distribution<double> {-M_PI, M_PI};
+
+    auto circuit = ket::QuantumCircuit {n_qubits};
+
+    for (std::size_t i {0}; i < 60; ++i) {
+        const auto target = qubit_dist(prng);
+        const auto control = (target + 1 + qubit_dist(prng) % (n_qubits - 1)) % n_qubits;
+
+        switch (gate_dist(prng)) {
+            case 0 : circuit.add_h_gate(target); break;
+            case 1 : circuit.add_x_gate(target); break;
+            case 2 : circuit.add_s_gate(target); break;
+            case 3 : circuit.add_sdag_gate(target); break;
+            case 4 : circuit.add_rz_gate(target, angle_dist(prng)); break;
+            case 5 : circuit.add_rx_gate(target, angle_dist(prng)); break;
+            case 6 : circuit.add_cx_gate(control, target); break;
+            case 7 : circuit.add_cz_gate(control, target); break;
+            case 8 : circuit.add_crz_gate(control, target, angle_dist(prng)); break;
+            default : circuit.add_csx_gate(control, target); break;
+        }
+    }
+
+    auto statistics = ket::CircuitOptimizationStatistics {};
+    const auto optimized = ket::optimize_circuit(circuit, statistics);
+
+    REQUIRE(statistics.n_gates_before == circuit.n_circuit_elements());
+    REQUIRE(statistics.n_gates_after == optimized.n_circuit_elements());
+
+    auto original_state = ket::generate_random_state(n_qubits, seed);
+    auto optimized_state = original_state;
+
+    ket::simulate(circuit, original_state);
+    ket::simulate(optimized, optimized_state);
+
+    REQUIRE(ket::almost_eq(original_state, optimized_state));
+}
@@ -0,0 +1,159 @@
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit_operations/compare_circuits.hpp"
+#include "kettle/circuit_operations/relabel_qubits.hpp"
+#include "kettle/gates/common_u_gates.hpp"
+#include "kettle/parameter/parameter.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+TEST_CASE("relabel_qubits()")
+{
+    SECTION("permute the qubits")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate(0);
+        circuit.add_cx_gate(0, 2);
+        circuit.add_rz_gate(1, 0.25);
+        circuit.add_u_gate(ket::sx_gate(), 2);
+        circuit.add_m_gate(2, 0);
+
+        const auto relabelled = ket::relabel_qubits(circuit, {2, 0, 1}, 3);
+
+        auto expected = ket::QuantumCircuit {3};
+        expected.add_h_gate(2);
+        expected.add_cx_gate(2, 1);
+        expected.add_rz_gate(0, 0.25);
+        expected.add_u_gate(ket::sx_gate(), 1);
+        expected.add_m_gate(1, 0);
+
+        REQUIRE(ket::almost_eq(relabelled, expected));
+    }
+
+    SECTION("remove an unused qubit")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_x_gate(0);
+        circuit.add_cx_gate(0, 2);
+
+        const auto relabelled = ket::relabel_qubits(circuit, {0, 99, 1}, 2);
+
+        REQUIRE(relabelled.n_qubits() == 2);
+        REQUIRE(relabelled.n_bits() == 3);
+
+        auto state = ket::Statevector {"00"};
+        ket::simulate(relabelled, state);
+        REQUIRE(ket::almost_eq(state, ket::Statevector {"11"}));
+    }
+
+    SECTION("control flow subcircuits are relabelled")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_x_gate(1);
+        circuit.add_m_gate(1, 0);
+        circuit.add_if_statement(0, [] { auto circ = ket::QuantumCircuit {2}; circ.add_x_gate(0); return circ; }());
+
+        const auto relabelled = ket::relabel_qubits(circuit, {1, 0}, 2);
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_x_gate(0);
+        expected.add_m_gate(0, 0);
+        expected.add_if_statement(0, [] { auto circ = ket::QuantumCircuit {2}; circ.add_x_gate(1); return circ; }());
+
+        REQUIRE(ket::almost_eq(relabelled, expected));
+    }
+
+    SECTION("parameterized gates keep their parameters")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        const auto id = circuit.add_rx_gate(0, 0.5, ket::param::parameterized {});
+
+        auto relabelled = ket::relabel_qubits(circuit, {1, 0}, 2);
+        relabelled.set_parameter_value(id, M_PI);
+
+        auto state = ket::Statevector {"00"};
+        ket::simulate(relabelled, state);
+        REQUIRE(ket::almost_eq(state, ket::Statevector {{{0.0, 0.0}, {0.0, 0.0}, {0.0, -1.0}, {0.0, 0.0}}}));
+    }
+
+    SECTION("new parameters do not reuse the names of existing ones")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        const auto id0 = circuit.add_rx_gate(0, 0.5, ket::param::parameterized {});
+
+        auto relabelled = ket::relabel_qubits(circuit, {1, 0}, 2);
+        const auto id1 = relabelled.add_ry_gate(0, 0.25, ket::param::parameterized {});
+
+        const auto& parameters = relabelled.parameter_data_map();
+        REQUIRE(parameters.at(id0).name != parameters.at(id1).name);
+    }
+
+    SECTION("throws for invalid mappings")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_cx_gate(0, 1);
+
+        REQUIRE_THROWS_AS(ket::relabel_qubits(circuit, {0}, 2), std::runtime_error);
+        REQUIRE_THROWS_AS(ket::relabel_qubits(circuit, {0, 2}, 2), std::runtime_error);
+        REQUIRE_THROWS_AS(ket::relabel_qubits(circuit, {0, 0}, 2), std::runtime_error);
+    }
+}
+
+TEST_CASE("qubit_gate_counts()")
+{
+    auto circuit = ket::QuantumCircuit {4};
+    circuit.add_h_gate(3);
+    circuit.add_cx_gate(3, 0);
+    circuit.add_m_gate(3, 0);
+    circuit.add_if_statement(0, [] { auto circ = ket::QuantumCircuit {4}; circ.add_x_gate(1); return circ; }());
+
+    REQUIRE_THAT(ket::qubit_gate_counts(circuit), Catch::Matchers::Equals(std::vector<std::size_t> {1, 1, 0, 3}));
+}
+
+TEST_CASE("hot_qubit_permutation()")
+{
+    SECTION("the most used qubit is moved to index 0")
+    {
+        auto circuit = ket::QuantumCircuit {4};
+        circuit.add_h_gate(3);
+        circuit.add_cx_gate(3, 0);
+        circuit.add_cx_gate(3, 1);
+        circuit.add_cx_gate(3, 2);
+        circuit.add_x_gate(2);
+
+        // counts are {1, 1, 2, 4}
+        REQUIRE_THAT(ket::hot_qubit_permutation(circuit), Catch::Matchers::Equals(std::vector<std::size_t> {2, 3, 1, 0}));
+    }
+
+    SECTION("equally used qubits keep their order")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate({0, 1, 2});
+
+        REQUIRE_THAT(ket::hot_qubit_permutation(circuit), Catch::Matchers::Equals(std::vector<std::size_t> {0, 1, 2}));
+    }
+}
+
+TEST_CASE("relabel_hot_qubits()")
+{
+    auto circuit = ket::QuantumCircuit {2};
+    circuit.add_h_gate(1);
+    circuit.add_cx_gate(1, 0);
+
+    const auto relabelled = ket::relabel_hot_qubits(circuit);
+
+    auto expected = ket::QuantumCircuit {2};
+    expected.add_h_gate(0);
+    expected.add_cx_gate(0, 1);
+
+    REQUIRE_THAT(relabelled.new_qubit_indices, Catch::Matchers::Equals(std::vector<std::size_t> {1, 0}));
+    REQUIRE(ket::almost_eq(relabelled.circuit, expected));
+}
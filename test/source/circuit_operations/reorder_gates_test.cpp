@@ -0,0 +1,208 @@
+#include <cmath>
+#include <cstddef>
+#include <random>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit_operations/compare_circuits.hpp"
+#include "kettle/circuit_operations/optimize_circuit.hpp"
+#include "kettle/circuit_operations/reorder_gates.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+TEST_CASE("reorder_commuting_gates() groups gates by qubit")
+{
+    SECTION("gates on disjoint qubits")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_h_gate(1);
+        circuit.add_x_gate(0);
+        circuit.add_y_gate(1);
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_h_gate(0);
+        expected.add_x_gate(0);
+        expected.add_h_gate(1);
+        expected.add_y_gate(1);
+
+        REQUIRE(ket::almost_eq(ket::reorder_commuting_gates(circuit), expected));
+    }
+
+    SECTION("two-qubit gates pull in the single-qubit gates on their qubits")
+    {
+        auto circuit = ket::QuantumCircuit {4};
+        circuit.add_cx_gate(0, 1);
+        circuit.add_cx_gate(2, 3);
+        circuit.add_rx_gate(1, 0.5);
+        circuit.add_rx_gate(3, 0.5);
+
+        auto expected = ket::QuantumCircuit {4};
+        expected.add_cx_gate(0, 1);
+        expected.add_rx_gate(1, 0.5);
+        expected.add_cx_gate(2, 3);
+        expected.add_rx_gate(3, 0.5);
+
+        REQUIRE(ket::almost_eq(ket::reorder_commuting_gates(circuit), expected));
+    }
+
+    SECTION("diagonal gates are placed together")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_rz_gate(0, 0.1);
+        circuit.add_h_gate(1);
+        circuit.add_t_gate(2);
+
+        auto expected = ket::QuantumCircuit {3};
+        expected.add_rz_gate(0, 0.1);
+        expected.add_t_gate(2);
+        expected.add_h_gate(1);
+
+        REQUIRE(ket::almost_eq(ket::reorder_commuting_gates(circuit), expected));
+    }
+
+    SECTION("gates move past commuting gates to reach each other")
+    {
+        // the RZ gate on the control qubit commutes with the CX gate
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_rz_gate(0, 0.1);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_h_gate(1);
+        circuit.add_rz_gate(0, 0.2);
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_rz_gate(0, 0.1);
+        expected.add_rz_gate(0, 0.2);
+        expected.add_cx_gate(0, 1);
+        expected.add_h_gate(1);
+
+        REQUIRE(ket::almost_eq(ket::reorder_commuting_gates(circuit), expected));
+    }
+
+    SECTION("non-commuting gates keep their order")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_h_gate(1);
+        circuit.add_cx_gate(1, 0);
+        circuit.add_x_gate(0);
+
+        REQUIRE(ket::almost_eq(ket::reorder_commuting_gates(circuit), circuit));
+    }
+}
+
+TEST_CASE("reorder_commuting_gates() with measurements and barriers")
+{
+    SECTION("gates do not move past a measurement on the same qubit")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_x_gate(0);
+        circuit.add_h_gate(1);
+        circuit.add_m_gate(0);
+        circuit.add_x_gate(0);
+        circuit.add_h_gate(1);
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_x_gate(0);
+        expected.add_m_gate(0);
+        expected.add_x_gate(0);
+        expected.add_h_gate(1);
+        expected.add_h_gate(1);
+
+        REQUIRE(ket::almost_eq(ket::reorder_commuting_gates(circuit), expected));
+    }
+
+    SECTION("measurements writing to the same bit keep their order")
+    {
+        auto circuit = ket::QuantumCircuit {3, 1};
+        circuit.add_x_gate(2);
+        circuit.add_m_gate(0, 0);
+        circuit.add_m_gate(2, 0);
+        circuit.add_x_gate(0);
+
+        const auto reordered = ket::reorder_commuting_gates(circuit);
+
+        auto state = ket::Statevector {"000"};
+        auto simulator = ket::StatevectorSimulator {};
+        simulator.run(reordered, state);
+
+        REQUIRE(simulator.classical_register().get(0) == 1);
+    }
+
+    SECTION("control flow statements are barriers")
+    {
+        auto subcircuit = ket::QuantumCircuit {2};
+        subcircuit.add_h_gate(0);
+        subcircuit.add_h_gate(1);
+        subcircuit.add_h_gate(0);
+
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_m_gate(1);
+        circuit.add_h_gate(0);
+        circuit.add_if_statement(1, subcircuit);
+        circuit.add_h_gate(0);
+
+        auto expected_subcircuit = ket::QuantumCircuit {2};
+        expected_subcircuit.add_h_gate(0);
+        expected_subcircuit.add_h_gate(0);
+        expected_subcircuit.add_h_gate(1);
+
+        auto expected = ket::QuantumCircuit {2};
+        expected.add_m_gate(1);
+        expected.add_h_gate(0);
+        expected.add_if_statement(1, expected_subcircuit);
+        expected.add_h_gate(0);
+
+        REQUIRE(ket::almost_eq(ket::reorder_commuting_gates(circuit), expected));
+    }
+}
+
+TEST_CASE("reorder_commuting_gates() preserves the action of random circuits")
+{
+    const auto seed = GENERATE(11, 12, 13, 14, 15);
+    const auto n_qubits = std::size_t {4};
+
+    auto prng = std::mt19937 {static_cast<std::mt19937::result_type>(seed)};
+    auto gate_dist = std::uniform_int_distribution<int> {0, 9};
+    auto qubit_dist = std::uniform_int_distribution<std::size_t> {0, n_qubits - 1};
+    auto angle_dist = std::uniform_real_distribution<double> {-M_PI, M_PI};
+
+    auto circuit = ket::QuantumCircuit {n_qubits};
+
+    for (std::size_t i {0}; i < 80; ++i) {
+        const auto target = qubit_dist(prng);
+        const auto control = (target + 1 + qubit_dist(prng) % (n_qubits - 1)) % n_qubits;
+
+        switch (gate_dist(prng)) {
+            case 0 : circuit.add_h_gate(target); break;
+            case 1 : circuit.add_x_gate(target); break;
+            case 2 : circuit.add_t_gate(target); break;
+            case 3 : circuit.add_ry_gate(target, angle_dist(prng)); break;
+            case 4 : circuit.add_rz_gate(target, angle_dist(prng)); break;
+            case 5 : circuit.add_rx_gate(target, angle_dist(prng)); break;
+            case 6 : circuit.add_cx_gate(control, target); break;
+            case 7 : circuit.add_cz_gate(control, target); break;
+            case 8 : circuit.add_cry_gate(control, target, angle_dist(prng)); break;
+            default : circuit.add_cp_gate(control, target, angle_dist(prng)); break;
+        }
+    }
+
+    const auto reordered = ket::reorder_commuting_gates(circuit);
+    REQUIRE(reordered.n_circuit_elements() == circuit.n_circuit_elements());
+
+    auto original_state = ket::generate_random_state(n_qubits, seed);
+    auto reordered_state = original_state;
+    auto optimized_state = original_state;
+
+    ket::simulate(circuit, original_state);
+    ket::simulate(reordered, reordered_state);
+    ket::simulate(ket::optimize_circuit(reordered), optimized_state);
+
+    REQUIRE(ket::almost_eq(original_state, reordered_state));
+    REQUIRE(ket::almost_eq(original_state, optimized_state));
+}
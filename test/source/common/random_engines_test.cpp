@@ -0,0 +1,155 @@
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <kettle/common/random_engines.hpp>
+
+static_assert(std::uniform_random_bit_generator<ket::Xoshiro256PlusPlus>);
+static_assert(std::uniform_random_bit_generator<ket::Philox4x32>);
+
+
+TEST_CASE("Xoshiro256PlusPlus")
+{
+    SECTION("matches the reference implementation")
+    {
+        auto prng = ket::Xoshiro256PlusPlus {ket::Xoshiro256PlusPlus::state_type {1, 2, 3, 4}};
+
+        REQUIRE(prng() == 41943041ULL);
+        REQUIRE(prng() == 58720359ULL);
+        REQUIRE(prng() == 3588806011781223ULL);
+        REQUIRE(prng() == 3591011842654386ULL);
+    }
+
+    SECTION("jump()")
+    {
+        auto prng = ket::Xoshiro256PlusPlus {ket::Xoshiro256PlusPlus::state_type {1, 2, 3, 4}};
+        prng.jump();
+
+        const auto expected = ket::Xoshiro256PlusPlus::state_type {
+            0x8c7a153956b5f3d1ULL, 0x701f1a713401d85eULL, 0x6527f66a65469085ULL, 0x8386b786c4408050ULL
+        };
+        REQUIRE(prng.state() == expected);
+    }
+
+    SECTION("jump() commutes with drawing outputs")
+    {
+        auto prng0 = ket::Xoshiro256PlusPlus {42};
+        auto prng1 = prng0;
+
+        prng0.jump();
+        prng0.discard(10);
+
+        prng1.discard(10);
+        prng1.jump();
+
+        REQUIRE(prng0 == prng1);
+    }
+
+    SECTION("the same seed gives the same outputs")
+    {
+        auto prng0 = ket::Xoshiro256PlusPlus {42};
+        auto prng1 = ket::Xoshiro256PlusPlus {42};
+        auto prng2 = ket::Xoshiro256PlusPlus {43};
+
+        REQUIRE(prng0 == prng1);
+        REQUIRE(prng0 != prng2);
+        REQUIRE(prng0() == prng1());
+    }
+
+    SECTION("throws with an all-zero state")
+    {
+        const auto zero_state = ket::Xoshiro256PlusPlus::state_type {0, 0, 0, 0};
+        REQUIRE_THROWS_AS(ket::Xoshiro256PlusPlus {zero_state}, std::runtime_error);
+    }
+}
+
+
+TEST_CASE("Philox4x32")
+{
+    using Counter = ket::Philox4x32::counter_type;
+    using Key = ket::Philox4x32::key_type;
+
+    SECTION("block() matches the known-answer tests of Random123")
+    {
+        REQUIRE(ket::Philox4x32::block(Counter {0, 0, 0, 0}, Key {0, 0}) == Counter {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+
+        const auto all_ones = Counter {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+        REQUIRE(ket::Philox4x32::block(all_ones, Key {0xffffffff, 0xffffffff}) == Counter {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+
+        const auto pi_counter = Counter {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344};
+        REQUIRE(ket::Philox4x32::block(pi_counter, Key {0xa4093822, 0x299f31d0}) == Counter {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+    }
+
+    SECTION("the outputs are the blocks of consecutive counters")
+    {
+        auto prng = ket::Philox4x32 {0, 0};
+
+        const auto block0 = ket::Philox4x32::block(Counter {0, 0, 0, 0}, Key {0, 0});
+        const auto block1 = ket::Philox4x32::block(Counter {1, 0, 0, 0}, Key {0, 0});
+
+        for (auto expected : block0) {
+            REQUIRE(prng() == expected);
+        }
+        for (auto expected : block1) {
+            REQUIRE(prng() == expected);
+        }
+    }
+
+    SECTION("discard() skips the same outputs as drawing them")
+    {
+        for (auto n_skipped_int : {0, 1, 3, 4, 5, 17}) {
+            const auto n_skipped = static_cast<std::uint64_t>(n_skipped_int);
+            auto prng0 = ket::Philox4x32 {42, 7};
+            auto prng1 = ket::Philox4x32 {42, 7};
+
+            // start partway through a block
+            prng0();
+            prng1();
+
+            for (std::uint64_t i {0}; i < n_skipped; ++i) {
+                prng0();
+            }
+            prng1.discard(n_skipped);
+
+            REQUIRE(prng0() == prng1());
+        }
+    }
+
+    SECTION("different streams give different outputs")
+    {
+        auto prng0 = ket::Philox4x32 {42, 0};
+        auto prng1 = ket::Philox4x32 {42, 1};
+
+        auto outputs0 = std::vector<std::uint32_t> {};
+        auto outputs1 = std::vector<std::uint32_t> {};
+        for (int i {0}; i < 8; ++i) {
+            outputs0.push_back(prng0());
+            outputs1.push_back(prng1());
+        }
+
+        REQUIRE(outputs0 != outputs1);
+    }
+}
+
+
+TEST_CASE("random engines work with the standard distributions")
+{
+    auto xoshiro = ket::Xoshiro256PlusPlus {42};
+    auto philox = ket::Philox4x32 {42};
+    auto uniform = std::uniform_real_distribution<double> {0.0, 1.0};
+
+    constexpr auto n_samples = 100000;
+    auto sum_xoshiro = 0.0;
+    auto sum_philox = 0.0;
+    for (int i {0}; i < n_samples; ++i) {
+        sum_xoshiro += uniform(xoshiro);
+        sum_philox += uniform(philox);
+    }
+
+    REQUIRE_THAT(sum_xoshiro / n_samples, Catch::Matchers::WithinAbs(0.5, 0.01));
+    REQUIRE_THAT(sum_philox / n_samples, Catch::Matchers::WithinAbs(0.5, 0.01));
+}
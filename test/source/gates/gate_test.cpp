@@ -1,3 +1,5 @@
+#include <utility>
+
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
@@ -5,6 +7,7 @@
 #include "kettle/common/matrix2x2.hpp"
 #include "kettle/gates/common_u_gates.hpp"
 #include "kettle/gates/primitive_gate.hpp"
+#include "kettle/parameter/parameter_expression.hpp"
 
 #include "kettle_internal/gates/primitive_gate/gate_create.hpp"
 
@@ -95,7 +98,7 @@ TEST_CASE("Test create and unpack gate functions")
         const auto target_index = std::size_t {0};
         const auto unitary_ptr = ket::ClonePtr<ket::Matrix2X2> {ket::x_gate()};
 
-        const auto gate_info = cre::create_u_gate(target_index, unitary_ptr);
+        const auto gate_info = cre::create_u_gate(target_index, *unitary_ptr);
         const auto [unpacked_target_index, unpacked_unitary_ptr] = cre::unpack_u_gate(gate_info);
 
         REQUIRE(unpacked_target_index == target_index);
@@ -109,7 +112,7 @@ TEST_CASE("Test create and unpack gate functions")
 
         const auto unitary_ptr = ket::ClonePtr<ket::Matrix2X2> {ket::x_gate()};
 
-        const auto gate_info = cre::create_cu_gate(control_index, target_index, unitary_ptr);
+        const auto gate_info = cre::create_cu_gate(control_index, target_index, *unitary_ptr);
         const auto [u_control_index, u_target_index, u_unitary_ptr] = cre::unpack_cu_gate(gate_info);
 
         REQUIRE(u_control_index == control_index);
@@ -117,3 +120,41 @@ TEST_CASE("Test create and unpack gate functions")
         REQUIRE(ket::almost_eq(*unitary_ptr, *u_unitary_ptr));
     }
 }
+
+TEST_CASE("GateInfo copies share their payload")
+{
+    STATIC_REQUIRE(sizeof(ket::GateInfo) <= 24);
+
+    SECTION("U gate")
+    {
+        const auto original = cre::create_u_gate(1, ket::x_gate());
+
+        auto copy = original;
+        REQUIRE(copy.unitary_ptr() == original.unitary_ptr());
+        REQUIRE(copy.param_expression_ptr() == nullptr);
+
+        auto moved = std::move(copy);
+        REQUIRE(moved.unitary_ptr() == original.unitary_ptr());
+        REQUIRE(ket::almost_eq(*moved.unitary_ptr(), ket::x_gate()));
+    }
+
+    SECTION("parameterized gate")
+    {
+        const auto expression = ket::param::ParameterExpression {ket::param::LiteralExpression {0.5}};
+        const auto original = cre::create_one_target_one_parameter_gate(G::RX, 0, expression);
+
+        auto copy = cre::create_one_target_gate(G::X, 0);
+        copy = original;
+        REQUIRE(copy.param_expression_ptr() == original.param_expression_ptr());
+        REQUIRE(copy.unitary_ptr() == nullptr);
+    }
+
+    SECTION("gates without a payload")
+    {
+        const auto gate_info = cre::create_one_target_one_angle_gate(G::RZ, 3, 0.25);
+
+        REQUIRE(gate_info.unitary_ptr() == nullptr);
+        REQUIRE(gate_info.param_expression_ptr() == nullptr);
+        REQUIRE_THAT(cre::unpack_gate_angle(gate_info), Catch::Matchers::WithinAbs(0.25, 1.0e-12));
+    }
+}
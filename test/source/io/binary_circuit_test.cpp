@@ -0,0 +1,226 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit_operations/compare_circuits.hpp"
+#include "kettle/gates/common_u_gates.hpp"
+#include "kettle/io/binary_circuit.hpp"
+#include "kettle/io/read_tangelo_file.hpp"
+#include "kettle/parameter/parameter.hpp"
+
+
+namespace
+{
+
+auto round_trip_(const ket::QuantumCircuit& circuit) -> ket::QuantumCircuit
+{
+    auto stream = std::stringstream {};
+    ket::save_binary_circuit(stream, circuit);
+
+    return ket::load_binary_circuit(stream);
+}
+
+}  // namespace
+
+
+TEST_CASE("binary circuit round trip")
+{
+    SECTION("primitive gates")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate({0, 1, 2});
+        circuit.add_cx_gate(0, 2);
+        circuit.add_rz_gate(1, 0.125);
+        circuit.add_cp_gate(2, 1, -1.5);
+        circuit.add_u_gate(ket::sx_gate(), 0);
+        circuit.add_cu_gate(ket::y_gate(), 1, 2);
+        circuit.add_m_gate(2, 1);
+
+        const auto loaded = round_trip_(circuit);
+
+        REQUIRE(loaded.n_qubits() == 3);
+        REQUIRE(loaded.n_bits() == 3);
+        REQUIRE(loaded.n_circuit_elements() == circuit.n_circuit_elements());
+        REQUIRE(ket::almost_eq(loaded, circuit));
+    }
+
+    SECTION("parameterized gates")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        const auto id0 = circuit.add_rx_gate(0, 0.5, ket::param::parameterized {});
+        circuit.add_crz_gate(0, 1, id0);
+        const auto id1 = circuit.add_ry_gate(1, 0.3, ket::param::parameterized {});
+        circuit.set_parameter_value(id1, 0.75);
+
+        auto loaded = round_trip_(circuit);
+
+        REQUIRE(loaded.parameter_data_map().size() == 2);
+        REQUIRE(loaded.parameter_data_map().at(id0).count == 2);
+        REQUIRE(ket::almost_eq(loaded, circuit));
+
+        // the loaded parameters are still connected to the gates that use them
+        loaded.set_parameter_value(id0, 1.25);
+        circuit.set_parameter_value(id0, 1.25);
+        REQUIRE(ket::almost_eq(loaded, circuit));
+    }
+
+    SECTION("control flow and circuit loggers")
+    {
+        auto if_circuit = ket::QuantumCircuit {2, 1};
+        if_circuit.add_x_gate(1);
+
+        auto else_circuit = ket::QuantumCircuit {2, 1};
+        else_circuit.add_h_gate(1);
+        else_circuit.add_statevector_circuit_logger();
+
+        auto circuit = ket::QuantumCircuit {2, 1};
+        circuit.add_h_gate(0);
+        circuit.add_m_gate(0, 0);
+        circuit.add_if_statement(0, if_circuit);
+        circuit.add_if_not_else_statement(0, if_circuit, else_circuit);
+        circuit.add_classical_register_circuit_logger();
+
+        const auto loaded = round_trip_(circuit);
+
+        REQUIRE(loaded.n_circuit_elements() == 5);
+        REQUIRE(loaded[4].is_circuit_logger());
+        REQUIRE(ket::almost_eq(loaded, circuit));
+    }
+
+    SECTION("saving the same circuit twice gives the same bytes")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_rx_gate(0, 0.5, ket::param::parameterized {});
+        circuit.add_ry_gate(1, 0.5, ket::param::parameterized {});
+        circuit.add_rz_gate(0, 0.5, ket::param::parameterized {});
+
+        auto stream0 = std::stringstream {};
+        auto stream1 = std::stringstream {};
+        ket::save_binary_circuit(stream0, circuit);
+        ket::save_binary_circuit(stream1, round_trip_(circuit));
+
+        REQUIRE(stream0.str() == stream1.str());
+    }
+}
+
+TEST_CASE("binary circuit file round trip")
+{
+    auto circuit = ket::QuantumCircuit {4};
+    for (std::size_t i {0}; i < 100; ++i) {
+        circuit.add_h_gate(i % 4);
+        circuit.add_cx_gate(i % 4, (i + 1) % 4);
+        circuit.add_rz_gate((i + 2) % 4, static_cast<double>(i) * 0.01);
+    }
+
+    const auto filepath = std::filesystem::temp_directory_path() / "kettle_binary_circuit_test.bin";
+    ket::save_binary_circuit(filepath, circuit);
+    const auto loaded = ket::load_binary_circuit(filepath);
+    std::filesystem::remove(filepath);
+
+    REQUIRE(ket::almost_eq(loaded, circuit));
+}
+
+TEST_CASE("convert_tangelo_to_binary_circuit()")
+{
+    const auto tangelo_filepath = std::filesystem::temp_directory_path() / "kettle_convert_tangelo_test.txt";
+    const auto binary_filepath = std::filesystem::temp_directory_path() / "kettle_convert_tangelo_test.bin";
+
+    {
+        auto outstream = std::ofstream {tangelo_filepath};
+        outstream << "Circuit object. Size 5                                  \n";
+        outstream << "                                                        \n";
+        outstream << "H         target : [0]                                  \n";
+        outstream << "RX        target : [2]   parameter : 1.5707963267948966 \n";
+        outstream << "CNOT      target : [1]   control : [0]                  \n";
+        outstream << "CPHASE    target : [2]   control : [1]   parameter : 0.5\n";
+        outstream << "SWAP      target : [0, 2]                               \n";
+    }
+
+    ket::convert_tangelo_to_binary_circuit(3, tangelo_filepath, 2, binary_filepath);
+
+    const auto expected = ket::read_tangelo_circuit(3, tangelo_filepath, 2);
+    const auto loaded = ket::load_binary_circuit(binary_filepath);
+
+    std::filesystem::remove(tangelo_filepath);
+    std::filesystem::remove(binary_filepath);
+
+    REQUIRE(loaded.n_qubits() == 3);
+    REQUIRE(loaded.n_circuit_elements() == expected.n_circuit_elements());
+    REQUIRE(ket::almost_eq(loaded, expected));
+}
+
+TEST_CASE("invalid binary circuits throw")
+{
+    auto circuit = ket::QuantumCircuit {2};
+    circuit.add_h_gate(0);
+    circuit.add_cx_gate(0, 1);
+
+    auto stream = std::stringstream {};
+    ket::save_binary_circuit(stream, circuit);
+    const auto contents = stream.str();
+
+    SECTION("wrong magic string")
+    {
+        auto modified = contents;
+        modified[0] = 'X';
+        auto instream = std::stringstream {modified};
+
+        REQUIRE_THROWS_AS(ket::load_binary_circuit(instream), std::runtime_error);
+    }
+
+    SECTION("truncated file")
+    {
+        auto instream = std::stringstream {contents.substr(0, contents.size() - 3)};
+
+        REQUIRE_THROWS_AS(ket::load_binary_circuit(instream), std::runtime_error);
+    }
+
+    SECTION("trailing data")
+    {
+        auto instream = std::stringstream {contents + "abc"};
+
+        REQUIRE_THROWS_AS(ket::load_binary_circuit(instream), std::runtime_error);
+    }
+
+    SECTION("subcircuit with more qubits than its parent")
+    {
+        auto parent = ket::QuantumCircuit {2, 1};
+        parent.add_if_statement(0, ket::QuantumCircuit {3, 1});
+
+        REQUIRE_THROWS_AS(round_trip_(parent), std::runtime_error);
+    }
+
+    SECTION("parameter expression with an unknown parameter")
+    {
+        auto parameterized = ket::QuantumCircuit {1};
+        parameterized.add_rx_gate(0, 0.5, ket::param::parameterized {});
+
+        auto modified_stream = std::stringstream {};
+        ket::save_binary_circuit(modified_stream, parameterized);
+        auto modified = modified_stream.str();
+
+        // the ID of the only parameter follows the magic string, the version, and four 64-bit counts
+        modified[8 + 4 + 4 * 8] ^= 0x01;
+        auto instream = std::stringstream {modified};
+
+        REQUIRE_THROWS_AS(ket::load_binary_circuit(instream), std::runtime_error);
+    }
+
+    SECTION("control flow statements nested too deeply")
+    {
+        auto nested = ket::QuantumCircuit {1, 1};
+        for (std::size_t i {0}; i < 300; ++i) {
+            auto outer = ket::QuantumCircuit {1, 1};
+            outer.add_if_statement(0, std::move(nested));
+            nested = std::move(outer);
+        }
+
+        REQUIRE_THROWS_AS(round_trip_(nested), std::runtime_error);
+    }
+}
@@ -0,0 +1,184 @@
+#include <complex>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "kettle/common/mathtools.hpp"
+#include "kettle/io/binary_statevector.hpp"
+#include "kettle/io/statevector.hpp"
+#include "kettle/state/endian.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+TEST_CASE("binary statevector round trip")
+{
+    const auto state = ket::generate_random_state(5, 42);
+    const auto endian = GENERATE(ket::Endian::LITTLE, ket::Endian::BIG);
+
+    SECTION("through a stream")
+    {
+        auto stream = std::stringstream {};
+        ket::save_binary_statevector(stream, state, endian);
+
+        REQUIRE(stream.str().size() == ket::BINARY_STATEVECTOR_HEADER_SIZE + 16 * state.n_states());
+
+        const auto loaded = ket::load_binary_statevector(stream);
+        REQUIRE(ket::almost_eq(loaded, state));
+    }
+
+    SECTION("through a stream, followed by other data")
+    {
+        auto stream = std::stringstream {};
+        ket::save_binary_statevector(stream, state, endian);
+        ket::save_binary_statevector(stream, state, endian);
+
+        const auto loaded0 = ket::load_binary_statevector(stream);
+        const auto loaded1 = ket::load_statevector(stream);
+        REQUIRE(ket::almost_eq(loaded0, state));
+        REQUIRE(ket::almost_eq(loaded1, state));
+    }
+
+    SECTION("through a stream, recognized by load_statevector()")
+    {
+        auto stream = std::stringstream {};
+        ket::save_binary_statevector(stream, state, endian);
+
+        const auto loaded = ket::load_statevector(stream);
+        REQUIRE(ket::almost_eq(loaded, state));
+    }
+
+    SECTION("through a file, written by several threads")
+    {
+        const auto n_threads = GENERATE(std::size_t {1}, std::size_t {3}, std::size_t {64});
+        const auto sync_policy = GENERATE(ket::FileSyncPolicy::NO_SYNC, ket::FileSyncPolicy::SYNC_ON_CLOSE);
+
+        const auto filepath = std::filesystem::temp_directory_path() / "kettle_binary_statevector_test.bin";
+        ket::save_binary_statevector(filepath, state, endian, sync_policy, n_threads);
+
+        const auto loaded = ket::load_binary_statevector(filepath);
+        const auto loaded_generic = ket::load_statevector(filepath);
+        const auto header = ket::load_binary_statevector_header(filepath);
+        std::filesystem::remove(filepath);
+
+        REQUIRE(ket::almost_eq(loaded, state));
+        REQUIRE(ket::almost_eq(loaded_generic, state));
+        REQUIRE(header.version == ket::BINARY_STATEVECTOR_FORMAT_VERSION);
+        REQUIRE(header.endian == endian);
+        REQUIRE(header.n_qubits == 5);
+        REQUIRE(header.n_states == 32);
+    }
+}
+
+TEST_CASE("binary statevector slices")
+{
+    const auto state = ket::generate_random_state(4, 7);
+    const auto filepath = std::filesystem::temp_directory_path() / "kettle_binary_statevector_slice_test.bin";
+
+    SECTION("little endian")
+    {
+        ket::save_binary_statevector(filepath, state, ket::Endian::LITTLE);
+        const auto slice = ket::load_binary_statevector_slice(filepath, 3, 11);
+        std::filesystem::remove(filepath);
+
+        REQUIRE(slice.size() == 8);
+        for (std::size_t i {0}; i < slice.size(); ++i) {
+            REQUIRE(slice[i] == state[i + 3]);
+        }
+    }
+
+    SECTION("big endian")
+    {
+        ket::save_binary_statevector(filepath, state, ket::Endian::BIG);
+        const auto slice = ket::load_binary_statevector_slice(filepath, 0, 16);
+        std::filesystem::remove(filepath);
+
+        REQUIRE(slice.size() == 16);
+        for (std::size_t i {0}; i < slice.size(); ++i) {
+            REQUIRE(slice[i] == state[ket::endian_flip(i, 4)]);
+        }
+    }
+
+    SECTION("empty slice")
+    {
+        ket::save_binary_statevector(filepath, state);
+        const auto slice = ket::load_binary_statevector_slice(filepath, 5, 5);
+        std::filesystem::remove(filepath);
+
+        REQUIRE(slice.empty());
+    }
+
+    SECTION("out of range slices throw")
+    {
+        ket::save_binary_statevector(filepath, state);
+        REQUIRE_THROWS_AS(ket::load_binary_statevector_slice(filepath, 4, 17), std::runtime_error);
+        REQUIRE_THROWS_AS(ket::load_binary_statevector_slice(filepath, 6, 5), std::runtime_error);
+        std::filesystem::remove(filepath);
+    }
+}
+
+TEST_CASE("invalid binary statevectors throw")
+{
+    const auto state = ket::generate_random_state(3, 1);
+
+    auto stream = std::stringstream {};
+    ket::save_binary_statevector(stream, state);
+    const auto contents = stream.str();
+
+    const auto load = [](const std::string& text) {
+        auto modified_stream = std::stringstream {text};
+        return ket::load_binary_statevector(modified_stream);
+    };
+
+    SECTION("wrong magic string")
+    {
+        auto modified = contents;
+        modified[0] = 'X';
+        REQUIRE_THROWS_AS(load(modified), std::runtime_error);
+    }
+
+    SECTION("unsupported version")
+    {
+        auto modified = contents;
+        modified[8] = static_cast<char>(99);
+        REQUIRE_THROWS_AS(load(modified), std::runtime_error);
+    }
+
+    SECTION("truncated amplitudes")
+    {
+        REQUIRE_THROWS_AS(load(contents.substr(0, contents.size() - 1)), std::runtime_error);
+    }
+
+    SECTION("number of states too large for the size of the file")
+    {
+        // 2^60 amplitudes of 16 bytes take 2^64 bytes, which wraps around to 0 in a std::size_t,
+        // so the header alone would otherwise seem to have the right size
+        auto modified = contents.substr(0, ket::BINARY_STATEVECTOR_HEADER_SIZE);
+        for (std::size_t i {0}; i < 8; ++i) {
+            modified[16 + i] = static_cast<char>(i == 0 ? 60 : 0);
+            modified[24 + i] = static_cast<char>(i == 7 ? 0x10 : 0);
+        }
+
+        REQUIRE_THROWS_AS(load(modified), std::runtime_error);
+        REQUIRE_THROWS_AS(ket::read_binary_statevector(std::as_bytes(std::span {modified})), std::runtime_error);
+    }
+
+    SECTION("truncated header")
+    {
+        REQUIRE_THROWS_AS(load(contents.substr(0, ket::BINARY_STATEVECTOR_HEADER_SIZE - 1)), std::runtime_error);
+    }
+
+    SECTION("corrupted amplitude")
+    {
+        auto modified = contents;
+        modified[ket::BINARY_STATEVECTOR_HEADER_SIZE + 20] ^= 0x01;
+        REQUIRE_THROWS_AS(load(modified), std::runtime_error);
+    }
+}
@@ -0,0 +1,224 @@
+#include <bit>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "kettle/calculations/probabilities.hpp"
+#include "kettle/io/npy.hpp"
+#include "kettle/state/endian.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+namespace
+{
+
+/*
+    Creates the contents of a `.npy` file the way `numpy.save()` does, with the raw bytes of the
+    elements given in `data`.
+*/
+auto make_npy_(const std::string& descr, std::size_t n_elements, const std::string& data, int major_version = 1) -> std::string
+{
+    auto header = "{'descr': '" + descr + "', 'fortran_order': False, 'shape': (" + std::to_string(n_elements) + ",), }";
+
+    const auto prefix_size = std::size_t {major_version == 1 ? 10U : 12U};
+    while ((prefix_size + header.size() + 1) % 64 != 0) {
+        header += ' ';
+    }
+    header += '\n';
+
+    auto output = std::string {"\x93NUMPY"};
+    output += static_cast<char>(major_version);
+    output += '\0';
+
+    const auto length_size = major_version == 1 ? 2 : 4;
+    for (int i {0}; i < length_size; ++i) {
+        output += static_cast<char>((header.size() >> (8 * i)) & 0xFFU);
+    }
+
+    return output + header + data;
+}
+
+template <typename Unsigned>
+auto encode_(Unsigned bits, bool is_big_endian) -> std::string
+{
+    auto output = std::string(sizeof(Unsigned), '\0');
+    for (std::size_t i {0}; i < sizeof(Unsigned); ++i) {
+        const auto i_byte = is_big_endian ? sizeof(Unsigned) - 1 - i : i;
+        output[i_byte] = static_cast<char>((bits >> (8 * i)) & 0xFFU);
+    }
+
+    return output;
+}
+
+auto as_bytes_(const std::string& contents) -> std::span<const std::byte>
+{
+    return std::as_bytes(std::span {contents});
+}
+
+}  // namespace
+
+
+TEST_CASE("npy statevector round trip")
+{
+    const auto state = ket::generate_random_state(4, 3);
+    const auto endian = GENERATE(ket::Endian::LITTLE, ket::Endian::BIG);
+
+    SECTION("through a stream")
+    {
+        auto stream = std::stringstream {};
+        ket::save_npy_statevector(stream, state, endian);
+
+        const auto contents = stream.str();
+        REQUIRE(contents.size() == 128 + 16 * 16);
+        REQUIRE(contents.substr(0, 6) == "\x93NUMPY");
+
+        const auto loaded = ket::read_npy_statevector(as_bytes_(contents), endian);
+        REQUIRE(ket::almost_eq(loaded, state));
+    }
+
+    SECTION("through a file")
+    {
+        const auto filepath = std::filesystem::temp_directory_path() / "kettle_npy_statevector_test.npy";
+        ket::save_npy_statevector(filepath, state, endian);
+        const auto loaded = ket::load_npy_statevector(filepath, endian);
+        std::filesystem::remove(filepath);
+
+        REQUIRE(ket::almost_eq(loaded, state));
+    }
+}
+
+TEST_CASE("read_npy_statevector() element types")
+{
+    const auto is_big_endian = GENERATE(false, true);
+    const auto order = std::string {is_big_endian ? ">" : "<"};
+    const auto major_version = GENERATE(1, 2, 3);
+
+    const auto expected = ket::Statevector {{{0.6, 0.0}, {0.0, -0.8}}};
+
+    SECTION("complex128")
+    {
+        auto data = std::string {};
+        for (auto value : {0.6, 0.0, 0.0, -0.8}) {
+            data += encode_(std::bit_cast<std::uint64_t>(value), is_big_endian);
+        }
+
+        const auto contents = make_npy_(order + "c16", 2, data, major_version);
+        REQUIRE(ket::almost_eq(ket::read_npy_statevector(as_bytes_(contents)), expected));
+    }
+
+    SECTION("complex64")
+    {
+        auto data = std::string {};
+        for (auto value : {0.6F, 0.0F, 0.0F, -0.8F}) {
+            data += encode_(std::bit_cast<std::uint32_t>(value), is_big_endian);
+        }
+
+        const auto contents = make_npy_(order + "c8", 2, data, major_version);
+        REQUIRE(ket::almost_eq(ket::read_npy_statevector(as_bytes_(contents)), expected, 1.0e-6));
+    }
+
+    SECTION("float64")
+    {
+        auto data = std::string {};
+        for (auto value : {0.6, -0.8}) {
+            data += encode_(std::bit_cast<std::uint64_t>(value), is_big_endian);
+        }
+
+        const auto contents = make_npy_(order + "f8", 2, data, major_version);
+        const auto expected_real = ket::Statevector {{{0.6, 0.0}, {-0.8, 0.0}}};
+        REQUIRE(ket::almost_eq(ket::read_npy_statevector(as_bytes_(contents)), expected_real));
+        REQUIRE(ket::read_npy_real_array(as_bytes_(contents)) == std::vector<double> {0.6, -0.8});
+    }
+}
+
+TEST_CASE("save npy probabilities and counts")
+{
+    SECTION("probabilities")
+    {
+        const auto state = ket::generate_random_state(3, 5);
+        const auto probabilities = ket::calculate_probabilities_raw(state);
+
+        const auto filepath = std::filesystem::temp_directory_path() / "kettle_npy_probabilities_test.npy";
+        ket::save_npy_probabilities(filepath, probabilities);
+        const auto loaded = ket::load_npy_real_array(filepath);
+        std::filesystem::remove(filepath);
+
+        REQUIRE(loaded == probabilities);
+    }
+
+    SECTION("counts")
+    {
+        const auto counts = std::map<std::size_t, std::size_t> {{1, 10}, {3, 7}};
+
+        auto stream = std::stringstream {};
+        ket::save_npy_counts(stream, counts, 4);
+
+        auto data = std::string {};
+        for (auto value : {0UL, 10UL, 0UL, 7UL}) {
+            data += encode_(static_cast<std::uint64_t>(value), false);
+        }
+
+        REQUIRE(stream.str() == make_npy_("<u8", 4, data));
+    }
+
+    SECTION("counts outside of the states throw")
+    {
+        auto stream = std::stringstream {};
+        REQUIRE_THROWS_AS(ket::save_npy_counts(stream, {{4, 1}}, 4), std::runtime_error);
+    }
+}
+
+TEST_CASE("invalid npy files throw")
+{
+    const auto data = std::string(32, '\0');
+
+    SECTION("wrong magic string")
+    {
+        auto contents = make_npy_("<c16", 2, data);
+        contents[1] = 'X';
+        REQUIRE_THROWS_AS(ket::read_npy_statevector(as_bytes_(contents)), std::runtime_error);
+    }
+
+    SECTION("unsupported element type")
+    {
+        const auto contents = make_npy_("<i8", 4, data);
+        REQUIRE_THROWS_AS(ket::read_npy_statevector(as_bytes_(contents)), std::runtime_error);
+    }
+
+    SECTION("data size does not match the shape")
+    {
+        const auto contents = make_npy_("<c16", 3, data);
+        REQUIRE_THROWS_AS(ket::read_npy_statevector(as_bytes_(contents)), std::runtime_error);
+    }
+
+    SECTION("shape whose data size overflows")
+    {
+        // 8 * (2^61 + 4) wraps around to 32, the size of the data
+        const auto n_elements = (std::size_t {1} << 61U) + 4;
+        const auto contents = make_npy_("<f8", n_elements, data);
+        REQUIRE_THROWS_AS(ket::read_npy_real_array(as_bytes_(contents)), std::runtime_error);
+    }
+
+    SECTION("length is not a power of 2")
+    {
+        const auto contents = make_npy_("<f8", 3, std::string(24, '\0'));
+        REQUIRE_THROWS_AS(ket::read_npy_statevector(as_bytes_(contents)), std::runtime_error);
+    }
+
+    SECTION("complex arrays are not real arrays")
+    {
+        const auto contents = make_npy_("<c16", 2, data);
+        REQUIRE_THROWS_AS(ket::read_npy_real_array(as_bytes_(contents)), std::runtime_error);
+    }
+}
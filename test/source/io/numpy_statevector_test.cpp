@@ -1,6 +1,7 @@
 #include <cstddef>
 #include <numeric>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -21,6 +22,7 @@ TEST_CASE("read_numpy_statevector()")
         " (2.970442628930022866e-01+2.970442628930022866e-01j)\n"
         " (3.465516400418360288e-01+3.465516400418360288e-01j)\n"
         " (3.960590171906697154e-01+3.960590171906697154e-01j)\n"
+        "trailing data\n"
     };
 
     const auto actual = ket::read_numpy_statevector(stream);
@@ -46,4 +48,9 @@ TEST_CASE("read_numpy_statevector()")
     const auto expected = ket::Statevector {std::move(expected_amplitudes)};
 
     REQUIRE(ket::almost_eq(actual, expected));
+
+    // the data after the statevector is left in the stream
+    auto trailing = std::string {};
+    std::getline(stream, trailing);
+    REQUIRE(trailing == "trailing data");
 }
@@ -27,3 +27,25 @@ TEST_CASE("read_pauli_operator()")
 
     REQUIRE(ket::almost_eq(pauli_op, expected));
 }
+
+TEST_CASE("read_pauli_operator() adds a zero term for each blank line")
+{
+    auto sstream = std::stringstream {
+        "\n"
+        " 1.100000000000e+01    0.000000000000e+00   :                       \n"
+        "                                                                    \n"
+        "-1.875000000000e-01    5.000000000000e-01   :   (0, Y)   (1, Z)     \n"
+    };
+
+    const auto pauli_op = ket::read_pauli_operator(sstream, 2);
+
+    const auto expected = ket::PauliOperator {
+        {.coefficient={ 0.0000, 0.0}, .pauli_string={PT::I, PT::I}},
+        {.coefficient={11.0000, 0.0}, .pauli_string={PT::I, PT::I}},
+        {.coefficient={ 0.0000, 0.0}, .pauli_string={PT::I, PT::I}},
+        {.coefficient={-0.1875, 0.5}, .pauli_string={PT::Y, PT::Z}},
+    };
+
+    REQUIRE(pauli_op.size() == 4);
+    REQUIRE(ket::almost_eq(pauli_op, expected));
+}
@@ -1,10 +1,13 @@
+#include <cstddef>
 #include <functional>
+#include <stdexcept>
 #include <sstream>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
 
+#include <kettle/circuit_operations/append_circuits.hpp>
 #include <kettle/circuit_operations/compare_circuits.hpp>
 #include <kettle/gates/primitive_gate.hpp>
 #include <kettle/io/read_tangelo_file.hpp>
@@ -265,3 +268,75 @@ TEST_CASE("read_tangelo_file() with control flow")
 
     REQUIRE(ket::almost_eq(original, reconstructed));
 }
+
+TEST_CASE("TangeloCircuitReader reads blocks")
+{
+    auto if_subcircuit = ket::QuantumCircuit {3};
+    if_subcircuit.add_x_gate({0, 2});
+
+    auto else_subcircuit = ket::QuantumCircuit {3};
+    else_subcircuit.add_cx_gate(1, 2);
+
+    auto original = ket::QuantumCircuit {3};
+    original.add_x_gate({0, 1});
+    original.add_h_gate({0, 1, 2});
+    original.add_m_gate({0, 1});
+    original.add_if_statement(0, if_subcircuit);
+    original.add_y_gate(0);
+    original.add_if_else_statement(1, if_subcircuit, else_subcircuit);
+    original.add_rx_gate(2, 0.25);
+
+    auto sstream = std::stringstream {};
+    ket::write_tangelo_circuit(original, sstream);
+
+    const auto block_size = GENERATE(std::size_t {1}, std::size_t {2}, std::size_t {3}, std::size_t {100});
+
+    auto reader = ket::TangeloCircuitReader {3, sstream, 0};
+    auto combined = ket::QuantumCircuit {3};
+
+    while (!reader.is_done()) {
+        const auto block = reader.read_block(block_size);
+
+        if (block.n_circuit_elements() != 0) {
+            const auto& last = block[block.n_circuit_elements() - 1];
+            REQUIRE(!(last.is_control_flow() && last.get_control_flow().is_if_statement()));
+        }
+
+        ket::extend_circuit(combined, block);
+    }
+
+    REQUIRE(ket::almost_eq(original, combined));
+}
+
+TEST_CASE("read_tangelo_file() gate names")
+{
+    SECTION("tangelo-specific names")
+    {
+        auto stream = std::stringstream {
+            "PHASE     target : [1]   parameter : 0.25\n"
+            "CPHASE    target : [0]   control : [2]   parameter : -0.5\n"
+            "CNOT      target : [2]   control : [1]\n"
+        };
+
+        const auto actual = ket::read_tangelo_circuit(3, stream, 0);
+
+        auto expected = ket::QuantumCircuit {3};
+        expected.add_p_gate(1, 0.25);
+        expected.add_cp_gate(2, 0, -0.5);
+        expected.add_cx_gate(1, 2);
+
+        REQUIRE(ket::almost_eq(actual, expected));
+    }
+
+    SECTION("unknown gate names throw")
+    {
+        const auto line = GENERATE(
+            "FOO       target : [1]\n",
+            "HH        target : [1]\n",
+            "CXX       target : [1]   control : [0]\n"
+        );
+
+        auto stream = std::stringstream {line};
+        REQUIRE_THROWS_AS(ket::read_tangelo_circuit(3, stream, 0), std::runtime_error);
+    }
+}
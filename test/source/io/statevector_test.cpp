@@ -31,3 +31,24 @@ TEST_CASE("read_numpy_statevector()")
 
     REQUIRE(ket::almost_eq(state, loaded_state));
 }
+
+
+TEST_CASE("load_statevector() only consumes the statevector from the stream")
+{
+    auto state0 = ket::Statevector {2};
+    auto state1 = ket::Statevector {3};
+
+    auto circuit = ket::QuantumCircuit {3};
+    circuit.add_h_gate({0, 2});
+    ket::simulate(circuit, state1);
+
+    auto stream = std::stringstream {};
+    ket::save_statevector(stream, state0);
+    ket::save_statevector(stream, state1, ket::Endian::BIG);
+
+    const auto loaded_state0 = ket::load_statevector(stream);
+    const auto loaded_state1 = ket::load_statevector(stream);
+
+    REQUIRE(ket::almost_eq(state0, loaded_state0));
+    REQUIRE(ket::almost_eq(state1, loaded_state1));
+}
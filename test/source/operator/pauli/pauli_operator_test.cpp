@@ -1,5 +1,7 @@
 #include <cmath>
 #include <complex>
+#include <stdexcept>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators.hpp>
@@ -9,6 +11,8 @@
 #include "kettle/operator/pauli/sparse_pauli_string.hpp"
 #include "kettle/operator/pauli/pauli_operator.hpp"
 #include "kettle/simulation/simulate.hpp"
+#include "kettle/simulation/simulate_pauli.hpp"
+#include "kettle/state/random.hpp"
 #include "kettle/state/statevector.hpp"
 
 
@@ -100,6 +104,37 @@ TEST_CASE("expectation value of SparsePauliString, 2-qubit")
     REQUIRE(ket::almost_eq(expval, testcase.expected));
 }
 
+TEST_CASE("expectation value of SparsePauliString matches applying the Pauli gates")
+{
+    const auto state = ket::generate_random_state(5, 12345);
+
+    const auto phase = GENERATE(ket::PauliPhase::PLUS_ONE, ket::PauliPhase::PLUS_EYE, ket::PauliPhase::MINUS_ONE, ket::PauliPhase::MINUS_EYE);
+    const auto terms = GENERATE(
+        std::vector<PT> {PT::I, PT::I, PT::I, PT::I, PT::I},
+        std::vector<PT> {PT::Z, PT::I, PT::Z, PT::Z, PT::I},
+        std::vector<PT> {PT::X, PT::I, PT::I, PT::X, PT::I},
+        std::vector<PT> {PT::Y, PT::I, PT::I, PT::I, PT::I},
+        std::vector<PT> {PT::Y, PT::Y, PT::Y, PT::I, PT::I},
+        std::vector<PT> {PT::X, PT::Y, PT::Z, PT::Y, PT::X}
+    );
+
+    const auto pauli_string = ket::SparsePauliString {terms, phase};
+
+    auto ket = state;
+    ket::simulate(pauli_string, ket);
+    const auto expected = ket::PAULI_PHASE_MAP.at(phase) * ket::inner_product(state, ket);
+
+    REQUIRE(ket::almost_eq(ket::expectation_value(pauli_string, state), expected));
+}
+
+TEST_CASE("expectation value of SparsePauliString with a different number of qubits throws")
+{
+    const auto pauli_string = ket::SparsePauliString {PT::X, PT::Z};
+    const auto state = ket::Statevector {"000"};
+
+    REQUIRE_THROWS_AS(ket::expectation_value(pauli_string, state), std::runtime_error);
+}
+
 TEST_CASE("expectation value of PauliOperator")
 {
     SECTION("<0|(Z + X)|0>")
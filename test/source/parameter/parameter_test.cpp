@@ -22,7 +22,7 @@ public:
     RiggedUniformIntDistribution([[maybe_unused]] std::uint8_t left, [[maybe_unused]] std::uint8_t right)
     {}
 
-    auto operator()([[maybe_unused]] std::mt19937& prng) -> std::uint8_t
+    auto operator()([[maybe_unused]] ket::internal::Prng& prng) -> std::uint8_t
     {
         return Output;
     }
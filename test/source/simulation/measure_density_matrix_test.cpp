@@ -31,7 +31,7 @@ public:
     RiggedDiscreteDistribution([[maybe_unused]] std::initializer_list<double> ignore)
     {}
 
-    auto operator()([[maybe_unused]] std::mt19937& prng) -> int
+    auto operator()([[maybe_unused]] ket::internal::Prng& prng) -> int
     {
         return Output;
     }
@@ -0,0 +1,225 @@
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <variant>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/gates/common_u_gates.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/simulation/simulate_auto.hpp"
+#include "kettle/state/density_matrix.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/sparse_statevector.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+TEST_CASE("analyze_circuit()")
+{
+    SECTION("reversible circuit")
+    {
+        auto circuit = ket::QuantumCircuit {4};
+        circuit.add_x_gate(0);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_u_gate(ket::x_gate(), 2);
+        circuit.add_m_gate(1);
+
+        const auto analysis = ket::analyze_circuit(circuit);
+
+        REQUIRE(analysis.n_qubits == 4);
+        REQUIRE(analysis.n_gates == 3);
+        REQUIRE(analysis.n_measurements == 1);
+        REQUIRE(analysis.n_branching_gates == 0);
+        REQUIRE(analysis.max_support_size == 1);
+
+        // U gates are conservatively treated as non-Clifford gates
+        REQUIRE(!analysis.is_clifford);
+        REQUIRE(!analysis.has_control_flow);
+        REQUIRE(!analysis.has_circuit_loggers);
+    }
+
+    SECTION("clifford circuit")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_s_gate(0);
+        circuit.add_cz_gate(0, 1);
+
+        REQUIRE(ket::analyze_circuit(circuit).is_clifford);
+    }
+
+    SECTION("branching gates")
+    {
+        auto circuit = ket::QuantumCircuit {4};
+        circuit.add_h_gate(0);
+        circuit.add_ry_gate(1, 0.5);
+        circuit.add_t_gate(2);
+
+        const auto analysis = ket::analyze_circuit(circuit);
+
+        REQUIRE(analysis.n_branching_gates == 2);
+        REQUIRE(!analysis.is_clifford);
+        REQUIRE(analysis.max_support_size == 4);
+    }
+
+    SECTION("support is bounded by the number of basis states")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate({0, 1, 0, 1});
+
+        const auto analysis = ket::analyze_circuit(circuit, 2);
+
+        REQUIRE(analysis.n_branching_gates == 4);
+        REQUIRE(analysis.max_support_size == 4);
+    }
+
+    SECTION("gates inside of control flow are included")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_m_gate(0);
+        circuit.add_if_statement(0, [] { auto circ = ket::QuantumCircuit {2}; circ.add_h_gate(1); return circ; }());
+        circuit.add_classical_register_circuit_logger();
+
+        const auto analysis = ket::analyze_circuit(circuit);
+
+        REQUIRE(analysis.has_control_flow);
+        REQUIRE(analysis.has_circuit_loggers);
+        REQUIRE(analysis.n_branching_gates == 1);
+    }
+}
+
+TEST_CASE("select_backend()")
+{
+    SECTION("sparse for a circuit with a small support")
+    {
+        auto circuit = ket::QuantumCircuit {20};
+        circuit.add_x_gate(0);
+        circuit.add_cx_gate(0, 19);
+
+        const auto decision = ket::select_backend(ket::analyze_circuit(circuit));
+
+        REQUIRE(decision.backend == ket::SimulationBackend::SPARSE_STATEVECTOR);
+        REQUIRE(!decision.reason.empty());
+    }
+
+    SECTION("dense for a circuit with a large support")
+    {
+        auto circuit = ket::QuantumCircuit {10};
+        circuit.add_h_gate({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+        const auto decision = ket::select_backend(ket::analyze_circuit(circuit));
+
+        REQUIRE(decision.backend == ket::SimulationBackend::STATEVECTOR);
+        REQUIRE(decision.estimated_memory == 16 * 1024);
+    }
+
+    SECTION("sparse if only the sparse statevector fits in memory")
+    {
+        auto circuit = ket::QuantumCircuit {10};
+        circuit.add_h_gate({0, 1, 2, 3, 4, 5, 6, 7});
+
+        auto options = ket::BackendSelectionOptions {};
+        options.memory_budget = 15 * 1024;
+
+        const auto decision = ket::select_backend(ket::analyze_circuit(circuit), options);
+
+        REQUIRE(decision.backend == ket::SimulationBackend::SPARSE_STATEVECTOR);
+    }
+
+    SECTION("throws if no simulator fits in memory")
+    {
+        auto circuit = ket::QuantumCircuit {10};
+        circuit.add_h_gate({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+        auto options = ket::BackendSelectionOptions {};
+        options.memory_budget = 1024;
+
+        REQUIRE_THROWS_AS(ket::select_backend(ket::analyze_circuit(circuit), options), std::runtime_error);
+    }
+
+    SECTION("forced backend")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+
+        auto options = ket::BackendSelectionOptions {};
+        options.forced_backend = ket::SimulationBackend::DENSITY_MATRIX;
+
+        const auto decision = ket::select_backend(ket::analyze_circuit(circuit), options);
+
+        REQUIRE(decision.backend == ket::SimulationBackend::DENSITY_MATRIX);
+    }
+
+    SECTION("forced density matrix backend throws with circuit loggers")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_statevector_circuit_logger();
+
+        auto options = ket::BackendSelectionOptions {};
+        options.forced_backend = ket::SimulationBackend::DENSITY_MATRIX;
+
+        REQUIRE_THROWS_AS(ket::select_backend(ket::analyze_circuit(circuit), options), std::runtime_error);
+    }
+}
+
+TEST_CASE("simulate_auto()")
+{
+    auto circuit = ket::QuantumCircuit {3};
+    circuit.add_h_gate(0);
+    circuit.add_cx_gate(0, 1);
+    circuit.add_ry_gate(2, 0.75);
+    circuit.add_m_gate(1);
+
+    const auto seed = 12345;
+    const auto initial_state = ket::generate_random_state(3, 54321);
+
+    auto expected = initial_state;
+    auto simulator = ket::StatevectorSimulator {};
+    simulator.run(circuit, expected, seed);
+
+    SECTION("from a bitstring")
+    {
+        // too large for the dense statevector in the default memory budget
+        const auto n_qubits = std::size_t {40};
+        auto large_circuit = ket::QuantumCircuit {n_qubits};
+        large_circuit.add_h_gate(0);
+        large_circuit.add_cx_gate(0, n_qubits - 1);
+
+        const auto result = ket::simulate_auto(large_circuit, std::string(n_qubits, '0'));
+
+        REQUIRE(result.decision.backend == ket::SimulationBackend::SPARSE_STATEVECTOR);
+
+        const auto& state = std::get<ket::SparseStatevector>(result.state);
+        REQUIRE(state.n_nonzero() == 2);
+    }
+
+    SECTION("from a statevector, each backend")
+    {
+        for (auto backend : {ket::SimulationBackend::STATEVECTOR, ket::SimulationBackend::SPARSE_STATEVECTOR}) {
+            auto options = ket::BackendSelectionOptions {};
+            options.forced_backend = backend;
+
+            const auto result = ket::simulate_auto(circuit, initial_state, options, seed);
+            REQUIRE(result.decision.backend == backend);
+            REQUIRE(result.classical_register.get(1) == simulator.classical_register().get(1));
+
+            if (backend == ket::SimulationBackend::STATEVECTOR) {
+                REQUIRE(ket::almost_eq(std::get<ket::Statevector>(result.state), expected));
+            }
+            else {
+                REQUIRE(ket::almost_eq(ket::to_statevector(std::get<ket::SparseStatevector>(result.state)), expected));
+            }
+        }
+    }
+
+    SECTION("density matrix backend")
+    {
+        auto options = ket::BackendSelectionOptions {};
+        options.forced_backend = ket::SimulationBackend::DENSITY_MATRIX;
+
+        const auto result = ket::simulate_auto(circuit, "000", options);
+        REQUIRE(std::holds_alternative<ket::DensityMatrix>(result.state));
+        REQUIRE(std::get<ket::DensityMatrix>(result.state).n_qubits() == 3);
+    }
+}
@@ -0,0 +1,53 @@
+#include <cstddef>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/simulation/simulate_relabelled.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+TEST_CASE("simulate_with_hot_qubits_first()")
+{
+    SECTION("gives the same state as simulate()")
+    {
+        // the ancilla at the top index is used by every gate, like in phase estimation
+        auto circuit = ket::QuantumCircuit {4};
+        circuit.add_h_gate(3);
+        for (std::size_t i {0}; i < 3; ++i) {
+            circuit.add_cp_gate(3, i, 0.25 * static_cast<double>(i + 1));
+            circuit.add_crx_gate(i, 3, 0.5);
+        }
+        circuit.add_ry_gate(1, 0.4);
+        circuit.add_cx_gate(1, 2);
+
+        const auto initial_state = ket::generate_random_state(4, 5678);
+
+        auto expected = initial_state;
+        ket::simulate(circuit, expected);
+
+        auto actual = initial_state;
+        ket::simulate_with_hot_qubits_first(circuit, actual);
+
+        REQUIRE(ket::almost_eq(actual, expected));
+    }
+
+    SECTION("the classical register is unchanged")
+    {
+        auto circuit = ket::QuantumCircuit {3, 2};
+        circuit.add_x_gate(2);
+        circuit.add_cx_gate(2, 1);
+        circuit.add_x_gate(2);
+        circuit.add_m_gate(2, 0);
+        circuit.add_m_gate(1, 1);
+
+        auto state = ket::Statevector {"000"};
+        const auto cregister = ket::simulate_with_hot_qubits_first(circuit, state);
+
+        REQUIRE(cregister.get(0) == 0);
+        REQUIRE(cregister.get(1) == 1);
+        REQUIRE(ket::almost_eq(state, ket::Statevector {"010"}));
+    }
+}
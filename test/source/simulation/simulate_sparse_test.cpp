@@ -0,0 +1,182 @@
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#define REQUIRE_MSG(cond, msg) do { INFO(msg); REQUIRE(cond); } while((void)0, 0)
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit/control_flow_predicate.hpp"
+#include "kettle/common/mathtools.hpp"
+#include "kettle/gates/common_u_gates.hpp"
+#include "kettle/gates/random_u_gates.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/simulation/simulate_sparse.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/sparse_statevector.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+TEST_CASE("compare sparse statevector simulations with statevector simulations")
+{
+    struct TestCase
+    {
+        std::string message;
+        std::function<void(ket::QuantumCircuit&)> circ_func;
+    };
+
+    const auto testcase = GENERATE(
+        TestCase {"H", [](ket::QuantumCircuit& circ) { circ.add_h_gate(0); }},
+        TestCase {"X", [](ket::QuantumCircuit& circ) { circ.add_x_gate(1); }},
+        TestCase {"Y", [](ket::QuantumCircuit& circ) { circ.add_y_gate(2); }},
+        TestCase {"Z", [](ket::QuantumCircuit& circ) { circ.add_z_gate(0); }},
+        TestCase {"S", [](ket::QuantumCircuit& circ) { circ.add_s_gate(1); }},
+        TestCase {"SDAG", [](ket::QuantumCircuit& circ) { circ.add_sdag_gate(2); }},
+        TestCase {"T", [](ket::QuantumCircuit& circ) { circ.add_t_gate(0); }},
+        TestCase {"TDAG", [](ket::QuantumCircuit& circ) { circ.add_tdag_gate(1); }},
+        TestCase {"SX", [](ket::QuantumCircuit& circ) { circ.add_sx_gate(2); }},
+        TestCase {"SXDAG", [](ket::QuantumCircuit& circ) { circ.add_sxdag_gate(0); }},
+        TestCase {"RX", [](ket::QuantumCircuit& circ) { circ.add_rx_gate(1, 0.1234); }},
+        TestCase {"RY", [](ket::QuantumCircuit& circ) { circ.add_ry_gate(2, -1.234); }},
+        TestCase {"RZ", [](ket::QuantumCircuit& circ) { circ.add_rz_gate(0, 2.345); }},
+        TestCase {"P", [](ket::QuantumCircuit& circ) { circ.add_p_gate(1, 0.789); }},
+        TestCase {"CH", [](ket::QuantumCircuit& circ) { circ.add_ch_gate(0, 1); }},
+        TestCase {"CX", [](ket::QuantumCircuit& circ) { circ.add_cx_gate(1, 2); }},
+        TestCase {"CY", [](ket::QuantumCircuit& circ) { circ.add_cy_gate(2, 0); }},
+        TestCase {"CZ", [](ket::QuantumCircuit& circ) { circ.add_cz_gate(0, 2); }},
+        TestCase {"CS", [](ket::QuantumCircuit& circ) { circ.add_cs_gate(1, 0); }},
+        TestCase {"CSDAG", [](ket::QuantumCircuit& circ) { circ.add_csdag_gate(2, 1); }},
+        TestCase {"CT", [](ket::QuantumCircuit& circ) { circ.add_ct_gate(0, 1); }},
+        TestCase {"CTDAG", [](ket::QuantumCircuit& circ) { circ.add_ctdag_gate(1, 2); }},
+        TestCase {"CSX", [](ket::QuantumCircuit& circ) { circ.add_csx_gate(2, 0); }},
+        TestCase {"CSXDAG", [](ket::QuantumCircuit& circ) { circ.add_csxdag_gate(0, 2); }},
+        TestCase {"CRX", [](ket::QuantumCircuit& circ) { circ.add_crx_gate(1, 0, 0.4321); }},
+        TestCase {"CRY", [](ket::QuantumCircuit& circ) { circ.add_cry_gate(2, 1, -0.321); }},
+        TestCase {"CRZ", [](ket::QuantumCircuit& circ) { circ.add_crz_gate(0, 1, 1.21); }},
+        TestCase {"CP", [](ket::QuantumCircuit& circ) { circ.add_cp_gate(1, 2, 3.0); }},
+        TestCase {"U", [](ket::QuantumCircuit& circ) { circ.add_u_gate(ket::generate_random_unitary2x2(42), 2); }},
+        TestCase {"CU", [](ket::QuantumCircuit& circ) { circ.add_cu_gate(ket::generate_random_unitary2x2(43), 2, 0); }}
+    );
+
+    const auto n_qubits = std::size_t {3};
+    auto circuit = ket::QuantumCircuit {n_qubits};
+    testcase.circ_func(circuit);
+
+    auto dense = ket::generate_random_state(n_qubits, 98765);
+    auto sparse = ket::SparseStatevector {dense};
+
+    ket::simulate(circuit, dense);
+    ket::simulate(circuit, sparse);
+
+    REQUIRE_MSG(ket::almost_eq(ket::to_statevector(sparse), dense), testcase.message);
+}
+
+TEST_CASE("sparse simulation of a reversible circuit keeps a small support")
+{
+    // a chain of CX gates copies the 0th qubit down the register; the result is a GHZ state
+    const auto n_qubits = std::size_t {50};
+    auto circuit = ket::QuantumCircuit {n_qubits};
+    circuit.add_h_gate(0);
+    for (std::size_t i {0}; i < n_qubits - 1; ++i) {
+        circuit.add_cx_gate(i, i + 1);
+    }
+
+    auto state = ket::SparseStatevector {n_qubits};
+    ket::simulate(circuit, state);
+
+    const auto all_ones = (std::size_t {1} << n_qubits) - 1;
+
+    REQUIRE(state.n_nonzero() == 2);
+    REQUIRE(ket::almost_eq(state.at(0), {M_SQRT1_2, 0.0}));
+    REQUIRE(ket::almost_eq(state.at(all_ones), {M_SQRT1_2, 0.0}));
+}
+
+TEST_CASE("sparse simulation prunes amplitudes that cancel")
+{
+    auto circuit = ket::QuantumCircuit {2};
+    circuit.add_h_gate(0);
+    circuit.add_h_gate(0);
+
+    auto state = ket::SparseStatevector {2};
+    ket::simulate(circuit, state);
+
+    REQUIRE(state.n_nonzero() == 1);
+    REQUIRE(ket::almost_eq(state.at(0), {1.0, 0.0}));
+}
+
+TEST_CASE("sparse simulation with measurements and control flow")
+{
+    SECTION("measurement collapses the state")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_x_gate(0);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_m_gate(1);
+
+        auto state = ket::SparseStatevector {2};
+        auto simulator = ket::SparseStatevectorSimulator {};
+        simulator.run(circuit, state);
+
+        REQUIRE(simulator.has_been_run());
+        REQUIRE(simulator.classical_register().get(1) == 1);
+        REQUIRE(ket::almost_eq(state, ket::SparseStatevector {"11"}));
+    }
+
+    SECTION("same outcomes as the dense simulator for the same seed")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate({0, 1, 2});
+        circuit.add_m_gate({0, 1});
+        circuit.add_if_else_statement(
+            ket::ControlFlowPredicate {{0, 1}, {1, 0}, ket::ControlFlowBooleanKind::IF},
+            [] { auto circ = ket::QuantumCircuit {3}; circ.add_x_gate(2); return circ; }(),
+            [] { auto circ = ket::QuantumCircuit {3}; circ.add_rx_gate(2, 0.5); return circ; }()
+        );
+
+        for (auto seed : {1, 2, 3, 4, 5}) {
+            auto dense = ket::Statevector {3};
+            auto dense_simulator = ket::StatevectorSimulator {};
+            dense_simulator.run(circuit, dense, seed);
+
+            auto sparse = ket::SparseStatevector {3};
+            auto sparse_simulator = ket::SparseStatevectorSimulator {};
+            sparse_simulator.run(circuit, sparse, seed);
+
+            REQUIRE(sparse_simulator.classical_register().get(0) == dense_simulator.classical_register().get(0));
+            REQUIRE(sparse_simulator.classical_register().get(1) == dense_simulator.classical_register().get(1));
+            REQUIRE(ket::almost_eq(ket::to_statevector(sparse), dense));
+        }
+    }
+
+    SECTION("circuit loggers")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_x_gate(1);
+        circuit.add_statevector_circuit_logger();
+        circuit.add_m_gate(1);
+        circuit.add_classical_register_circuit_logger();
+
+        auto state = ket::SparseStatevector {2};
+        auto simulator = ket::SparseStatevectorSimulator {};
+        simulator.run(circuit, state);
+
+        const auto& loggers = simulator.circuit_loggers();
+        REQUIRE(loggers.size() == 2);
+        REQUIRE(loggers[0].is_statevector_circuit_logger());
+        REQUIRE(ket::almost_eq(loggers[0].get_statevector_circuit_logger().statevector(), ket::Statevector {"01"}));
+        REQUIRE(loggers[1].is_classical_register_circuit_logger());
+        REQUIRE(loggers[1].get_classical_register_circuit_logger().classical_register().get(1) == 1);
+    }
+}
+
+TEST_CASE("sparse simulation throws for mismatched number of qubits")
+{
+    auto circuit = ket::QuantumCircuit {3};
+    auto state = ket::SparseStatevector {2};
+
+    REQUIRE_THROWS_AS(ket::simulate(circuit, state), std::runtime_error);
+}
@@ -0,0 +1,84 @@
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/io/write_tangelo_file.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/simulation/simulate_tangelo_stream.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+TEST_CASE("simulate_tangelo_stream()")
+{
+    SECTION("gives the same state as simulating the full circuit")
+    {
+        auto circuit = ket::QuantumCircuit {4};
+        for (std::size_t i {0}; i < 50; ++i) {
+            circuit.add_h_gate(i % 4);
+            circuit.add_cx_gate(i % 4, (i + 1) % 4);
+            circuit.add_ry_gate((i + 2) % 4, 0.1 * static_cast<double>(i));
+            circuit.add_cp_gate((i + 3) % 4, i % 4, 0.05 * static_cast<double>(i));
+        }
+
+        auto sstream = std::stringstream {};
+        ket::write_tangelo_circuit(circuit, sstream);
+
+        const auto block_size = GENERATE(std::size_t {1}, std::size_t {7}, std::size_t {1000});
+
+        auto expected = ket::generate_random_state(4, 123);
+        auto actual = expected;
+
+        ket::simulate(circuit, expected);
+
+        auto simulator = ket::StatevectorSimulator {};
+        ket::simulate_tangelo_stream(simulator, sstream, 0, actual, std::nullopt, block_size);
+
+        REQUIRE(simulator.has_been_run());
+        REQUIRE(ket::almost_eq(expected, actual));
+    }
+
+    SECTION("measurements carry over to control flow in later blocks")
+    {
+        auto if_subcircuit = ket::QuantumCircuit {3};
+        if_subcircuit.add_x_gate(2);
+
+        auto else_subcircuit = ket::QuantumCircuit {3};
+        else_subcircuit.add_h_gate(2);
+
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_x_gate(0);
+        circuit.add_m_gate(0);
+        circuit.add_h_gate(1);
+        circuit.add_h_gate(1);
+        circuit.add_if_statement(0, if_subcircuit);
+        circuit.add_if_else_statement(0, if_subcircuit, else_subcircuit);
+        circuit.add_m_gate(2);
+
+        auto sstream = std::stringstream {};
+        ket::write_tangelo_circuit(circuit, sstream);
+
+        auto state = ket::Statevector {"000"};
+        auto simulator = ket::StatevectorSimulator {};
+        ket::simulate_tangelo_stream(simulator, sstream, 0, state, 42, 1);
+
+        // the X-gate is applied twice, once by each control flow statement
+        REQUIRE(ket::almost_eq(state, ket::Statevector {"100"}));
+        REQUIRE(simulator.classical_register().get(0) == 1);
+        REQUIRE(simulator.classical_register().get(2) == 0);
+    }
+
+    SECTION("parsing errors are passed to the caller")
+    {
+        auto sstream = std::stringstream {"H         target : [0]\nNOTAGATE  target : [1]\n"};
+
+        auto state = ket::Statevector {"00"};
+        auto simulator = ket::StatevectorSimulator {};
+
+        REQUIRE_THROWS_AS(ket::simulate_tangelo_stream(simulator, sstream, 0, state, std::nullopt, 1), std::runtime_error);
+    }
+}
@@ -1290,3 +1290,93 @@ TEST_CASE("simulate and get statevector loggers")
     const auto expected3 = ket::Statevector {{ {0.5, 0.0}, {0.5, 0.0}, {0.5, 0.0}, {0.5, 0.0} }};
     REQUIRE(ket::almost_eq(logger3.statevector(), expected3));
 }
+
+TEST_CASE("simulate_branches()")
+{
+    SECTION("circuit without measurements has a single branch")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_cx_gate(0, 1);
+
+        const auto branches = ket::simulate_branches(circuit, ket::Statevector {"00"}, 1000, 42);
+
+        auto expected = ket::Statevector {"00"};
+        ket::simulate(circuit, expected);
+
+        REQUIRE(branches.size() == 1);
+        REQUIRE(branches[0].n_shots == 1000);
+        REQUIRE(ket::almost_eq(branches[0].state, expected));
+    }
+
+    SECTION("measurement splits the shots between the outcomes")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_m_gate(0);
+
+        const auto n_shots = std::size_t {10000};
+        const auto branches = ket::simulate_branches(circuit, ket::Statevector {"00"}, n_shots, 42);
+
+        REQUIRE(branches.size() == 2);
+
+        auto total_shots = std::size_t {0};
+        for (const auto& branch : branches) {
+            total_shots += branch.n_shots;
+
+            // roughly half of the shots should go to each outcome
+            REQUIRE(branch.n_shots > 4500);
+            REQUIRE(branch.n_shots < 5500);
+
+            const auto expected = branch.cregister.get(0) == 0 ? ket::Statevector {"00"} : ket::Statevector {"11"};
+            REQUIRE(ket::almost_eq(branch.state, expected));
+        }
+
+        REQUIRE(total_shots == n_shots);
+        REQUIRE(branches[0].cregister.get(0) != branches[1].cregister.get(0));
+    }
+
+    SECTION("deterministic measurement does not split the shots")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_x_gate(1);
+        circuit.add_m_gate({0, 1});
+
+        const auto branches = ket::simulate_branches(circuit, ket::Statevector {"00"}, 100, 42);
+
+        REQUIRE(branches.size() == 1);
+        REQUIRE(branches[0].n_shots == 100);
+        REQUIRE(branches[0].cregister.get(0) == 0);
+        REQUIRE(branches[0].cregister.get(1) == 1);
+    }
+
+    SECTION("control flow follows the outcome of each branch")
+    {
+        auto circuit = ket::QuantumCircuit {2};
+        circuit.add_h_gate(0);
+        circuit.add_m_gate(0);
+        circuit.add_if_statement(0, [] {
+            auto subcircuit = ket::QuantumCircuit {2};
+            subcircuit.add_x_gate(1);
+            return subcircuit;
+        }());
+
+        const auto branches = ket::simulate_branches(circuit, ket::Statevector {"00"}, 1000, 42);
+
+        REQUIRE(branches.size() == 2);
+        for (const auto& branch : branches) {
+            const auto expected = branch.cregister.get(0) == 0 ? ket::Statevector {"00"} : ket::Statevector {"11"};
+            REQUIRE(ket::almost_eq(branch.state, expected));
+        }
+    }
+
+    SECTION("zero shots gives no branches")
+    {
+        auto circuit = ket::QuantumCircuit {1};
+        circuit.add_h_gate(0);
+        circuit.add_m_gate(0);
+
+        REQUIRE(ket::simulate_branches(circuit, ket::Statevector {"0"}, 0).empty());
+    }
+}
@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/matchers/catch_matchers_vector.hpp>
+
+#include "kettle/circuit/circuit.hpp"
+#include "kettle/circuit_operations/relabel_qubits.hpp"
+#include "kettle/simulation/simulate.hpp"
+#include "kettle/state/permute_qubits.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+TEST_CASE("permute_qubits()")
+{
+    SECTION("computational basis states")
+    {
+        struct TestCase
+        {
+            std::string input;
+            std::vector<std::size_t> new_qubit_indices;
+            std::string expected;
+        };
+
+        const auto testcase = GENERATE(
+            TestCase {"100", {0, 1, 2}, "100"},
+            TestCase {"100", {2, 0, 1}, "001"},
+            TestCase {"110", {2, 0, 1}, "101"},
+            TestCase {"1101", {3, 2, 1, 0}, "1011"},
+            TestCase {"1000", {1, 2, 3, 0}, "0100"}
+        );
+
+        const auto state = ket::Statevector {testcase.input};
+        const auto permuted = ket::permute_qubits(state, testcase.new_qubit_indices);
+
+        REQUIRE(ket::almost_eq(permuted, ket::Statevector {testcase.expected}));
+    }
+
+    SECTION("the inverse permutation restores the state")
+    {
+        const auto state = ket::generate_random_state(5, 1234);
+        const auto new_qubit_indices = std::vector<std::size_t> {3, 0, 4, 1, 2};
+
+        const auto permuted = ket::permute_qubits(state, new_qubit_indices);
+        const auto restored = ket::permute_qubits(permuted, ket::inverse_qubit_permutation(new_qubit_indices));
+
+        REQUIRE(ket::almost_eq(restored, state));
+    }
+
+    SECTION("matches simulating a relabelled circuit")
+    {
+        auto circuit = ket::QuantumCircuit {3};
+        circuit.add_h_gate(0);
+        circuit.add_cx_gate(0, 1);
+        circuit.add_ry_gate(2, 0.7);
+        circuit.add_crz_gate(2, 1, 0.3);
+
+        const auto new_qubit_indices = std::vector<std::size_t> {1, 2, 0};
+        const auto relabelled = ket::relabel_qubits(circuit, new_qubit_indices, 3);
+
+        auto state = ket::Statevector {"000"};
+        ket::simulate(circuit, state);
+
+        auto relabelled_state = ket::Statevector {"000"};
+        ket::simulate(relabelled, relabelled_state);
+
+        REQUIRE(ket::almost_eq(ket::permute_qubits(state, new_qubit_indices), relabelled_state));
+    }
+
+    SECTION("throws for invalid permutations")
+    {
+        const auto state = ket::Statevector {"000"};
+
+        REQUIRE_THROWS_AS(ket::permute_qubits(state, {0, 1}), std::runtime_error);
+        REQUIRE_THROWS_AS(ket::permute_qubits(state, {0, 1, 3}), std::runtime_error);
+        REQUIRE_THROWS_AS(ket::permute_qubits(state, {0, 1, 1}), std::runtime_error);
+        REQUIRE_THROWS_AS(ket::inverse_qubit_permutation({2, 2, 0}), std::runtime_error);
+    }
+}
+
+TEST_CASE("inverse_qubit_permutation()")
+{
+    REQUIRE_THAT(ket::inverse_qubit_permutation({2, 0, 1}), Catch::Matchers::Equals(std::vector<std::size_t> {1, 2, 0}));
+    REQUIRE_THAT(ket::inverse_qubit_permutation({0, 1, 2}), Catch::Matchers::Equals(std::vector<std::size_t> {0, 1, 2}));
+}
@@ -0,0 +1,152 @@
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include "kettle/common/mathtools.hpp"
+#include "kettle/state/endian.hpp"
+#include "kettle/state/random.hpp"
+#include "kettle/state/sparse_statevector.hpp"
+#include "kettle/state/statevector.hpp"
+
+
+TEST_CASE("SparseStatevector default construction")
+{
+    const auto state = ket::SparseStatevector {3};
+
+    REQUIRE(state.n_qubits() == 3);
+    REQUIRE(state.n_states() == 8);
+    REQUIRE(state.n_nonzero() == 1);
+    REQUIRE(ket::almost_eq(state.at(0), {1.0, 0.0}));
+
+    for (std::size_t i {1}; i < state.n_states(); ++i) {
+        REQUIRE(ket::almost_eq(state.at(i), {0.0, 0.0}));
+    }
+}
+
+TEST_CASE("SparseStatevector from string")
+{
+    SECTION("|110>, little endian")
+    {
+        const auto state = ket::SparseStatevector {"110", ket::Endian::LITTLE};
+        REQUIRE(state.n_nonzero() == 1);
+        REQUIRE(ket::almost_eq(state.at(3), {1.0, 0.0}));
+        REQUIRE(ket::almost_eq(state.at("110"), {1.0, 0.0}));
+    }
+
+    SECTION("|110>, big endian")
+    {
+        const auto state = ket::SparseStatevector {"110", ket::Endian::BIG};
+        REQUIRE(state.n_nonzero() == 1);
+        REQUIRE(ket::almost_eq(state.at(6), {1.0, 0.0}));
+        REQUIRE(ket::almost_eq(state.at("110", ket::Endian::BIG), {1.0, 0.0}));
+    }
+}
+
+TEST_CASE("SparseStatevector with many qubits only stores the support")
+{
+    const auto n_qubits = std::size_t {60};
+    const auto state = ket::SparseStatevector {n_qubits};
+
+    REQUIRE(state.n_qubits() == n_qubits);
+    REQUIRE(state.n_states() == (std::size_t {1} << n_qubits));
+    REQUIRE(state.n_nonzero() == 1);
+}
+
+TEST_CASE("SparseStatevector from amplitudes")
+{
+    SECTION("valid amplitudes")
+    {
+        const auto amplitudes = ket::SparseStatevector::AmplitudeMap {{0, {M_SQRT1_2, 0.0}}, {5, {0.0, M_SQRT1_2}}};
+        const auto state = ket::SparseStatevector {3, amplitudes};
+
+        REQUIRE(state.n_nonzero() == 2);
+        REQUIRE(ket::almost_eq(state.at(0), {M_SQRT1_2, 0.0}));
+        REQUIRE(ket::almost_eq(state.at(5), {0.0, M_SQRT1_2}));
+    }
+
+    SECTION("explicit zeros are pruned")
+    {
+        const auto amplitudes = ket::SparseStatevector::AmplitudeMap {{1, {1.0, 0.0}}, {2, {0.0, 0.0}}};
+        const auto state = ket::SparseStatevector {2, amplitudes};
+
+        REQUIRE(state.n_nonzero() == 1);
+    }
+
+    SECTION("throws if not normalized")
+    {
+        const auto amplitudes = ket::SparseStatevector::AmplitudeMap {{0, {1.0, 0.0}}, {1, {1.0, 0.0}}};
+        REQUIRE_THROWS_AS(ket::SparseStatevector(2, amplitudes), std::runtime_error);
+    }
+
+    SECTION("throws if an index is out of bounds")
+    {
+        const auto amplitudes = ket::SparseStatevector::AmplitudeMap {{4, {1.0, 0.0}}};
+        REQUIRE_THROWS_AS(ket::SparseStatevector(2, amplitudes), std::runtime_error);
+    }
+}
+
+TEST_CASE("Invalid SparseStatevector creation throws exceptions")
+{
+    SECTION("zero qubits")
+    {
+        REQUIRE_THROWS_AS(ket::SparseStatevector(0), std::runtime_error);
+    }
+
+    SECTION("too many qubits")
+    {
+        REQUIRE_THROWS_AS(ket::SparseStatevector(64), std::runtime_error);
+    }
+
+    SECTION("out of bounds access")
+    {
+        const auto state = ket::SparseStatevector {2};
+        REQUIRE_THROWS_AS(state.at(4), std::runtime_error);
+    }
+}
+
+TEST_CASE("SparseStatevector conversion to and from Statevector")
+{
+    SECTION("round trip of a random dense state")
+    {
+        const auto dense = ket::generate_random_state(4, 12345);
+        const auto sparse = ket::SparseStatevector {dense};
+
+        REQUIRE(sparse.n_qubits() == dense.n_qubits());
+        REQUIRE(ket::almost_eq(ket::to_statevector(sparse), dense));
+    }
+
+    SECTION("zero amplitudes are not stored")
+    {
+        const auto dense = ket::Statevector {{{M_SQRT1_2, 0.0}, {0.0, 0.0}, {0.0, 0.0}, {0.0, -M_SQRT1_2}}};
+        const auto sparse = ket::SparseStatevector {dense};
+
+        REQUIRE(sparse.n_nonzero() == 2);
+        REQUIRE(ket::almost_eq(sparse.at(3), {0.0, -M_SQRT1_2}));
+    }
+}
+
+TEST_CASE("almost_eq() for SparseStatevector")
+{
+    const auto left = ket::SparseStatevector {"01"};
+
+    SECTION("same state")
+    {
+        const auto right = ket::SparseStatevector {ket::Statevector {"01"}};
+        REQUIRE(ket::almost_eq(left, right));
+    }
+
+    SECTION("different state")
+    {
+        const auto right = ket::SparseStatevector {"10"};
+        REQUIRE(!ket::almost_eq(left, right));
+    }
+
+    SECTION("different number of qubits")
+    {
+        const auto right = ket::SparseStatevector {"010"};
+        REQUIRE(!ket::almost_eq(left, right));
+    }
+}